@@ -0,0 +1,152 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Administrator.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Times the PCM (IMA-ADPCM) voice decoder of the plugin the way the voice path drives it: a header
+// notification and a data notification per frame, decoded behind each other into one buffer until
+// a batch is complete, like GATTRemote does before it hands the audio over.
+
+using namespace WPEFramework;
+
+namespace {
+
+    static constexpr uint16_t MaxDecodedFrame = 1024;
+    static constexpr uint16_t MaxVoiceBuffer = 4 * MaxDecodedFrame;
+
+    struct Options {
+        Options()
+            : Frames(200000)
+            , Size(20)
+            , Batch(4)
+        {
+        }
+
+        uint32_t Frames;
+        uint32_t Size;
+        uint32_t Batch;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-frames") == 0)) {
+                options.Frames = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-size") == 0)) {
+                options.Size = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-batch") == 0)) {
+                options.Batch = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Frames == 0) || (options.Size < 6) || (options.Size > 0xFF) || (options.Batch == 0) || ((options.Batch * options.Size * 4) > MaxVoiceBuffer));
+    }
+
+    void ShowHelp()
+    {
+        printf("BluetoothRemoteControlDecoderBenchmark [options]\n"
+               "\t-frames <count>           Frames to decode [200000]\n"
+               "\t-size <bytes>             ADPCM bytes per frame, 6 to 255 [20]\n"
+               "\t-batch <count>            Frames decoded into one buffer before it is handed over [4]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    Decoders::IDecoder* decoder = Decoders::IDecoder::Instance(Exchange::IVoiceProducer::IProfile::codec::PCM, string());
+
+    if (decoder == nullptr) {
+        fprintf(stderr, "No PCM decoder available\n");
+        return (2);
+    }
+
+    // 32 different frames, so the branch predictor can not learn the data.
+    std::vector< std::vector<uint8_t> > frames(32, std::vector<uint8_t>(options.Size));
+    uint32_t state = 0xCAFEBABE;
+
+    for (std::vector<uint8_t>& frame : frames) {
+        for (uint8_t& byte : frame) {
+            state = (state * 1664525) + 1013904223;
+            byte = static_cast<uint8_t>(state >> 24);
+        }
+    }
+
+    std::vector<uint8_t> buffer(MaxVoiceBuffer);
+    uint64_t samples = 0;
+    uint32_t deliveries = 0;
+    uint32_t checksum = 0;
+    uint16_t pending = 0;
+    uint32_t batched = 0;
+
+    decoder->Reset();
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (uint32_t index = 0; index < options.Frames; index++) {
+        const std::vector<uint8_t>& frame(frames[index % 32]);
+        const uint8_t header[5] = { static_cast<uint8_t>(index % 32), static_cast<uint8_t>(index % 89), frame[0], frame[1], 0 };
+
+        decoder->Decode(sizeof(header), header, MaxDecodedFrame, &(buffer[pending]));
+        pending += decoder->Decode(static_cast<uint16_t>(frame.size()), frame.data(), MaxDecodedFrame, &(buffer[pending]));
+
+        if (++batched >= options.Batch) {
+            // Stands in for the hand over, it has to touch the decoded audio.
+            checksum += buffer[0] + buffer[pending - 1];
+            samples += (pending / sizeof(int16_t));
+            deliveries++;
+            pending = 0;
+            batched = 0;
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("frames,size,batch,deliveries,dropped,samples,msamples_per_s,ns_per_sample,checksum\n");
+    printf("%u,%u,%u,%u,%u,%llu,%.2f,%.2f,%u\n",
+        options.Frames, options.Size, options.Batch, deliveries, decoder->Dropped(),
+        static_cast<unsigned long long>(samples),
+        (seconds > 0 ? (samples / seconds) / 1000000.0 : 0),
+        (samples > 0 ? (seconds * 1000000000.0) / samples : 0),
+        checksum);
+
+    const bool result = ((decoder->Dropped() == 0) && (samples == (static_cast<uint64_t>(deliveries) * options.Batch * options.Size * 2)));
+
+    delete decoder;
+
+    return (result == true ? 0 : 2);
+}
@@ -0,0 +1,301 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+#include <NotificationQueue.h>
+
+// Feeds synthetic GATT notifications from one thread to another, the way the communicator thread
+// hands them to the decoupling thread of the BluetoothRemoteControl plugin. The "ring" mode uses
+// the NotificationQueue of the plugin, the "list" mode the locked std::list of heap allocated copies
+// it replaced. Every notification carries a sequence number and its injection time, so losses and
+// the latency up to the consumer are reported next to the throughput. Unpaced, the producer waits
+// for a free slot, to measure throughput. Paced, a notification that finds the ring full is dropped,
+// like the plugin does.
+
+namespace {
+
+    static constexpr uint16_t VoiceHandle = 0x0033;
+    static constexpr uint16_t Slots = 64;
+    static constexpr uint16_t SlotSize = 0xFF;
+
+    typedef WPEFramework::Plugin::NotificationQueue<Slots, SlotSize> Ring;
+
+    struct Options {
+        Options()
+            : Notifications(100000)
+            , Size(20)
+            , Rate(0)
+            , List(false)
+        {
+        }
+
+        uint32_t Notifications;
+        uint32_t Size;
+        uint32_t Rate;
+        bool List;
+    };
+
+    struct Header {
+        uint32_t Sequence;
+        uint64_t Time;
+    } __attribute__((packed));
+
+    struct Result {
+        Result()
+            : Received(0)
+            , Gaps(0)
+            , Next(0)
+            , Checksum(0)
+            , Latencies()
+        {
+        }
+
+        std::atomic<uint32_t> Received;
+        uint32_t Gaps;
+        uint32_t Next;
+        uint32_t Checksum;
+        std::vector<uint32_t> Latencies;
+    };
+
+    // The list based decoupling as it was: a copy per notification, a lock on both sides.
+    class List {
+    public:
+        List(const List&) = delete;
+        List& operator=(const List&) = delete;
+
+        List()
+            : _lock()
+            , _queue()
+        {
+        }
+
+    public:
+        bool Push(const uint16_t handle, const uint8_t length, const uint8_t data[])
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _queue.emplace_back(handle, std::string(reinterpret_cast<const char*>(data), length));
+            return (true);
+        }
+        bool Pop(uint16_t& handle, std::string& data)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            bool result = (_queue.empty() == false);
+            if (result == true) {
+                handle = _queue.front().first;
+                data = _queue.front().second;
+                _queue.pop_front();
+            }
+            return (result);
+        }
+    private:
+        std::mutex _lock;
+        std::list< std::pair<uint16_t, std::string> > _queue;
+    };
+
+    uint64_t Now()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((static_cast<uint64_t>(now.tv_sec) * 1000000000) + now.tv_nsec);
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-notifications") == 0)) {
+                options.Notifications = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-size") == 0)) {
+                options.Size = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-rate") == 0)) {
+                options.Rate = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-mode") == 0)) {
+                index++;
+                options.List = (strcmp(argv[index], "list") == 0);
+                showHelp = ((options.List == false) && (strcmp(argv[index], "ring") != 0));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Notifications == 0) || (options.Size < sizeof(Header)) || (options.Size > SlotSize));
+    }
+
+    void ShowHelp()
+    {
+        printf("BluetoothRemoteControlBenchmark [options]\n"
+               "\t-notifications <count>    Notifications to pass [100000]\n"
+               "\t-size <bytes>             Payload per notification, %u to %u [20]\n"
+               "\t-rate <count>             Notifications per second, 0 is as fast as possible [0]\n"
+               "\t-mode <ring|list>         Slot ring or locked list of copies [ring]\n",
+            static_cast<uint32_t>(sizeof(Header)), SlotSize);
+    }
+
+    // Stands in for the decoder, it has to look at every byte.
+    void Decode(const uint8_t length, const uint8_t data[], Result& result)
+    {
+        Header header;
+        memcpy(&header, data, sizeof(header));
+
+        const uint64_t now = Now();
+        result.Latencies.push_back(static_cast<uint32_t>((now - header.Time) / 1000));
+        result.Gaps += (header.Sequence != result.Next ? 1 : 0);
+        result.Next = header.Sequence + 1;
+
+        for (uint8_t index = sizeof(header); index < length; index++) {
+            result.Checksum += data[index];
+        }
+
+        result.Received++;
+    }
+
+    void Consume(Ring& ring, const uint32_t total, const std::atomic<bool>& done, Result& result)
+    {
+        while ((result.Received < total) && ((done.load() == false) || (ring.IsEmpty() == false))) {
+            const Ring::Slot* slot;
+
+            if ((slot = ring.Front()) == nullptr) {
+                std::this_thread::yield();
+            } else {
+                Decode(slot->Length, slot->Data, result);
+                ring.Pop();
+            }
+        }
+    }
+
+    void Consume(List& list, const uint32_t total, const std::atomic<bool>& done, Result& result)
+    {
+        uint16_t handle;
+        std::string data;
+
+        while ((result.Received < total) && (done.load() == false)) {
+            if (list.Pop(handle, data) == false) {
+                std::this_thread::yield();
+            } else {
+                Decode(static_cast<uint8_t>(data.length()), reinterpret_cast<const uint8_t*>(data.c_str()), result);
+            }
+        }
+    }
+
+    template <typename QUEUE>
+    uint32_t Produce(QUEUE& queue, const Options& options)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        uint8_t frame[SlotSize];
+        uint32_t sent = 0;
+
+        for (uint32_t index = 0; index < options.Size; index++) {
+            frame[index] = static_cast<uint8_t>(index);
+        }
+
+        for (uint32_t sequence = 0; sequence < options.Notifications; sequence++) {
+            Header header;
+            header.Sequence = sequence;
+            header.Time = Now();
+            memcpy(frame, &header, sizeof(header));
+
+            if (options.Rate == 0) {
+                while (queue.Push(VoiceHandle, static_cast<uint8_t>(options.Size), frame) == false) {
+                    std::this_thread::yield();
+                }
+                sent++;
+            } else {
+                sent += (queue.Push(VoiceHandle, static_cast<uint8_t>(options.Size), frame) == true ? 1 : 0);
+                std::this_thread::sleep_until(start + std::chrono::microseconds((static_cast<uint64_t>(sequence + 1) * 1000000) / options.Rate));
+            }
+        }
+
+        return (sent);
+    }
+
+    template <typename QUEUE>
+    int Run(QUEUE& queue, const Options& options)
+    {
+        Result result;
+        std::atomic<bool> done(false);
+        result.Latencies.reserve(options.Notifications);
+
+        std::thread consumer([&]() { Consume(queue, options.Notifications, done, result); });
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const uint32_t sent = Produce(queue, options);
+
+        // Whatever has not arrived a second after the last notification is lost.
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while ((result.Received < sent) && (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        done = true;
+        consumer.join();
+
+        printf("mode,notifications,size,rate,sent,received,dropped,gaps,per_s,min_us,p50_us,p99_us,max_us\n");
+
+        std::vector<uint32_t>& latencies(result.Latencies);
+        std::sort(latencies.begin(), latencies.end());
+
+        if (latencies.empty() == true) {
+            latencies.push_back(0);
+        }
+
+        printf("%s,%u,%u,%u,%u,%u,%u,%u,%.0f,%u,%u,%u,%u\n",
+            (options.List == true ? "list" : "ring"), options.Notifications, options.Size, options.Rate, sent, result.Received.load(),
+            options.Notifications - sent, result.Gaps, (seconds > 0 ? result.Received.load() / seconds : 0),
+            latencies.front(), latencies[latencies.size() / 2], latencies[(latencies.size() * 99) / 100], latencies.back());
+
+        return ((result.Received == options.Notifications) && (result.Gaps == 0) ? 0 : 2);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    int exitCode;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        exitCode = 1;
+    } else if (options.List == true) {
+        List list;
+        exitCode = Run(list, options);
+    } else {
+        // Heap allocated, like the plugin has it as a member of a heap allocated object.
+        Ring* ring = new Ring();
+        exitCode = Run(*ring, options);
+        delete ring;
+    }
+
+    return (exitCode);
+}
@@ -449,8 +449,11 @@ namespace Plugin {
         }
     }
 
-    void BluetoothRemoteControl::VoiceData(const uint32_t seq, const uint16_t length, const uint8_t dataBuffer[])
+    void BluetoothRemoteControl::VoiceData(const uint32_t seq, const uint8_t frames, const uint16_t length, const uint8_t dataBuffer[])
     {
+        // The data holds the frames seq up to seq + frames - 1, they are delivered under the first one.
+        TRACE(Trace::Information, (_T("Audio frames: %u-%u, %u bytes"), seq, seq + frames - 1, length));
+
         _adminLock.Lock();
 
         if (_voiceHandler != nullptr) {
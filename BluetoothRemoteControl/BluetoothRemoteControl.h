@@ -22,6 +22,7 @@
 #include "Module.h"
 
 #include "Administrator.h"
+#include "NotificationQueue.h"
 #include "WAVRecorder.h"
 
 #include <interfaces/IBluetooth.h>
@@ -77,6 +78,8 @@ namespace Plugin {
         class GATTRemote : public Bluetooth::GATTSocket {
         private:
             static constexpr uint16_t HID_UUID         = 0x1812;
+            static constexpr uint16_t MaxDecodedFrame  = 1024;
+            static constexpr uint16_t MaxVoiceBuffer   = 4 * MaxDecodedFrame;
 
             class Flow {
             public:
@@ -141,43 +144,19 @@ namespace Plugin {
 
             class Decoupling : public Core::Thread {
             private:
-                class Slot {
-                public:
-                    Slot() = delete;
-                    Slot& operator= (const Slot&) = delete;
-                    Slot(const uint16_t handle, const uint8_t length, const uint8_t data[]) 
-                        : _handle(handle)
-                        , _data(reinterpret_cast<const char*>(data), length) {
-                    }
-                    Slot(const Slot& copy) 
-                        : _handle(copy._handle)
-                        , _data(copy._data) {
-                    }
-                    ~Slot() {
-                    }
-                public:
-                    uint16_t Handle() const {
-                        return (_handle);
-                    }
-                    uint8_t Length() const {
-                        return (static_cast<uint8_t>(_data.length()));
-                    }
-                    const uint8_t* Data() const {
-                        return (reinterpret_cast<const uint8_t*>(_data.c_str()));
-                    }
+                // Voice notifications arrive in bursts, room for well over the ones of a single burst.
+                static constexpr uint16_t Slots = 64;
+                static constexpr uint16_t SlotSize = 0xFF;
 
-                private:
-                    uint16_t _handle;
-                    std::string _data;
-                };
+                typedef NotificationQueue<Slots, SlotSize> Queue;
 
             public:
                 Decoupling(const Decoupling&) = delete;
                 Decoupling& operator=(const Decoupling&) = delete;
                 Decoupling(GATTRemote* parent)
                     : _parent(*parent)
-                    , _adminLock()
                     , _queue()
+                    , _dropped(0)
                 {
                     ASSERT(parent != nullptr);
                 }
@@ -186,27 +165,27 @@ namespace Plugin {
                 }
 
             public:
+                // Only called from the communicator thread.
                 void Submit(const uint16_t handle, const uint8_t length, const uint8_t buffer[])
                 {
                     ASSERT (length > 0);
 
-                    _adminLock.Lock();
-                    _queue.emplace_back(Slot(handle, length, buffer));
-                    _adminLock.Unlock();
+                    if (_queue.Push(handle, length, buffer) == false) {
+                        _dropped++;
+                        TRACE(Trace::Error, (_T("Notification on handle %d dropped, %d dropped so far"), handle, _dropped));
+                    }
 
                     Run();
                 }
                 uint32_t Worker() override
                 {
-                    Block();
+                    const Queue::Slot* entry;
 
-                    while (_queue.size() > 0) {
+                    Block();
 
-                        _adminLock.Lock();
-                        Slot entry (_queue.front());
-                        _queue.pop_front();
-                        _adminLock.Unlock();
-                        _parent.Message(entry.Handle(), entry.Length(), entry.Data());
+                    while ((entry = _queue.Front()) != nullptr) {
+                        _parent.Message(entry->Handle, entry->Length, entry->Data);
+                        _queue.Pop();
                     }
 
                     return (Core::infinite);
@@ -214,8 +193,8 @@ namespace Plugin {
 
             private:
                 GATTRemote& _parent;
-                Core::CriticalSection _adminLock;
-                std::list<Slot> _queue;
+                Queue _queue;
+                uint32_t _dropped;
             };
 
             class AudioProfile : public Exchange::IVoiceProducer::IProfile {
@@ -268,12 +247,14 @@ namespace Plugin {
                         , SampleRate(8000)
                         , Channels(1)
                         , Resolution(16)
+                        , Batch(1)
                     {    
                         Add(_T("codec"), &Codec);
                         Add(_T("samplerate"), &SampleRate);
                         Add(_T("channels"), &Channels);
                         Add(_T("resolution"), &Resolution);
                         Add(_T("configuration"), &Configuration);
+                        Add(_T("batch"), &Batch);
                     }
                     ~Profile() override 
                     {
@@ -285,6 +266,7 @@ namespace Plugin {
                     Core::JSON::DecUInt8 Channels;
                     Core::JSON::DecUInt8 Resolution;
                     Core::JSON::String Configuration;
+                    Core::JSON::DecUInt8 Batch;
                 };
 
             public:
@@ -451,6 +433,12 @@ namespace Plugin {
                 , _voiceCommandHandle(~0)
                 , _audioProfile(nullptr)
                 , _decoder(nullptr)
+                , _startFrame(false)
+                , _currentKey(0)
+                , _voiceLength(0)
+                , _voiceSequence(0)
+                , _voiceFrames(0)
+                , _voiceBatch(1)
             {
                 Config config;
                 config.FromString(configuration);
@@ -488,6 +476,12 @@ namespace Plugin {
                 , _voiceCommandHandle(data.VoiceCommandHandle.Value())
                 , _audioProfile(nullptr)
                 , _decoder(nullptr)
+                , _startFrame(false)
+                , _currentKey(0)
+                , _voiceLength(0)
+                , _voiceSequence(0)
+                , _voiceFrames(0)
+                , _voiceBatch(1)
             {
                 Config config;
                 config.FromString(configuration);
@@ -565,6 +559,9 @@ namespace Plugin {
                 _audioProfile->Release();
 
                 _decoder = Decoders::IDecoder::Instance(config.Codec.Value(), config.Configuration.Value());
+                _voiceBatch = std::max(static_cast<uint8_t>(1), config.Batch.Value());
+                _voiceLength = 0;
+                _voiceFrames = 0;
 
                 if (_decoder == nullptr) {
                     _decoder = nullptr;
@@ -590,15 +587,25 @@ namespace Plugin {
                 _adminLock.Lock();
 
                 if ( (handle == _voiceDataHandle) && (_decoder != nullptr) ) {
-                    uint8_t decoded[1024];
-                    uint16_t sendLength = _decoder->Decode(length, buffer, sizeof(decoded), decoded);
+                    // Decode straight behind what is already pending, so a number of frames can
+                    // be handed over in one go.
+                    uint16_t sendLength = _decoder->Decode(length, buffer, MaxDecodedFrame, &(_voiceBuffer[_voiceLength]));
                     if (sendLength > 0) {
-                        ASSERT (sendLength <= sizeof(decoded));
+                        ASSERT (sendLength <= MaxDecodedFrame);
                         if (_startFrame == true) {
                             _startFrame = false;
                             _parent->VoiceData(_audioProfile);
                         }
-                        _parent->VoiceData(_decoder->Frames(), sendLength, decoded);
+                        if (_voiceFrames == 0) {
+                            // A chunk is reported by the sequence number of the first frame in it.
+                            _voiceSequence = _decoder->Frames();
+                        }
+                        _voiceLength += sendLength;
+                        _voiceFrames++;
+
+                        if ((_voiceFrames >= _voiceBatch) || ((_voiceLength + MaxDecodedFrame) > MaxVoiceBuffer)) {
+                            FlushVoiceData();
+                        }
                     }
                 }
                 else if ( (handle == _keysDataHandle) && (length >= 2) ) {
@@ -615,13 +622,17 @@ namespace Plugin {
 
                     // If we start, reset.
                     if (buffer[0] == 0) {
-                        // We are done, signal that the button to speak has been released!
+                        // We are done, deliver what is still pending and signal that the button
+                        // to speak has been released!
+                        FlushVoiceData();
                         _parent->VoiceData(nullptr);
                     }
                     else {
                         // Looks like the TPress-to-talk button is pressed...
                         _decoder->Reset();
                         _startFrame = true;
+                        _voiceLength = 0;
+                        _voiceFrames = 0;
                     }
                 }
                 else if ( (handle == _batteryLevelHandle) && (length >= 1) ) {
@@ -630,6 +641,14 @@ namespace Plugin {
 
                 _adminLock.Unlock();
             }
+            void FlushVoiceData()
+            {
+                if (_voiceLength > 0) {
+                    _parent->VoiceData(_voiceSequence, _voiceFrames, _voiceLength, _voiceBuffer);
+                    _voiceLength = 0;
+                    _voiceFrames = 0;
+                }
+            }
             void Constructor(const Config& config) 
             {
                 ASSERT(_parent != nullptr);
@@ -645,6 +664,7 @@ namespace Plugin {
                 }
 
                 _decoder = Decoders::IDecoder::Instance(config.AudioProfile.Codec.Value(), config.AudioProfile.Configuration.Value());
+                _voiceBatch = std::max(static_cast<uint8_t>(1), config.AudioProfile.Batch.Value());
 
                 if (_decoder != nullptr) { 
                     _audioProfile = Core::Service<AudioProfile>::Create<AudioProfile>(
@@ -970,6 +990,13 @@ namespace Plugin {
             Decoders::IDecoder* _decoder;
             bool _startFrame;
             uint16_t _currentKey;
+
+            // Decoded voice frames waiting to be delivered as one chunk.
+            uint8_t _voiceBuffer[MaxVoiceBuffer];
+            uint16_t _voiceLength;
+            uint32_t _voiceSequence;
+            uint8_t _voiceFrames;
+            uint8_t _voiceBatch;
         };
 
     public:
@@ -1083,7 +1110,7 @@ namespace Plugin {
         uint32_t Revoke();
         void Operational(const GATTRemote::Data& settings);
         void VoiceData(Exchange::IVoiceProducer::IProfile* profile);
-        void VoiceData(const uint32_t seq, const uint16_t length, const uint8_t dataBuffer[]);
+        void VoiceData(const uint32_t seq, const uint8_t frames, const uint16_t length, const uint8_t dataBuffer[]);
         void KeyEvent(const bool pressed, const uint16_t keyCode);
         void BatteryLevel(const uint8_t level);
         
@@ -0,0 +1,105 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Single producer, single consumer ring of preallocated slots for GATT notifications. The
+    // communicator thread copies a notification straight into a free slot, the decoupling thread
+    // hands the slot to the decoder as is and frees it afterwards. Nothing is allocated and no lock
+    // is taken on either side. Only depends on the standard library, so it can be used stand alone.
+    template <const uint16_t SLOTS, const uint16_t PAYLOAD>
+    class NotificationQueue {
+    private:
+        static_assert((SLOTS != 0) && ((SLOTS & (SLOTS - 1)) == 0), "The number of slots must be a power of 2");
+        static_assert(PAYLOAD <= 0xFF, "A notification payload does not exceed 255 bytes");
+
+    public:
+        struct Slot {
+            uint16_t Handle;
+            uint8_t Length;
+            uint8_t Data[PAYLOAD];
+        };
+
+    public:
+        NotificationQueue(const NotificationQueue<SLOTS, PAYLOAD>&) = delete;
+        NotificationQueue<SLOTS, PAYLOAD>& operator=(const NotificationQueue<SLOTS, PAYLOAD>&) = delete;
+
+        NotificationQueue()
+            : _head(0)
+            , _tail(0)
+        {
+        }
+        ~NotificationQueue()
+        {
+        }
+
+    public:
+        inline bool IsEmpty() const
+        {
+            return (_head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire));
+        }
+        // Producer side only, fails if all slots are taken or the payload does not fit a slot.
+        bool Push(const uint16_t handle, const uint8_t length, const uint8_t data[])
+        {
+            bool result = false;
+            const uint32_t tail = _tail.load(std::memory_order_relaxed);
+
+            if ((length <= PAYLOAD) && ((tail - _head.load(std::memory_order_acquire)) < SLOTS)) {
+                Slot& slot(_slots[tail & (SLOTS - 1)]);
+                slot.Handle = handle;
+                slot.Length = length;
+                ::memcpy(slot.Data, data, length);
+                _tail.store(tail + 1, std::memory_order_release);
+                result = true;
+            }
+
+            return (result);
+        }
+
+        // Consumer side only. The slot stays owned by the consumer until it is handed back with Pop().
+        const Slot* Front() const
+        {
+            const uint32_t head = _head.load(std::memory_order_relaxed);
+
+            return (head != _tail.load(std::memory_order_acquire) ? &(_slots[head & (SLOTS - 1)]) : nullptr);
+        }
+        void Pop()
+        {
+            _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+    private:
+        // Keep the indexes on their own cache line, they are written by different threads. Padded
+        // rather than aligned, the queue is a member of heap allocated objects.
+        std::atomic<uint32_t> _head;
+        uint8_t _headPadding[64 - sizeof(std::atomic<uint32_t>)];
+        std::atomic<uint32_t> _tail;
+        uint8_t _tailPadding[64 - sizeof(std::atomic<uint32_t>)];
+        Slot _slots[SLOTS];
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
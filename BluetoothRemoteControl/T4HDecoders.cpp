@@ -182,93 +182,120 @@ public:
     }
 
 private:
-    int16_t DecodeNibble (const uint8_t nibble) {
-
-        static const int8_t IndexLUT[] = {
-            -1, -1, -1, -1, 2, 4, 6, 8,
-            -1, -1, -1, -1, 2, 4, 6, 8
-        };
-
-        static const uint16_t StepSizeLUT[] = {
-            7,     8,     9,     10,    11,    12,    13,    14,
-            16,    17,    19,    21,    23,    25,    28,    31,
-            34,    37,    41,    45,    50,    55,    60,    66,    
-            73,    80,    88,    97,    107,   118,   130,   143,
-            157,   173,   190,   209,   230,   253,   279,   307,   
-            337,   371,   408,   449,   494,   544,   598,   658,
-            724,   796,   876,   963,   1060,  1166,  1282,  1411,  
-            1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,
-            3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  
-            7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
-            15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 
-            32767
-        };
-
-        uint16_t step = StepSizeLUT[_SI_dec];
-        uint16_t cum_diff = step >> 3;
-
-        _SI_dec += IndexLUT[nibble];
-
-        if (_SI_dec < 0) {
-            _SI_dec = 0;
-        }
-        else if (_SI_dec > 88) {
-            _SI_dec = 88;
-        }
+    // IMA-ADPCM is a serial process, every sample depends on the previous predictor and step
+    // index, so the work per nibble is brought down to a single table lookup instead. For every
+    // step index and nibble the table holds the (signed) difference to apply and the next index.
+    struct Step {
+        int32_t Difference;
+        uint8_t Index;
+    };
 
-        if ((nibble & 4) != 0) {
-            cum_diff += step;
-        }
-        if ((nibble & 2) != 0) {
-            cum_diff += step >> 1;
-        }
-        if ((nibble & 1) != 0) {
-            cum_diff += step >> 2;
-        }
-        if ((nibble & 8) != 0) {
-            if (_PV_dec < (-32767 + cum_diff)) {
-                _PV_dec = -32767;
-            }
-            else {
-                _PV_dec -= cum_diff;
+    static constexpr uint8_t MaxStepIndex = 88;
+
+    class StepTable {
+    public:
+        StepTable(const StepTable&) = delete;
+        StepTable& operator= (const StepTable&) = delete;
+
+        StepTable()
+        {
+            static const int8_t IndexLUT[] = {
+                -1, -1, -1, -1, 2, 4, 6, 8,
+                -1, -1, -1, -1, 2, 4, 6, 8
+            };
+
+            static const uint16_t StepSizeLUT[] = {
+                7,     8,     9,     10,    11,    12,    13,    14,
+                16,    17,    19,    21,    23,    25,    28,    31,
+                34,    37,    41,    45,    50,    55,    60,    66,
+                73,    80,    88,    97,    107,   118,   130,   143,
+                157,   173,   190,   209,   230,   253,   279,   307,
+                337,   371,   408,   449,   494,   544,   598,   658,
+                724,   796,   876,   963,   1060,  1166,  1282,  1411,
+                1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,
+                3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,
+                7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+                15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+                32767
+            };
+
+            for (uint8_t index = 0; index <= MaxStepIndex; index++) {
+                const uint16_t step = StepSizeLUT[index];
+
+                for (uint8_t nibble = 0; nibble < 16; nibble++) {
+                    int32_t difference = (step >> 3);
+
+                    if ((nibble & 4) != 0) {
+                        difference += step;
+                    }
+                    if ((nibble & 2) != 0) {
+                        difference += (step >> 1);
+                    }
+                    if ((nibble & 1) != 0) {
+                        difference += (step >> 2);
+                    }
+
+                    const int16_t next = static_cast<int16_t>(index) + IndexLUT[nibble];
+
+                    _steps[index][nibble].Difference = ((nibble & 8) != 0 ? -difference : difference);
+                    _steps[index][nibble].Index = static_cast<uint8_t>(std::max(static_cast<int16_t>(0), std::min(static_cast<int16_t>(MaxStepIndex), next)));
+                }
             }
         }
-        else {
-            if (_PV_dec > (0x7fff - cum_diff)) {
-                _PV_dec = 0x7fff;
-            }
-            else {
-                _PV_dec += cum_diff;
-	    }
+        ~StepTable() {
+        }
+
+    public:
+        inline const Step& Lookup(const uint8_t index, const uint8_t nibble) const {
+            return (_steps[index][nibble]);
         }
-        return (_PV_dec);
+
+    private:
+        Step _steps[MaxStepIndex + 1][16];
+    };
+
+    static const StepTable& Steps() {
+        static const StepTable table;
+        return (table);
+    }
+
+    inline int16_t DecodeNibble (const StepTable& table, int32_t& predictor, uint8_t& index, const uint8_t nibble) const {
+        const Step& entry (table.Lookup(index, nibble));
+
+        // Branch free clamp, the compiler turns these into conditional moves.
+        predictor = std::max(static_cast<int32_t>(-32767), std::min(static_cast<int32_t>(32767), predictor + entry.Difference));
+        index = entry.Index;
+
+        return (static_cast<int16_t>(predictor));
     }
     uint16_t DecodeStream(const uint16_t lengthIn, const uint8_t dataIn[], const uint16_t lengthOut, uint8_t dataOut[])
     {
-        // TODO: check lengthOut
-        uint16_t maxStorage = (lengthOut / 4);
+        const StepTable& table (Steps());
+        const uint16_t maxBytes = std::min(lengthIn, static_cast<uint16_t>(lengthOut / (2 * sizeof(int16_t))));
         int16_t* output = reinterpret_cast<int16_t*>(dataOut);
 
-        for (uint16_t index = 0; index < lengthIn; index++)
-        {
-            uint8_t byte = dataIn[index];
+        // Work on locals, so the state stays in registers for the whole frame.
+        int32_t predictor = _PV_dec;
+        uint8_t index = static_cast<uint8_t>(std::max(static_cast<int8_t>(0), std::min(static_cast<int8_t>(MaxStepIndex), _SI_dec)));
 
-            int16_t dec1 = DecodeNibble(byte & 0xF);
-            int16_t dec2 = DecodeNibble((byte >> 4) & 0xF);
+        for (uint16_t loop = 0; loop < maxBytes; loop++) {
+            const uint8_t byte = dataIn[loop];
 
-            if (maxStorage >= 2) {
+            output[0] = DecodeNibble(table, predictor, index, (byte & 0xF));
+            output[1] = DecodeNibble(table, predictor, index, (byte >> 4));
+            output += 2;
+        }
 
-                // Add the new bytes
-                *output++ = dec1;
-                *output++ = dec2;
-                maxStorage -= 2;
-            }
-            else if (maxStorage >= 1) {
-                *output++ = dec1;
-                maxStorage -= 1;
-            }
-   	}
-        return (lengthIn * 4);
+        // Whatever did not fit, still has to move the decoder state forward.
+        for (uint16_t loop = maxBytes; loop < lengthIn; loop++) {
+            DecodeNibble(table, predictor, index, (dataIn[loop] & 0xF));
+            DecodeNibble(table, predictor, index, (dataIn[loop] >> 4));
+        }
+
+        _PV_dec = static_cast<int16_t>(predictor);
+        _SI_dec = static_cast<int8_t>(index);
+
+        return (maxBytes * 2 * sizeof(int16_t));
     }
 
 private:
@@ -0,0 +1,437 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Administrator.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Golden test of the PCM (IMA-ADPCM) voice decoder. The captures are fed, notification by notification,
+// through the decoder of the plugin and through the per-nibble decoder it replaced, the samples have to
+// be identical. Without arguments synthetic captures are used: a tone sweep, a clipping square wave and
+// noise, encoded the way the remote does. Recorded captures can be passed with -capture, a capture file
+// holds the notifications of the voice data characteristic, each prefixed by its length in one byte.
+
+using namespace WPEFramework;
+
+namespace {
+
+    static constexpr uint16_t MaxDecodedFrame = 1024;
+
+    static const int8_t IndexLUT[] = {
+        -1, -1, -1, -1, 2, 4, 6, 8,
+        -1, -1, -1, -1, 2, 4, 6, 8
+    };
+
+    static const uint16_t StepSizeLUT[] = {
+        7,     8,     9,     10,    11,    12,    13,    14,
+        16,    17,    19,    21,    23,    25,    28,    31,
+        34,    37,    41,    45,    50,    55,    60,    66,
+        73,    80,    88,    97,    107,   118,   130,   143,
+        157,   173,   190,   209,   230,   253,   279,   307,
+        337,   371,   408,   449,   494,   544,   598,   658,
+        724,   796,   876,   963,   1060,  1166,  1282,  1411,
+        1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,
+        3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,
+        7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+        15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+        32767
+    };
+
+    typedef std::vector< std::vector<uint8_t> > Capture;
+
+    // The decoder as it was before it became table driven, this is what the output is checked against.
+    class Reference {
+    public:
+        Reference(const Reference&) = delete;
+        Reference& operator=(const Reference&) = delete;
+
+        Reference()
+            : _PV_dec(0)
+            , _SI_dec(0)
+            , _started(false)
+        {
+        }
+
+    public:
+        void Decode(const std::vector<uint8_t>& notification, std::vector<int16_t>& samples)
+        {
+            if (notification.size() == 5) {
+                _PV_dec = static_cast<int16_t>((notification[3] << 8) | notification[2]);
+                _SI_dec = notification[1];
+                _started = true;
+            } else if ((notification.size() > 1) && (_started == true)) {
+                for (const uint8_t byte : notification) {
+                    samples.push_back(DecodeNibble(byte & 0xF));
+                    samples.push_back(DecodeNibble((byte >> 4) & 0xF));
+                }
+            }
+        }
+
+    private:
+        int16_t DecodeNibble(const uint8_t nibble)
+        {
+            uint16_t step = StepSizeLUT[_SI_dec];
+            uint16_t cum_diff = step >> 3;
+
+            _SI_dec += IndexLUT[nibble];
+
+            if (_SI_dec < 0) {
+                _SI_dec = 0;
+            } else if (_SI_dec > 88) {
+                _SI_dec = 88;
+            }
+
+            if ((nibble & 4) != 0) {
+                cum_diff += step;
+            }
+            if ((nibble & 2) != 0) {
+                cum_diff += step >> 1;
+            }
+            if ((nibble & 1) != 0) {
+                cum_diff += step >> 2;
+            }
+            if ((nibble & 8) != 0) {
+                if (_PV_dec < (-32767 + cum_diff)) {
+                    _PV_dec = -32767;
+                } else {
+                    _PV_dec -= cum_diff;
+                }
+            } else {
+                if (_PV_dec > (0x7fff - cum_diff)) {
+                    _PV_dec = 0x7fff;
+                } else {
+                    _PV_dec += cum_diff;
+                }
+            }
+            return (_PV_dec);
+        }
+
+    private:
+        int16_t _PV_dec;
+        int8_t _SI_dec;
+        bool _started;
+    };
+
+    // IMA-ADPCM encoder, only there to turn a signal into the notifications a remote sends:
+    // a header with sequence number, step index and predictor, the data and a footer.
+    class Encoder {
+    public:
+        Encoder(const Encoder&) = delete;
+        Encoder& operator=(const Encoder&) = delete;
+
+        Encoder()
+            : _predictor(0)
+            , _index(0)
+        {
+        }
+
+    public:
+        void Encode(const std::vector<int16_t>& signal, const uint16_t frameSize, Capture& capture)
+        {
+            uint8_t sequence = 0;
+
+            for (size_t offset = 0; (offset + (2 * frameSize)) <= signal.size(); offset += (2 * frameSize)) {
+                std::vector<uint8_t> header(5);
+                header[0] = sequence;
+                header[1] = _index;
+                header[2] = static_cast<uint8_t>(_predictor & 0xFF);
+                header[3] = static_cast<uint8_t>((_predictor >> 8) & 0xFF);
+                header[4] = 0;
+                capture.push_back(header);
+
+                std::vector<uint8_t> data(frameSize);
+                for (uint16_t index = 0; index < frameSize; index++) {
+                    const uint8_t low = Nibble(signal[offset + (2 * index)]);
+                    const uint8_t high = Nibble(signal[offset + (2 * index) + 1]);
+                    data[index] = static_cast<uint8_t>(low | (high << 4));
+                }
+                capture.push_back(data);
+                capture.push_back(std::vector<uint8_t>(1, 0));
+
+                sequence = (sequence + 1) % 32;
+            }
+        }
+
+    private:
+        uint8_t Nibble(const int16_t sample)
+        {
+            const int32_t step = StepSizeLUT[_index];
+            int32_t difference = static_cast<int32_t>(sample) - _predictor;
+            uint8_t nibble = 0;
+
+            if (difference < 0) {
+                nibble = 8;
+                difference = -difference;
+            }
+            if (difference >= step) {
+                nibble |= 4;
+                difference -= step;
+            }
+            if (difference >= (step >> 1)) {
+                nibble |= 2;
+                difference -= (step >> 1);
+            }
+            if (difference >= (step >> 2)) {
+                nibble |= 1;
+            }
+
+            // Track the predictor exactly the way the decoder does.
+            int32_t delta = (step >> 3);
+            delta += ((nibble & 4) != 0 ? step : 0);
+            delta += ((nibble & 2) != 0 ? (step >> 1) : 0);
+            delta += ((nibble & 1) != 0 ? (step >> 2) : 0);
+            _predictor += ((nibble & 8) != 0 ? -delta : delta);
+            _predictor = (_predictor < -32767 ? -32767 : (_predictor > 32767 ? 32767 : _predictor));
+
+            const int16_t next = static_cast<int16_t>(_index) + IndexLUT[nibble];
+            _index = static_cast<uint8_t>(next < 0 ? 0 : (next > 88 ? 88 : next));
+
+            return (nibble);
+        }
+
+    private:
+        int32_t _predictor;
+        uint8_t _index;
+    };
+
+    std::vector<int16_t> Sweep(const uint32_t samples)
+    {
+        std::vector<int16_t> signal(samples);
+        for (uint32_t index = 0; index < samples; index++) {
+            const double time = static_cast<double>(index) / 16000.0;
+            signal[index] = static_cast<int16_t>(12000.0 * sin(2 * M_PI * (100.0 + (1900.0 * time)) * time));
+        }
+        return (signal);
+    }
+
+    std::vector<int16_t> Square(const uint32_t samples)
+    {
+        std::vector<int16_t> signal(samples);
+        for (uint32_t index = 0; index < samples; index++) {
+            signal[index] = (((index / 40) & 1) != 0 ? 32767 : -32768);
+        }
+        return (signal);
+    }
+
+    std::vector<int16_t> Noise(const uint32_t samples)
+    {
+        std::vector<int16_t> signal(samples);
+        uint32_t state = 0x12345678;
+        for (uint32_t index = 0; index < samples; index++) {
+            state = (state * 1664525) + 1013904223;
+            signal[index] = static_cast<int16_t>(state >> 16);
+        }
+        return (signal);
+    }
+
+    // Random data behind every header, step indexes and predictors included, to hit every table entry
+    // and both clamps.
+    Capture Random(const uint32_t frames, const uint16_t frameSize)
+    {
+        Capture capture;
+        uint32_t state = 0xCAFEBABE;
+
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            std::vector<uint8_t> header(5);
+            state = (state * 1664525) + 1013904223;
+            header[0] = static_cast<uint8_t>(frame % 32);
+            header[1] = static_cast<uint8_t>((state >> 8) % 89);
+            header[2] = static_cast<uint8_t>(state >> 16);
+            header[3] = static_cast<uint8_t>(state >> 24);
+            header[4] = 0;
+            capture.push_back(header);
+
+            std::vector<uint8_t> data(frameSize);
+            for (uint8_t& byte : data) {
+                state = (state * 1664525) + 1013904223;
+                byte = static_cast<uint8_t>(state >> 24);
+            }
+            capture.push_back(data);
+        }
+
+        return (capture);
+    }
+
+    bool Load(const char fileName[], Capture& capture)
+    {
+        FILE* file = fopen(fileName, "rb");
+        int length;
+
+        if (file != nullptr) {
+            while ((length = fgetc(file)) != EOF) {
+                std::vector<uint8_t> notification(length);
+                if ((length > 0) && (fread(notification.data(), 1, length, file) != static_cast<size_t>(length))) {
+                    break;
+                }
+                capture.push_back(notification);
+            }
+            fclose(file);
+        }
+
+        return ((file != nullptr) && (capture.empty() == false));
+    }
+
+    // Runs a capture through both decoders, an output buffer of lengthOut bytes is offered per notification.
+    bool Compare(const char name[], const Capture& capture, const uint16_t lengthOut)
+    {
+        Decoders::IDecoder* decoder = Decoders::IDecoder::Instance(Exchange::IVoiceProducer::IProfile::codec::PCM, string());
+        Reference reference;
+        std::vector<int16_t> expected;
+        std::vector<int16_t> decoded;
+        uint8_t buffer[MaxDecodedFrame];
+        bool result = (decoder != nullptr);
+
+        if (result == true) {
+            decoder->Reset();
+
+            for (const std::vector<uint8_t>& notification : capture) {
+                std::vector<int16_t> samples;
+                reference.Decode(notification, samples);
+
+                const uint16_t length = decoder->Decode(static_cast<uint16_t>(notification.size()), notification.data(), lengthOut, buffer);
+
+                if (length > lengthOut) {
+                    printf("%s: %u bytes reported, only %u offered\n", name, length, lengthOut);
+                    result = false;
+                }
+
+                // What did not fit is lost, but must not change what is decoded after it.
+                const uint16_t fitting = std::min(static_cast<uint16_t>(samples.size() * sizeof(int16_t)), lengthOut);
+                const uint16_t expectedLength = fitting - (fitting % (2 * sizeof(int16_t)));
+
+                if (length != expectedLength) {
+                    printf("%s: %u bytes decoded, %u expected\n", name, length, expectedLength);
+                    result = false;
+                }
+
+                expected.insert(expected.end(), samples.begin(), samples.begin() + (expectedLength / sizeof(int16_t)));
+                decoded.insert(decoded.end(), reinterpret_cast<const int16_t*>(buffer), reinterpret_cast<const int16_t*>(buffer) + (length / sizeof(int16_t)));
+            }
+
+            for (size_t index = 0; (result == true) && (index < expected.size()); index++) {
+                if (expected[index] != decoded[index]) {
+                    printf("%s: sample %u is %d, %d expected\n", name, static_cast<uint32_t>(index), decoded[index], expected[index]);
+                    result = false;
+                }
+            }
+
+            delete decoder;
+        }
+
+        printf("%-24s %8u samples %s\n", name, static_cast<uint32_t>(decoded.size()), (result == true ? "ok" : "FAILED"));
+
+        return (result);
+    }
+
+    // Sequence numbers wrap at 32, a gap is reported as dropped frames.
+    bool Sequence()
+    {
+        Decoders::IDecoder* decoder = Decoders::IDecoder::Instance(Exchange::IVoiceProducer::IProfile::codec::PCM, string());
+        static const uint8_t Sequences[] = { 30, 31, 0, 3, 4, 2 };
+        const uint8_t data[20] = {};
+        uint8_t buffer[MaxDecodedFrame];
+        bool result = (decoder != nullptr);
+
+        if (result == true) {
+            decoder->Reset();
+
+            for (const uint8_t sequence : Sequences) {
+                const uint8_t header[5] = { sequence, 0, 0, 0, 0 };
+                decoder->Decode(sizeof(header), header, sizeof(buffer), buffer);
+                decoder->Decode(sizeof(data), data, sizeof(buffer), buffer);
+            }
+
+            // 1 and 2 are missing after 0, after 4 the next 29 (5..31 and 0, 1) are missing.
+            result = ((decoder->Frames() == (sizeof(Sequences) - 1)) && (decoder->Dropped() == (2 + 29)));
+
+            printf("%-24s %8u frames, %u dropped %s\n", "sequence", decoder->Frames(), decoder->Dropped(), (result == true ? "ok" : "FAILED"));
+
+            delete decoder;
+        }
+
+        return (result);
+    }
+
+    bool ParseOptions(int argc, char** argv, std::vector<const char*>& captures)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-capture") == 0)) {
+                captures.push_back(argv[++index]);
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return (showHelp);
+    }
+
+    void ShowHelp()
+    {
+        printf("BluetoothRemoteControlDecoderTest [options]\n"
+               "\t-capture <file>           Recorded voice notifications, length prefixed, to check instead of the synthetic ones\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<const char*> captures;
+
+    if (ParseOptions(argc, argv, captures) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    bool result = true;
+
+    if (captures.empty() == false) {
+        for (const char* fileName : captures) {
+            Capture capture;
+
+            if (Load(fileName, capture) == false) {
+                printf("Could not load capture [%s]\n", fileName);
+                result = false;
+            } else {
+                result = Compare(fileName, capture, MaxDecodedFrame) && result;
+            }
+        }
+    } else {
+        Capture sweep, square, noise;
+        Encoder().Encode(Sweep(16000), 20, sweep);
+        Encoder().Encode(Square(16000), 20, square);
+        Encoder().Encode(Noise(16000), 128, noise);
+
+        result = Compare("sweep", sweep, MaxDecodedFrame) && result;
+        result = Compare("square", square, MaxDecodedFrame) && result;
+        result = Compare("noise", noise, MaxDecodedFrame) && result;
+        result = Compare("random", Random(2000, 40), MaxDecodedFrame) && result;
+        result = Compare("random, short output", Random(2000, 40), 100) && result;
+        result = Sequence() && result;
+    }
+
+    return (result == true ? 0 : 2);
+}
@@ -539,6 +539,99 @@ namespace Plugin {
         return (result);
     }
 
+    uint32_t Compositor::Commit(const Transaction& transaction)
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        _adminLock.Lock();
+
+        // Check everything up front, a transaction is applied completely or not at all.
+        for (auto& entry : transaction._changes) {
+            if (_clients.find(entry.first) == _clients.end()) {
+                result = Core::ERROR_FIRST_RESOURCE_NOT_FOUND;
+            } else if (((entry.second.Flags & Transaction::OPACITY) != 0) && (entry.second.Opacity > Exchange::IComposition::maxOpacity)) {
+                result = Core::ERROR_BAD_REQUEST;
+            }
+        }
+        for (auto& entry : transaction._order) {
+            if (_clients.find(entry.first) == _clients.end()) {
+                result = Core::ERROR_FIRST_RESOURCE_NOT_FOUND;
+            } else if ((entry.second.empty() == false) && (_clients.find(entry.second) == _clients.end())) {
+                result = Core::ERROR_SECOND_RESOURCE_NOT_FOUND;
+            }
+        }
+
+        if (result == Core::ERROR_NONE) {
+            std::vector<string> original(_zOrder.begin(), _zOrder.end());
+            std::vector<string> order(original);
+
+            // Resolve all reorders on the copy, only where a client ends up counts.
+            for (auto& entry : transaction._order) {
+                if (entry.first != entry.second) {
+                    order.erase(std::find(order.begin(), order.end(), entry.first));
+                    order.insert((entry.second.empty() == true ? order.begin() : std::find(order.begin(), order.end(), entry.second)), entry.first);
+                }
+            }
+
+            // The geometry can fail, the geometry it replaces is kept to put back if anything fails.
+            std::list< std::pair<Exchange::IComposition::IClient*, Exchange::IComposition::Rectangle> > resized;
+
+            for (auto& entry : transaction._changes) {
+                if ((result == Core::ERROR_NONE) && ((entry.second.Flags & Transaction::GEOMETRY) != 0)) {
+                    Exchange::IComposition::IClient* client(_clients[entry.first]);
+                    const Exchange::IComposition::Rectangle previous(client->Geometry());
+
+                    result = client->Geometry(entry.second.Rectangle);
+
+                    if (result == Core::ERROR_NONE) {
+                        resized.emplace_front(client, previous);
+                    }
+                }
+            }
+
+            if (result == Core::ERROR_NONE) {
+                // The compositors can only raise a client to the top. So from the deepest position that
+                // changes up, every client is raised, bottom to top, the one that ends up on top last.
+                uint16_t deepest = static_cast<uint16_t>(order.size());
+                while ((deepest != 0) && (order[deepest - 1] == original[deepest - 1])) {
+                    deepest--;
+                }
+
+                uint16_t index = deepest;
+                while ((index-- != 0) && (result == Core::ERROR_NONE)) {
+                    result = _clients[order[index]]->ZOrder(0);
+                }
+
+                if (result != Core::ERROR_NONE) {
+                    // Below the deepest change nothing moved, raising the rest as it was brings it back.
+                    index = deepest;
+                    while (index-- != 0) {
+                        _clients[original[index]]->ZOrder(0);
+                    }
+                }
+            }
+
+            if (result == Core::ERROR_NONE) {
+                // Opacity can not fail once its range is checked, so it goes last, when nothing can be undone.
+                for (auto& entry : transaction._changes) {
+                    if ((entry.second.Flags & Transaction::OPACITY) != 0) {
+                        _clients[entry.first]->Opacity(entry.second.Opacity);
+                    }
+                }
+
+                _zOrder.assign(order.begin(), order.end());
+            } else {
+                for (auto& entry : resized) {
+                    entry.first->Geometry(entry.second);
+                }
+            }
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
     Exchange::IComposition::IClient* Compositor::InterfaceByCallsign(const string& callsign) const
     {
         Exchange::IComposition::IClient* client = nullptr;
@@ -158,6 +158,179 @@ namespace Plugin {
             Core::JSON::DecUInt32 Height;
         };
 
+    public:
+        // A set of scene changes that is validated as a whole and applied in one go. Unless all clients
+        // involved are attached nothing is applied. Geometry and opacity changes to the same client
+        // collapse into the last one, z-order changes are applied in the order they were added.
+        class Transaction {
+        private:
+            Transaction(const Transaction&) = delete;
+            Transaction& operator=(const Transaction&) = delete;
+
+            enum change : uint8_t {
+                GEOMETRY = 0x01,
+                OPACITY = 0x02
+            };
+
+            struct Change {
+                Change()
+                    : Flags(0)
+                    , Rectangle()
+                    , Opacity(0)
+                {
+                }
+
+                uint8_t Flags;
+                Exchange::IComposition::Rectangle Rectangle;
+                uint32_t Opacity;
+            };
+
+        public:
+            Transaction()
+                : _changes()
+                , _order()
+            {
+            }
+            ~Transaction()
+            {
+            }
+
+        public:
+            inline bool IsEmpty() const
+            {
+                return ((_changes.empty() == true) && (_order.empty() == true));
+            }
+            void Geometry(const string& callsign, const Exchange::IComposition::Rectangle& rectangle)
+            {
+                Change& entry(_changes[callsign]);
+                entry.Flags |= GEOMETRY;
+                entry.Rectangle = rectangle;
+            }
+            void Opacity(const string& callsign, const uint32_t value)
+            {
+                Change& entry(_changes[callsign]);
+                entry.Flags |= OPACITY;
+                entry.Opacity = value;
+            }
+            void ToTop(const string& callsign)
+            {
+                _order.emplace_back(callsign, string());
+            }
+            void PutBefore(const string& callsignRelativeTo, const string& callsignToReorder)
+            {
+                _order.emplace_back(callsignToReorder, callsignRelativeTo);
+            }
+
+        private:
+            friend class Compositor;
+
+            std::map<string, Change> _changes;
+            // Client to reorder and the client it is put in front of, on top if that is empty.
+            std::list< std::pair<string, string> > _order;
+        };
+
+        class TransactionParamsData : public Core::JSON::Container {
+        public:
+            class GeometryData : public Core::JSON::Container {
+            public:
+                GeometryData()
+                    : Core::JSON::Container()
+                {
+                    Init();
+                }
+                GeometryData(const GeometryData& other)
+                    : Core::JSON::Container()
+                    , X(other.X)
+                    , Y(other.Y)
+                    , Width(other.Width)
+                    , Height(other.Height)
+                {
+                    Init();
+                }
+                GeometryData& operator=(const GeometryData& rhs)
+                {
+                    X = rhs.X;
+                    Y = rhs.Y;
+                    Width = rhs.Width;
+                    Height = rhs.Height;
+                    return (*this);
+                }
+
+            private:
+                void Init()
+                {
+                    Add(_T("x"), &X);
+                    Add(_T("y"), &Y);
+                    Add(_T("width"), &Width);
+                    Add(_T("height"), &Height);
+                }
+
+            public:
+                Core::JSON::DecUInt32 X;
+                Core::JSON::DecUInt32 Y;
+                Core::JSON::DecUInt32 Width;
+                Core::JSON::DecUInt32 Height;
+            };
+
+            class ChangeData : public Core::JSON::Container {
+            public:
+                ChangeData()
+                    : Core::JSON::Container()
+                {
+                    Init();
+                }
+                ChangeData(const ChangeData& other)
+                    : Core::JSON::Container()
+                    , Client(other.Client)
+                    , Geometry(other.Geometry)
+                    , Opacity(other.Opacity)
+                    , Top(other.Top)
+                    , Below(other.Below)
+                {
+                    Init();
+                }
+                ChangeData& operator=(const ChangeData& rhs)
+                {
+                    Client = rhs.Client;
+                    Geometry = rhs.Geometry;
+                    Opacity = rhs.Opacity;
+                    Top = rhs.Top;
+                    Below = rhs.Below;
+                    return (*this);
+                }
+
+            private:
+                void Init()
+                {
+                    Add(_T("client"), &Client);
+                    Add(_T("geometry"), &Geometry);
+                    Add(_T("opacity"), &Opacity);
+                    Add(_T("top"), &Top);
+                    Add(_T("below"), &Below);
+                }
+
+            public:
+                Core::JSON::String Client;
+                GeometryData Geometry;
+                Core::JSON::DecUInt8 Opacity;
+                Core::JSON::Boolean Top;
+                Core::JSON::String Below;
+            };
+
+        public:
+            TransactionParamsData(const TransactionParamsData&) = delete;
+            TransactionParamsData& operator=(const TransactionParamsData&) = delete;
+
+            TransactionParamsData()
+                : Core::JSON::Container()
+            {
+                Add(_T("changes"), &Changes);
+            }
+
+        public:
+            Core::JSON::ArrayType<ChangeData> Changes;
+        };
+
     public:
         Compositor();
         virtual ~Compositor();
@@ -197,6 +370,7 @@ namespace Plugin {
         Exchange::IComposition::Rectangle Geometry(const string& callsign) const;
         uint32_t ToTop(const string& callsign);
         uint32_t PutBefore(const string& callsignRelativeTo, const string& callsignToReorder);
+        uint32_t Commit(const Transaction& transaction);
 
         Exchange::IComposition::IClient* InterfaceByCallsign(const string& callsign) const;
 
@@ -207,6 +381,7 @@ namespace Plugin {
         uint32_t endpoint_putontop(const JsonData::Compositor::PutontopParamsInfo& params);
         uint32_t endpoint_putbelow(const JsonData::Compositor::PutbelowParamsData& params);
         uint32_t endpoint_kill(const JsonData::Compositor::PutontopParamsInfo& params);
+        uint32_t endpoint_transaction(const TransactionParamsData& params);
         uint32_t get_resolution(Core::JSON::EnumType<JsonData::Compositor::ResolutionType>& response) const;
         uint32_t set_resolution(const Core::JSON::EnumType<JsonData::Compositor::ResolutionType>& param);
         uint32_t get_clients(Core::JSON::ArrayType<Core::JSON::String>& response) const;
@@ -35,6 +35,7 @@ namespace Plugin {
         Register<PutontopParamsInfo,void>(_T("putontop"), &Compositor::endpoint_putontop, this);
         Register<PutbelowParamsData,void>(_T("putbelow"), &Compositor::endpoint_putbelow, this);
         Register<PutontopParamsInfo,void>(_T("kill"), &Compositor::endpoint_kill, this);
+        Register<TransactionParamsData,void>(_T("transaction"), &Compositor::endpoint_transaction, this);
         Property<Core::JSON::EnumType<ResolutionType>>(_T("resolution"), &Compositor::get_resolution, &Compositor::set_resolution, this);
         Property<Core::JSON::ArrayType<Core::JSON::String>>(_T("clients"), &Compositor::get_clients, nullptr, this);
         Property<Core::JSON::ArrayType<Core::JSON::String>>(_T("zorder"), &Compositor::get_zorder, nullptr, this);
@@ -45,6 +46,7 @@ namespace Plugin {
 
     void Compositor::UnregisterAll()
     {
+        Unregister(_T("transaction"));
         Unregister(_T("kill"));
         Unregister(_T("putbelow"));
         Unregister(_T("putontop"));
@@ -93,6 +95,43 @@ namespace Plugin {
         return Kill(client);;
     }
 
+    // Method: transaction - Applies a set of scene changes in one go
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_FIRST_RESOURCE_NOT_FOUND: Client not found, nothing is applied
+    //  - ERROR_SECOND_RESOURCE_NOT_FOUND: Client to put a client below not found, nothing is applied
+    //  - ERROR_BAD_REQUEST: Opacity out of range, nothing is applied
+    //  - Any other error: A client failed a change, what was applied is undone
+    uint32_t Compositor::endpoint_transaction(const TransactionParamsData& params)
+    {
+        Transaction transaction;
+
+        Core::JSON::ArrayType<TransactionParamsData::ChangeData>::ConstIterator index(params.Changes.Elements());
+        while (index.Next() == true) {
+            const TransactionParamsData::ChangeData& change(index.Current());
+            const string& client = change.Client.Value();
+
+            if (change.Geometry.IsSet() == true) {
+                Exchange::IComposition::Rectangle rectangle = Exchange::IComposition::Rectangle();
+                rectangle.x = change.Geometry.X.Value();
+                rectangle.y = change.Geometry.Y.Value();
+                rectangle.width = change.Geometry.Width.Value();
+                rectangle.height = change.Geometry.Height.Value();
+                transaction.Geometry(client, rectangle);
+            }
+            if (change.Opacity.IsSet() == true) {
+                transaction.Opacity(client, change.Opacity.Value());
+            }
+            if (change.Top.Value() == true) {
+                transaction.ToTop(client);
+            } else if (change.Below.IsSet() == true) {
+                transaction.PutBefore(change.Below.Value(), client);
+            }
+        }
+
+        return (Commit(transaction));
+    }
+
     // Property: resolution - Screen resolution
     // Return codes:
     //  - ERROR_NONE: Success
@@ -0,0 +1,263 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Module.h"
+
+#include <interfaces/IComposition.h>
+
+MODULE_NAME_DECLARATION(BUILD_REFERENCE)
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Compositor without a display. The clients are taken from the configuration and only record the
+    // scene they are given. Like a real compositor, changes are folded into the next frame, every frame
+    // reports how many client calls it took up, so the number of compositions per scene update can be
+    // checked without graphics hardware.
+    class CompositorImplementation : public Exchange::IComposition {
+    private:
+        CompositorImplementation(const CompositorImplementation&) = delete;
+        CompositorImplementation& operator=(const CompositorImplementation&) = delete;
+
+        class Config : public Core::JSON::Container {
+        private:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+        public:
+            Config()
+                : Core::JSON::Container()
+                , Clients()
+                , Frame(16)
+            {
+                Add(_T("clients"), &Clients);
+                Add(_T("frame"), &Frame);
+            }
+            ~Config()
+            {
+            }
+
+        public:
+            Core::JSON::ArrayType<Core::JSON::String> Clients;
+            Core::JSON::DecUInt16 Frame;
+        };
+
+        class Client : public Exchange::IComposition::IClient {
+        private:
+            Client() = delete;
+            Client(const Client&) = delete;
+            Client& operator=(const Client&) = delete;
+
+        public:
+            Client(CompositorImplementation& parent, const string& name, const Exchange::IComposition::ScreenResolution resolution)
+                : _parent(parent)
+                , _name(name)
+                , _rectangle({ 0, 0, Exchange::IComposition::WidthFromResolution(resolution), Exchange::IComposition::HeightFromResolution(resolution) })
+                , _opacity(Exchange::IComposition::maxOpacity)
+            {
+            }
+            ~Client() override
+            {
+            }
+
+        public:
+            string Name() const override
+            {
+                return (_name);
+            }
+            void Kill() override
+            {
+                TRACE(Trace::Information, (_T("Kill requested for client %s"), _name.c_str()));
+            }
+            void Opacity(const uint32_t value) override
+            {
+                _opacity = value;
+                _parent.Changed();
+            }
+            uint32_t Geometry(const Exchange::IComposition::Rectangle& rectangle) override
+            {
+                _rectangle = rectangle;
+                _parent.Changed();
+
+                return (Core::ERROR_NONE);
+            }
+            Exchange::IComposition::Rectangle Geometry() const override
+            {
+                return (_rectangle);
+            }
+            // Like the real compositors, a client can only be raised to the top.
+            uint32_t ZOrder(const uint16_t index) override
+            {
+                uint32_t result = Core::ERROR_UNAVAILABLE;
+
+                if (index == 0) {
+                    TRACE(Trace::Information, (_T("Client %s raised to the top"), _name.c_str()));
+                    _parent.Changed();
+                    result = Core::ERROR_NONE;
+                }
+
+                return (result);
+            }
+
+            BEGIN_INTERFACE_MAP(Client)
+                INTERFACE_ENTRY(Exchange::IComposition::IClient)
+            END_INTERFACE_MAP
+
+        private:
+            CompositorImplementation& _parent;
+            const string _name;
+            Exchange::IComposition::Rectangle _rectangle;
+            uint32_t _opacity;
+        };
+
+    public:
+        CompositorImplementation()
+            : _adminLock()
+            , _service(nullptr)
+            , _observers()
+            , _clients()
+            , _resolution(Exchange::IComposition::ScreenResolution_720p)
+            , _frame(16)
+            , _changes(0)
+            , _frames(0)
+            , _job(*this)
+        {
+        }
+        ~CompositorImplementation() override
+        {
+            _job.Revoke();
+
+            for (auto& client : _clients) {
+                client->Release();
+            }
+        }
+
+        BEGIN_INTERFACE_MAP(CompositorImplementation)
+            INTERFACE_ENTRY(Exchange::IComposition)
+        END_INTERFACE_MAP
+
+    public:
+        uint32_t Configure(PluginHost::IShell* service) override
+        {
+            Config config;
+            config.FromString(service->ConfigLine());
+
+            _service = service;
+            _frame = std::max(config.Frame.Value(), static_cast<uint16_t>(1));
+
+            _adminLock.Lock();
+
+            Core::JSON::ArrayType<Core::JSON::String>::ConstIterator index(config.Clients.Elements());
+            while (index.Next() == true) {
+                Exchange::IComposition::IClient* client = Core::Service<Client>::Create<Exchange::IComposition::IClient>(*this, index.Current().Value(), _resolution);
+
+                _clients.push_back(client);
+
+                for (auto& observer : _observers) {
+                    observer->Attached(index.Current().Value(), client);
+                }
+            }
+
+            _adminLock.Unlock();
+
+            PluginHost::ISubSystem* subSystems(_service->SubSystems());
+            ASSERT(subSystems != nullptr);
+            if (subSystems != nullptr) {
+                subSystems->Set(PluginHost::ISubSystem::PLATFORM, nullptr);
+                subSystems->Set(PluginHost::ISubSystem::GRAPHICS, nullptr);
+                subSystems->Release();
+            }
+
+            return (Core::ERROR_NONE);
+        }
+        void Register(Exchange::IComposition::INotification* notification) override
+        {
+            _adminLock.Lock();
+            ASSERT(std::find(_observers.begin(), _observers.end(), notification) == _observers.end());
+            notification->AddRef();
+            _observers.push_back(notification);
+            for (auto& client : _clients) {
+                notification->Attached(client->Name(), client);
+            }
+            _adminLock.Unlock();
+        }
+        void Unregister(Exchange::IComposition::INotification* notification) override
+        {
+            _adminLock.Lock();
+            std::list<Exchange::IComposition::INotification*>::iterator index(std::find(_observers.begin(), _observers.end(), notification));
+            ASSERT(index != _observers.end());
+            if (index != _observers.end()) {
+                _observers.erase(index);
+                notification->Release();
+            }
+            _adminLock.Unlock();
+        }
+        void Resolution(const Exchange::IComposition::ScreenResolution format) override
+        {
+            _resolution = format;
+        }
+        Exchange::IComposition::ScreenResolution Resolution() const override
+        {
+            return (_resolution);
+        }
+
+    private:
+        friend Core::ThreadPool::JobType<CompositorImplementation&>;
+
+        // The first change after a frame starts the next one, the ones that follow within the frame
+        // time are part of it.
+        void Changed()
+        {
+            _adminLock.Lock();
+
+            if (_changes++ == 0) {
+                _job.Schedule(Core::Time::Now().Add(_frame));
+            }
+
+            _adminLock.Unlock();
+        }
+        void Dispatch()
+        {
+            _adminLock.Lock();
+
+            const uint32_t changes = _changes;
+            _changes = 0;
+            _frames++;
+
+            _adminLock.Unlock();
+
+            TRACE(Trace::Information, (_T("Composed frame %d out of %d client changes"), _frames, changes));
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        PluginHost::IShell* _service;
+        std::list<Exchange::IComposition::INotification*> _observers;
+        std::list<Exchange::IComposition::IClient*> _clients;
+        Exchange::IComposition::ScreenResolution _resolution;
+        uint16_t _frame;
+        uint32_t _changes;
+        uint32_t _frames;
+        Core::WorkerPool::JobType<CompositorImplementation&> _job;
+    };
+
+    SERVICE_REGISTRATION(CompositorImplementation, 1, 0);
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,323 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+// Blasts M-SEARCH datagrams at a running DIAL server, the way a room full of phones looking for a
+// screen does. Every round all clients send their search at once and the benchmark waits for the
+// replies, so the server sees a burst of requesters to answer in one go. Clients sit on their own
+// loopback address, 127.0.0.<10 + n>, as the server throttles repeated searches per host; a round
+// interval shorter than the "throttle" window of the server shows up as lost replies. Searches for
+// other services can be mixed in, those must be dropped by the server without a reply.
+
+namespace {
+
+    static const char SearchTarget[] = "urn:dial-multiscreen-org:service:dial:1";
+
+    struct Options {
+        Options()
+            : Address("127.0.0.1")
+            , Port(1900)
+            , Clients(16)
+            , Rounds(100)
+            , Interval(0)
+            , Noise(0)
+            , Timeout(200)
+        {
+        }
+
+        std::string Address;
+        uint16_t Port;
+        uint32_t Clients;
+        uint32_t Rounds;
+        uint32_t Interval;
+        uint32_t Noise;
+        uint32_t Timeout;
+    };
+
+    struct Client {
+        int Descriptor;
+        uint64_t Sent;
+        bool Answered;
+    };
+
+    struct Result {
+        Result()
+            : Sent(0)
+            , Received(0)
+            , Invalid(0)
+            , Late(0)
+            , Latencies()
+        {
+        }
+
+        uint32_t Sent;
+        uint32_t Received;
+        uint32_t Invalid;
+        uint32_t Late;
+        std::vector<uint32_t> Latencies;
+    };
+
+    uint64_t Now()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000));
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-address") == 0)) {
+                options.Address = argv[++index];
+            } else if ((value == true) && (strcmp(argv[index], "-port") == 0)) {
+                options.Port = static_cast<uint16_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-clients") == 0)) {
+                options.Clients = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-rounds") == 0)) {
+                options.Rounds = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-interval") == 0)) {
+                options.Interval = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-noise") == 0)) {
+                options.Noise = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-timeout") == 0)) {
+                options.Timeout = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Clients == 0) || (options.Clients > 240) || (options.Rounds == 0));
+    }
+
+    void ShowHelp()
+    {
+        printf("DIALServerBenchmark [options]\n"
+               "\t-address <ip>             Address the DIAL server listens on, the multicast group works too [127.0.0.1]\n"
+               "\t-port <port>              SSDP port of the DIAL server [1900]\n"
+               "\t-clients <count>          Clients searching at the same time, at most 240 [16]\n"
+               "\t-rounds <count>           Searches per client [100]\n"
+               "\t-interval <ms>            Time between the start of two rounds [0]\n"
+               "\t-noise <count>            Searches for other services per round, from the first client [0]\n"
+               "\t-timeout <ms>             Time to wait for the replies of a round [200]\n");
+    }
+
+    std::string Search(const char target[], const Options& options)
+    {
+        char buffer[256];
+
+        snprintf(buffer, sizeof(buffer),
+            "M-SEARCH * HTTP/1.1\r\n"
+            "HOST: %s:%u\r\n"
+            "MAN: \"ssdp:discover\"\r\n"
+            "MX: 1\r\n"
+            "ST: %s\r\n"
+            "\r\n",
+            options.Address.c_str(), options.Port, target);
+
+        return (std::string(buffer));
+    }
+
+    // A reply is valid when it is a 200 OK for the DIAL search target that tells where to go.
+    bool IsValid(const char reply[], const size_t length)
+    {
+        const std::string text(reply, length);
+
+        return ((text.compare(0, 15, "HTTP/1.1 200 OK") == 0) && (text.find(SearchTarget) != std::string::npos) && (text.find("LOCATION:") != std::string::npos));
+    }
+
+    int Open(const uint32_t index, const bool loopback)
+    {
+        int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+        if (fd != -1) {
+            struct sockaddr_in local;
+            memset(&local, 0, sizeof(local));
+            local.sin_family = AF_INET;
+            local.sin_port = 0;
+            local.sin_addr.s_addr = (loopback == true ? htonl(INADDR_LOOPBACK + 10 + index) : htonl(INADDR_ANY));
+
+            if (::bind(fd, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) != 0) {
+                fprintf(stderr, "Could not bind client %u: %s\n", index, strerror(errno));
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        return (fd);
+    }
+
+    // Collects the replies of one round, until every client has its answer or the round times out.
+    void Collect(const int epoll, std::vector<Client>& clients, const Options& options, Result& result)
+    {
+        const uint64_t deadline = Now() + (static_cast<uint64_t>(options.Timeout) * 1000);
+        uint32_t pending = static_cast<uint32_t>(clients.size());
+        struct epoll_event events[64];
+        char reply[2048];
+        uint64_t now;
+
+        while ((pending > 0) && ((now = Now()) < deadline)) {
+            const int count = epoll_wait(epoll, events, 64, static_cast<int>(((deadline - now) + 999) / 1000));
+
+            for (int index = 0; index < count; index++) {
+                Client& client(clients[events[index].data.u32]);
+                ssize_t length;
+
+                while ((length = ::recv(client.Descriptor, reply, sizeof(reply), 0)) > 0) {
+                    const uint64_t arrived = Now();
+
+                    if (IsValid(reply, static_cast<size_t>(length)) == false) {
+                        result.Invalid++;
+                    } else if (client.Answered == true) {
+                        // A second answer to a single search, or one that came in after its round.
+                        result.Late++;
+                    } else {
+                        client.Answered = true;
+                        result.Latencies.push_back(static_cast<uint32_t>(arrived - client.Sent));
+                        result.Received++;
+                        pending--;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    struct sockaddr_in server;
+    memset(&server, 0, sizeof(server));
+    server.sin_family = AF_INET;
+    server.sin_port = htons(options.Port);
+
+    if (inet_pton(AF_INET, options.Address.c_str(), &server.sin_addr) != 1) {
+        fprintf(stderr, "Invalid server address [%s]\n", options.Address.c_str());
+        return (1);
+    }
+
+    const bool loopback = ((ntohl(server.sin_addr.s_addr) >> 24) == 127);
+    const std::string search(Search(SearchTarget, options));
+    const std::string noise(Search("urn:schemas-upnp-org:device:MediaRenderer:1", options));
+
+    int epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    std::vector<Client> clients;
+    int exitCode = 1;
+
+    for (uint32_t index = 0; (index < options.Clients) && (epoll != -1); index++) {
+        Client client;
+        client.Descriptor = Open(index, loopback);
+        client.Sent = 0;
+        client.Answered = false;
+
+        if (client.Descriptor == -1) {
+            break;
+        }
+
+        struct epoll_event watch;
+        memset(&watch, 0, sizeof(watch));
+        watch.events = EPOLLIN;
+        watch.data.u32 = index;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, client.Descriptor, &watch);
+
+        clients.push_back(client);
+    }
+
+    if (clients.size() == options.Clients) {
+        Result result;
+        result.Latencies.reserve(options.Clients * options.Rounds);
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t round = 0; round < options.Rounds; round++) {
+            const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+            for (uint32_t index = 0; index < options.Noise; index++) {
+                ::sendto(clients[0].Descriptor, noise.c_str(), noise.length(), 0, reinterpret_cast<struct sockaddr*>(&server), sizeof(server));
+            }
+
+            for (Client& client : clients) {
+                client.Answered = false;
+                client.Sent = Now();
+
+                if (::sendto(client.Descriptor, search.c_str(), search.length(), 0, reinterpret_cast<struct sockaddr*>(&server), sizeof(server)) == static_cast<ssize_t>(search.length())) {
+                    result.Sent++;
+                }
+            }
+
+            Collect(epoll, clients, options, result);
+
+            if (options.Interval != 0) {
+                std::this_thread::sleep_until(begin + std::chrono::milliseconds(options.Interval));
+            }
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        printf("clients,rounds,noise,sent,received,lost,late,invalid,replies_per_s,min_us,p50_us,p99_us,max_us\n");
+
+        std::vector<uint32_t>& latencies(result.Latencies);
+        std::sort(latencies.begin(), latencies.end());
+
+        if (latencies.empty() == true) {
+            latencies.push_back(0);
+        }
+
+        printf("%u,%u,%u,%u,%u,%u,%u,%u,%.0f,%u,%u,%u,%u\n",
+            options.Clients, options.Rounds, options.Noise, result.Sent, result.Received, result.Sent - result.Received, result.Late, result.Invalid,
+            (seconds > 0 ? result.Received / seconds : 0),
+            latencies.front(), latencies[latencies.size() / 2], latencies[(latencies.size() * 99) / 100], latencies.back());
+
+        exitCode = ((result.Received == result.Sent) && (result.Invalid == 0) ? 0 : 2);
+    }
+
+    for (Client& client : clients) {
+        ::close(client.Descriptor);
+    }
+
+    if (epoll != -1) {
+        ::close(epoll);
+    }
+
+    return (exitCode);
+}
@@ -56,21 +56,14 @@ namespace Plugin {
         WebFlow& operator=(const WebFlow& a_RHS) = delete;
 
     public:
-        WebFlow(const Core::ProxyType<Web::Request>& request, const Core::NodeId& nodeId)
+        WebFlow(const uint8_t* dataFrame, const uint16_t length, const Core::NodeId& nodeId)
         {
-            if (request.IsValid() == true) {
-                string text;
-                request->ToString(text);
-                _text = Core::ToString(string("\n[" + nodeId.HostAddress() + ']' + text + '\n'));
-            }
+            string text(reinterpret_cast<const char*>(dataFrame), length);
+            _text = Core::ToString(string("\n[" + nodeId.HostAddress() + ']' + text + '\n'));
         }
-        WebFlow(const Core::ProxyType<Web::Response>& response, const Core::NodeId& nodeId)
+        WebFlow(const string& text, const Core::NodeId& nodeId)
         {
-            if (response.IsValid() == true) {
-                string text;
-                response->ToString(text);
-                _text = Core::ToString(string("\n[" + nodeId.HostAddress() + ']' + text + '\n'));
-            }
+            _text = Core::ToString(string("\n[" + nodeId.HostAddress() + ']' + text + '\n'));
         }
         ~WebFlow()
         {
@@ -90,42 +83,34 @@ namespace Plugin {
         std::string _text;
     };
 
-    uint16_t DIALServer::WebTransform::Transform(Web::Request::Deserializer& deserializer, uint8_t* dataFrame, const uint16_t maxSendSize)
+    static inline const uint8_t* SkipLine(const uint8_t* index, const uint8_t* end)
     {
-        uint16_t index = 0;
-        const uint8_t* checker = dataFrame;
-
-        // This is a UDP service, so a message should be complete. If the first keyword is not a keyword we
-        // expect, ignore the full message, it is not a DIAL server package and does not require any further
-        // processing.
-        // First skip the white sace, if applicable...
-        while (isspace(*checker)) {
-            checker++;
-        }
-
-        // Now see if the first keyword is "M-SEARCH"
-        while ((index < _keywordLength) && (toupper(*checker) == Web::Request::MSEARCH[index])) {
-            checker++;
+        while ((index < end) && (*index != '\n')) {
             index++;
         }
+        return (index < end ? index + 1 : end);
+    }
 
-        // Now we need to find the keyword "M-SEARCH" see if we have it..
-        if (index == _keywordLength) {
-            deserializer.Flush();
-            index = deserializer.Deserialize(dataFrame, maxSendSize);
-        } else {
-            index = maxSendSize;
+    static inline bool StartsWith(const uint8_t* index, const uint8_t* end, const TCHAR keyword[], const uint16_t length)
+    {
+        uint16_t loop = 0;
+
+        while ((loop < length) && ((index + loop) < end) && (toupper(index[loop]) == toupper(keyword[loop]))) {
+            loop++;
         }
 
-        return (index);
+        return (loop == length);
     }
 
-    DIALServer::DIALServerImpl::DIALServerImpl(const string& MACAddress, const string& baseURL, const string& appPath)
-        : BaseClass(5, false, Core::NodeId(DialServerInterface.AnyInterface(), DialServerInterface.PortNumber()), DialServerInterface.AnyInterface(), 1024, 1024)
+    DIALServer::DIALServerImpl::DIALServerImpl(const string& MACAddress, const string& baseURL, const string& appPath, const uint16_t throttle)
+        : Core::SocketDatagram(false, Core::NodeId(DialServerInterface.AnyInterface(), DialServerInterface.PortNumber()), DialServerInterface.AnyInterface(), 1024, 1024)
         , _response(Core::ProxyType<Web::Response>::Create())
+        , _rendered()
         , _destinations()
+        , _requesters()
         , _baseURL(baseURL)
         , _appPath(appPath)
+        , _throttle(static_cast<uint64_t>(throttle) * Core::Time::TicksPerMillisecond)
     {
         _response->ErrorCode = Web::STATUS_OK;
         _response->Message = _T("OK");
@@ -140,67 +125,201 @@ namespace Plugin {
         // _response->WakeUp = _T("MAC=") + MACAddress + _T(";Timeout=10");
         _response->Mode(Web::MARSHAL_UPPERCASE);
 
-        if (Link().Open(1000) != Core::ERROR_NONE) {
+        Render();
+
+        if (SocketDatagram::Open(1000) != Core::ERROR_NONE) {
             ASSERT(false && "Seems we can not open the DIAL discovery port");
         }
 
-        Link().Join(DialServerInterface);
+        SocketDatagram::Join(DialServerInterface);
     }
 
     /* virtual */ DIALServer::DIALServerImpl::~DIALServerImpl()
     {
-        Link().Leave(DialServerInterface);
-        Link().Close(Core::infinite);
+        SocketDatagram::Leave(DialServerInterface);
+        SocketDatagram::Close(Core::infinite);
     }
 
-    // Notification of a Partial Request received, time to attach a body..
-    /* virtual */ void DIALServer::DIALServerImpl::LinkBody(Core::ProxyType<Web::Request>& element)
+    bool DIALServer::DIALServerImpl::IsSearchRequest(const uint8_t* dataFrame, const uint16_t length) const
     {
-        // upnp requests are empty so no body needed...
+        static const uint16_t keywordLength = static_cast<uint16_t>(_tcslen(Web::Request::MSEARCH));
+        static const TCHAR searchTarget[] = _T("ST:");
+
+        const uint8_t* index = dataFrame;
+        const uint8_t* const end = dataFrame + length;
+        bool result = false;
+
+        // This is a UDP service, so a message should be complete. If the first keyword is not a keyword we
+        // expect, ignore the full message, it is not a DIAL server package and does not require any further
+        // processing. First skip the white space, if applicable...
+        while ((index < end) && (isspace(*index))) {
+            index++;
+        }
+
+        if (StartsWith(index, end, Web::Request::MSEARCH, keywordLength) == true) {
+            // Now walk the header lines, we are only interested in the search target.
+            index = SkipLine(index, end);
+
+            while ((index < end) && (result == false) && (*index != '\r') && (*index != '\n')) {
+                if (StartsWith(index, end, searchTarget, sizeof(searchTarget) - 1) == true) {
+                    index += (sizeof(searchTarget) - 1);
+
+                    while ((index < end) && ((*index == ' ') || (*index == '\t'))) {
+                        index++;
+                    }
+
+                    const uint8_t* value = index;
+
+                    while ((index < end) && (*index != '\r') && (*index != '\n')) {
+                        index++;
+                    }
+                    while ((index > value) && ((index[-1] == ' ') || (index[-1] == '\t'))) {
+                        index--;
+                    }
+
+                    result = ((static_cast<uint32_t>(index - value) == _SearchTarget.length()) && (_SearchTarget.compare(0, _SearchTarget.length(), reinterpret_cast<const char*>(value), index - value) == 0));
+                    break;
+                }
+                index = SkipLine(index, end);
+            }
+        }
+
+        return (result);
     }
-    // Notification of a Partial Request received, time to attach a body..
-    // upnp requests are empty so no body needed...
-    /* virtual */ void DIALServer::DIALServerImpl::Received(Core::ProxyType<Web::Request>& request)
+
+    bool DIALServer::DIALServerImpl::IsThrottled(const Core::NodeId& source)
     {
-        Core::NodeId sourceNode(Link().ReceivedNode());
-        TRACE(WebFlow, (request, sourceNode));
+        bool result = false;
+
+        if (_throttle != 0) {
+            const uint64_t now = Core::Time::Now().Ticks();
+            const string key(source.HostAddress());
+
+            if (_requesters.size() >= MaxTrackedSources) {
+                // Forget about the requesters that are outside the window, they are allowed again anyway.
+                std::unordered_map<string, uint64_t>::iterator index(_requesters.begin());
+                while (index != _requesters.end()) {
+                    if ((index->second + _throttle) <= now) {
+                        index = _requesters.erase(index);
+                    } else {
+                        index++;
+                    }
+                }
+            }
 
-        if ((request->Verb == Web::Request::HTTP_MSEARCH) && (request->ST.IsSet() == true)) {
-            if (request->ST.Value() == _SearchTarget) {
+            std::unordered_map<string, uint64_t>::iterator index(_requesters.find(key));
 
-                TRACE(Protocol, (&(*request)));
-                _destinations.push_back(sourceNode);
-                // remember the NodeId where this comes from.
-                if (_destinations.size() == 1) {
+            if (index == _requesters.end()) {
+                if (_requesters.size() < MaxTrackedSources) {
+                    _requesters.emplace(key, now);
+                }
+            } else if ((index->second + _throttle) > now) {
+                result = true;
+            } else {
+                index->second = now;
+            }
+        }
+
+        return (result);
+    }
+
+    void DIALServer::DIALServerImpl::Render()
+    {
+        _response->Location = _baseURL + '/' + _appPath + '/' + _DefaultAppInfoDevice;
+        _response->ToString(_rendered);
+    }
+
+    uint16_t DIALServer::DIALServerImpl::SendBatch()
+    {
+        uint16_t sent = 0;
 
-                    Link().RemoteNode(_destinations.front());
+#ifdef __LINUX__
+        struct mmsghdr messages[MaxBatchSize];
+        struct iovec vector;
+        uint8_t count = 0;
 
-                    _response->Location = URL() + '/' + _DefaultAppInfoDevice;
+        vector.iov_base = const_cast<char*>(_rendered.c_str());
+        vector.iov_len = _rendered.length();
 
-                    Submit(_response);
+        std::list<Core::NodeId>::const_iterator index(_destinations.begin());
+
+        while ((index != _destinations.end()) && (count < MaxBatchSize)) {
+            ::memset(&(messages[count]), 0, sizeof(struct mmsghdr));
+            messages[count].msg_hdr.msg_name = const_cast<struct sockaddr*>(static_cast<const struct sockaddr*>(*index));
+            messages[count].msg_hdr.msg_namelen = index->Size();
+            messages[count].msg_hdr.msg_iov = &vector;
+            messages[count].msg_hdr.msg_iovlen = 1;
+            count++;
+            index++;
+        }
+
+        int result = ::sendmmsg(static_cast<int>(SocketDatagram::Descriptor()), messages, count, MSG_DONTWAIT);
+
+        if (result > 0) {
+            sent = static_cast<uint16_t>(result);
+
+            for (uint16_t loop = 0; loop < sent; loop++) {
+                TRACE(WebFlow, (_rendered, _destinations.front()));
+                _destinations.pop_front();
+            }
+        }
+#endif
+
+        return (sent);
+    }
+
+    /* virtual */ uint16_t DIALServer::DIALServerImpl::ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+    {
+        if (IsSearchRequest(dataFrame, receivedSize) == true) {
+
+            Core::NodeId sourceNode(SocketDatagram::ReceivedNode());
+
+            TRACE(WebFlow, (dataFrame, receivedSize, sourceNode));
+
+            _lock.Lock();
+
+            if (IsThrottled(sourceNode) == false) {
+                // remember the NodeId where this comes from.
+                _destinations.push_back(sourceNode);
+
+                if (_destinations.size() == 1) {
+                    SocketDatagram::Trigger();
                 }
             }
+
+            _lock.Unlock();
         }
+
+        return (receivedSize);
     }
 
-    // Notification of a Response send.
-    /* virtual */ void DIALServer::DIALServerImpl::Send(const Core::ProxyType<Web::Response>& response)
+    /* virtual */ uint16_t DIALServer::DIALServerImpl::SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
     {
-        TRACE(WebFlow, (response, _destinations.front()));
+        uint16_t result = 0;
+
+        _lock.Lock();
+
+        // If multiple requesters are waiting, hand them all in one go to the kernel.
+        if (_destinations.size() > 1) {
+            SendBatch();
+        }
 
-        TRACE(Protocol, (&(*response)));
+        if (_destinations.empty() == false) {
+            ASSERT(_rendered.length() <= maxSendSize);
 
-        // Drop the current destination.
-        _destinations.pop_front();
+            SocketDatagram::RemoteNode(_destinations.front());
 
-        if (_destinations.size() > 0) {
-            _response->Location = URL() + '/' + _DefaultAppInfoDevice;
+            TRACE(WebFlow, (_rendered, _destinations.front()));
 
-            // Move on to notifying the next one.
-            Link().RemoteNode(_destinations.front());
+            result = static_cast<uint16_t>(std::min(_rendered.length(), static_cast<size_t>(maxSendSize)));
+            ::memcpy(dataFrame, _rendered.c_str(), result);
 
-            Submit(response);
+            _destinations.pop_front();
         }
+
+        _lock.Unlock();
+
+        return (result);
     }
 
     // Notification of a channel state change..
@@ -296,7 +415,7 @@ namespace Plugin {
 
             // TODO: THis used to be the MAC, but I think  it is just a unique number, otherwise, we need the MAC
             //       that goes with the selectedNode !!!!
-            _dialServiceImpl = new DIALServerImpl(deviceId, service->Accessor(), _DefaultAppInfoPath);
+            _dialServiceImpl = new DIALServerImpl(deviceId, service->Accessor(), _DefaultAppInfoPath, _config.Throttle.Value());
 
             ASSERT(_dialServiceImpl != nullptr);
 
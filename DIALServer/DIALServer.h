@@ -95,6 +95,7 @@ namespace Plugin {
                 , Interface()
                 , WebServer()
                 , SwitchBoard()
+                , Throttle(1000)
             {
                 Add(_T("interface"), &Interface);
                 Add(_T("name"), &Name);
@@ -108,6 +109,7 @@ namespace Plugin {
                 Add(_T("upc"), &UPC);
                 Add(_T("webserver"), &WebServer);
                 Add(_T("switchboard"), &SwitchBoard);
+                Add(_T("throttle"), &Throttle);
                 Add(_T("apps"), &Apps);
             }
             ~Config()
@@ -127,6 +129,7 @@ namespace Plugin {
             Core::JSON::String Interface;
             Core::JSON::String WebServer;
             Core::JSON::String SwitchBoard;
+            Core::JSON::DecUInt16 Throttle;
             Core::JSON::ArrayType<App> Apps;
         };
 
@@ -558,50 +561,26 @@ namespace Plugin {
         private:
             std::string _text;
         };
-        class WebTransform {
-        private:
-            WebTransform(const WebTransform&);
-            WebTransform& operator=(const WebTransform&);
-
-        public:
-            inline WebTransform()
-                : _keywordLength(static_cast<uint8_t>(_tcslen(Web::Request::MSEARCH)))
-            {
-            }
-            inline ~WebTransform()
-            {
-            }
-
-            // Methods to extract and insert data into the socket buffers
-            uint16_t Transform(Web::Request::Deserializer& deserializer, uint8_t* dataFrame, const uint16_t maxSendSize);
-
-        private:
-            uint8_t _keywordLength;
-        };
-        class DIALServerImpl : public Web::WebLinkType<Core::SocketDatagram, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>, WebTransform> {
+        class DIALServerImpl : public Core::SocketDatagram {
         private:
             static const Core::NodeId DialServerInterface;
-            typedef Web::WebLinkType<Core::SocketDatagram, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>, WebTransform> BaseClass;
+            static constexpr uint8_t MaxBatchSize = 16;
+            static constexpr uint8_t MaxTrackedSources = 64;
 
             DIALServerImpl(const DIALServerImpl&) = delete;
             DIALServerImpl& operator=(const DIALServerImpl&) = delete;
 
         public:
-            DIALServerImpl(const string& MACAddress, const string& baseURL, const string& appPath);
-            virtual ~DIALServerImpl();
+            DIALServerImpl(const string& MACAddress, const string& baseURL, const string& appPath, const uint16_t throttle);
+            ~DIALServerImpl() override;
 
         public:
-            // Notification of a Partial Request received, time to attach a body..
-            virtual void LinkBody(Core::ProxyType<Web::Request>& element);
-
-            // Notification of a Request received.
-            virtual void Received(Core::ProxyType<Web::Request>& text);
-
-            // Notification of a Response send.
-            virtual void Send(const Core::ProxyType<Web::Response>& text);
+            // Methods to extract and insert data into the socket buffers
+            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override;
+            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override;
 
             // Notification of a channel state change..
-            virtual void StateChange();
+            void StateChange() override;
 
             inline string URL() const
             {
@@ -625,16 +604,32 @@ namespace Plugin {
 
                 _baseURL = hostName;
 
+                // The location is the only variable part of the answer, so this is
+                // the moment to (re)render it, not when somebody is searching for us.
+                Render();
+
                 _lock.Unlock();
             }
 
+        private:
+            // Cheap check on the raw datagram, it should be an M-SEARCH for our search target,
+            // everything else on the SSDP multicast group is none of our business.
+            bool IsSearchRequest(const uint8_t* dataFrame, const uint16_t length) const;
+            bool IsThrottled(const Core::NodeId& source);
+            void Render();
+            uint16_t SendBatch();
+
         private:
             mutable Core::CriticalSection _lock;
-            // This should be the "Response" as depicted by the parent/DIALserver.
+            // This is the "Response" as depicted by the parent/DIALserver.
             Core::ProxyType<Web::Response> _response;
+            // The response serialized once, every requester gets exactly the same bytes.
+            string _rendered;
             std::list<Core::NodeId> _destinations;
+            std::unordered_map<string, uint64_t> _requesters;
             string _baseURL;
             const string _appPath;
+            const uint64_t _throttle;
         };
         class AppInformation {
         private:
@@ -26,6 +26,7 @@ namespace Plugin {
 
     static Core::ProxyPoolType<Web::Response> responseFactory(4);
     static Core::ProxyPoolType<Web::JSONBodyType<DeviceInfo::Data>> jsonResponseFactory(4);
+    static Core::ProxyPoolType<Web::TextBody> textResponseFactory(4);
 
     /* virtual */ const string DeviceInfo::Initialize(PluginHost::IShell* service)
     {
@@ -43,6 +44,16 @@ namespace Plugin {
 
         ASSERT(_subSystem != nullptr);
 
+        // The sampler only runs, and needs to be stopped, if it could be started.
+        if ((_subSystem != nullptr) && (config.SampleRate.Value() != 0)) {
+            _sampleRate = config.SampleRate.Value();
+
+            // Addresses are only collected again when the kernel reports a change.
+            _adapters.Open();
+            Sample(true, true);
+            _job.Schedule(Core::Time::Now().Add(_sampleRate));
+        }
+
         // On success return empty, to indicate there is no error text.
 
         return (_subSystem != nullptr) ? EMPTY_STRING : _T("Could not retrieve System Information.");
@@ -52,6 +63,17 @@ namespace Plugin {
     {
         ASSERT(_service == service);
 
+        if (_sampleRate != 0) {
+            _adapters.Close();
+            _job.Revoke();
+
+            _adminLock.Lock();
+            _snapshot.reset();
+            _adminLock.Unlock();
+
+            _sampleRate = 0;
+        }
+
         if (_subSystem != nullptr) {
             _subSystem->Release();
             _subSystem = nullptr;
@@ -83,28 +105,49 @@ namespace Plugin {
         // <GET> - currently, only the GET command is supported, returning system info
         if (request.Verb == Web::Request::HTTP_GET) {
 
-            Core::ProxyType<Web::JSONBodyType<Data>> response(jsonResponseFactory.Element());
-
+            std::shared_ptr<const Snapshot> snapshot(Current());
             Core::TextSegmentIterator index(Core::TextFragment(request.Path, _skipURL, static_cast<uint32_t>(request.Path.length()) - _skipURL), false, '/');
 
             // Always skip the first one, it is an empty part because we start with a '/' if there are more parameters.
             index.Next();
 
-            if (index.Next() == false) {
-                AddressInfo(response->Addresses);
-                SysInfo(response->SystemInfo);
-                SocketPortInfo(response->Sockets);
-            } else if (index.Current() == "Adresses") {
-                AddressInfo(response->Addresses);
-            } else if (index.Current() == "System") {
-                SysInfo(response->SystemInfo);
-            } else if (index.Current() == "Sockets") {
-                SocketPortInfo(response->Sockets);
+            if (snapshot != nullptr) {
+                // Served as serialized for this snapshot.
+                Core::ProxyType<Web::TextBody> response(textResponseFactory.Element());
+
+                if (index.Next() == false) {
+                    (*response) = Body(*snapshot, Snapshot::ALL);
+                } else if (index.Current() == "Adresses") {
+                    (*response) = Body(*snapshot, Snapshot::ADDRESSES);
+                } else if (index.Current() == "System") {
+                    (*response) = Body(*snapshot, Snapshot::SYSTEM);
+                } else if (index.Current() == "Sockets") {
+                    (*response) = Body(*snapshot, Snapshot::SOCKETS);
+                } else {
+                    (*response) = Body(*snapshot, Snapshot::NONE);
+                }
+
+                result->Body<Web::TextBody>(response);
+            } else {
+                Core::ProxyType<Web::JSONBodyType<Data>> response(jsonResponseFactory.Element());
+
+                if (index.Next() == false) {
+                    AddressInfo(response->Addresses);
+                    SysInfo(response->SystemInfo);
+                    SocketPortInfo(response->Sockets);
+                } else if (index.Current() == "Adresses") {
+                    AddressInfo(response->Addresses);
+                } else if (index.Current() == "System") {
+                    SysInfo(response->SystemInfo);
+                } else if (index.Current() == "Sockets") {
+                    SocketPortInfo(response->Sockets);
+                }
+
+                result->Body(Core::proxy_cast<Web::IBody>(response));
             }
             // TODO RB: I guess we should do something here to return other info (e.g. time) as well.
 
             result->ContentType = Web::MIMETypes::MIME_JSON;
-            result->Body(Core::proxy_cast<Web::IBody>(response));
         } else {
             result->ErrorCode = Web::STATUS_BAD_REQUEST;
             result->Message = _T("Unsupported request for the [DeviceInfo] service.");
@@ -113,47 +156,203 @@ namespace Plugin {
         return result;
     }
 
-    void DeviceInfo::SysInfo(JsonData::DeviceInfo::SysteminfoData& systemInfo) const
+    void DeviceInfo::Dispatch()
+    {
+        Sample(true, false);
+
+        _job.Schedule(Core::Time::Now().Add(_sampleRate));
+    }
+
+    // Publishes a new snapshot, the parts not sampled are taken over from the current one.
+    void DeviceInfo::Sample(const bool system, const bool addresses)
+    {
+        _sampleLock.Lock();
+
+        std::shared_ptr<const Snapshot> current(Current());
+        std::shared_ptr<Snapshot> snapshot(new Snapshot());
+
+        if ((system == true) || (current == nullptr)) {
+            Collect(*snapshot);
+        } else {
+            snapshot->Time = current->Time;
+            snapshot->Uptime = current->Uptime;
+            snapshot->FreeRam = current->FreeRam;
+            snapshot->TotalRam = current->TotalRam;
+            snapshot->HostName = current->HostName;
+            snapshot->CpuLoad = current->CpuLoad;
+            snapshot->Runs = current->Runs;
+        }
+
+        if ((addresses == true) || (current == nullptr)) {
+            Collect(snapshot->Addresses);
+        } else {
+            snapshot->Addresses = current->Addresses;
+        }
+
+        snapshot->Version = (current != nullptr ? current->Version + 1 : 1);
+
+        if (current != nullptr) {
+            // Whatever did not change keeps the text it was already serialized to, if any.
+            const bool sockets = (snapshot->Runs == current->Runs);
+
+            current->Lock.Lock();
+            snapshot->Bodies[Snapshot::NONE] = current->Bodies[Snapshot::NONE];
+            if (addresses == false) {
+                snapshot->Bodies[Snapshot::ADDRESSES] = current->Bodies[Snapshot::ADDRESSES];
+            }
+            if (system == false) {
+                snapshot->Bodies[Snapshot::SYSTEM] = current->Bodies[Snapshot::SYSTEM];
+            }
+            if (sockets == true) {
+                snapshot->Bodies[Snapshot::SOCKETS] = current->Bodies[Snapshot::SOCKETS];
+            }
+            if ((addresses == false) && (system == false) && (sockets == true)) {
+                snapshot->Bodies[Snapshot::ALL] = current->Bodies[Snapshot::ALL];
+            }
+            current->Lock.Unlock();
+        }
+
+        _adminLock.Lock();
+        _snapshot = snapshot;
+        _adminLock.Unlock();
+
+        _sampleLock.Unlock();
+    }
+
+    string DeviceInfo::Body(const Snapshot& snapshot, const Snapshot::body part) const
+    {
+        snapshot.Lock.Lock();
+
+        string& body(snapshot.Bodies[part]);
+
+        if (body.empty() == true) {
+            Data data;
+
+            if ((part == Snapshot::ALL) || (part == Snapshot::ADDRESSES)) {
+                AddressInfo(snapshot, data.Addresses);
+            }
+            if ((part == Snapshot::ALL) || (part == Snapshot::SYSTEM)) {
+                SysInfo(snapshot, data.SystemInfo);
+            }
+            if ((part == Snapshot::ALL) || (part == Snapshot::SOCKETS)) {
+                SocketPortInfo(snapshot, data.Sockets);
+            }
+
+            data.ToString(body);
+        }
+
+        string result(body);
+
+        snapshot.Lock.Unlock();
+
+        return (result);
+    }
+
+    void DeviceInfo::Collect(Snapshot& snapshot) const
     {
         Core::SystemInfo& singleton(Core::SystemInfo::Instance());
 
-        systemInfo.Time = Core::Time::Now().ToRFC1123(true);
-        systemInfo.Version = _service->Version() + _T("#") + _subSystem->BuildTreeHash();
-        systemInfo.Uptime = singleton.GetUpTime();
-        systemInfo.Freeram = singleton.GetFreeRam();
-        systemInfo.Totalram = singleton.GetTotalRam();
-        systemInfo.Devicename = singleton.GetHostName();
-        systemInfo.Cpuload = Core::NumberType<uint32_t>(static_cast<uint32_t>(singleton.GetCpuLoad())).Text();
-        systemInfo.Serialnumber = _systemId;
+        snapshot.Time = Core::Time::Now().ToRFC1123(true);
+        snapshot.Uptime = singleton.GetUpTime();
+        snapshot.FreeRam = singleton.GetFreeRam();
+        snapshot.TotalRam = singleton.GetTotalRam();
+        snapshot.HostName = singleton.GetHostName();
+        snapshot.CpuLoad = static_cast<uint32_t>(singleton.GetCpuLoad());
+        snapshot.Runs = Core::ResourceMonitor::Instance().Runs();
     }
 
-    void DeviceInfo::AddressInfo(Core::JSON::ArrayType<JsonData::DeviceInfo::AddressesData>& addressInfo) const
+    /* static */ void DeviceInfo::Collect(std::list<Snapshot::Address>& addresses)
     {
         // Get the point of entry on WPEFramework..
         Core::AdapterIterator interfaces;
 
         while (interfaces.Next() == true) {
 
-            JsonData::DeviceInfo::AddressesData newElement;
-            newElement.Name = interfaces.Name();
-            newElement.Mac = interfaces.MACAddress(':');
-            JsonData::DeviceInfo::AddressesData& element(addressInfo.Add(newElement));
+            addresses.emplace_back();
+            Snapshot::Address& element(addresses.back());
+            element.Name = interfaces.Name();
+            element.MAC = interfaces.MACAddress(':');
 
             // get an interface with a public IP address, then we will have a proper MAC address..
             Core::IPV4AddressIterator selectedNode(interfaces.Index());
 
             while (selectedNode.Next() == true) {
+                element.IPs.push_back(selectedNode.Address().HostAddress());
+            }
+        }
+    }
+
+    void DeviceInfo::SysInfo(const Snapshot& snapshot, JsonData::DeviceInfo::SysteminfoData& systemInfo) const
+    {
+        systemInfo.Time = snapshot.Time;
+        systemInfo.Version = _service->Version() + _T("#") + _subSystem->BuildTreeHash();
+        systemInfo.Uptime = snapshot.Uptime;
+        systemInfo.Freeram = snapshot.FreeRam;
+        systemInfo.Totalram = snapshot.TotalRam;
+        systemInfo.Devicename = snapshot.HostName;
+        systemInfo.Cpuload = Core::NumberType<uint32_t>(snapshot.CpuLoad).Text();
+        systemInfo.Serialnumber = _systemId;
+    }
+
+    void DeviceInfo::AddressInfo(const Snapshot& snapshot, Core::JSON::ArrayType<JsonData::DeviceInfo::AddressesData>& addressInfo) const
+    {
+        for (const Snapshot::Address& address : snapshot.Addresses) {
+
+            JsonData::DeviceInfo::AddressesData newElement;
+            newElement.Name = address.Name;
+            newElement.Mac = address.MAC;
+            JsonData::DeviceInfo::AddressesData& element(addressInfo.Add(newElement));
+
+            for (const string& ip : address.IPs) {
                 Core::JSON::String nodeName;
-                nodeName = selectedNode.Address().HostAddress();
+                nodeName = ip;
 
                 element.Ip.Add(nodeName);
             }
         }
     }
 
+    void DeviceInfo::SocketPortInfo(const Snapshot& snapshot, JsonData::DeviceInfo::SocketinfoData& socketPortInfo) const
+    {
+        socketPortInfo.Runs = snapshot.Runs;
+    }
+
+    // Served from the last snapshot, or collected on the spot if there is no sampler.
+    void DeviceInfo::SysInfo(JsonData::DeviceInfo::SysteminfoData& systemInfo) const
+    {
+        std::shared_ptr<const Snapshot> snapshot(Current());
+
+        if (snapshot != nullptr) {
+            SysInfo(*snapshot, systemInfo);
+        } else {
+            Snapshot live;
+            Collect(live);
+            SysInfo(live, systemInfo);
+        }
+    }
+
+    void DeviceInfo::AddressInfo(Core::JSON::ArrayType<JsonData::DeviceInfo::AddressesData>& addressInfo) const
+    {
+        std::shared_ptr<const Snapshot> snapshot(Current());
+
+        if (snapshot != nullptr) {
+            AddressInfo(*snapshot, addressInfo);
+        } else {
+            Snapshot live;
+            Collect(live.Addresses);
+            AddressInfo(live, addressInfo);
+        }
+    }
+
     void DeviceInfo::SocketPortInfo(JsonData::DeviceInfo::SocketinfoData& socketPortInfo) const
     {
-        socketPortInfo.Runs = Core::ResourceMonitor::Instance().Runs();
+        std::shared_ptr<const Snapshot> snapshot(Current());
+
+        if (snapshot != nullptr) {
+            SocketPortInfo(*snapshot, socketPortInfo);
+        } else {
+            socketPortInfo.Runs = Core::ResourceMonitor::Instance().Runs();
+        }
     }
 
 } // namespace Plugin
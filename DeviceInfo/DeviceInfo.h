@@ -23,6 +23,8 @@
 #include "Module.h"
 #include <interfaces/json/JsonData_DeviceInfo.h>
 
+#include <memory>
+
 namespace WPEFramework {
 namespace Plugin {
 
@@ -50,6 +52,138 @@ namespace Plugin {
             JsonData::DeviceInfo::SocketinfoData Sockets;
         };
 
+    private:
+        class Config : public Core::JSON::Container {
+        private:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+        public:
+            Config()
+                : Core::JSON::Container()
+                , SampleRate(1000)
+            {
+                Add(_T("samplerate"), &SampleRate);
+            }
+            ~Config()
+            {
+            }
+
+        public:
+            // In ms, 0 collects the information on every request.
+            Core::JSON::DecUInt32 SampleRate;
+        };
+
+        // Everything a request can ask for, collected by the sampler. A snapshot is never changed
+        // once published, a new sample or an address change publishes a new version. The web
+        // responses are serialized by the first request that needs them and kept with the snapshot,
+        // the ones a new version did not change are taken over from the previous one.
+        class Snapshot {
+        public:
+            enum body {
+                ALL,
+                ADDRESSES,
+                SYSTEM,
+                SOCKETS,
+                NONE,
+                BODIES
+            };
+
+            struct Address {
+                string Name;
+                string MAC;
+                std::list<string> IPs;
+            };
+
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+
+            Snapshot()
+                : Version(0)
+                , Time()
+                , Uptime(0)
+                , FreeRam(0)
+                , TotalRam(0)
+                , HostName()
+                , CpuLoad(0)
+                , Addresses()
+                , Runs(0)
+                , Lock()
+            {
+            }
+            ~Snapshot()
+            {
+            }
+
+        public:
+            uint32_t Version;
+            string Time;
+            uint64_t Uptime;
+            uint64_t FreeRam;
+            uint64_t TotalRam;
+            string HostName;
+            uint32_t CpuLoad;
+            std::list<Address> Addresses;
+            uint32_t Runs;
+
+            // Empty until serialized.
+            mutable Core::CriticalSection Lock;
+            mutable string Bodies[BODIES];
+        };
+
+        class AdapterNotification : public Core::AdapterObserver::INotification {
+        private:
+            AdapterNotification() = delete;
+            AdapterNotification(const AdapterNotification&) = delete;
+            AdapterNotification& operator=(const AdapterNotification&) = delete;
+
+        public:
+#ifdef __WINDOWS__
+#pragma warning(disable : 4355)
+#endif
+            AdapterNotification(DeviceInfo& parent)
+                : _parent(parent)
+                , _observer(this)
+                , _job(*this)
+            {
+            }
+#ifdef __WINDOWS__
+#pragma warning(default : 4355)
+#endif
+            ~AdapterNotification()
+            {
+            }
+
+        public:
+            void Open()
+            {
+                _observer.Open();
+            }
+            void Close()
+            {
+                _observer.Close();
+                _job.Revoke();
+            }
+            void Event(const string& /* interface */) override
+            {
+                // Address changes come in bursts, pick them up once it settles.
+                _job.Schedule(Core::Time::Now().Add(100));
+            }
+
+        private:
+            friend Core::ThreadPool::JobType<AdapterNotification&>;
+
+            void Dispatch()
+            {
+                _parent.Sample(false, true);
+            }
+
+        private:
+            DeviceInfo& _parent;
+            Core::AdapterObserver _observer;
+            Core::WorkerPool::JobType<AdapterNotification&> _job;
+        };
+
     private:
         DeviceInfo(const DeviceInfo&) = delete;
         DeviceInfo& operator=(const DeviceInfo&) = delete;
@@ -71,16 +205,28 @@ namespace Plugin {
         }
 
     public:
+#ifdef __WINDOWS__
+#pragma warning(disable : 4355)
+#endif
         DeviceInfo()
             : _skipURL(0)
             , _service(nullptr)
             , _subSystem(nullptr)
             , _systemId()
             , _deviceId()
+            , _adminLock()
+            , _sampleLock()
+            , _sampleRate(0)
+            , _snapshot()
+            , _adapters(*this)
+            , _job(*this)
         {
             RegisterAll();
         }
 
+#ifdef __WINDOWS__
+#pragma warning(default : 4355)
+#endif
         virtual ~DeviceInfo()
         {
             UnregisterAll();
@@ -117,12 +263,38 @@ namespace Plugin {
         void SocketPortInfo(JsonData::DeviceInfo::SocketinfoData& socketPortInfo) const;
         string GetDeviceId() const;
 
+        // Sampler
+        friend Core::ThreadPool::JobType<DeviceInfo&>;
+
+        void Dispatch();
+        void Sample(const bool system, const bool addresses);
+        void Collect(Snapshot& snapshot) const;
+        static void Collect(std::list<Snapshot::Address>& addresses);
+        std::shared_ptr<const Snapshot> Current() const
+        {
+            _adminLock.Lock();
+            std::shared_ptr<const Snapshot> result(_snapshot);
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        void SysInfo(const Snapshot& snapshot, JsonData::DeviceInfo::SysteminfoData& systemInfo) const;
+        void AddressInfo(const Snapshot& snapshot, Core::JSON::ArrayType<JsonData::DeviceInfo::AddressesData>& addressInfo) const;
+        void SocketPortInfo(const Snapshot& snapshot, JsonData::DeviceInfo::SocketinfoData& socketPortInfo) const;
+        string Body(const Snapshot& snapshot, const Snapshot::body part) const;
+
     private:
         uint8_t _skipURL;
         PluginHost::IShell* _service;
         PluginHost::ISubSystem* _subSystem;
         string _systemId;
         mutable string _deviceId;
+        mutable Core::CriticalSection _adminLock;
+        Core::CriticalSection _sampleLock;
+        uint32_t _sampleRate;
+        std::shared_ptr<const Snapshot> _snapshot;
+        AdapterNotification _adapters;
+        Core::WorkerPool::JobType<DeviceInfo&> _job;
     };
 
 } // namespace Plugin
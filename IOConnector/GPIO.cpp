@@ -19,6 +19,12 @@
  
 #include "GPIO.h"
 
+#include <linux/gpio.h>
+
+#ifdef GPIO_V2_LINE_FLAG_EDGE_RISING
+#define GPIO_CHARDEV_V2 1
+#endif
+
 namespace WPEFramework {
 
 ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
@@ -55,6 +61,14 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
         namespace GPIO
 {
 
+    // Same clock as the kernel uses for line event timestamps, in us.
+    static uint64_t Monotonic()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000));
+    }
+
     // ----------------------------------------------------------------------------------------------------
     // Class: PIN
     // ----------------------------------------------------------------------------------------------------
@@ -65,6 +79,10 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
         , _activeLow(activeLow ? 1 : 0)
         , _lastValue(false)
         , _descriptor(-1)
+        , _chardev(false)
+        , _flags(0)
+        , _debounce(0)
+        , _fed(false)
         , _timedPin(this)
     {
         if (_pin != 0xFF) {
@@ -98,9 +116,60 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
         _timedPin.AddReference();
     }
 
+    Pin::Pin(const string& chip, const uint8_t line, const bool activeLow)
+        : BaseClass(line, IExternal::regulator, IExternal::general, IExternal::logic, 0)
+        , _pin(line)
+        , _activeLow(activeLow ? 1 : 0)
+        , _lastValue(false)
+        , _descriptor(-1)
+        , _chardev(true)
+        , _flags(0)
+        , _debounce(0)
+        , _fed(false)
+        , _timedPin(this)
+    {
+#ifdef GPIO_CHARDEV_V2
+        int fd = open(chip.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            TRACE_L1(_T("Could not open GPIO chip %s, error %d"), chip.c_str(), errno);
+        } else {
+            struct gpio_v2_line_request request;
+
+            _flags = GPIO_V2_LINE_FLAG_INPUT | (activeLow ? GPIO_V2_LINE_FLAG_ACTIVE_LOW : 0);
+
+            memset(&request, 0, sizeof(request));
+            request.offsets[0] = line;
+            request.num_lines = 1;
+            request.config.flags = _flags;
+            strncpy(request.consumer, "WPEFramework", sizeof(request.consumer) - 1);
+
+            if (ioctl(fd, GPIO_V2_GET_LINE_IOCTL, &request) < 0) {
+                TRACE_L1(_T("Could not request line %d on GPIO chip %s, error %d"), line, chip.c_str(), errno);
+            } else {
+                _descriptor = request.fd;
+            }
+
+            close(fd);
+        }
+#else
+        TRACE_L1(_T("GPIO chip %s requested, but the kernel headers lack the v2 GPIO uAPI"), chip.c_str());
+#endif
+
+        _timedPin.AddRef();
+        _timedPin.AddReference();
+    }
+
     /* virtual */ Pin::~Pin()
     {
-        if (_descriptor != -1) {
+        if ((_descriptor != -1) && (_chardev == true)) {
+            Core::ResourceMonitor::Instance().Unregister(*this);
+
+            // Closing the line request releases the line.
+            close(_descriptor);
+            _descriptor = -1;
+        }
+        else if (_descriptor != -1) {
             Core::ResourceMonitor::Instance().Unregister(*this);
 
             close(_descriptor);
@@ -153,29 +222,108 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
 
     /* virtual */ uint16_t Pin::Events()
     {
-        return (_descriptor != -1 ? (POLLPRI | POLLERR) : 0);
+        return (_descriptor == -1 ? 0 : (_chardev == true ? POLLIN : (POLLPRI | POLLERR)));
     }
 
     /* virtual */ void Pin::Handle(const uint16_t events)
     {
+#ifdef GPIO_CHARDEV_V2
+        if ((_chardev == true) && ((events & POLLIN) != 0)) {
+
+            // Drain whatever the kernel queued in one read, every edge carries its own timestamp.
+            struct gpio_v2_line_event edges[EventBatch];
+            ssize_t size = read(_descriptor, edges, sizeof(edges));
+
+            if (size >= static_cast<ssize_t>(sizeof(struct gpio_v2_line_event))) {
+                uint32_t count = static_cast<uint32_t>(size / sizeof(struct gpio_v2_line_event));
+
+                for (uint32_t index = 0; index < count; index++) {
+                    _timedPin.Update((edges[index].id == GPIO_V2_LINE_EVENT_RISING_EDGE), (edges[index].timestamp_ns / 1000));
+                }
+
+                // The last edge tells the current state, make sure HasChanged reports it.
+                _lastValue = (edges[count - 1].id != GPIO_V2_LINE_EVENT_RISING_EDGE);
+                _fed = true;
 
+                Updated();
+            }
+        }
+        else
+#endif
         if ((events & (POLLPRI | POLLERR)) != 0) {
 
             unsigned char buffer[1];
+            const uint64_t timestamp = Monotonic();
 
             read(_descriptor, &buffer, sizeof(buffer));
 
+            const bool value = Get();
+
+            // Take the time of the interrupt, not the time it is dispatched.
+            _timedPin.Update(value, timestamp);
+
             // If we are only triggered on a falling edge, or a rising edge
             // the change is not detected compared to the previous value,
             // force HasChanged to be true!!
-            _lastValue = !Get();
+            _lastValue = !value;
+            _fed = true;
 
             Updated();
         }
     }
 
+    void Pin::Configure()
+    {
+#ifdef GPIO_CHARDEV_V2
+        struct gpio_v2_line_config config;
+
+        memset(&config, 0, sizeof(config));
+        config.flags = _flags;
+
+        // Debouncing is only available on inputs.
+        if ((_debounce != 0) && ((_flags & GPIO_V2_LINE_FLAG_INPUT) != 0)) {
+            config.num_attrs = 1;
+            config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+            config.attrs[0].attr.debounce_period_us = _debounce;
+            config.attrs[0].mask = 1;
+        }
+
+        if (ioctl(_descriptor, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0) {
+            TRACE_L1(_T("Could not configure GPIO line %d, error %d"), _pin, errno);
+        }
+#endif
+    }
+
+    void Pin::Debounce(const uint16_t milliSeconds)
+    {
+        if ((_chardev == true) && (_descriptor != -1)) {
+            // The kernel debounces the line, the edges reported are stable already.
+            _debounce = milliSeconds * 1000;
+            _timedPin.Threshold(0);
+            Configure();
+        } else {
+            _timedPin.Threshold(milliSeconds);
+        }
+    }
+
     void Pin::Trigger(const trigger_mode mode)
     {
+#ifdef GPIO_CHARDEV_V2
+        if ((_chardev == true) && (_descriptor != -1)) {
+            // There is no level triggering on a line, the edge towards that level will do.
+            _flags &= ~(GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING);
+
+            if ((mode & (RISING | HIGH)) != 0) {
+                _flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+            }
+            if ((mode & (FALLING | LOW)) != 0) {
+                _flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            }
+
+            Configure();
+        }
+        else
+#endif
         if (_descriptor != -1) {
             // Oke looks like we have a valid pin.
             char buffer[64];
@@ -209,6 +357,19 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
     {
         bool result = false;
 
+#ifdef GPIO_CHARDEV_V2
+        if ((_chardev == true) && (_descriptor != -1)) {
+            struct gpio_v2_line_values values;
+            values.bits = 0;
+            values.mask = 1;
+
+            // Active low is handled by the kernel for lines.
+            if (ioctl(_descriptor, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) == 0) {
+                result = ((values.bits & 1) != 0);
+            }
+        }
+        else
+#endif
         if (_descriptor != -1) {
             uint8_t value;
             lseek(_descriptor, 0, SEEK_SET);
@@ -223,6 +384,16 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
 
     void Pin::Set(const bool value)
     {
+#ifdef GPIO_CHARDEV_V2
+        if ((_chardev == true) && (_descriptor != -1)) {
+            struct gpio_v2_line_values values;
+            values.bits = (value ? 1 : 0);
+            values.mask = 1;
+
+            ioctl(_descriptor, GPIO_V2_LINE_SET_VALUES_IOCTL, &values);
+        }
+        else
+#endif
         if (_descriptor != -1) {
             uint8_t newValue;
             if (_activeLow != 0) {
@@ -236,6 +407,19 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
 
     void Pin::Mode(const pin_mode mode)
     {
+#ifdef GPIO_CHARDEV_V2
+        if ((_chardev == true) && (_descriptor != -1)) {
+            if (mode == GPIO::Pin::INPUT) {
+                _flags = (_flags & ~GPIO_V2_LINE_FLAG_OUTPUT) | GPIO_V2_LINE_FLAG_INPUT;
+                Configure();
+            } else if (mode == GPIO::Pin::OUTPUT) {
+                // Edge detection and bias are input only.
+                _flags = (_flags & GPIO_V2_LINE_FLAG_ACTIVE_LOW) | GPIO_V2_LINE_FLAG_OUTPUT;
+                Configure();
+            }
+        }
+        else
+#endif
         if (_descriptor != -1) {
             // Oke looks like we have a valid pin.
             char buffer[64];
@@ -259,6 +443,14 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
 
     void Pin::Pull(const pull_mode mode)
     {
+#ifdef GPIO_CHARDEV_V2
+        if ((_chardev == true) && (_descriptor != -1)) {
+            _flags &= ~(GPIO_V2_LINE_FLAG_BIAS_PULL_UP | GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN | GPIO_V2_LINE_FLAG_BIAS_DISABLED);
+            _flags |= (mode == GPIO::Pin::UP ? GPIO_V2_LINE_FLAG_BIAS_PULL_UP : (mode == GPIO::Pin::DOWN ? GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN : GPIO_V2_LINE_FLAG_BIAS_DISABLED));
+            Configure();
+        }
+        else
+#endif
         if (_descriptor != -1) {
             // Oke looks like we have a valid pin.
             char buffer[64];
@@ -288,7 +480,7 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
     }
 
     void Pin::Unregister(IInputPin::INotification* sink) /* override */ {
-        _timedPin.Register(sink);
+        _timedPin.Unregister(sink);
     }
 
     uint32_t Pin::AddMarker(const IInputPin::INotification* sink, const uint32_t marker) /* override */ {
@@ -301,8 +493,13 @@ ENUM_CONVERSION_BEGIN(GPIO::Pin::trigger_mode)
 
     /* virtual */ void Pin::Trigger()
     {
+        // An edge that came in through Handle() is fed already, with the time it occured.
+        const bool fed = _fed.exchange(false);
+
         if (HasChanged() == true) {
-            _timedPin.Update(Get());
+            if (fed == false) {
+                _timedPin.Update(Get(), Monotonic());
+            }
             BaseClass::Updated();
         }
     }
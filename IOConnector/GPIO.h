@@ -23,6 +23,8 @@
 #include "Module.h"
 #include "TimedInput.h"
 
+#include <atomic>
+
 #include <interfaces/IExternalBase.h>
 #include <interfaces/IInputPin.h>
 
@@ -52,7 +54,7 @@ namespace GPIO {
         public:
             TimedPin(Pin* parent)
                 : _parent(*parent)
-                , _marker(~0)
+                , _reached()
                 , _job()
                 , _observerList()
                 , _markerMap()
@@ -172,19 +174,29 @@ namespace GPIO {
                 return (result);
 
             }
-            void Update(const bool pressed)
+            void Threshold(const uint16_t milliSeconds)
+            {
+                _parent.Lock();
+                _monitor.Threshold(milliSeconds);
+                _parent.Unlock();
+            }
+
+            // The timestamp is the moment the edge occured, in us on the monotonic clock.
+            void Update(const bool pressed, const uint64_t timestamp)
             {
                 uint32_t marker;
 
-                if (_monitor.Reached(pressed, marker) == true) {
- 
-                    _parent.Lock();
+                _parent.Lock();
 
-                    ASSERT(_marker == static_cast<uint32_t>(~0));
-                    _marker = marker;
-                    _parent.Schedule(Core::Time(), _job);
-                    _parent.Unlock();
+                if (_monitor.Reached(pressed, timestamp, marker) == true) {
+                    // A batch of edges can complete more than one press before the job runs.
+                    _reached.push_back(marker);
+                    if (_reached.size() == 1) {
+                        _parent.Schedule(Core::Time(), _job);
+                    }
                 }
+
+                _parent.Unlock();
             }
 
         private:
@@ -192,13 +204,21 @@ namespace GPIO {
             {
                 _parent.Lock();
 
-                uint32_t marker = _marker;
+                ASSERT(_reached.empty() == false);
+
+                uint32_t marker = _reached.front();
+                _reached.pop_front();
+
+                if (_reached.empty() == false) {
+                    _parent.Schedule(Core::Time(), _job);
+                }
 
                 MarkerMap::iterator loop (_markerMap.find(marker));
                 if (loop != _markerMap.end()) {
                     ObserverList::const_iterator index(loop->second.cbegin());
-                    _marker = ~0;
                     RecursiveCall(loop->second, index, marker);
+                } else {
+                    _parent.Unlock();
                 }
             }
             void RecursiveCall(const ObserverList& list, ObserverList::const_iterator& position, const uint32_t marker)
@@ -217,7 +237,7 @@ namespace GPIO {
 
         private:
             Pin& _parent;
-            uint32_t _marker;
+            std::list<uint32_t> _reached;
             Core::ProxyType<Core::IDispatch> _job;
             ObserverList _observerList;
             MarkerMap _markerMap;
@@ -248,8 +268,15 @@ namespace GPIO {
             LOW = 0x08
         };
 
+        // Edges read from a line in one go.
+        static constexpr uint8_t EventBatch = 16;
+
     public:
+        // A pin exported through /sys/class/gpio.
         Pin(const uint8_t id, const bool activeLow);
+        // A line on a GPIO character device (e.g. /dev/gpiochip0), driven through the v2 uAPI. The kernel
+        // debounces and timestamps the edges. This works against a gpio-sim chip as well.
+        Pin(const string& chip, const uint8_t line, const bool activeLow);
         virtual ~Pin();
 
     public:
@@ -259,6 +286,7 @@ namespace GPIO {
         void Trigger(const trigger_mode mode);
         void Mode(const pin_mode mode);
         void Pull(const pull_mode mode);
+        void Debounce(const uint16_t milliSeconds);
 
         bool HasChanged() const;
         void Align();
@@ -299,12 +327,17 @@ namespace GPIO {
         virtual void Revoke(const Core::ProxyType<Core::IDispatch>& job) override;
 
         void Flush();
+        void Configure();
 
     private:
         const uint8_t _pin;
         uint8_t _activeLow;
         bool _lastValue;
         mutable int _descriptor;
+        const bool _chardev;
+        uint64_t _flags;
+        uint32_t _debounce;
+        std::atomic<bool> _fed;
         Core::ProxyObject<TimedPin> _timedPin;
     };
 }
@@ -104,10 +104,19 @@ namespace Plugin
 
         while (index.Next() == true) {
 
-            GPIO::Pin* pin = Core::Service<GPIO::Pin>::Create<GPIO::Pin>(index.Current().Id.Value(), index.Current().ActiveLow.Value());
+            GPIO::Pin* pin;
             uint8_t mode = 0;
 
+            // With a chip, the id is the line offset on that GPIO character device.
+            if (index.Current().Chip.Value().empty() == false) {
+                pin = Core::Service<GPIO::Pin>::Create<GPIO::Pin>(index.Current().Chip.Value(), index.Current().Id.Value(), index.Current().ActiveLow.Value());
+            } else {
+                pin = Core::Service<GPIO::Pin>::Create<GPIO::Pin>(index.Current().Id.Value(), index.Current().ActiveLow.Value());
+            }
+
             if (pin != nullptr) {
+                pin->Debounce(index.Current().Debounce.Value());
+
                 switch (index.Current().Mode.Value()) {
                 case Config::Pin::LOW: {
                     pin->Mode(GPIO::Pin::INPUT);
@@ -137,22 +137,30 @@ namespace Plugin {
                     : Id(~0)
                     , Mode(LOW)
                     , ActiveLow(false)
+                    , Chip()
+                    , Debounce(static_cast<uint16_t>(GPIO::TimedInput::BounceThreshold))
                     , Handlers()
                 {
                     Add(_T("id"), &Id);
                     Add(_T("mode"), &Mode);
                     Add(_T("activelow"), &ActiveLow);
+                    Add(_T("chip"), &Chip);
+                    Add(_T("debounce"), &Debounce);
                     Add(_T("handlers"), &Handlers);
                 }
                 Pin(const Pin& copy)
                     : Id(copy.Id)
                     , Mode(copy.Mode)
                     , ActiveLow(copy.ActiveLow)
+                    , Chip(copy.Chip)
+                    , Debounce(copy.Debounce)
                     , Handlers(copy.Handlers)
                 {
                     Add(_T("id"), &Id);
                     Add(_T("mode"), &Mode);
                     Add(_T("activelow"), &ActiveLow);
+                    Add(_T("chip"), &Chip);
+                    Add(_T("debounce"), &Debounce);
                     Add(_T("handlers"), &Handlers);
                 }
                 virtual ~Pin()
@@ -164,6 +172,8 @@ namespace Plugin {
                     Id = RHS.Id;
                     Mode = RHS.Mode;
                     ActiveLow = RHS.ActiveLow;
+                    Chip = RHS.Chip;
+                    Debounce = RHS.Debounce;
                     Handlers = RHS.Handlers;
 
                     return (*this);
@@ -173,6 +183,8 @@ namespace Plugin {
                 Core::JSON::DecUInt8 Id;
                 Core::JSON::EnumType<mode> Mode;
                 Core::JSON::Boolean ActiveLow;
+                Core::JSON::String Chip;
+                Core::JSON::DecUInt16 Debounce;
                 Core::JSON::ArrayType<Handler> Handlers;
             };
 
@@ -0,0 +1,148 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimedInput.h"
+
+#include <stdio.h>
+
+// Feeds edge sequences, with the timestamps the kernel (or Handle()) would attach, into the marker
+// evaluation of an input pin: long presses, short taps and contact bounce on either edge.
+
+using namespace WPEFramework;
+
+namespace {
+
+    static constexpr uint64_t Millisecond = 1000;
+
+    uint32_t _failures = 0;
+
+    void Check(const char description[], const bool condition)
+    {
+        printf("%-72s %s\n", description, (condition == true ? "ok" : "FAILED"));
+        _failures += (condition == true ? 0 : 1);
+    }
+
+    // Returns the marker reached at the last edge, 0 if none was.
+    uint32_t Feed(GPIO::TimedInput& input, const bool pressed, const uint64_t timestamp)
+    {
+        uint32_t marker = 0;
+        return (input.Reached(pressed, timestamp, marker) == true ? marker : 0);
+    }
+
+    void Markers(GPIO::TimedInput& input)
+    {
+        input.Add(3000);
+        input.Add(1000);
+        input.Add(5000);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) {
+        printf("%s\n\tRuns the press/release marker and debounce checks, no options\n", argv[0]);
+        return (1);
+    }
+
+    {
+        GPIO::TimedInput input;
+        Markers(input);
+        uint64_t now = 1000000;
+
+        Feed(input, true, now);
+        Check("A press of 1.5 s reaches the 1000 ms marker", (Feed(input, false, now + 1500 * Millisecond) == 1000));
+
+        now += 10000 * Millisecond;
+        Feed(input, true, now);
+        Check("A press of 3.5 s reaches the 3000 ms marker", (Feed(input, false, now + 3500 * Millisecond) == 3000));
+
+        now += 10000 * Millisecond;
+        Feed(input, true, now);
+        Check("A press shorter than the first marker reaches none", (Feed(input, false, now + 500 * Millisecond) == 0));
+    }
+    {
+        GPIO::TimedInput input;
+        Markers(input);
+        uint64_t now = 1000000;
+
+        Feed(input, true, now);
+        Check("A tap within the bounce threshold reaches no marker", (Feed(input, false, now + 40 * Millisecond) == 0));
+
+        // Long after the tap, a new press must be timed from its own edge, not from the tap.
+        now += 60000 * Millisecond;
+        Feed(input, true, now);
+        Check("A press long after a short tap is timed from its own edge", (Feed(input, false, now + 1200 * Millisecond) == 1000));
+    }
+    {
+        GPIO::TimedInput input;
+        Markers(input);
+        uint64_t now = 1000000;
+
+        Feed(input, true, now);
+        Feed(input, false, now + 5 * Millisecond);
+        Feed(input, true, now + 8 * Millisecond);
+        Check("Bounce right after the press, the original press continues", (Feed(input, false, now + 3100 * Millisecond) == 3000));
+    }
+    {
+        GPIO::TimedInput input;
+        Markers(input);
+        uint64_t now = 1000000;
+
+        Feed(input, true, now);
+        Check("Bounce after a release, the release still reaches its marker", (Feed(input, false, now + 1200 * Millisecond) == 1000));
+        Feed(input, true, now + 1205 * Millisecond);
+        Check("The bounced press after the release reaches nothing", (Feed(input, false, now + 1210 * Millisecond) == 0));
+
+        now += 5000 * Millisecond;
+        Feed(input, true, now);
+        Check("The next real press is timed normally", (Feed(input, false, now + 5200 * Millisecond) == 5000));
+    }
+    {
+        GPIO::TimedInput input;
+        Markers(input);
+        uint64_t now = 1000000;
+
+        Feed(input, true, now);
+        Feed(input, true, now + 900 * Millisecond);
+        Check("A repeated press edge does not restart the press", (Feed(input, false, now + 1100 * Millisecond) == 1000));
+        Check("A repeated release edge is ignored", (Feed(input, false, now + 1200 * Millisecond) == 0));
+    }
+    {
+        GPIO::TimedInput input;
+        Markers(input);
+        input.Threshold(0);
+        uint64_t now = 1000000;
+
+        Feed(input, true, now);
+        Feed(input, false, now + 5 * Millisecond);
+        Feed(input, true, now + 8 * Millisecond);
+        Check("Debounced by the kernel, every edge counts", (Feed(input, false, now + 1500 * Millisecond) == 1000));
+    }
+    {
+        GPIO::TimedInput input;
+        Markers(input);
+        input.Remove(1000);
+        uint64_t now = 1000000;
+
+        Feed(input, true, now);
+        Check("A removed marker is not reached anymore", (Feed(input, false, now + 1500 * Millisecond) == 0));
+    }
+
+    return (_failures == 0 ? 0 : 2);
+}
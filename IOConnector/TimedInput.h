@@ -25,16 +25,25 @@ namespace WPEFramework {
 
 namespace GPIO {
 
+    // Turns the press/release edges of an input into the marker (in ms) that was reached when the input
+    // was released. Edges carry the time they occured (in us, on a monotonic clock), so the outcome does
+    // not depend on when the edge gets processed. Edges that follow the previous edge within the bounce
+    // threshold are considered contact bounce. A release always ends the press, a press right after a bounced
+    // release resumes it. If the kernel already debounces the line, the threshold is 0.
     class TimedInput {
-    private:
-        const uint16_t BounceThreshold = 100;
+    public:
+        static constexpr uint16_t BounceThreshold = 100;
 
     public:
         TimedInput(const TimedInput&) = delete;
         TimedInput& operator=(const TimedInput&) = delete;
         TimedInput()
             : _markers()
+            , _threshold(BounceThreshold * 1000)
             , _pressedTime(0)
+            , _releasedTime(0)
+            , _bouncedTime(0)
+            , _pressed(false)
         {
         }
         ~TimedInput()
@@ -42,6 +51,9 @@ namespace GPIO {
         }
 
     public:
+        void Threshold(const uint16_t milliSeconds) {
+            _threshold = milliSeconds * 1000;
+        }
         void Clear() {
             _markers.clear();
         }
@@ -68,29 +80,49 @@ namespace GPIO {
                 _markers.erase(index);
             }
         }
- 
-        bool Reached(bool pressed, uint32_t& marker)
+
+        bool Reached(const bool pressed, const uint64_t timestamp, uint32_t& marker)
         {
             bool reached = false;
-            uint64_t now = Core::Time::Now().Ticks();
-            if (pressed == true) {
-                if (now > (_pressedTime + BounceThreshold)) {
-                    _pressedTime = now;
-                }
-            }
-            // Filter out contact bounce here.
-            else if ((_pressedTime + BounceThreshold) > now) {
-                uint32_t elapsedTime = static_cast<uint32_t>(now - _pressedTime);
 
-                // See which marker we have reached..
-                std::list<uint32_t>::const_iterator index;
-                while ( (index != _markers.end()) && (elapsedTime <= *index)) {
-                    marker = *index;
-                    index++;
+            if (pressed != _pressed) {
+                _pressed = pressed;
+
+                if (pressed == true) {
+                    if ((_releasedTime != 0) && ((timestamp - _releasedTime) < _threshold)) {
+                        // Contact bounce after a release. If that release was bounce itself, the press it
+                        // interrupted continues, otherwise this press and its release are ignored.
+                        _pressedTime = _bouncedTime;
+                    }
+                    else {
+                        _pressedTime = timestamp;
+                    }
+                    _bouncedTime = 0;
+                }
+                else if (_pressedTime == 0) {
+                    // The release of a press that was contact bounce.
                 }
+                else if ((timestamp - _pressedTime) < _threshold) {
+                    // Contact bounce right after the press, or a tap too short to count. Only a press
+                    // within the threshold picks the original press up again.
+                    _bouncedTime = _pressedTime;
+                    _releasedTime = timestamp;
+                    _pressedTime = 0;
+                }
+                else {
+                    const uint32_t elapsed = static_cast<uint32_t>((timestamp - _pressedTime) / 1000);
+
+                    // See which marker we have reached..
+                    std::list<uint32_t>::const_iterator index(_markers.cbegin());
+                    while ((index != _markers.cend()) && (*index <= elapsed)) {
+                        marker = *index;
+                        reached = true;
+                        index++;
+                    }
 
-                // Now we know which marker we have reached, report it.
-                reached = true;
+                    _releasedTime = timestamp;
+                    _pressedTime = 0;
+                }
             }
 
             return(reached);
@@ -98,7 +130,11 @@ namespace GPIO {
 
     private:
         std::list<uint32_t> _markers;
-	uint64_t _pressedTime;
+        uint32_t _threshold;
+        uint64_t _pressedTime;
+        uint64_t _releasedTime;
+        uint64_t _bouncedTime;
+        bool _pressed;
     };
 
 } // namespace Plugin
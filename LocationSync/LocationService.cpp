@@ -267,6 +267,9 @@ namespace Plugin {
         , _remoteId()
         , _sourceNode()
         , _tryInterval(0)
+        , _retries(0)
+        , _started(0)
+        , _latency(0)
         , _callback(callback)
         , _publicIPAddress()
         , _timeZone()
@@ -343,6 +346,9 @@ namespace Plugin {
                     string fullRequest; _request->ToString(fullRequest);
                     _infoCarrier = constructor->factory();
 
+                    _started = Core::Time::Now().Ticks();
+                    _latency = 0;
+
                     _activity.Submit();
 
                     result = Core::ERROR_NONE;
@@ -377,6 +383,22 @@ namespace Plugin {
         _adminLock.Unlock();
     }
 
+    void LocationService::Restore(const string& publicIPAddress, const string& timeZone, const string& country, const string& region, const string& city)
+    {
+        _adminLock.Lock();
+
+        if ((_state == IDLE) || (_state == FAILED) || (_state == LOADED)) {
+            _publicIPAddress = publicIPAddress;
+            _timeZone = timeZone;
+            _country = country;
+            _region = region;
+            _city = city;
+            _state = LOADED;
+        }
+
+        _adminLock.Unlock();
+    }
+
     // Methods to extract and insert data into the socket buffers
     /* virtual */ void LocationService::LinkBody(Core::ProxyType<Web::Response>& element)
     {
@@ -414,6 +436,7 @@ namespace Plugin {
                 _publicIPAddress = _infoCarrier->IP();
             }
             _state = LOADED;
+            _latency = static_cast<uint32_t>((Core::Time::Now().Ticks() - _started) / Core::Time::TicksPerMillisecond);
 
             ASSERT(!_publicIPAddress.empty());
 
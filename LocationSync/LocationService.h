@@ -22,6 +22,8 @@
 
 #include "Module.h"
 
+#include <atomic>
+
 namespace WPEFramework {
 
 namespace Plugin {
@@ -68,6 +70,23 @@ namespace Plugin {
         uint32_t Probe(const string& remoteNode, const uint32_t retries, const uint32_t retryTimeSpan);
         void Stop();
 
+        // Take over a previously obtained location, e.g. from persistent storage, until a probe replaces it.
+        void Restore(const string& publicIPAddress, const string& timeZone, const string& country, const string& region, const string& city);
+
+        // The last probe got an answer.
+        bool IsLoaded() const
+        {
+            _adminLock.Lock();
+            bool result = (_state == LOADED);
+            _adminLock.Unlock();
+            return (result);
+        }
+        // Time it took the last probe to get its answer, in mS, 0 if it did not get one (yet).
+        uint32_t Latency() const
+        {
+            return (_latency);
+        }
+
         /*
        * ------------------------------------------------------------------------------------------------------------
        * ISubSystem::INetwork methods
@@ -116,12 +135,14 @@ namespace Plugin {
         void Dispatch();
 
     private:
-        Core::CriticalSection _adminLock;
+        mutable Core::CriticalSection _adminLock;
         state _state;
         string _remoteId;
         Core::NodeId _sourceNode;
         uint32_t _tryInterval;
         uint32_t _retries;
+        uint64_t _started;
+        std::atomic<uint32_t> _latency;
         Core::IDispatch* _callback;
         string _publicIPAddress;
         string _timeZone;
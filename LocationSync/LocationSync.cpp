@@ -32,8 +32,9 @@ namespace Plugin {
 #endif
     LocationSync::LocationSync()
         : _skipURL(0)
-        , _source()
-        , _sink(this)
+        , _sources()
+        , _notification(*this)
+        , _prober(&_notification)
         , _service(nullptr)
     {
         RegisterAll();
@@ -54,12 +55,35 @@ namespace Plugin {
         config.FromString(service->ConfigLine());
         string version = service->Version();
 
-        if (LocationService::IsSupported(config.Source.Value()) == Core::ERROR_NONE) {
+        Core::JSON::ArrayType<Core::JSON::String>::Iterator index(config.Sources.Elements());
+        std::list<string> sources;
+
+        if (config.Source.IsSet() == true) {
+            sources.push_back(config.Source.Value());
+        }
+        while (index.Next() == true) {
+            sources.push_back(index.Current().Value());
+        }
+
+        for (const string& source : sources) {
+            if (LocationService::IsSupported(source) == Core::ERROR_NONE) {
+                _sources.push_back(source);
+            } else {
+                SYSLOG(Logging::Startup, (_T("Location source [%s] is not supported"), source.c_str()));
+            }
+        }
+
+        if (_sources.empty() == false) {
+            string cacheFile;
+
             _skipURL = static_cast<uint16_t>(service->WebPrefix().length());
-            _source = config.Source.Value();
             _service = service;
 
-            _sink.Initialize(service, config.Source.Value(), config.Interval.Value(), config.Retries.Value());
+            if ((config.CacheTTL.Value() != 0) && (service->PersistentPath().empty() == false) && (Core::Directory(service->PersistentPath().c_str()).CreatePath() == true)) {
+                cacheFile = service->PersistentPath() + _T("location.json");
+            }
+
+            _prober.Initialize(_sources, config.Interval.Value(), config.Retries.Value(), cacheFile, config.CacheTTL.Value());
         } else {
             result = _T("URL for retrieving location is incorrect !!!");
         }
@@ -72,7 +96,8 @@ namespace Plugin {
     {
         ASSERT(_service == service);
 
-        _sink.Deinitialize();
+        _prober.Deinitialize();
+        _sources.clear();
     }
 
     /* virtual */ string LocationSync::Information() const
@@ -119,8 +144,8 @@ namespace Plugin {
         } else if (request.Verb == Web::Request::HTTP_POST) {
             index.Next();
             if (index.Next()) {
-                if ((index.Current() == "Sync") && (_source.empty() == false)) {
-                    uint32_t error = _sink.Probe(_source, 1, 1);
+                if ((index.Current() == "Sync") && (_sources.empty() == false)) {
+                    uint32_t error = _prober.Probe(1, 1);
 
                     if (error != Core::ERROR_NONE) {
                         result->ErrorCode = Web::STATUS_INTERNAL_SERVER_ERROR;
@@ -144,12 +169,12 @@ namespace Plugin {
 
         if (subSystem != nullptr) {
 
-            subSystem->Set(PluginHost::ISubSystem::INTERNET, _sink.Network());
-            subSystem->Set(PluginHost::ISubSystem::LOCATION, _sink.Location());
+            subSystem->Set(PluginHost::ISubSystem::INTERNET, _prober.Network());
+            subSystem->Set(PluginHost::ISubSystem::LOCATION, _prober.Location());
             subSystem->Release();
 
-            if ((_sink.Location() != nullptr) && (_sink.Location()->TimeZone().empty() == false)) {
-                Core::SystemInfo::SetEnvironment(_T("TZ"), _sink.Location()->TimeZone());
+            if ((_prober.Location() != nullptr) && (_prober.Location()->TimeZone().empty() == false)) {
+                Core::SystemInfo::SetEnvironment(_T("TZ"), _prober.Location()->TimeZone());
                 event_locationchange();
             }
         }
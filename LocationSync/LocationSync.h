@@ -20,7 +20,7 @@
 #ifndef LOCATIONSYNC_LOCATIONSYNC_H
 #define LOCATIONSYNC_LOCATIONSYNC_H
 
-#include "LocationService.h"
+#include "Prober.h"
 #include <interfaces/json/JsonData_LocationSync.h>
 #include "Module.h"
 
@@ -63,82 +63,27 @@ namespace Plugin {
 
     private:
         class Notification : public Core::IDispatch {
-        private:
+        public:
             Notification() = delete;
             Notification(const Notification&) = delete;
             Notification& operator=(const Notification&) = delete;
 
-        public:
-#ifdef __WINDOWS__
-#pragma warning(disable : 4355)
-#endif
-            explicit Notification(LocationSync* parent)
-                : _parent(*parent)
-                , _source()
-                , _interval()
-                , _retries()
-                , _locator(Core::Service<LocationService>::Create<LocationService>(this))
+            explicit Notification(LocationSync& parent)
+                : _parent(parent)
             {
-                ASSERT(parent != nullptr);
             }
-#ifdef __WINDOWS__
-#pragma warning(default : 4355)
-#endif
             ~Notification()
-            {
-                _locator->Release();
-            }
-
-        public:
-            inline void Initialize(PluginHost::IShell* service, const string& source, const uint16_t interval, const uint8_t retries)
-            {
-                _source = source;
-                _interval = interval;
-                _retries = retries;
-
-                Probe();
-            }
-            inline void Deinitialize()
             {
             }
-            uint32_t Probe(const string& remoteNode, const uint32_t retries, const uint32_t retryTimeSpan)
-            {
-                _source = remoteNode;
-                _interval = retryTimeSpan;
-                _retries = retries;
-
-                return (Probe());
-            }
-
-            inline PluginHost::ISubSystem::ILocation* Location()
-            {
-                return (_locator);
-            }
-            inline PluginHost::ISubSystem::IInternet* Network()
-            {
-                return (_locator);
-            }
 
         private:
-            inline uint32_t Probe()
-            {
-
-                ASSERT(_locator != nullptr);
-
-                return (_locator != nullptr ? _locator->Probe(_source, _retries, _interval) : Core::ERROR_UNAVAILABLE);
-            }
-
-            virtual void Dispatch()
+            void Dispatch() override
             {
                 _parent.SyncedLocation();
             }
 
         private:
             LocationSync& _parent;
-            string _source;
-            uint16_t _interval;
-            uint8_t _retries;
-            LocationService* _locator;
         };
 
         class Config : public Core::JSON::Container {
@@ -151,10 +96,14 @@ namespace Plugin {
                 : Interval(30)
                 , Retries(8)
                 , Source()
+                , Sources()
+                , CacheTTL(86400)
             {
                 Add(_T("interval"), &Interval);
                 Add(_T("retries"), &Retries);
                 Add(_T("source"), &Source);
+                Add(_T("sources"), &Sources);
+                Add(_T("cachettl"), &CacheTTL);
             }
             ~Config()
             {
@@ -164,6 +113,8 @@ namespace Plugin {
             Core::JSON::DecUInt16 Interval;
             Core::JSON::DecUInt8 Retries;
             Core::JSON::String Source;
+            Core::JSON::ArrayType<Core::JSON::String> Sources;
+            Core::JSON::DecUInt32 CacheTTL;
         };
 
     private:
@@ -198,14 +149,16 @@ namespace Plugin {
         void UnregisterAll();
         uint32_t endpoint_sync();
         uint32_t get_location(JsonData::LocationSync::LocationData& response) const;
+        uint32_t get_probes(Core::JSON::ArrayType<Prober::ProbeData>& response) const;
         void event_locationchange();
 
         void SyncedLocation();
 
     private:
         uint16_t _skipURL;
-        string _source;
-        Core::Sink<Notification> _sink;
+        std::list<string> _sources;
+        Core::Sink<Notification> _notification;
+        Prober _prober;
         PluginHost::IShell* _service;
     };
 
@@ -34,12 +34,14 @@ namespace Plugin {
     {
         Register<void,void>(_T("sync"), &LocationSync::endpoint_sync, this);
         Property<LocationData>(_T("location"), &LocationSync::get_location, nullptr, this);
+        Property<Core::JSON::ArrayType<Prober::ProbeData>>(_T("probes"), &LocationSync::get_probes, nullptr, this);
     }
 
     void LocationSync::UnregisterAll()
     {
         Unregister(_T("sync"));
         Unregister(_T("location"));
+        Unregister(_T("probes"));
     }
 
     // API implementation
@@ -56,8 +58,8 @@ namespace Plugin {
     {
         uint32_t result = Core::ERROR_NONE;
 
-        if (_source.empty() == false) {
-            result = _sink.Probe(_source, 1, 1);
+        if (_sources.empty() == false) {
+            result = _prober.Probe(1, 1);
         } else {
             result = Core::ERROR_GENERAL;
         }
@@ -88,6 +90,16 @@ namespace Plugin {
         return Core::ERROR_NONE;
     }
 
+    // Property: probes - Outcome of the last probe of every location source
+    // Return codes:
+    //  - ERROR_NONE: Success
+    uint32_t LocationSync::get_probes(Core::JSON::ArrayType<Prober::ProbeData>& response) const
+    {
+        _prober.Probes(response);
+
+        return Core::ERROR_NONE;
+    }
+
     // Event: locationchange - Signals a location change
     void LocationSync::event_locationchange()
     {
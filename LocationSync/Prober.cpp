@@ -0,0 +1,214 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Prober.h"
+
+namespace WPEFramework {
+namespace Plugin {
+
+    void Prober::Initialize(const std::list<string>& sources, const uint16_t interval, const uint8_t retries, const string& cacheFile, const uint32_t timeToLive)
+    {
+        _interval = interval;
+        _retries = retries;
+        _cacheFile = cacheFile;
+
+        for (const string& source : sources) {
+            _endpoints.emplace_back(*this, source);
+        }
+
+        // A location that is recent enough is published right away, the probes refresh it in the background.
+        if (Load(timeToLive) == true) {
+            _update->Dispatch();
+        }
+
+        Probe();
+    }
+
+    void Prober::Deinitialize()
+    {
+        for (Core::Sink<Endpoint>& endpoint : _endpoints) {
+            endpoint.Locator()->Stop();
+        }
+
+        _adminLock.Lock();
+        _published = nullptr;
+        _cached = false;
+        _adminLock.Unlock();
+
+        _endpoints.clear();
+
+        if (_cache != nullptr) {
+            _cache->Release();
+            _cache = nullptr;
+        }
+    }
+
+    uint32_t Prober::Probe()
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+        _adminLock.Lock();
+
+        _decided = false;
+        for (Core::Sink<Endpoint>& endpoint : _endpoints) {
+            endpoint.Finished(false);
+        }
+
+        _adminLock.Unlock();
+
+        // Started outside the lock, a locator reports back with its own lock taken.
+        for (Core::Sink<Endpoint>& endpoint : _endpoints) {
+            uint32_t status = endpoint.Locator()->Probe(endpoint.Source(), _retries, _interval);
+
+            if ((result != Core::ERROR_NONE) && (status != Core::ERROR_UNAVAILABLE)) {
+                result = status;
+            }
+
+            // A probe that could not start never reports back, it failed. One still in progress will.
+            if ((status != Core::ERROR_NONE) && (status != Core::ERROR_INPROGRESS)) {
+                Completed(endpoint, false);
+            }
+        }
+
+        return (result);
+    }
+
+    // Called by each locator when its probe ends. The first one with an answer decides, the others
+    // only get to record their latency.
+    void Prober::Completed(Endpoint& endpoint, const bool answered)
+    {
+        bool publish = false;
+
+        _adminLock.Lock();
+
+        endpoint.Finished(true);
+
+        if (_decided == false) {
+            if (answered == true) {
+                TRACE(Trace::Information, (_T("Location found by [%s] in %d mS"), endpoint.Source().c_str(), endpoint.Locator()->Latency()));
+
+                _published = endpoint.Locator();
+                _decided = true;
+                _cached = false;
+                publish = true;
+
+                Save(*_published);
+            } else {
+                std::list< Core::Sink<Endpoint> >::const_iterator index(_endpoints.begin());
+
+                while ((index != _endpoints.end()) && (index->IsFinished() == true)) {
+                    index++;
+                }
+
+                // Nobody could answer. A cached location stays, otherwise report what we have, like before.
+                if (index == _endpoints.end()) {
+                    _decided = true;
+
+                    if (_cached == false) {
+                        _published = endpoint.Locator();
+                        publish = true;
+                    }
+                }
+            }
+        }
+
+        _adminLock.Unlock();
+
+        if (publish == true) {
+            _update->Dispatch();
+        }
+    }
+
+    void Prober::Probes(Core::JSON::ArrayType<ProbeData>& probes) const
+    {
+        for (const Core::Sink<Endpoint>& endpoint : _endpoints) {
+            ProbeData& entry(probes.Add());
+
+            entry.Source = endpoint.Source();
+            entry.Valid = endpoint.Locator()->IsLoaded();
+            entry.Latency = endpoint.Locator()->Latency();
+        }
+    }
+
+    bool Prober::Load(const uint32_t timeToLive)
+    {
+        bool result = false;
+
+        if ((_cacheFile.empty() == false) && (_endpoints.empty() == false)) {
+            Core::File file(_cacheFile);
+
+            if (file.Open(true) == true) {
+                Cache cache;
+                Core::OptionalType<Core::JSON::Error> error;
+
+                cache.IElement::FromFile(file, error);
+
+                if (error.IsSet() == true) {
+                    SYSLOG(Logging::ParsingError, (_T("Parsing failed with %s"), ErrorDisplayMessage(error.Value()).c_str()));
+                } else if ((cache.PublicIp.Value().empty() == false) && ((cache.Updated.Value() + (static_cast<uint64_t>(timeToLive) * Core::Time::TicksPerMillisecond * 1000)) > Core::Time::Now().Ticks())) {
+                    // Not one of the locators, those get probed, and their results must not mix with this one.
+                    if (_cache == nullptr) {
+                        _cache = Core::Service<LocationService>::Create<LocationService>(nullptr);
+                    }
+
+                    _cache->Restore(cache.PublicIp.Value(), cache.TimeZone.Value(), cache.Country.Value(), cache.Region.Value(), cache.City.Value());
+
+                    _adminLock.Lock();
+                    _published = _cache;
+                    _cached = true;
+                    _adminLock.Unlock();
+
+                    result = true;
+
+                    SYSLOG(Logging::Startup, (_T("Published the cached location, ip: %s, tz: %s"), cache.PublicIp.Value().c_str(), cache.TimeZone.Value().c_str()));
+                }
+
+                file.Close();
+            }
+        }
+
+        return (result);
+    }
+
+    void Prober::Save(const LocationService& location) const
+    {
+        if (_cacheFile.empty() == false) {
+            Core::File file(_cacheFile);
+
+            if (file.Create() == true) {
+                Cache cache;
+
+                cache.PublicIp = location.PublicIPAddress();
+                cache.TimeZone = location.TimeZone();
+                cache.Region = location.Region();
+                cache.Country = location.Country();
+                cache.City = location.City();
+                cache.Updated = Core::Time::Now().Ticks();
+
+                if (cache.IElement::ToFile(file) == false) {
+                    TRACE(Trace::Warning, (_T("Could not store the location in %s"), _cacheFile.c_str()));
+                }
+
+                file.Close();
+            }
+        }
+    }
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,231 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOCATIONSYNC_PROBER_H
+#define LOCATIONSYNC_PROBER_H
+
+#include "LocationService.h"
+#include "Module.h"
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Probes all location sources at the same time and publishes the first answer. A stored location,
+    // if recent enough, is published before any of them answers.
+    class Prober {
+    public:
+        // The last location found, so a restart can publish it without waiting for the network.
+        class Cache : public Core::JSON::Container {
+        public:
+            Cache(const Cache&) = delete;
+            Cache& operator=(const Cache&) = delete;
+
+            Cache()
+                : Core::JSON::Container()
+                , PublicIp()
+                , TimeZone()
+                , Region()
+                , Country()
+                , City()
+                , Updated(0)
+            {
+                Add(_T("ip"), &PublicIp);
+                Add(_T("timezone"), &TimeZone);
+                Add(_T("region"), &Region);
+                Add(_T("country"), &Country);
+                Add(_T("city"), &City);
+                Add(_T("updated"), &Updated);
+            }
+            ~Cache()
+            {
+            }
+
+        public:
+            Core::JSON::String PublicIp;
+            Core::JSON::String TimeZone;
+            Core::JSON::String Region;
+            Core::JSON::String Country;
+            Core::JSON::String City;
+            Core::JSON::DecUInt64 Updated; // Core::Time ticks
+        };
+
+        class ProbeData : public Core::JSON::Container {
+        public:
+            ProbeData& operator=(const ProbeData&) = delete;
+
+            ProbeData()
+                : Core::JSON::Container()
+                , Source()
+                , Valid()
+                , Latency()
+            {
+                Add(_T("source"), &Source);
+                Add(_T("valid"), &Valid);
+                Add(_T("latency"), &Latency);
+            }
+            ProbeData(const ProbeData& copy)
+                : Core::JSON::Container()
+                , Source(copy.Source)
+                , Valid(copy.Valid)
+                , Latency(copy.Latency)
+            {
+                Add(_T("source"), &Source);
+                Add(_T("valid"), &Valid);
+                Add(_T("latency"), &Latency);
+            }
+            ~ProbeData()
+            {
+            }
+
+        public:
+            Core::JSON::String Source;
+            Core::JSON::Boolean Valid;
+            Core::JSON::DecUInt32 Latency;
+        };
+
+    private:
+        // Every source is probed by its own locator, they all run at the same time.
+        class Endpoint : public Core::IDispatch {
+        public:
+            Endpoint() = delete;
+            Endpoint(const Endpoint&) = delete;
+            Endpoint& operator=(const Endpoint&) = delete;
+
+#ifdef __WINDOWS__
+#pragma warning(disable : 4355)
+#endif
+            Endpoint(Prober& parent, const string& source)
+                : _parent(parent)
+                , _source(source)
+                , _finished(false)
+                , _locator(Core::Service<LocationService>::Create<LocationService>(this))
+            {
+            }
+#ifdef __WINDOWS__
+#pragma warning(default : 4355)
+#endif
+            ~Endpoint()
+            {
+                _locator->Release();
+            }
+
+        public:
+            inline const string& Source() const
+            {
+                return (_source);
+            }
+            inline LocationService* Locator()
+            {
+                return (_locator);
+            }
+            inline const LocationService* Locator() const
+            {
+                return (_locator);
+            }
+            inline bool IsFinished() const
+            {
+                return (_finished);
+            }
+            inline void Finished(const bool finished)
+            {
+                _finished = finished;
+            }
+
+        private:
+            void Dispatch() override
+            {
+                _parent.Completed(*this, _locator->IsLoaded());
+            }
+
+        private:
+            Prober& _parent;
+            const string _source;
+            bool _finished;
+            LocationService* _locator;
+        };
+
+    public:
+        Prober() = delete;
+        Prober(const Prober&) = delete;
+        Prober& operator=(const Prober&) = delete;
+
+        // The update is dispatched each time a different location gets published.
+        explicit Prober(Core::IDispatch* update)
+            : _adminLock()
+            , _interval()
+            , _retries()
+            , _endpoints()
+            , _published(nullptr)
+            , _cache(nullptr)
+            , _decided(false)
+            , _cached(false)
+            , _cacheFile()
+            , _update(update)
+        {
+            ASSERT(update != nullptr);
+        }
+        ~Prober()
+        {
+            _endpoints.clear();
+        }
+
+    public:
+        void Initialize(const std::list<string>& sources, const uint16_t interval, const uint8_t retries, const string& cacheFile, const uint32_t timeToLive);
+        void Deinitialize();
+        uint32_t Probe(const uint32_t retries, const uint32_t retryTimeSpan)
+        {
+            _interval = retryTimeSpan;
+            _retries = retries;
+
+            return (Probe());
+        }
+        void Probes(Core::JSON::ArrayType<ProbeData>& probes) const;
+
+        inline PluginHost::ISubSystem::ILocation* Location()
+        {
+            return (_published);
+        }
+        inline PluginHost::ISubSystem::IInternet* Network()
+        {
+            return (_published);
+        }
+
+    private:
+        uint32_t Probe();
+        void Completed(Endpoint& endpoint, const bool answered);
+        bool Load(const uint32_t timeToLive);
+        void Save(const LocationService& location) const;
+
+    private:
+        Core::CriticalSection _adminLock;
+        uint16_t _interval;
+        uint8_t _retries;
+        std::list< Core::Sink<Endpoint> > _endpoints;
+        LocationService* _published;
+        LocationService* _cache; // The stored location, a provisional answer until a probe gets one.
+        bool _decided;
+        bool _cached;
+        string _cacheFile;
+        Core::IDispatch* _update;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
+
+#endif // LOCATIONSYNC_PROBER_H
@@ -0,0 +1,401 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Prober.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// Runs the location prober against HTTP stand-ins for ip-api.com on 127.0.0.1, see standin.sh: a fast
+// and a slow one, one that never answers and a port nobody listens on. Checks which location gets
+// published, and when, with and without a stored location.
+
+using namespace WPEFramework;
+
+namespace {
+
+    class WorkerPool : public Core::WorkerPool {
+    private:
+        class Dispatcher : public Core::ThreadPool::IDispatcher {
+        public:
+            Dispatcher(const Dispatcher&) = delete;
+            Dispatcher& operator=(const Dispatcher&) = delete;
+
+            Dispatcher() = default;
+            ~Dispatcher() = default;
+
+        private:
+            void Initialize() override
+            {
+            }
+            void Deinitialize() override
+            {
+            }
+            void Dispatch(Core::IDispatch* job) override
+            {
+                job->Dispatch();
+            }
+        };
+
+    public:
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        WorkerPool()
+            : Core::WorkerPool(4, Core::Thread::DefaultStackSize(), 16, &_dispatcher)
+            , _dispatcher()
+        {
+            Core::IWorkerPool::Assign(this);
+            Run();
+        }
+        ~WorkerPool()
+        {
+            Stop();
+            Core::IWorkerPool::Assign(nullptr);
+        }
+
+    private:
+        Dispatcher _dispatcher;
+    };
+
+    // Answers every request like ip-api.com does, after a delay. A mute one accepts, but never answers.
+    class StandIn {
+    public:
+        StandIn() = delete;
+        StandIn(const StandIn&) = delete;
+        StandIn& operator=(const StandIn&) = delete;
+
+        StandIn(const string& timeZone, const uint32_t delay, const bool mute = false)
+            : _timeZone(timeZone)
+            , _delay(delay)
+            , _mute(mute)
+            , _socket(::socket(AF_INET, SOCK_STREAM, 0))
+            , _port(0)
+            , _thread()
+        {
+            struct sockaddr_in address;
+            socklen_t length = sizeof(address);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            if ((::bind(_socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) && (::listen(_socket, 4) == 0) && (::getsockname(_socket, reinterpret_cast<struct sockaddr*>(&address), &length) == 0)) {
+                _port = ntohs(address.sin_port);
+                _thread = std::thread([this]() { Serve(); });
+            }
+        }
+        ~StandIn()
+        {
+            ::shutdown(_socket, SHUT_RDWR);
+
+            if (_thread.joinable() == true) {
+                _thread.join();
+            }
+
+            ::close(_socket);
+        }
+
+    public:
+        string Source() const
+        {
+            return (_T("http://ip-api.com:") + Core::NumberType<uint16_t>(_port).Text() + _T("/json"));
+        }
+
+    private:
+        void Serve()
+        {
+            int connection;
+
+            while ((connection = ::accept(_socket, nullptr, nullptr)) >= 0) {
+                char buffer[1024];
+                string request;
+                ssize_t loaded;
+
+                while ((request.find("\r\n\r\n") == string::npos) && ((loaded = ::recv(connection, buffer, sizeof(buffer), 0)) > 0)) {
+                    request.append(buffer, loaded);
+                }
+
+                if (_mute == false) {
+                    const string body(_T("{\"country\":\"Netherlands\",\"region\":\"NH\",\"city\":\"Amsterdam\",\"timezone\":\"") + _timeZone + _T("\",\"query\":\"192.0.2.1\"}"));
+                    const string response(_T("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: ") + Core::NumberType<uint32_t>(static_cast<uint32_t>(body.length())).Text() + _T("\r\n\r\n") + body);
+
+                    ::usleep(_delay * 1000);
+                    ::send(connection, response.c_str(), response.length(), MSG_NOSIGNAL);
+                } else {
+                    // Keep the line open until the prober gives up.
+                    while (::recv(connection, buffer, sizeof(buffer), 0) > 0) {
+                    }
+                }
+
+                ::close(connection);
+            }
+        }
+
+    private:
+        const string _timeZone;
+        const uint32_t _delay;
+        const bool _mute;
+        int _socket;
+        uint16_t _port;
+        std::thread _thread;
+    };
+
+    class Update : public Core::IDispatch {
+    public:
+        Update(const Update&) = delete;
+        Update& operator=(const Update&) = delete;
+
+        Update()
+            : _adminLock()
+            , _signal(false, true)
+            , _count(0)
+        {
+        }
+        ~Update()
+        {
+        }
+
+    public:
+        // Waits until the location was published the given number of times.
+        bool Wait(const uint32_t count, const uint32_t waitTime)
+        {
+            const uint64_t end = Core::Time::Now().Add(waitTime).Ticks();
+
+            while ((Count() < count) && (Core::Time::Now().Ticks() < end)) {
+                _signal.Lock(100);
+                _signal.ResetEvent();
+            }
+
+            return (Count() >= count);
+        }
+        uint32_t Count() const
+        {
+            _adminLock.Lock();
+            uint32_t result = _count;
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        void Dispatch() override
+        {
+            _adminLock.Lock();
+            _count++;
+            _adminLock.Unlock();
+
+            _signal.SetEvent();
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        Core::Event _signal;
+        uint32_t _count;
+    };
+
+    uint32_t _failures = 0;
+
+    void Check(const char description[], const bool condition)
+    {
+        printf("%-64s %s\n", description, (condition == true ? "ok" : "FAILED"));
+        _failures += (condition == true ? 0 : 1);
+    }
+
+    string TimeZone(Plugin::Prober& prober)
+    {
+        return (prober.Location() != nullptr ? prober.Location()->TimeZone() : string());
+    }
+
+    uint32_t Answered(const Plugin::Prober& prober, uint32_t& count)
+    {
+        Core::JSON::ArrayType<Plugin::Prober::ProbeData> probes;
+        Core::JSON::ArrayType<Plugin::Prober::ProbeData>::Iterator index(probes.Elements());
+        uint32_t answered = 0;
+
+        prober.Probes(probes);
+
+        count = 0;
+        while (index.Next() == true) {
+            answered += (index.Current().Valid.Value() == true ? 1 : 0);
+            count++;
+        }
+
+        return (answered);
+    }
+
+    void Store(const string& cacheFile, const string& timeZone, const uint64_t updated)
+    {
+        Core::File file(cacheFile);
+
+        if (file.Create() == true) {
+            Plugin::Prober::Cache cache;
+
+            cache.PublicIp = _T("192.0.2.2");
+            cache.TimeZone = timeZone;
+            cache.Updated = updated;
+            cache.IElement::ToFile(file);
+
+            file.Close();
+        }
+    }
+
+    string Stored(const string& cacheFile)
+    {
+        Plugin::Prober::Cache cache;
+        Core::File file(cacheFile);
+
+        if (file.Open(true) == true) {
+            Core::OptionalType<Core::JSON::Error> error;
+            cache.IElement::FromFile(file, error);
+            file.Close();
+        }
+
+        return (cache.TimeZone.Value());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    char root[] = "/tmp/locationsync-XXXXXX";
+
+    if ((argc > 1) || (::mkdtemp(root) == nullptr)) {
+        printf("%s\n\tRuns against HTTP stand-ins, ip-api.com must resolve to 127.0.0.1, see standin.sh\n", argv[0]);
+        return (1);
+    }
+
+    if (Core::NodeId(_T("ip-api.com"), Core::NodeId::TYPE_IPV4).HostAddress() != _T("127.0.0.1")) {
+        printf("ip-api.com does not resolve to 127.0.0.1, run the test through standin.sh\n");
+        ::rmdir(root);
+        return (1);
+    }
+
+    // The stand-ins only listen on IPv4, do not let the locators try IPv6 first.
+    Core::NodeId::ClearIPV6Enabled();
+
+    const string cacheFile(string(root) + _T("/location.json"));
+    const string refused(_T("http://ip-api.com:1/json"));
+
+    {
+        WorkerPool pool;
+
+        {
+            StandIn slow(_T("Europe/Slow"), 800);
+            StandIn fast(_T("Europe/Fast"), 50);
+            Core::Sink<Update> update;
+            Plugin::Prober prober(&update);
+            uint32_t count;
+
+            prober.Initialize({ slow.Source(), fast.Source() }, 1, 1, cacheFile, 3600);
+
+            Check("The fastest source is published", (update.Wait(1, 2000) == true) && (TimeZone(prober) == _T("Europe/Fast")));
+            Check("Only the fastest source answered yet", (Answered(prober, count) == 1) && (count == 2));
+
+            ::usleep(1500 * 1000);
+
+            Check("The slow source answers later, but is not published", (Answered(prober, count) == 2) && (update.Count() == 1) && (TimeZone(prober) == _T("Europe/Fast")));
+            Check("The published location is stored", (Stored(cacheFile) == _T("Europe/Fast")));
+
+            prober.Probe(1, 1);
+
+            Check("A new probe round publishes again", (update.Wait(2, 2000) == true) && (TimeZone(prober) == _T("Europe/Fast")));
+
+            prober.Deinitialize();
+        }
+        {
+            StandIn mute(_T("Europe/Mute"), 0, true);
+            Core::Sink<Update> update;
+            Plugin::Prober prober(&update);
+            uint32_t count;
+
+            prober.Initialize({ mute.Source(), refused }, 1, 1, string(), 0);
+
+            Check("Without answers, nothing is published before all probes fail", (update.Wait(1, 500) == false));
+            Check("Once all probes failed, an empty location is published", (update.Wait(1, 5000) == true) && (prober.Location() != nullptr) && (TimeZone(prober).empty() == true));
+            Check("None of the probes answered", (Answered(prober, count) == 0) && (count == 2));
+
+            prober.Deinitialize();
+        }
+        {
+            Core::Sink<Update> update;
+            Plugin::Prober prober(&update);
+
+            prober.Initialize({ _T("http://unsupported.example.com/json") }, 1, 1, string(), 0);
+
+            Check("A probe that can not start, fails right away", (update.Count() == 1) && (prober.Location() != nullptr));
+
+            prober.Deinitialize();
+        }
+        {
+            Core::Sink<Update> update;
+            Plugin::Prober prober(&update);
+            uint32_t count;
+
+            prober.Initialize({ refused }, 1, 1, cacheFile, 3600);
+
+            Check("A stored location is published right away", (update.Count() == 1) && (TimeZone(prober) == _T("Europe/Fast")));
+
+            ::usleep(1500 * 1000);
+
+            Check("Failing probes leave the stored location published", (update.Count() == 1) && (TimeZone(prober) == _T("Europe/Fast")));
+            Check("The stored location is not reported as a probe", (Answered(prober, count) == 0) && (count == 1));
+
+            prober.Deinitialize();
+        }
+        {
+            StandIn other(_T("Europe/Other"), 200);
+            Core::Sink<Update> update;
+            Plugin::Prober prober(&update);
+
+            prober.Initialize({ other.Source() }, 1, 1, cacheFile, 3600);
+
+            Check("The stored location is published first", (update.Count() == 1) && (TimeZone(prober) == _T("Europe/Fast")));
+            Check("An answer replaces the stored location", (update.Wait(2, 2000) == true) && (TimeZone(prober) == _T("Europe/Other")));
+            Check("The answer is stored", (Stored(cacheFile) == _T("Europe/Other")));
+
+            prober.Deinitialize();
+        }
+        {
+            Core::Sink<Update> update;
+            Plugin::Prober prober(&update);
+
+            Store(cacheFile, _T("Europe/Stale"), Core::Time::Now().Sub(2 * 3600 * 1000).Ticks());
+
+            prober.Initialize({ refused }, 1, 1, cacheFile, 3600);
+
+            Check("A stored location past its time to live is not published", (update.Count() == 0));
+            Check("It is not published when the probes fail either", (update.Wait(1, 5000) == true) && (TimeZone(prober).empty() == true));
+
+            prober.Deinitialize();
+        }
+    }
+
+    ::unlink(cacheFile.c_str());
+    ::rmdir(root);
+
+    Core::Singleton::Dispose();
+
+    return (_failures == 0 ? 0 : 2);
+}
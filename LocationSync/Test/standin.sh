@@ -0,0 +1,51 @@
+#!/bin/sh
+
+# If not stated otherwise in this file or this component's LICENSE file the
+# following copyright and licenses apply:
+#
+# Copyright 2020 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Runs the prober test with ip-api.com resolving to 127.0.0.1, where the test starts its HTTP stand-ins.
+# /etc/hosts is only replaced in a mount namespace of the test, the system never sees it.
+#
+#   standin.sh <LocationSyncProberTest>
+
+TEST="$1"
+
+if [ -z "$TEST" ] || [ ! -x "$TEST" ]; then
+    echo "usage: $0 <LocationSyncProberTest>"
+    exit 1
+fi
+
+if ! command -v unshare > /dev/null; then
+    echo "Needs unshare, skipped"
+    exit 77
+fi
+
+HOSTS=$(mktemp /tmp/standin-hosts.XXXXXX) || exit 77
+trap 'rm -f "$HOSTS"' EXIT
+
+printf '127.0.0.1 localhost\n127.0.0.1 ip-api.com\n' > "$HOSTS"
+
+# Root can do without a user namespace, anyone else needs one to mount.
+if [ "$(id -u)" -eq 0 ]; then
+    NAMESPACES="--mount"
+else
+    NAMESPACES="--mount --map-root-user"
+fi
+
+unshare $NAMESPACES true 2> /dev/null || { echo "No mount namespace available, skipped"; exit 77; }
+
+unshare $NAMESPACES sh -c 'mount --bind "$1" /etc/hosts && exec "$2"' standin "$HOSTS" "$TEST"
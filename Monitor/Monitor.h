@@ -21,6 +21,8 @@
 #define __MONITOR_H
 
 #include "Module.h"
+#include "Schedule.h"
+#include <JSONNotification.h>
 #include <interfaces/IMemory.h>
 #include <interfaces/json/JsonData_Monitor.h>
 #include <limits>
@@ -112,12 +114,12 @@ namespace Plugin {
             }
 
         public:
-            void Measure(Exchange::IMemory* memInterface)
+            void Measure(const uint64_t resident, const uint64_t allocated, const uint64_t shared, const uint8_t processes)
             {
-                _resident.Set(memInterface->Resident());
-                _allocated.Set(memInterface->Allocated());
-                _shared.Set(memInterface->Shared());
-                _process.Set(memInterface->Processes());
+                _resident.Set(resident);
+                _allocated.Set(allocated);
+                _shared.Set(shared);
+                _process.Set(processes);
             }
             void Operational(const bool operational)
             {
@@ -472,6 +474,7 @@ namespace Plugin {
             class MonitorObject {
             public:
                 MonitorObject() = delete;
+                MonitorObject(const MonitorObject&) = delete;
                 MonitorObject& operator=(const MonitorObject&) = delete;
 
                 enum evaluation {
@@ -485,8 +488,25 @@ namespace Plugin {
                     int32_t WindowSeconds;
                 } RestartSettings;
 
+                enum check {
+                    OPERATIONAL = 0x01,
+                    MEMORY = 0x02
+                };
+
+                // What one measurement found, before it is added to the statistics.
+                struct Sample {
+                    uint8_t Checks;
+                    bool Operational;
+                    uint64_t Resident;
+                    uint64_t Allocated;
+                    uint64_t Shared;
+                    uint8_t Processes;
+                };
+
             public:
                 MonitorObject(
+                    MonitorObjects& parent,
+                    const string& callsign,
                     const bool actOnOperational,
                     const uint32_t operationalInterval,
                     const uint32_t memoryInterval,
@@ -496,7 +516,9 @@ namespace Plugin {
                     const uint8_t operationalRestartLimit,
                     const uint16_t memoryRestartWindow,
                     const uint8_t memoryRestartLimit)
-                    : _operationalInterval(operationalInterval)
+                    : _parent(parent)
+                    , _callsign(callsign)
+                    , _operationalInterval(operationalInterval)
                     , _memoryInterval(memoryInterval)
                     , _memoryThreshold(memoryThreshold * 1024)
                     , _operationalSlots(operationalInterval)
@@ -514,6 +536,9 @@ namespace Plugin {
                     , _operationalEvaluate(actOnOperational)
                     , _source(nullptr)
                     , _active{false}
+                    , _queued(false)
+                    , _pending(false)
+                    , _job(*this)
                 {
                     ASSERT((_operationalInterval != 0) || (_memoryInterval != 0));
 
@@ -523,33 +548,10 @@ namespace Plugin {
                         _interval = (_operationalInterval == 0 ? _memoryInterval : _operationalInterval);
                     }
                 }
-                MonitorObject(const MonitorObject& copy)
-                    : _operationalInterval(copy._operationalInterval)
-                    , _memoryInterval(copy._memoryInterval)
-                    , _memoryThreshold(copy._memoryThreshold)
-                    , _operationalSlots(copy._operationalSlots)
-                    , _memorySlots(copy._memorySlots)
-                    , _nextSlot(copy._nextSlot)
-                    , _operationalRestartCount(copy._operationalRestartCount)
-                    , _operationalRestartWindowStart(copy._operationalRestartWindowStart)
-                    , _memoryRestartCount(copy._memoryRestartCount)
-                    , _memoryRestartWindowStart(copy._memoryRestartWindowStart)
-                    , _operationalRestartWindow(copy._operationalRestartWindow)
-                    , _operationalRestartLimit(copy._operationalRestartLimit)
-                    , _memoryRestartWindow(copy._memoryRestartWindow)
-                    , _memoryRestartLimit(copy._memoryRestartLimit)
-                    , _measurement(copy._measurement)
-                    , _operationalEvaluate(copy._operationalEvaluate)
-                    , _source(copy._source)
-                    , _interval(copy._interval)
-                    , _active{copy._active}
-                {
-                    if (_source != nullptr) {
-                        _source->AddRef();
-                    }
-                }
                 ~MonitorObject()
                 {
+                    _job.Revoke();
+
                     if (_source != nullptr) {
                         _source->Release();
                         _source = nullptr;
@@ -663,30 +665,65 @@ namespace Plugin {
 
                     _measurement.Operational(_source != nullptr);
                 }
-                inline uint32_t Evaluate()
+                // Returns the observed interface with a reference taken, nullptr if it is not there (anymore).
+                inline Exchange::IMemory* Source() const
                 {
-                    uint32_t status(SUCCESFULL);
                     if (_source != nullptr) {
-                        _operationalSlots -= _interval;
-                        _memorySlots -= _interval;
-
-                        if ((_operationalInterval != 0) && (_operationalSlots == 0)) {
-                            bool operational = _source->IsOperational();
-                            _measurement.Operational(operational);
-                            if (operational == false) {
-                                status |= NOT_OPERATIONAL;
-                                TRACE_L1("Status not operational. %d", __LINE__);
-                            }
-                            _operationalSlots = _operationalInterval;
+                        _source->AddRef();
+                    }
+                    return (_source);
+                }
+                // Counts down the slots, returns the checks that are due in this one.
+                inline uint8_t Due()
+                {
+                    uint8_t checks = 0;
+
+                    _operationalSlots -= _interval;
+                    _memorySlots -= _interval;
+
+                    if ((_operationalInterval != 0) && (_operationalSlots == 0)) {
+                        checks |= OPERATIONAL;
+                        _operationalSlots = _operationalInterval;
+                    }
+                    if ((_memoryInterval != 0) && (_memorySlots == 0)) {
+                        checks |= MEMORY;
+                        _memorySlots = _memoryInterval;
+                    }
+
+                    return (checks);
+                }
+                // Asks the observed plugin, which may live in another process. Touches nothing of this
+                // object, so it runs without the lock of the parent.
+                static void Take(Exchange::IMemory* source, Sample& sample)
+                {
+                    if ((sample.Checks & OPERATIONAL) != 0) {
+                        sample.Operational = source->IsOperational();
+                    }
+                    if ((sample.Checks & MEMORY) != 0) {
+                        sample.Resident = source->Resident();
+                        sample.Allocated = source->Allocated();
+                        sample.Shared = source->Shared();
+                        sample.Processes = source->Processes();
+                    }
+                }
+                // Adds the sample to the measurement, under the lock of the parent.
+                inline uint32_t Evaluate(const Sample& sample)
+                {
+                    uint32_t status(SUCCESFULL);
+
+                    if ((sample.Checks & OPERATIONAL) != 0) {
+                        _measurement.Operational(sample.Operational);
+                        if (sample.Operational == false) {
+                            status |= NOT_OPERATIONAL;
+                            TRACE_L1("Status not operational. %d", __LINE__);
                         }
-                        if ((_memoryInterval != 0) && (_memorySlots == 0)) {
-                            _measurement.Measure(_source);
+                    }
+                    if ((sample.Checks & MEMORY) != 0) {
+                        _measurement.Measure(sample.Resident, sample.Allocated, sample.Shared, sample.Processes);
 
-                            if ((_memoryThreshold != 0) && (_measurement.Resident().Last() > _memoryThreshold)) {
-                                status |= EXCEEDED_MEMORY;
-                                TRACE_L1("Status MetaData Exceeded. %d", __LINE__);
-                            }
-                            _memorySlots = _memoryInterval;
+                        if ((_memoryThreshold != 0) && (_measurement.Resident().Last() > _memoryThreshold)) {
+                            status |= EXCEEDED_MEMORY;
+                            TRACE_L1("Status MetaData Exceeded. %d", __LINE__);
                         }
                     }
                     return (status);
@@ -695,7 +732,43 @@ namespace Plugin {
                 bool IsActive() const { return _active; }
                 void Active(bool active) { _active = active; }
 
+                // Whether the object has an entry in the schedule of the parent.
+                bool IsQueued() const { return _queued; }
+                void Queued(bool queued) { _queued = queued; }
+
+                inline const string& Callsign() const
+                {
+                    return (_callsign);
+                }
+                // Hands the measurement to the worker pool. A measurement that is still running when the
+                // next slot comes up is not stacked, that slot is skipped.
+                inline void Measure()
+                {
+                    if (_pending == false) {
+                        _pending = true;
+                        _job.Submit();
+                    }
+                }
+                inline void Measured()
+                {
+                    _pending = false;
+                }
+                inline void Revoke()
+                {
+                    _job.Revoke();
+                }
+
+            private:
+                friend Core::ThreadPool::JobType<MonitorObject&>;
+
+                void Dispatch()
+                {
+                    _parent.Measure(*this);
+                }
+
             private:
+                MonitorObjects& _parent;
+                const string _callsign;
                 const uint32_t _operationalInterval; //!< Interval (s) to check the monitored processes
                 const uint32_t _memoryInterval; //!<  Interval (s) for a memory measurement.
                 const uint64_t _memoryThreshold; //!< MetaData threshold in bytes for all processes.
@@ -715,6 +788,9 @@ namespace Plugin {
                 Exchange::IMemory* _source;
                 uint32_t _interval; //!< The lowest possible interval to check both memory and processes.
                 bool _active;
+                bool _queued;
+                bool _pending;
+                Core::WorkerPool::JobType<MonitorObject&> _job;
             };
 
         public:
@@ -724,6 +800,7 @@ namespace Plugin {
             MonitorObjects(Monitor* parent)
                 : _adminLock()
                 , _monitor()
+                , _schedule()
                 , _job(*this)
                 , _service(nullptr)
                 , _parent(*parent)
@@ -792,8 +869,11 @@ namespace Plugin {
                     }
                     SYSLOG(Logging::Startup, (_T("Monitoring: %s (%d,%d)."), callSign.c_str(), (interval / 1000000), (memory / 1000000)));
                     if ((interval != 0) || (memory != 0)) {
-                        _monitor.insert(
-                            std::pair<string, MonitorObject>(callSign, MonitorObject(
+                        _monitor.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(callSign),
+                            std::forward_as_tuple(
+                                *this,
+                                callSign,
 								element.Operational.Value() >= 0, 
 								interval, 
 								memory, 
@@ -802,13 +882,12 @@ namespace Plugin {
 								operationalWindow, 
 								operationalLimit, 
 								memoryWindow, 
-								memoryLimit)));
+								memoryLimit));
                     }
                 }
 
+                // Observations enter the schedule as soon as their plugin is reported active.
                 _adminLock.Unlock();
-
-                _job.Submit();
             }
             inline void Close()
             {
@@ -816,7 +895,13 @@ namespace Plugin {
 
                 _job.Revoke();
 
+                // The measurements take the lock, do not hold it while waiting for them.
+                for (std::pair<const string, MonitorObject>& entry : _monitor) {
+                    entry.second.Revoke();
+                }
+
                 _adminLock.Lock();
+                _schedule.Clear();
                 _monitor.clear();
                 _adminLock.Unlock();
                 _service->Release();
@@ -834,20 +919,20 @@ namespace Plugin {
                     PluginHost::IShell::state currentState(service->State());
 
                     if (currentState == PluginHost::IShell::ACTIVATED) {
-                        bool is_active = index->second.IsActive();
                         index->second.Active(true);
-                        if (is_active == false &&
-                            std::count_if(_monitor.begin(), _monitor.end(), [](const std::pair<string, MonitorObject>& v) {
-                                return v.second.IsActive();
-                            }) == 1) {
-
-                            // A monitor which previously was stopped restarting is being activated.
-                            // Moreover it's the only only which now becomes active. This means probing
-                            // has to be activated as well since it was stopped at point the last observee
-                            // turned inactive
-                            _job.Submit();
-
-                            TRACE(Trace::Information, (_T("Starting to probe as active observee appeared.")));
+                        if (index->second.IsQueued() == false) {
+                            bool idle = _schedule.IsEmpty();
+
+                            index->second.Retrigger(Core::Time::Now().Ticks());
+                            Queue(index->second);
+
+                            if (idle == true) {
+                                // The schedule ran empty when the last observee turned inactive, so
+                                // probing stopped. This one is the first to come back, start again.
+                                _job.Submit();
+
+                                TRACE(Trace::Information, (_T("Starting to probe as active observee appeared.")));
+                            }
                         }
 
                         // Get the MetaData interface
@@ -864,12 +949,10 @@ namespace Plugin {
                         if ((index->second.HasRestartAllowed() == true) && ((service->Reason() == PluginHost::IShell::MEMORY_EXCEEDED) || (service->Reason() == PluginHost::IShell::FAILURE))) {
                             if (index->second.RegisterRestart(service->Reason()) == false) {
                                 TRACE(Trace::Fatal, (_T("Giving up restarting of %s: Failed more than %d times within %d seconds."), service->Callsign().c_str(), index->second.RestartLimit(service->Reason()), index->second.RestartWindow(service->Reason())));
-                                const string message("{\"callsign\": \"" + service->Callsign() + "\", \"action\": \"Restart\", \"reason\":\"" + (std::to_string(index->second.RestartLimit(service->Reason()))).c_str() + " Attempts Failed within the restart window\"}");
-                                _service->Notify(message);
+                                _service->Notify(JSONNotification().String("callsign", service->Callsign()).String("action", "Restart").String("reason", std::to_string(index->second.RestartLimit(service->Reason())) + " Attempts Failed within the restart window").Data());
                                 _parent.event_action(service->Callsign(), "StoppedRestaring", std::to_string(index->second.RestartLimit(service->Reason())) + " attempts failed within the restart window");
                             } else {
-                                const string message("{\"callsign\": \"" + service->Callsign() + "\", \"action\": \"Activate\", \"reason\": \"Automatic\" }");
-                                _service->Notify(message);
+                                _service->Notify(JSONNotification().String("callsign", service->Callsign()).String("action", "Activate").String("reason", "Automatic").Data());
                                 _parent.event_action(service->Callsign(), "Activate", "Automatic");
                                 TRACE(Trace::Error, (_T("Restarting %s again because we detected it misbehaved."), service->Callsign().c_str()));
                                 Core::IWorkerPool::Instance().Submit(PluginHost::IShell::Job::Create(service, PluginHost::IShell::ACTIVATED, PluginHost::IShell::AUTOMATIC));
@@ -1003,63 +1086,89 @@ namespace Plugin {
         private:
             friend Core::ThreadPool::JobType<MonitorObjects&>;
 
-            // Dispatch can be run in an unlocked state as the destruction of the observer list
-            // is always done if the thread that calls the Dispatch is blocked (paused)
+            // Only the observations that are due are taken from the schedule, their measurements run in
+            // parallel on the worker pool as they may have to reach out to other processes.
             void Dispatch()
             {
                 uint64_t scheduledTime(Core::Time::Now().Ticks());
-                uint64_t nextSlot(static_cast<uint64_t>(~0));
 
-                std::map<string, MonitorObject>::iterator index(_monitor.begin());
+                _adminLock.Lock();
+
+                MonitorObject* due;
+
+                while ((due = _schedule.Due(scheduledTime)) != nullptr) {
+                    MonitorObject& info(*due);
 
-                // Go through the list of pending observations...
-                while (index != _monitor.end()) {
-                    MonitorObject& info(index->second);
                     if (info.IsActive() == false) {
-                        ++index;
-                        continue;
+                        // It will be queued again when the plugin is activated again.
+                        info.Queued(false);
+                    } else {
+                        info.Measure();
+                        info.Retrigger(scheduledTime + 1);
+
+                        _schedule.Queue(info.TimeSlot(), &info);
+                    }
+                }
+
+                if (_schedule.IsEmpty() == false) {
+                    uint64_t nextSlot(_schedule.Next());
+
+                    if (nextSlot < Core::Time::Now().Ticks()) {
+                        _job.Submit();
+                    } else {
+                        nextSlot += 1000 /* Add 1 ms */;
+                        _job.Schedule(nextSlot);
                     }
+                } else {
+                    TRACE(Trace::Information, (_T("Stopping to probe due to lack of active observees.")));
+                }
 
-                    if (info.TimeSlot() <= scheduledTime) {
-                        uint32_t value(info.Evaluate());
+                _adminLock.Unlock();
+            }
+            void Queue(MonitorObject& info)
+            {
+                info.Queued(true);
+                _schedule.Queue(info.TimeSlot(), &info);
+            }
+            // Runs on a worker pool thread, one job per observation.
+            void Measure(MonitorObject& info)
+            {
+                MonitorObject::Sample sample{};
 
-                        if ((value & (MonitorObject::NOT_OPERATIONAL | MonitorObject::EXCEEDED_MEMORY)) != 0) {
-                            PluginHost::IShell* plugin(_service->QueryInterfaceByCallsign<PluginHost::IShell>(index->first));
+                _adminLock.Lock();
+                Exchange::IMemory* source(info.Source());
+                if (source != nullptr) {
+                    sample.Checks = info.Due();
+                }
+                _adminLock.Unlock();
 
-                            if (plugin != nullptr) {
-                                Core::EnumerateType<PluginHost::IShell::reason> why(((value & MonitorObject::EXCEEDED_MEMORY) != 0) ? PluginHost::IShell::MEMORY_EXCEEDED : PluginHost::IShell::FAILURE);
+                // The observed plugin is asked without the lock, only the outcome is published under it.
+                if (source != nullptr) {
+                    MonitorObject::Take(source, sample);
+                    source->Release();
+                }
 
-                                const string message("{\"callsign\": \"" + plugin->Callsign() + "\", \"action\": \"Deactivate\", \"reason\": \"" + why.Data() + "\" }");
-                                SYSLOG(Trace::Fatal, (_T("FORCED Shutdown: %s by reason: %s."), plugin->Callsign().c_str(), why.Data()));
+                _adminLock.Lock();
+                uint32_t value(info.Evaluate(sample));
+                info.Measured();
+                _adminLock.Unlock();
 
-                                _service->Notify(message);
+                if ((value & (MonitorObject::NOT_OPERATIONAL | MonitorObject::EXCEEDED_MEMORY)) != 0) {
+                    PluginHost::IShell* plugin(_service->QueryInterfaceByCallsign<PluginHost::IShell>(info.Callsign()));
 
-                                _parent.event_action(plugin->Callsign(), "Deactivate", why.Data());
+                    if (plugin != nullptr) {
+                        Core::EnumerateType<PluginHost::IShell::reason> why(((value & MonitorObject::EXCEEDED_MEMORY) != 0) ? PluginHost::IShell::MEMORY_EXCEEDED : PluginHost::IShell::FAILURE);
 
-                                Core::IWorkerPool::Instance().Submit(PluginHost::IShell::Job::Create(plugin, PluginHost::IShell::DEACTIVATED, why.Value()));
+                        SYSLOG(Trace::Fatal, (_T("FORCED Shutdown: %s by reason: %s."), plugin->Callsign().c_str(), why.Data()));
 
-                                plugin->Release();
-                            }
-                        }
-                        info.Retrigger(scheduledTime);
-                    }
+                        _service->Notify(JSONNotification().String("callsign", plugin->Callsign()).String("action", "Deactivate").String("reason", why.Data()).Data());
 
-                    if (info.TimeSlot() < nextSlot) {
-                        nextSlot = info.TimeSlot();
-                    }
+                        _parent.event_action(plugin->Callsign(), "Deactivate", why.Data());
 
-                    index++;
-                }
+                        Core::IWorkerPool::Instance().Submit(PluginHost::IShell::Job::Create(plugin, PluginHost::IShell::DEACTIVATED, why.Value()));
 
-                if (nextSlot != static_cast<uint64_t>(~0)) {    
-                    if (nextSlot < Core::Time::Now().Ticks()) {
-                        _job.Submit();
-                    } else {
-                        nextSlot += 1000 /* Add 1 ms */;
-                        _job.Schedule(nextSlot);
+                        plugin->Release();
                     }
-               } else {
-                  TRACE(Trace::Information, (_T("Stopping to probe due to lack of active observees.")));
                 }
             }
 
@@ -1075,6 +1184,7 @@ namespace Plugin {
 
             Core::CriticalSection _adminLock;
             std::map<string, MonitorObject> _monitor;
+            Schedule<MonitorObject> _schedule;
             Core::WorkerPool::JobType<MonitorObjects&> _job;
             PluginHost::IShell* _service;
             Monitor& _parent;
@@ -0,0 +1,98 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Elements ordered on their next time slot, the earliest on top, so a wakeup only has to look at
+    // the ones that are due. The elements are not owned.
+    template <typename ELEMENT>
+    class Schedule {
+    private:
+        typedef std::pair<uint64_t, ELEMENT*> Slot;
+
+        struct Later {
+            bool operator()(const Slot& lhs, const Slot& rhs) const
+            {
+                return (lhs.first > rhs.first);
+            }
+        };
+
+    public:
+        Schedule(const Schedule&) = delete;
+        Schedule& operator=(const Schedule&) = delete;
+
+        Schedule()
+            : _slots()
+        {
+        }
+        ~Schedule()
+        {
+        }
+
+    public:
+        inline bool IsEmpty() const
+        {
+            return (_slots.empty());
+        }
+        inline uint32_t Size() const
+        {
+            return (static_cast<uint32_t>(_slots.size()));
+        }
+        // The earliest slot, only valid if the schedule is not empty.
+        inline uint64_t Next() const
+        {
+            return (_slots.front().first);
+        }
+        void Queue(const uint64_t slot, ELEMENT* element)
+        {
+            _slots.emplace_back(slot, element);
+            std::push_heap(_slots.begin(), _slots.end(), Later());
+        }
+        // Takes out the earliest element if its slot is at, or before, the given time, nullptr otherwise.
+        ELEMENT* Due(const uint64_t time)
+        {
+            ELEMENT* result = nullptr;
+
+            if ((_slots.empty() == false) && (_slots.front().first <= time)) {
+                std::pop_heap(_slots.begin(), _slots.end(), Later());
+                result = _slots.back().second;
+                _slots.pop_back();
+            }
+
+            return (result);
+        }
+        void Clear()
+        {
+            _slots.clear();
+        }
+
+    private:
+        std::vector<Slot> _slots;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,227 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Schedule.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Simulates the schedule of the Monitor with hundreds of observees at different intervals, on a
+// simulated clock, the way MonitorObjects::Dispatch drives it. Part of them is deactivated halfway
+// and activated again later. Prints how many entries the wakeups touched, against a full scan.
+
+using namespace WPEFramework;
+
+namespace {
+
+    struct Options {
+        Options()
+            : Observees(500)
+            , Duration(600)
+        {
+        }
+
+        uint32_t Observees;
+        uint32_t Duration;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-observees") == 0)) {
+                options.Observees = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-duration") == 0)) {
+                options.Duration = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Observees < 4) || (options.Duration < 4));
+    }
+
+    void ShowHelp()
+    {
+        printf("MonitorScheduleTest [options]\n"
+               "\t-observees <count>        Observees to simulate, at least 4 [500]\n"
+               "\t-duration <seconds>       Simulated time, at least 4 [600]\n");
+    }
+
+    uint32_t _failures = 0;
+
+    void Check(const char description[], const bool condition)
+    {
+        printf("%-64s %s\n", description, (condition == true ? "ok" : "FAILED"));
+        _failures += (condition == true ? 0 : 1);
+    }
+
+    // Stands in for a MonitorObject, all times in seconds.
+    struct Observee {
+        uint64_t Interval;
+        uint64_t Slot;
+        bool Active;
+        bool Queued;
+        uint32_t Measured;
+
+        void Retrigger(const uint64_t current)
+        {
+            while (Slot < current) {
+                Slot += Interval;
+            }
+        }
+    };
+
+    // Measurements in the slots at, or after, from and before until, for an observee that started at 0.
+    uint32_t Slots(const uint64_t interval, const uint64_t from, const uint64_t until)
+    {
+        return (static_cast<uint32_t>(((until + interval - 1) / interval) - ((from + interval - 1) / interval)));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    static const uint64_t Intervals[] = { 1, 2, 3, 5, 10, 30, 60 };
+
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    std::vector<Observee> observees(options.Observees);
+    Plugin::Schedule<Observee> schedule;
+
+    const uint64_t deactivation = options.Duration / 2;
+    const uint64_t activation = (options.Duration * 3) / 4;
+
+    for (uint32_t index = 0; index < observees.size(); index++) {
+        Observee& observee(observees[index]);
+
+        observee.Interval = Intervals[index % (sizeof(Intervals) / sizeof(Intervals[0]))];
+        observee.Slot = 0;
+        observee.Active = true;
+        observee.Queued = true;
+        observee.Measured = 0;
+
+        schedule.Queue(observee.Slot, &observee);
+    }
+
+    Check("All observees are queued", (schedule.Size() == observees.size()));
+
+    uint64_t now = 0;
+    uint64_t previous = 0;
+    uint32_t wakeups = 0;
+    uint32_t touched = 0;
+    bool onlyDue = true;
+    bool allDue = true;
+    bool ordered = true;
+    bool deactivated = false;
+    bool activated = false;
+
+    while ((schedule.IsEmpty() == false) && (schedule.Next() <= options.Duration)) {
+        now = schedule.Next();
+
+        // Every fourth observee is deactivated halfway, and activated again later, like StateChange does.
+        if ((deactivated == false) && (now >= deactivation)) {
+            for (uint32_t index = 0; index < observees.size(); index += 4) {
+                observees[index].Active = false;
+            }
+            deactivated = true;
+        }
+        if ((activated == false) && (now >= activation)) {
+            for (uint32_t index = 0; index < observees.size(); index += 4) {
+                Observee& observee(observees[index]);
+
+                observee.Active = true;
+                if (observee.Queued == false) {
+                    observee.Retrigger(activation);
+                    observee.Queued = true;
+                    schedule.Queue(observee.Slot, &observee);
+                }
+            }
+            activated = true;
+            now = schedule.Next();
+        }
+
+        uint32_t due = 0;
+        for (const Observee& observee : observees) {
+            due += (((observee.Queued == true) && (observee.Slot <= now)) ? 1 : 0);
+        }
+
+        uint32_t taken = 0;
+        Observee* entry;
+
+        while ((entry = schedule.Due(now)) != nullptr) {
+            onlyDue = onlyDue && (entry->Slot <= now);
+            ordered = ordered && (entry->Slot >= previous);
+            previous = entry->Slot;
+            taken++;
+
+            if (entry->Active == false) {
+                entry->Queued = false;
+            } else {
+                entry->Measured++;
+                entry->Retrigger(now + 1);
+                schedule.Queue(entry->Slot, entry);
+            }
+        }
+
+        allDue = allDue && (taken == due);
+        touched += taken;
+        wakeups++;
+    }
+
+    Check("A wakeup only takes out observees that are due", (onlyDue == true));
+    Check("A wakeup takes out all observees that are due", (allDue == true));
+    Check("Observees come out in the order of their slots", (ordered == true));
+
+    bool always = true;
+    bool paused = true;
+    uint32_t inactive = 0;
+
+    for (uint32_t index = 0; index < observees.size(); index++) {
+        const Observee& observee(observees[index]);
+
+        if ((index % 4) != 0) {
+            always = always && (observee.Measured == Slots(observee.Interval, 0, options.Duration + 1));
+        } else {
+            const uint64_t resumed = ((activation + observee.Interval - 1) / observee.Interval) * observee.Interval;
+
+            paused = paused && (observee.Measured == (Slots(observee.Interval, 0, deactivation) + Slots(observee.Interval, resumed, options.Duration + 1)));
+            inactive += (observee.Queued == false ? 1 : 0);
+        }
+    }
+
+    Check("Active observees are measured once in each of their slots", (always == true));
+    Check("Deactivated observees are skipped until they are activated", (paused == true));
+    Check("Activated observees are queued again", (inactive == 0) && (schedule.Size() == observees.size()));
+
+    printf("observees,duration,wakeups,touched,scanned\n");
+    printf("%u,%u,%u,%u,%llu\n", options.Observees, options.Duration, wakeups, touched,
+        static_cast<unsigned long long>(wakeups) * options.Observees);
+
+    return (_failures == 0 ? 0 : 2);
+}
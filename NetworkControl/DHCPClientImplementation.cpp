@@ -37,11 +37,13 @@ namespace Plugin {
         return (Core::NodeId(sockaddr_broadcast));
     }
 
-    DHCPClientImplementation::DHCPClientImplementation(const string& interfaceName, DiscoverCallback discoverCallback, RequestCallback claimCallback)
+    DHCPClientImplementation::DHCPClientImplementation(const string& interfaceName, const bool rapidCommit, DiscoverCallback discoverCallback, RequestCallback claimCallback)
         : Core::SocketDatagram(false, Core::NodeId(_T("0.0.0.0"), DefaultDHCPClientPort, Core::NodeId::TYPE_IPV4), RemoteAddress(), 1024, 2048)
         , _adminLock()
         , _interfaceName(interfaceName)
         , _state(IDLE)
+        , _modus(CLASSIFICATION_INVALID)
+        , _rapidCommit(rapidCommit)
         , _serverIdentifier(0)
         , _xid(0)
         , _preferred()
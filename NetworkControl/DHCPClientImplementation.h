@@ -76,6 +76,7 @@ namespace Plugin {
             OPTION_RENEWALTIME = 58,
             OPTION_REBINDINGTIME = 59,
             OPTION_CLIENTIDENTIFIER = 61,
+            OPTION_RAPIDCOMMIT = 80, // RFC 4039
             OPTION_END = 255,
         };
 
@@ -173,6 +174,7 @@ namespace Plugin {
                 , leaseTime()
                 , renewalTime()
                 , rebindingTime()
+                , rapidCommit(false)
             {
             }
 
@@ -185,6 +187,7 @@ namespace Plugin {
                 , leaseTime()
                 , renewalTime()
                 , rebindingTime()
+                , rapidCommit(false)
             {
                 FromRAW(optionsData, length);    
             }
@@ -263,6 +266,9 @@ namespace Plugin {
                         ::memcpy(&rebindingTime, &optionsData[used], sizeof(rebindingTime));
                         rebindingTime = ntohl(rebindingTime);
                         break;
+                    case OPTION_RAPIDCOMMIT:
+                        rapidCommit = true;
+                        break;
                     }
 
                     /* move on to the next option. */
@@ -280,6 +286,7 @@ namespace Plugin {
             Core::OptionalType<uint32_t> leaseTime; /* lease time in seconds */
             Core::OptionalType<uint32_t> renewalTime; /* renewal time in seconds */
             Core::OptionalType<uint32_t> rebindingTime; /* rebinding time in seconds */
+            bool rapidCommit; /* the ACK answers a DISCOVER directly */
         };
 
         class Offer {
@@ -519,6 +526,12 @@ namespace Plugin {
             {
                 return _id;
             }
+            // Starts a new transaction for this offer, as the id pairs the answer with the offer.
+            uint32_t Renew()
+            {
+                Crypto::Random(_id);
+                return (_id);
+            }
             bool IsValid() const
             {
                 return (_offer.IsValid());
@@ -579,7 +592,7 @@ namespace Plugin {
         typedef std::function<void(Offer&, bool)> RequestCallback;
 
     public:
-        DHCPClientImplementation(const string& interfaceName, DiscoverCallback discoverCallback, RequestCallback claimCallback);
+        DHCPClientImplementation(const string& interfaceName, const bool rapidCommit, DiscoverCallback discoverCallback, RequestCallback claimCallback);
         virtual ~DHCPClientImplementation();
 
     public:
@@ -642,39 +655,13 @@ namespace Plugin {
         }
 
         uint32_t Request(const Offer& offer) {
+            return (Request(offer, false));
+        }
 
-            uint32_t result = Core::ERROR_INPROGRESS;
-
-            _adminLock.Lock();
-            if (SocketDatagram::IsOpen() == true
-                || SocketDatagram::Open(Core::infinite, _interfaceName) == Core::ERROR_NONE) {
-
-                SocketDatagram::Broadcast(true);
-
-                if (_state == RECEIVING || _state == IDLE) {
-                    TRACE(Trace::Information, ("Sending REQUEST for %s", offer.Address().HostAddress().c_str()));
-                    _state = SENDING;
-                    _modus = CLASSIFICATION_REQUEST;
-                    _preferred = offer.Address();
-                    // Use offer id as transaction id to pair request with correct response
-                    _xid = offer.Id(); 
-
-                    if (offer.Source().IsEmpty() == false) {
-                        auto addr = reinterpret_cast<const sockaddr_in*>(static_cast<const struct sockaddr*>(offer.Source()));
-                        
-                        memcpy(&_serverIdentifier, &(addr->sin_addr), 4);
-                    }
-
-                    result = Core::ERROR_NONE;
-                    SocketDatagram::Trigger();
-                }
-            } else {
-                TRACE_L1("Failed to open socket whilte trying to request ip %s\n", offer.Address().HostAddress().c_str());
-            }
-
-            _adminLock.Unlock();
-
-            return (result);
+        /* INIT-REBOOT (RFC 2131 section 4.3.2): confirm a previously leased address without a DISCOVER
+           round trip. The server identifier is left out, any server that knows the network may answer. */
+        uint32_t Reboot(const Offer& offer) {
+            return (Request(offer, true));
         }
 
         inline uint32_t Decline(const Core::NodeId& acknowledged)
@@ -795,6 +782,57 @@ namespace Plugin {
             return _leasedOffer;
         }
 
+        uint32_t Request(const Offer& offer, const bool reboot) {
+
+            uint32_t result = Core::ERROR_INPROGRESS;
+
+            _adminLock.Lock();
+            if (SocketDatagram::IsOpen() == true
+                || SocketDatagram::Open(Core::infinite, _interfaceName) == Core::ERROR_NONE) {
+
+                SocketDatagram::Broadcast(true);
+
+                if (_state == RECEIVING || _state == IDLE) {
+                    TRACE(Trace::Information, ("Sending %s for %s", (reboot ? "INIT-REBOOT REQUEST" : "REQUEST"), offer.Address().HostAddress().c_str()));
+                    _state = SENDING;
+                    _modus = CLASSIFICATION_REQUEST;
+                    _preferred = offer.Address();
+                    _serverIdentifier = 0;
+
+                    if (reboot == true) {
+                        // A new transaction, like a DISCOVER: never reuse an xid from an earlier boot. The offer
+                        // is re-keyed with it, so the answer is still paired with the persisted lease.
+                        const uint32_t id = offer.Id();
+                        auto entry = std::find_if(_unleasedOffers.begin(), _unleasedOffers.end(), [id](Offer& o) {return o.Id() == id;});
+
+                        if (entry != _unleasedOffers.end()) {
+                            _xid = entry->Renew();
+                        } else {
+                            Crypto::Random(_xid);
+                        }
+                    } else {
+                        // Use offer id as transaction id to pair request with correct response
+                        _xid = offer.Id(); 
+                    }
+
+                    if ((reboot == false) && (offer.Source().IsEmpty() == false)) {
+                        auto addr = reinterpret_cast<const sockaddr_in*>(static_cast<const struct sockaddr*>(offer.Source()));
+                        
+                        memcpy(&_serverIdentifier, &(addr->sin_addr), 4);
+                    }
+
+                    result = Core::ERROR_NONE;
+                    SocketDatagram::Trigger();
+                }
+            } else {
+                TRACE_L1("Failed to open socket whilte trying to request ip %s\n", offer.Address().HostAddress().c_str());
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
         uint16_t Message(uint8_t stream[], const uint16_t length) const
         {
 
@@ -862,6 +900,12 @@ namespace Plugin {
                 options[index++] = OPTION_ROUTER;
                 options[index++] = OPTION_DNS;
                 options[index++] = OPTION_BROADCASTADDRESS;
+
+                if (_rapidCommit == true) {
+                    // Offer to skip the OFFER/REQUEST exchange, servers that support it ACK right away.
+                    options[index++] = OPTION_RAPIDCOMMIT;
+                    options[index++] = 0;
+                }
             } else if (_modus == CLASSIFICATION_REQUEST) {
                 // required for usage in bridged networks
                 if (_serverIdentifier != 0) {
@@ -911,7 +955,12 @@ namespace Plugin {
                         {
                             Iterator offer = FindUnleasedOffer(xid);
                                         
-                            if (offer.IsValid()) {
+                            if ((offer.IsValid() == false) && (xid == _discoverXID) && (_modus == CLASSIFICATION_DISCOVER) && (options.rapidCommit == true)) {
+                                // Rapid commit (RFC 4039), the ACK is the answer to our DISCOVER, the lease is ours.
+                                TRACE(Trace::Information, ("Received a rapid commit ACK from: %s", source.HostAddress().c_str()));
+                                Offer& leased = MakeLeased(Offer(source, frame, options));
+                                _claimCallback(leased, true);
+                            } else if (offer.IsValid()) {
                                 offer.Current().Update(options); // Update if informations changed since offering
                                 
                                 Offer& leased = MakeLeased(offer.Current());
@@ -944,6 +993,7 @@ namespace Plugin {
         string _interfaceName;
         state _state;
         classifications _modus;
+        const bool _rapidCommit;
         uint8_t _MAC[6];
         mutable uint32_t _serverIdentifier;
         mutable uint32_t _xid;
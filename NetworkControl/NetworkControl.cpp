@@ -81,6 +81,7 @@ namespace Plugin
         , _service(nullptr)
         , _responseTime(0)
         , _retries(0)
+        , _rapidCommit(true)
         , _persistentStoragePath()
         , _dns()
         , _interfaces()
@@ -108,6 +109,7 @@ namespace Plugin
         _skipURL = static_cast<uint8_t>(service->WebPrefix().length());
         _responseTime = config.TimeOut.Value();
         _retries = config.Retries.Value();
+        _rapidCommit = config.RapidCommit.Value();
         _dnsFile = config.DNSFile.Value();
 
         // We will only "open" the DNS resolve file, so of ot does not exist yet, create an empty file.
@@ -129,55 +131,43 @@ namespace Plugin
             }
         }
 
+        std::list<const Entry*> pending;
         Core::JSON::ArrayType<Entry>::Iterator index(config.Interfaces.Elements());
 
         while (index.Next() == true) {
             if (index.Current().Interface.IsSet() == true) {
-                string interfaceName(index.Current().Interface.Value());
-                Core::AdapterIterator adapter;
-                uint8_t retries = (_responseTime * 2);
+                pending.push_back(&(index.Current()));
+            }
+        }
 
-                // Some interfaces take some time, to be available. Wait a certain amount
-                // of time in which the interface should come up.
-                do {
-                    adapter = Core::AdapterIterator(interfaceName);
+        // Some interfaces take some time, to be available. Wait a certain amount of time in which the
+        // interfaces should come up. They are waited for together and each one is activated as soon as it
+        // is there, so the DHCP exchanges of all interfaces run side by side.
+        uint8_t retries = (_responseTime * 2);
 
-                    if (adapter.IsValid() == false) {
-                        Core::AdapterIterator::Flush();
-                        SleepMs(500);
-                    }
+        while (pending.empty() == false) {
+            std::list<const Entry*>::iterator entry(pending.begin());
 
-                } while ((retries-- != 0) && (adapter.IsValid() == false));
+            while (entry != pending.end()) {
+                Core::AdapterIterator adapter((*entry)->Interface.Value());
 
-                if (adapter.IsValid() == false) {
-                    SYSLOG(Logging::Startup, (_T("Interface [%s], not available"), interfaceName.c_str()));
+                if (adapter.IsValid() == true) {
+                    Activate(adapter, **entry);
+                    entry = pending.erase(entry);
                 } else {
+                    entry++;
+                }
+            }
 
-                    adapter.Up(true);
-
-                    auto dhcpInterface = _dhcpInterfaces.emplace(std::piecewise_construct,
-                        std::make_tuple(interfaceName),
-                        std::make_tuple(Core::ProxyType<DHCPEngine>::Create(this, interfaceName, _persistentStoragePath)));
-                    _interfaces.emplace(std::piecewise_construct,
-                        std::make_tuple(interfaceName),
-                        std::make_tuple(index.Current()));
-
-                    JsonData::NetworkControl::NetworkData::ModeType how(index.Current().Mode);
-                    if (how == JsonData::NetworkControl::NetworkData::ModeType::MANUAL) {
-                        SYSLOG(Logging::Startup, (_T("Interface [%s] activated, no IP associated"), interfaceName.c_str()));
-                    } else {
-                        if (how == JsonData::NetworkControl::NetworkData::ModeType::DYNAMIC) {
-                            if (dhcpInterface.first->second->LoadLeases() == true) {
-                                SYSLOG(Logging::Startup, (_T("Leased list for interface [%s] loaded!"), interfaceName.c_str()));
-                            }
-
-                            SYSLOG(Logging::Startup, (_T("Interface [%s] activated, DHCP request issued"), interfaceName.c_str()));
-                            Reload(interfaceName, true);
-                        } else {
-                            SYSLOG(Logging::Startup, (_T("Interface [%s] activated, static IP assigned"), interfaceName.c_str()));
-                            Reload(interfaceName, false);
-                        }
+            if (pending.empty() == false) {
+                if (retries-- == 0) {
+                    for (const Entry* info : pending) {
+                        SYSLOG(Logging::Startup, (_T("Interface [%s], not available"), info->Interface.Value().c_str()));
                     }
+                    pending.clear();
+                } else {
+                    Core::AdapterIterator::Flush();
+                    SleepMs(500);
                 }
             }
         }
@@ -438,10 +428,9 @@ namespace Plugin
             
             Core::AdapterIterator::Flush();
 
-            string message(string("{ \"interface\": \"") + adapter.Name() + string("\", \"status\":0, \"ip\":\"" + ipAddress.HostAddress() + "\" }"));
             TRACE(Trace::Information, (_T("DHCP Request set on: %s"), adapter.Name().c_str()));
 
-            _service->Notify(message); 
+            _service->Notify(JSONNotification().String("interface", adapter.Name()).Number("status", 0).String("ip", ipAddress.HostAddress()).Data());
         }
 
         return (Core::ERROR_NONE);
@@ -487,8 +476,11 @@ namespace Plugin
                 DHCPClientImplementation::Offer::JSON lease;
                 Core::OptionalType<Core::JSON::Error> error;
                 if (lease.IElement::FromFile(leaseFile, error) == true) {
+                    DHCPClientImplementation::Offer offer(lease.Get());
 
-                    _client.AddUnleasedOffer(lease.Get());
+                    // Remember it, the first request for this lease is an INIT-REBOOT.
+                    _lease = offer.Id();
+                    _client.AddUnleasedOffer(offer);
                 }
 
                 if (error.IsSet() == true) {
@@ -504,6 +496,42 @@ namespace Plugin
         return result;
     }
 
+    void NetworkControl::Activate(Core::AdapterIterator& adapter, const Entry& info)
+    {
+        const string interfaceName(info.Interface.Value());
+
+        adapter.Up(true);
+
+        // The DHCP exchanges of interfaces activated earlier are already running, and use these maps.
+        _adminLock.Lock();
+
+        auto dhcpInterface = _dhcpInterfaces.emplace(std::piecewise_construct,
+            std::make_tuple(interfaceName),
+            std::make_tuple(Core::ProxyType<DHCPEngine>::Create(this, interfaceName, _persistentStoragePath)));
+        _interfaces.emplace(std::piecewise_construct,
+            std::make_tuple(interfaceName),
+            std::make_tuple(info));
+
+        JsonData::NetworkControl::NetworkData::ModeType how(info.Mode.Value());
+        if (how == JsonData::NetworkControl::NetworkData::ModeType::MANUAL) {
+            SYSLOG(Logging::Startup, (_T("Interface [%s] activated, no IP associated"), interfaceName.c_str()));
+        } else {
+            if (how == JsonData::NetworkControl::NetworkData::ModeType::DYNAMIC) {
+                if (dhcpInterface.first->second->LoadLeases() == true) {
+                    SYSLOG(Logging::Startup, (_T("Leased list for interface [%s] loaded!"), interfaceName.c_str()));
+                }
+
+                SYSLOG(Logging::Startup, (_T("Interface [%s] activated, DHCP request issued"), interfaceName.c_str()));
+                Reload(interfaceName, true);
+            } else {
+                SYSLOG(Logging::Startup, (_T("Interface [%s] activated, static IP assigned"), interfaceName.c_str()));
+                Reload(interfaceName, false);
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
     uint32_t NetworkControl::Reload(const string& interfaceName, const bool dynamic)
     {
 
@@ -746,10 +774,9 @@ namespace Plugin
 
         if (index != _dhcpInterfaces.end()) {
 
-            string message(string("{ \"interface\": \"") + index->first + string("\", \"status\":11 }"));
             TRACE(Trace::Information, (_T("DHCP Request timed out on: %s"), index->first.c_str()));
 
-            _service->Notify(message);
+            _service->Notify(JSONNotification().String("interface", index->first).Number("status", 11).Data());
 
             // We can close the port now
             index->second->Completed();
@@ -837,13 +864,16 @@ namespace Plugin
 
     void NetworkControl::Activity(const string& interfaceName)
     {
-        string message;
         Core::AdapterIterator adapter(interfaceName);
         JsonData::NetworkControl::ConnectionchangeParamsData::StatusType status;
+        bool running = false;
+        bool up = false;
+        const char* event;
 
         if (adapter.IsValid() == true) {
             // Send a message with the state of the adapter.
-            message = string(_T("{ \"interface\": \"")) + interfaceName + string(_T("\", \"running\": \"")) + string(adapter.IsRunning() ? _T("true") : _T("false")) + string(_T("\", \"up\": \"")) + string(adapter.IsUp() ? _T("true") : _T("false")) + _T("\", \"event\": \"");
+            running = adapter.IsRunning();
+            up = adapter.IsUp();
             TRACE(Trace::Information, (_T("Adapter change report on: %s"), interfaceName.c_str()));
 
             _adminLock.Lock();
@@ -856,12 +886,12 @@ namespace Plugin
                     std::make_tuple(interfaceName),
                     std::make_tuple(StaticInfo()));
 
-                message += _T("Create\" }");
+                event = "Create";
 
                 TRACE(Trace::Information, (_T("Added interface: %s"), interfaceName.c_str()));
                 status = JsonData::NetworkControl::ConnectionchangeParamsData::StatusType::CREATED;
             } else {
-                message += _T("Update\" }");
+                event = "Update";
                 status = JsonData::NetworkControl::ConnectionchangeParamsData::StatusType::UPDATED;
                 TRACE(Trace::Information, (_T("Updated interface: %s"), interfaceName.c_str()));
             }
@@ -899,10 +929,10 @@ namespace Plugin
             TRACE(Trace::Information, (_T("Removed interface: %s"), interfaceName.c_str()));
             status = JsonData::NetworkControl::ConnectionchangeParamsData::StatusType::REMOVED;
 
-            message = string(_T("{ \"interface\": \"")) + interfaceName + string(_T("\", \"running\": \"false\", \"up\": \"false\", \"event\": \"Delete\" }"));
+            event = "Delete";
         }
 
-        _service->Notify(message);
+        _service->Notify(JSONNotification().String("interface", interfaceName).String("running", (running ? "true" : "false")).String("up", (up ? "true" : "false")).String("event", event).Data());
         event_connectionchange(interfaceName.c_str(), string(), status);
     }
 
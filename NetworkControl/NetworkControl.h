@@ -23,6 +23,7 @@
 #include "DHCPClientImplementation.h"
 #include "Module.h"
 
+#include <JSONNotification.h>
 #include <interfaces/IIPNetwork.h>
 #include <interfaces/json/JsonData_NetworkControl.h> 
 
@@ -211,6 +212,7 @@ namespace Plugin {
                 , TimeOut(5)
                 , Retries(4)
                 , Open(true)
+                , RapidCommit(true)
             {
                 Add(_T("dnsfile"), &DNSFile);
                 Add(_T("interfaces"), &Interfaces);
@@ -218,6 +220,7 @@ namespace Plugin {
                 Add(_T("retries"), &Retries);
                 Add(_T("open"), &Open);
                 Add(_T("dns"), &DNS);
+                Add(_T("rapidcommit"), &RapidCommit);
             }
             ~Config()
             {
@@ -230,6 +233,7 @@ namespace Plugin {
             Core::JSON::DecUInt8 TimeOut;
             Core::JSON::DecUInt8 Retries;
             Core::JSON::Boolean Open;
+            Core::JSON::Boolean RapidCommit;
         };
 
         class StaticInfo {
@@ -304,6 +308,12 @@ namespace Plugin {
             DHCPClientImplementation::Offer _offer;
         };
         class DHCPEngine : public Core::IDispatch {
+        private:
+            // RFC 2131 section 4.1, retransmissions back off up to this interval (in ms).
+            static constexpr uint32_t MaxBackoff = 64000;
+            // An INIT-REBOOT that is not answered quickly falls back to a full discovery.
+            static constexpr uint8_t RebootRetries = 1;
+
         private:
             DHCPEngine() = delete;
             DHCPEngine(const DHCPEngine&) = delete;
@@ -316,7 +326,9 @@ namespace Plugin {
             DHCPEngine(NetworkControl* parent, const string& interfaceName, const string& persistentStoragePath)
                 : _parent(*parent)
                 , _retries(0)
-                , _client(interfaceName, std::bind(&DHCPEngine::NewOffer, this, std::placeholders::_1), 
+                , _attempt(0)
+                , _lease(0)
+                , _client(interfaceName, parent->RapidCommit(), std::bind(&DHCPEngine::NewOffer, this, std::placeholders::_1), 
                           std::bind(&DHCPEngine::RequestResult, this, std::placeholders::_1, std::placeholders::_2))
                 , _leaseFilePath((persistentStoragePath.empty()) ? "" :  (persistentStoragePath + _client.Interface() + ".json"))
             {
@@ -344,7 +356,7 @@ namespace Plugin {
 
             inline uint32_t Discover(const Core::NodeId& preferred)
             {
-                ResetWatchdog();
+                ResetWatchdog(_parent.Retries());
                 uint32_t result = _client.Discover(preferred);
 
                 return (result);
@@ -360,7 +372,14 @@ namespace Plugin {
 
                 auto offerIterator = _client.UnleasedOffers();
                 if (offerIterator.Next() == true) {
-                    Request(offerIterator.Current());
+                    if (offerIterator.Current().Id() == _lease) {
+                        // The persisted lease, only worth one quick attempt.
+                        _lease = 0;
+                        ResetWatchdog(RebootRetries);
+                        _client.Reboot(offerIterator.Current());
+                    } else {
+                        Request(offerIterator.Current());
+                    }
                 } else {
                     Discover(preferred);
                 }
@@ -389,7 +408,7 @@ namespace Plugin {
 
             inline void Request(const DHCPClientImplementation::Offer& offer) {
 
-                ResetWatchdog();
+                ResetWatchdog(_parent.Retries());
                 _client.Request(offer);
             }
 
@@ -406,12 +425,26 @@ namespace Plugin {
                 _client.RemoveUnleasedOffer(offer);
             }
 
-            void SetupWatchdog() 
+            // RFC 2131 section 4.1: the delay doubles with every retransmission, up to 64 seconds, and is
+            // randomized by a second either way, so clients that booted together do not stay in lock step.
+            uint32_t Backoff() const
             {
-                const uint16_t responseMS = _parent.ResponseTime() * 1000;
-                Core::Time entry(Core::Time::Now().Add(responseMS));
-                _retries = _parent.Retries();
+                const uint32_t initial = _parent.ResponseTime() * 1000;
+                const uint32_t scaled = (_attempt < 7 ? (initial << _attempt) : MaxBackoff);
+                const uint32_t delay = (scaled < MaxBackoff ? scaled : MaxBackoff);
+                uint16_t jitter;
+
+                Crypto::Random(jitter);
+
+                return (delay > 1000 ? (delay - 1000 + (jitter % 2001)) : delay);
+            }
 
+            void SetupWatchdog(const uint8_t retries) 
+            {
+                _attempt = 0;
+                _retries = retries;
+
+                Core::Time entry(Core::Time::Now().Add(Backoff()));
                 Core::ProxyType<Core::IDispatch> job(*this);    
 
                 // Submit a job, as watchdog.
@@ -423,10 +456,10 @@ namespace Plugin {
                 Core::IWorkerPool::Instance().Revoke(Core::ProxyType<Core::IDispatch>(*this));
             }
 
-            inline void ResetWatchdog() 
+            inline void ResetWatchdog(const uint8_t retries) 
             {
                 StopWatchdog();
-                SetupWatchdog();
+                SetupWatchdog(retries);
             }
 
             void CleanUp() 
@@ -438,8 +471,9 @@ namespace Plugin {
             virtual void Dispatch() override
             {
                 if (_retries > 0) {
-                    const uint16_t responseMS = _parent.ResponseTime() * 1000;
-                    Core::Time entry(Core::Time::Now().Add(responseMS));
+                    _attempt++;
+
+                    Core::Time entry(Core::Time::Now().Add(Backoff()));
                     Core::ProxyType<Core::IDispatch> job(*this);
 
                     _retries--;
@@ -471,6 +505,8 @@ namespace Plugin {
         private:
             NetworkControl& _parent;
             uint8_t _retries;
+            uint8_t _attempt;
+            uint32_t _lease; // Offer id of the persisted lease, until it has been tried
             DHCPClientImplementation _client;
             string _leaseFilePath;
         };
@@ -512,6 +548,7 @@ namespace Plugin {
         virtual uint32_t RemoveDNS(IIPNetwork::IDNSServers* dnsEntries) override;
 
     private:
+        void Activate(Core::AdapterIterator& adapter, const Entry& info);
         uint32_t Reload(const string& interfaceName, const bool dynamic);
         uint32_t SetIP(Core::AdapterIterator& adapter, const Core::IPNode& ipAddress, const Core::NodeId& gateway, const Core::NodeId& broadcast, bool clearOld = false);
         bool NewOffer(const string& interfaceName, const DHCPClientImplementation::Offer& offer);
@@ -529,6 +566,10 @@ namespace Plugin {
         {
             return (_retries);
         }
+        inline bool RapidCommit() const
+        {
+            return (_rapidCommit);
+        }
         void ClearAssignedIPV4IPs(Core::AdapterIterator& adapter);
         void ClearAssignedIPV6IPs(Core::AdapterIterator& adapter);
 
@@ -549,6 +590,7 @@ namespace Plugin {
         PluginHost::IShell* _service;
         uint8_t _responseTime;
         uint8_t _retries;
+        bool _rapidCommit;
         string _dnsFile;
         string _persistentStoragePath;
         std::list<std::pair<uint16_t, Core::NodeId>> _dns;
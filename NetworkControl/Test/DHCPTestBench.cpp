@@ -0,0 +1,227 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DHCPClientImplementation.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Runs the DHCP client of the plugin against a real server on the given interface, see veth.sh: a full
+// discovery, a rapid commit discovery, the INIT-REBOOT of a persisted lease and that of a lease from
+// another network. Prints the time each exchange took.
+
+using namespace WPEFramework;
+
+namespace {
+
+    typedef Plugin::DHCPClientImplementation Client;
+
+    struct Options {
+        Options()
+            : Interface()
+            , Network()
+            , Timeout(5000)
+        {
+        }
+
+        string Interface;
+        string Network;
+        uint32_t Timeout;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-interface") == 0)) {
+                options.Interface = argv[++index];
+            } else if ((value == true) && (strcmp(argv[index], "-network") == 0)) {
+                options.Network = argv[++index];
+            } else if ((value == true) && (strcmp(argv[index], "-timeout") == 0)) {
+                options.Timeout = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Interface.empty() == true) || (options.Timeout == 0));
+    }
+
+    void ShowHelp()
+    {
+        printf("NetworkControlDHCPTestBench [options]\n"
+               "\t-interface <name>         Interface a DHCP server answers on, required\n"
+               "\t-network <prefix>         Prefix the leased address must start with, e.g. 10.77.0. []\n"
+               "\t-timeout <ms>             Time to wait for the server [5000]\n");
+    }
+
+    uint32_t _failures = 0;
+
+    void Check(const char description[], const bool condition)
+    {
+        printf("%-64s %s\n", description, (condition == true ? "ok" : "FAILED"));
+        _failures += (condition == true ? 0 : 1);
+    }
+
+    class Bench {
+    public:
+        Bench() = delete;
+        Bench(const Bench&) = delete;
+        Bench& operator=(const Bench&) = delete;
+
+        Bench(const string& interfaceName, const bool rapidCommit)
+            : _client(interfaceName, rapidCommit,
+                  [this](Client::Offer& offer) { Offered(offer); },
+                  [this](Client::Offer& offer, bool result) { Claimed(offer, result); })
+            , _claimed(false, true)
+            , _offers(0)
+            , _result(false)
+            , _leased()
+            , _start(0)
+            , _elapsed(0)
+        {
+        }
+        ~Bench()
+        {
+            _client.Completed();
+        }
+
+    public:
+        bool Discover(const uint32_t waitTime)
+        {
+            _start = Core::Time::Now().Ticks();
+            return ((_client.Discover(Core::NodeId()) == Core::ERROR_NONE) && (Wait(waitTime) == true));
+        }
+        // Hands the lease over the way the plugin persists it, and confirms it with an INIT-REBOOT.
+        bool Reboot(const string& persisted, const uint32_t waitTime, uint32_t& previousId)
+        {
+            Client::Offer::JSON lease;
+            lease.FromString(persisted);
+            _client.AddUnleasedOffer(lease.Get());
+
+            Client::Iterator offer(_client.UnleasedOffers());
+            offer.Next();
+            previousId = offer.Current().Id();
+
+            _start = Core::Time::Now().Ticks();
+            return ((_client.Reboot(offer.Current()) == Core::ERROR_NONE) && (Wait(waitTime) == true));
+        }
+        uint32_t Offers() const
+        {
+            return (_offers);
+        }
+        bool Result() const
+        {
+            return (_result);
+        }
+        Client::Offer& Leased()
+        {
+            return (_leased);
+        }
+        uint32_t Elapsed() const
+        {
+            return (_elapsed);
+        }
+
+    private:
+        bool Wait(const uint32_t waitTime)
+        {
+            return (_claimed.Lock(waitTime) == Core::ERROR_NONE);
+        }
+        // Called from the socket monitor, like in the plugin, the first offer is requested.
+        void Offered(Client::Offer& offer)
+        {
+            if (_offers++ == 0) {
+                _client.Request(offer);
+            }
+        }
+        void Claimed(Client::Offer& offer, bool result)
+        {
+            _elapsed = static_cast<uint32_t>((Core::Time::Now().Ticks() - _start) / Core::Time::TicksPerMillisecond);
+            _result = result;
+            _leased = offer;
+            _claimed.SetEvent();
+        }
+
+    private:
+        Client _client;
+        Core::Event _claimed;
+        uint32_t _offers;
+        bool _result;
+        Client::Offer _leased;
+        uint64_t _start;
+        uint32_t _elapsed;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    string persisted;
+
+    {
+        Bench bench(options.Interface, false);
+
+        Check("Discovery leases an address", (bench.Discover(options.Timeout) == true) && (bench.Result() == true));
+        Check("The address is on the served network", (bench.Leased().Address().HostAddress().compare(0, options.Network.length(), options.Network) == 0));
+        Check("Without rapid commit, the lease follows an offer", (bench.Offers() > 0));
+        printf("discover,%u ms\n", bench.Elapsed());
+
+        Client::Offer::JSON lease(bench.Leased());
+        lease.ToString(persisted);
+    }
+    {
+        Bench bench(options.Interface, true);
+
+        Check("Rapid commit discovery leases an address", (bench.Discover(options.Timeout) == true) && (bench.Result() == true));
+        Check("With rapid commit, there is no offer round trip", (bench.Offers() == 0));
+        printf("rapidcommit,%u ms\n", bench.Elapsed());
+    }
+    {
+        Bench bench(options.Interface, false);
+        uint32_t previousId = 0;
+
+        Check("INIT-REBOOT confirms the persisted lease", (bench.Reboot(persisted, options.Timeout, previousId) == true) && (bench.Result() == true));
+        Check("The confirmed address is the persisted one", (persisted.find('"' + bench.Leased().Address().HostAddress() + '"') != string::npos));
+        Check("INIT-REBOOT runs its own transaction, with a fresh xid", (bench.Leased().Id() != previousId));
+        printf("initreboot,%u ms\n", bench.Elapsed());
+    }
+    {
+        Bench bench(options.Interface, false);
+        uint32_t previousId = 0;
+
+        Check("INIT-REBOOT of an address from another network is refused",
+            (bench.Reboot(_T("{\"offer\":\"10.88.0.5\",\"netmask\":24,\"leaseTime\":3600}"), options.Timeout, previousId) == true) && (bench.Result() == false));
+        printf("initreboot-nak,%u ms\n", bench.Elapsed());
+    }
+
+    Core::Singleton::Dispose();
+
+    return (_failures == 0 ? 0 : 2);
+}
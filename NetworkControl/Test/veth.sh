@@ -0,0 +1,68 @@
+#!/bin/sh
+
+# If not stated otherwise in this file or this component's LICENSE file the
+# following copyright and licenses apply:
+#
+# Copyright 2020 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Runs the DHCP client test bench against dnsmasq, over a veth pair: the client end stays in this
+# namespace, the server end lives in its own namespace. Everything is removed again on exit.
+#
+#   veth.sh <NetworkControlDHCPTestBench> [bench options]
+
+BENCH="$1"
+shift
+
+NAMESPACE=dhcpbench
+CLIENT=dhcpb0
+SERVER=dhcpb1
+
+if [ -z "$BENCH" ] || [ ! -x "$BENCH" ]; then
+    echo "usage: $0 <NetworkControlDHCPTestBench> [options]"
+    exit 1
+fi
+
+if [ "$(id -u)" -ne 0 ] || ! command -v ip > /dev/null || ! command -v dnsmasq > /dev/null; then
+    echo "Needs root, ip and dnsmasq, skipped"
+    exit 77
+fi
+
+cleanup() {
+    [ -n "$DNSMASQ" ] && kill "$DNSMASQ" 2> /dev/null
+    ip link del "$CLIENT" 2> /dev/null
+    ip netns del "$NAMESPACE" 2> /dev/null
+    rm -f "/tmp/$NAMESPACE.leases"
+}
+trap cleanup EXIT
+
+cleanup
+
+ip netns add "$NAMESPACE" || exit 77
+ip link add "$CLIENT" type veth peer name "$SERVER" || exit 77
+ip link set "$SERVER" netns "$NAMESPACE"
+ip -n "$NAMESPACE" addr add 10.77.0.1/24 dev "$SERVER"
+ip -n "$NAMESPACE" link set "$SERVER" up
+ip link set "$CLIENT" up
+
+# Authoritative, so a request for an address from another network is refused (NAK), not ignored.
+ip netns exec "$NAMESPACE" dnsmasq --keep-in-foreground --no-daemon --port=0 --interface="$SERVER" \
+    --bind-interfaces --dhcp-authoritative --dhcp-rapid-commit --dhcp-range=10.77.0.10,10.77.0.50,1h \
+    --dhcp-leasefile="/tmp/$NAMESPACE.leases" > /dev/null 2>&1 &
+DNSMASQ=$!
+
+# Give dnsmasq and the link a moment to come up.
+sleep 1
+
+"$BENCH" -interface "$CLIENT" -network 10.77.0. "$@"
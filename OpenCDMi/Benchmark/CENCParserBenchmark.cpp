@@ -0,0 +1,343 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../CENCParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Constructs the key set of a session from init data the way CreateSession does, once with the
+// init data cache turned off, so every construction is a full parse, and once with the cache on,
+// as for a renewal or for another session on the same content. The samples follow the layout of
+// recorded init data: a CENC v1 "pssh" box, a Widevine v0 "pssh" box, a PlayReady object with a
+// v4.0.0.0 header and the clearkey "keyids" JSON. Recorded init data can be added with -file.
+// Next to that the key id lookups of a license response are timed against the key id index and
+// against a linear search of the key list, which is what every lookup used to be.
+
+using namespace WPEFramework;
+
+namespace {
+
+    typedef Plugin::CommonEncryptionData CENC;
+
+    static const uint8_t CommonSystem[] = { 0x10, 0x77, 0xef, 0xec, 0xc0, 0xb2, 0x4d, 0x02, 0xac, 0xe3, 0x3c, 0x1e, 0x52, 0xe2, 0xfb, 0x4b };
+    static const uint8_t WidevineSystem[] = { 0xed, 0xef, 0x8b, 0xa9, 0x79, 0xd6, 0x4a, 0xce, 0xa3, 0xc8, 0x27, 0xdc, 0xd5, 0x1d, 0x21, 0xed };
+
+    struct Options {
+        Options()
+            : Iterations(10000)
+            , Keys(8)
+            , Files()
+        {
+        }
+
+        uint32_t Iterations;
+        uint32_t Keys;
+        std::vector<std::string> Files;
+    };
+
+    struct Sample {
+        std::string Name;
+        std::vector<uint8_t> Data;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-iterations") == 0)) {
+                options.Iterations = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-keys") == 0)) {
+                options.Keys = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-file") == 0)) {
+                options.Files.push_back(argv[++index]);
+            } else {
+                showHelp = true;
+            }
+        }
+
+        // Keep the generated init data within the 16 bit length CreateSession takes.
+        return ((showHelp == true) || (options.Iterations == 0) || (options.Keys == 0) || (options.Keys > 256));
+    }
+
+    void ShowHelp()
+    {
+        printf("OCDMBenchmark [options]\n"
+               "\t-iterations <count>       Key sets constructed per sample and run [10000]\n"
+               "\t-keys <count>             Key ids in the generated init data [8]\n"
+               "\t-file <path>              Recorded init data to add as a sample, may be repeated\n");
+    }
+
+    void Kid(const uint32_t index, uint8_t kid[])
+    {
+        for (uint8_t position = 0; position < 16; position++) {
+            kid[position] = static_cast<uint8_t>((index * 0x9E3779B1) >> ((position & 3) * 8)) ^ position;
+        }
+    }
+
+    void Append32(std::vector<uint8_t>& data, const uint32_t value)
+    {
+        data.push_back(static_cast<uint8_t>(value >> 24));
+        data.push_back(static_cast<uint8_t>(value >> 16));
+        data.push_back(static_cast<uint8_t>(value >> 8));
+        data.push_back(static_cast<uint8_t>(value));
+    }
+
+    std::vector<uint8_t> PSSH(const uint8_t version, const uint8_t system[], const std::vector<uint8_t>& payload)
+    {
+        std::vector<uint8_t> box;
+
+        Append32(box, static_cast<uint32_t>(8 + 4 + 16 + payload.size()));
+        box.insert(box.end(), { 'p', 's', 's', 'h' });
+        Append32(box, static_cast<uint32_t>(version) << 24);
+        box.insert(box.end(), system, system + 16);
+        box.insert(box.end(), payload.begin(), payload.end());
+
+        return (box);
+    }
+
+    // version 1: KID_count, KIDs, Data_size (0)
+    std::vector<uint8_t> Common(const uint32_t keys)
+    {
+        std::vector<uint8_t> payload;
+        uint8_t kid[16];
+
+        Append32(payload, keys);
+        for (uint32_t index = 0; index < keys; index++) {
+            Kid(index, kid);
+            payload.insert(payload.end(), kid, kid + sizeof(kid));
+        }
+        Append32(payload, 0);
+
+        return (PSSH(1, CommonSystem, payload));
+    }
+
+    // version 0: Data_size, followed by the Widevine header, its key_id fields laid out back to back.
+    std::vector<uint8_t> Widevine(const uint32_t keys)
+    {
+        std::vector<uint8_t> payload;
+        uint8_t kid[16];
+
+        Append32(payload, keys * 16);
+        Append32(payload, 0);
+        for (uint32_t index = 0; index < keys; index++) {
+            Kid(index, kid);
+            payload.insert(payload.end(), kid, kid + sizeof(kid));
+        }
+
+        return (PSSH(0, WidevineSystem, payload));
+    }
+
+    std::string Base64(const uint8_t data[], const uint32_t length, const bool url)
+    {
+        static const char Table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string result;
+        uint32_t index = 0;
+
+        for (; (index + 2) < length; index += 3) {
+            const uint32_t value = (data[index] << 16) | (data[index + 1] << 8) | data[index + 2];
+            result += Table[(value >> 18) & 0x3F];
+            result += Table[(value >> 12) & 0x3F];
+            result += Table[(value >> 6) & 0x3F];
+            result += Table[value & 0x3F];
+        }
+        if (index < length) {
+            const uint32_t value = (data[index] << 16) | ((index + 1) < length ? (data[index + 1] << 8) : 0);
+            result += Table[(value >> 18) & 0x3F];
+            result += Table[(value >> 12) & 0x3F];
+            if ((index + 1) < length) {
+                result += Table[(value >> 6) & 0x3F];
+            }
+            if (url == false) {
+                result.append(((index + 1) < length) ? 1 : 2, '=');
+            }
+        }
+        if (url == true) {
+            std::replace(result.begin(), result.end(), '+', '-');
+            std::replace(result.begin(), result.end(), '/', '_');
+        }
+
+        return (result);
+    }
+
+    // PlayReady object: length, record count, record type 1 with a UTF-16LE v4.0.0.0 header.
+    std::vector<uint8_t> PlayReady(const uint32_t keys)
+    {
+        std::string xml("<WRMHEADER xmlns=\"http://schemas.microsoft.com/DRM/2007/03/PlayReadyHeader\" version=\"4.0.0.0\"><DATA><PROTECTINFO><KEYLEN>16</KEYLEN><ALGID>AESCTR</ALGID></PROTECTINFO>");
+        std::vector<uint8_t> object;
+        uint8_t kid[16];
+
+        for (uint32_t index = 0; index < keys; index++) {
+            Kid(index, kid);
+            xml += "<KID>" + Base64(kid, sizeof(kid), false) + "</KID>";
+        }
+        xml += "<LA_URL>http://playready.example.com/rightsmanager.asmx</LA_URL></DATA></WRMHEADER>";
+
+        const uint32_t size = static_cast<uint32_t>(xml.length() * 2);
+        const uint32_t total = 10 + size;
+
+        object.insert(object.end(), { static_cast<uint8_t>(total), static_cast<uint8_t>(total >> 8), static_cast<uint8_t>(total >> 16), static_cast<uint8_t>(total >> 24) });
+        object.insert(object.end(), { 1, 0, 1, 0 });
+        object.insert(object.end(), { static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8) });
+        for (const char character : xml) {
+            object.push_back(static_cast<uint8_t>(character));
+            object.push_back(0);
+        }
+
+        return (object);
+    }
+
+    std::vector<uint8_t> ClearKey(const uint32_t keys)
+    {
+        std::string json("{\"kids\":[");
+        uint8_t kid[16];
+
+        for (uint32_t index = 0; index < keys; index++) {
+            Kid(index, kid);
+            json += (index == 0 ? "\"" : ",\"") + Base64(kid, sizeof(kid), true) + "\"";
+        }
+        json += "]}";
+
+        return (std::vector<uint8_t>(json.begin(), json.end()));
+    }
+
+    bool Load(const std::string& path, std::vector<uint8_t>& data)
+    {
+        FILE* file = ::fopen(path.c_str(), "rb");
+
+        if (file != nullptr) {
+            uint8_t buffer[1024];
+            size_t length;
+
+            while ((length = ::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+                data.insert(data.end(), buffer, buffer + length);
+            }
+            ::fclose(file);
+        }
+
+        return ((file != nullptr) && (data.empty() == false) && (data.size() <= 0xFFFF));
+    }
+
+    template <typename ACTION>
+    double Measure(const uint32_t iterations, ACTION action)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t index = 0; index < iterations; index++) {
+            action(index);
+        }
+
+        return (std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations);
+    }
+
+    uint32_t Count(const CENC& keys)
+    {
+        uint32_t result = 0;
+        CENC::Iterator index(keys.Keys());
+
+        while (index.Next() == true) {
+            result++;
+        }
+
+        return (result);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    std::vector<Sample> samples;
+    samples.push_back({ "cenc", Common(options.Keys) });
+    samples.push_back({ "widevine", Widevine(options.Keys) });
+    samples.push_back({ "playready", PlayReady(options.Keys) });
+    samples.push_back({ "clearkey", ClearKey(options.Keys) });
+
+    for (const std::string& file : options.Files) {
+        Sample sample;
+        sample.Name = file;
+
+        if (Load(file, sample.Data) == false) {
+            fprintf(stderr, "Could not load init data from %s\n", file.c_str());
+            return (1);
+        }
+        samples.push_back(sample);
+    }
+
+    uint32_t checksum = 0;
+
+    printf("sample,bytes,keys,parse_ns,cached_ns\n");
+
+    for (const Sample& sample : samples) {
+        const uint8_t* data = sample.Data.data();
+        const uint16_t length = static_cast<uint16_t>(sample.Data.size());
+
+        CENC::CacheCapacity(0);
+        const double parse = Measure(options.Iterations, [&](const uint32_t) { checksum += Count(CENC(data, length)); });
+
+        CENC::CacheCapacity(16);
+        checksum += Count(CENC(data, length));
+        const double cached = Measure(options.Iterations, [&](const uint32_t) { checksum += Count(CENC(data, length)); });
+
+        printf("%s,%u,%u,%.0f,%.0f\n", sample.Name.c_str(), static_cast<uint32_t>(length), Count(CENC(data, length)), parse, cached);
+    }
+
+    // A license response reports the status of every key of the session.
+    const std::vector<uint8_t> init(Common(options.Keys));
+    CENC keys(init.data(), static_cast<uint16_t>(init.size()));
+    std::list<CENC::KeyId> list;
+    std::vector<CENC::KeyId> lookups;
+
+    CENC::Iterator index(keys.Keys());
+    while (index.Next() == true) {
+        list.push_back(index.Current());
+        lookups.push_back(index.Current());
+    }
+    std::reverse(lookups.begin(), lookups.end());
+
+    const uint32_t rounds = std::max(1u, (options.Iterations * 16) / options.Keys);
+
+    const double indexed = Measure(rounds, [&](const uint32_t) {
+        for (const CENC::KeyId& key : lookups) {
+            checksum += keys.Status(key);
+        }
+    }) / lookups.size();
+    const double linear = Measure(rounds, [&](const uint32_t) {
+        for (const CENC::KeyId& key : lookups) {
+            checksum += (std::find(list.begin(), list.end(), key) != list.end() ? 1 : 0);
+        }
+    }) / lookups.size();
+
+    printf("\nkeys,index_lookup_ns,list_lookup_ns\n");
+    printf("%u,%.1f,%.1f\n", static_cast<uint32_t>(lookups.size()), indexed, linear);
+
+    // Keep the measured work from being optimized away.
+    return (checksum == 0xFFFFFFFF ? 2 : 0);
+}
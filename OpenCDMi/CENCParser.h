@@ -23,6 +23,8 @@
 #include "Module.h"
 #include <ocdm/IOCDM.h>
 
+#include <unordered_map>
+
 namespace WPEFramework {
 namespace Plugin {
 
@@ -112,20 +114,142 @@ namespace Plugin {
 
         typedef Core::IteratorType<const std::list<KeyId>, const KeyId&, std::list<KeyId>::const_iterator> Iterator;
 
+    private:
+        static uint32_t Hash(const uint8_t data[], const uint16_t length)
+        {
+            // FNV-1a
+            uint32_t result = 2166136261;
+
+            for (uint16_t index = 0; index < length; index++) {
+                result = (result ^ data[index]) * 16777619;
+            }
+
+            return (result);
+        }
+
+        struct KeyIdHash {
+            size_t operator()(const OCDM::KeyId& key) const
+            {
+                return (Hash(key.Id(), KeyId::Length()));
+            }
+        };
+
+        typedef std::unordered_map<OCDM::KeyId, std::list<KeyId>::iterator, KeyIdHash> Index;
+
+        // The parsed init data of the last sessions, shared by all of them. A license renewal or
+        // another session for multi-key content hands in the same init data again, that now only
+        // costs a hash and a compare instead of a full parse.
+        class Cache {
+        private:
+            struct Entry {
+                uint32_t Hash;
+                std::vector<uint8_t> Data;
+                std::list<KeyId> Keys;
+            };
+
+        public:
+            Cache(const Cache&) = delete;
+            Cache& operator=(const Cache&) = delete;
+
+            Cache()
+                : _adminLock()
+                , _capacity(16)
+                , _entries()
+            {
+            }
+            ~Cache()
+            {
+            }
+
+            static Cache& Instance()
+            {
+                static Cache _singleton;
+                return (_singleton);
+            }
+
+        public:
+            void Capacity(const uint8_t entries)
+            {
+                _adminLock.Lock();
+                _capacity = entries;
+                while (_entries.size() > _capacity) {
+                    _entries.pop_back();
+                }
+                _adminLock.Unlock();
+            }
+            bool Get(const uint32_t hash, const uint8_t data[], const uint16_t length, std::list<KeyId>& keys)
+            {
+                bool found = false;
+
+                _adminLock.Lock();
+
+                std::list<Entry>::iterator index(_entries.begin());
+                while ((index != _entries.end()) && ((index->Hash != hash) || (index->Data.size() != length) || (::memcmp(index->Data.data(), data, length) != 0))) {
+                    index++;
+                }
+
+                if (index != _entries.end()) {
+                    // Most recently used first.
+                    _entries.splice(_entries.begin(), _entries, index);
+                    keys = index->Keys;
+                    found = true;
+                }
+
+                _adminLock.Unlock();
+
+                return (found);
+            }
+            void Set(const uint32_t hash, const uint8_t data[], const uint16_t length, const std::list<KeyId>& keys)
+            {
+                _adminLock.Lock();
+
+                if (_capacity > 0) {
+                    if (_entries.size() == _capacity) {
+                        _entries.pop_back();
+                    }
+                    _entries.push_front({ hash, std::vector<uint8_t>(data, data + length), keys });
+                }
+
+                _adminLock.Unlock();
+            }
+
+        private:
+            Core::CriticalSection _adminLock;
+            uint8_t _capacity;
+            std::list<Entry> _entries;
+        };
+
     public:
         CommonEncryptionData(const uint8_t data[], const uint16_t length)
             : _keyIds()
+            , _index()
         {
-            Parse(data, length);
+            Cache& cache(Cache::Instance());
+            const uint32_t hash = Hash(data, length);
+
+            if (cache.Get(hash, data, length, _keyIds) == true) {
+                Reindex();
+            } else {
+                Parse(data, length);
+                cache.Set(hash, data, length, _keyIds);
+            }
         }
         CommonEncryptionData(const CommonEncryptionData& copy)
             : _keyIds(copy._keyIds)
+            , _index()
         {
+            Reindex();
         }
         ~CommonEncryptionData()
         {
         }
 
+        // The number of parsed init data blobs kept, 0 turns the cache off.
+        static void CacheCapacity(const uint8_t entries)
+        {
+            Cache::Instance().Capacity(entries);
+        }
+
     public:
         inline ::OCDM::ISession::KeyStatus Status() const
         {
@@ -135,9 +259,9 @@ namespace Plugin {
         {
             ::OCDM::ISession::KeyStatus result(::OCDM::ISession::StatusPending);
             if (key.IsValid() == true) {
-                std::list<KeyId>::const_iterator index(std::find(_keyIds.begin(), _keyIds.end(), key));
-                if (index != _keyIds.end()) {
-                    result = index->Status();
+                Index::const_iterator index(_index.find(key));
+                if (index != _index.end()) {
+                    result = index->second->Status();
                 }
             }
             return (result);
@@ -148,18 +272,19 @@ namespace Plugin {
         }
         inline bool HasKeyId(const OCDM::KeyId& keyId) const
         {
-            return (std::find(_keyIds.begin(), _keyIds.end(), keyId) != _keyIds.end());
+            return (_index.find(keyId) != _index.end());
         }
         inline void AddKeyId(const KeyId& key)
         {
-            std::list<KeyId>::iterator index(std::find(_keyIds.begin(), _keyIds.end(), key));
+            Index::iterator index(_index.find(key));
 
-            if (index == _keyIds.end()) {
+            if (index == _index.end()) {
                 TRACE_L1("Added key: %s for system: %02X\n", key.ToString().c_str(), key.Systems());
                 _keyIds.emplace_back(key);
+                _index.emplace(key, std::prev(_keyIds.end()));
             } else {
                 TRACE_L1("Updated key: %s for system: %02X\n", key.ToString().c_str(), key.Systems());
-                index->Flag(key.Systems());
+                index->second->Flag(key.Systems());
             }
         }
         inline const KeyId* UpdateKeyStatus(::OCDM::ISession::KeyStatus status, const KeyId& key)
@@ -168,13 +293,14 @@ namespace Plugin {
 
             ASSERT(key.IsValid() == true);
 
-            std::list<KeyId>::iterator index(std::find(_keyIds.begin(), _keyIds.end(), key));
+            Index::iterator index(_index.find(key));
 
-            if (index == _keyIds.end()) {
+            if (index == _index.end()) {
                 _keyIds.emplace_back(key);
+                _index.emplace(key, std::prev(_keyIds.end()));
                 entry = &(_keyIds.back());
             } else {
-                entry = &(*index);
+                entry = &(*(index->second));
             }
             entry->Status(status);
 
@@ -187,14 +313,7 @@ namespace Plugin {
             std::list<KeyId>::const_iterator requested(keys._keyIds.begin());
 
             while ((requested != keys._keyIds.end()) && (result == true)) {
-                std::list<KeyId>::const_iterator index(_keyIds.begin());
-
-                while ((index != _keyIds.end()) && (*index != *requested)) {
-                    index++;
-                }
-
-                result = (index != _keyIds.end());
-
+                result = (_index.find(*requested) != _index.end());
                 requested++;
             }
 
@@ -204,6 +323,13 @@ namespace Plugin {
             return _keyIds.empty();
         }
     private:
+        void Reindex()
+        {
+            _index.clear();
+            for (std::list<KeyId>::iterator index(_keyIds.begin()); index != _keyIds.end(); index++) {
+                _index.emplace(*index, index);
+            }
+        }
         uint8_t Base64(const uint8_t value[], const uint8_t sourceLength, uint8_t object[], const uint8_t length)
         {
             uint8_t state = 0;
@@ -479,6 +605,7 @@ namespace Plugin {
 
     private:
         std::list<KeyId> _keyIds;
+        Index _index;
     };
 }
 } // namespace WPEFramework::Plugin
@@ -126,7 +126,7 @@ namespace {
                 result->ErrorCode = Web::STATUS_OK;
                 result->Message = _T("OK");
             } else if (status == Core::ERROR_INPROGRESS) {
-                result->Message = _T("Some operation already in progress. Only one at a time is allowed");
+                result->Message = _T("Package already queued or repository synchronization already in progress");
             }
         }
 
@@ -26,6 +26,7 @@ namespace WPEFramework {
 namespace Plugin {
 namespace {
     constexpr auto* kInstallMethodName = _T("install");
+    constexpr auto* kInstallBatchMethodName = _T("installbatch");
     constexpr auto* kSynchronizeMethodName = _T("synchronize");
 }
 
@@ -51,6 +52,15 @@ namespace {
             Core::JSON::String Version;
         };
 
+        struct BatchParams : public Core::JSON::Container {
+            BatchParams(const BatchParams& other) = delete;
+            BatchParams& operator=(const BatchParams& other) = delete;
+            BatchParams() {
+                Add(_T("packages"), &Packages);
+            }
+            Core::JSON::ArrayType<Params> Packages;
+        };
+
         Packager(const Packager&) = delete;
         Packager& operator=(const Packager&) = delete;
         Packager()
@@ -64,6 +74,20 @@ namespace {
                 return this->_implementation->Install(params.Package.Value(), params.Version.Value(),
                                                                  params.Architecture.Value());
             });
+            Register<BatchParams, void>(kInstallBatchMethodName, [this](const BatchParams& params) -> uint32_t {
+                // Queued back to back, so the implementation installs them in one transaction.
+                uint32_t result = Core::ERROR_NONE;
+                Core::JSON::ArrayType<Params>::ConstIterator index(params.Packages.Elements());
+                while (index.Next() == true) {
+                    uint32_t status = this->_implementation->Install(index.Current().Package.Value(),
+                                                                     index.Current().Version.Value(),
+                                                                     index.Current().Architecture.Value());
+                    if (result == Core::ERROR_NONE) {
+                        result = status;
+                    }
+                }
+                return result;
+            });
             Register<void, void>(kSynchronizeMethodName, [this]() -> uint32_t {
                 return this->_implementation->SynchronizeRepository();
             });
@@ -72,6 +96,7 @@ namespace {
         ~Packager() override
         {
             Unregister(kInstallMethodName);
+            Unregister(kInstallBatchMethodName);
             Unregister(kSynchronizeMethodName);
         }
 
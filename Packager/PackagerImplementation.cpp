@@ -21,12 +21,12 @@
 
 #if defined (DO_NOT_USE_DEPRECATED_API)
 #include <opkg_cmd.h>
+#include <pkg_hash.h>
 #else
 #include <opkg.h>
 #endif
 #include <opkg_download.h>
 
-
 namespace WPEFramework {
 namespace Plugin {
 
@@ -98,6 +98,14 @@ namespace Plugin {
              _volatileCache = config.MakeCacheVolatile.Value();
          }
 
+        if (config.BatchWindow.IsSet() == true) {
+            _batchWindow = config.BatchWindow.Value();
+        }
+
+        if (config.RepositoryFreshness.IsSet() == true) {
+            _index.Freshness(config.RepositoryFreshness.Value());
+        }
+
         if (Core::File(_configFile).Exists() == false) {
             result = Core::ERROR_GENERAL;
         } else if (Core::Directory(_tempPath.c_str()).CreatePath() == false) {
@@ -126,9 +134,13 @@ namespace Plugin {
         _adminLock.Lock();
         notification->AddRef();
         _notifications.push_back(notification);
-        if (_inProgress.Install != nullptr) {
-            ASSERT(_inProgress.Package != nullptr);
-            notification->StateChange(_inProgress.Package, _inProgress.Install);
+        for (const InstallationData& data : _inProgress) {
+            ASSERT(data.Package != nullptr && data.Install != nullptr);
+            notification->StateChange(data.Package, data.Install);
+        }
+        for (const InstallationData& data : _queue) {
+            ASSERT(data.Package != nullptr && data.Install != nullptr);
+            notification->StateChange(data.Package, data.Install);
         }
         _adminLock.Unlock();
     }
@@ -156,134 +168,203 @@ namespace Plugin {
 
     uint32_t PackagerImplementation::DoWork(const string* name, const string* version, const string* arch)
     {
-        uint32_t result = Core::ERROR_INPROGRESS;
+        uint32_t result = Core::ERROR_NONE;
 
         _adminLock.Lock();
-        if (_inProgress.Install == nullptr && _isSyncing == false) {
-            ASSERT(_inProgress.Package == nullptr);
-            result = Core::ERROR_NONE;
-            // OPKG bug: it marks it checked dependency for a package as cyclic dependency handling fix
-            // but since in our case it's not an process which dies when done, this info survives and makes the
-            // deps check to be skipped on subsequent calls. This is why hash_deinit() is called below
-            // and needs to be initialized here agian.
-            if (_opkgInitialized == true)  // it was initialized
-                FreeOPKG();
-            _opkgInitialized = InitOPKG();
-
-            if (_opkgInitialized) {
-                if (name && version && arch) {
-                    _inProgress.Package = Core::Service<PackageInfo>::Create<PackageInfo>(*name, *version, *arch);
-                    _inProgress.Install = Core::Service<InstallInfo>::Create<InstallInfo>();
-                } else {
-                    _isSyncing = true;
-                }
-                _worker.Run();
+        if (name && version && arch) {
+            // Installs are queued and picked up together by the worker. Only the same package twice is refused.
+            auto sameName = [name](const InstallationData& data) { return (data.Package->Name() == *name); };
+            if ((std::find_if(_queue.begin(), _queue.end(), sameName) != _queue.end()) ||
+                (std::find_if(_inProgress.begin(), _inProgress.end(), sameName) != _inProgress.end())) {
+                result = Core::ERROR_INPROGRESS;
             } else {
-                result = Core::ERROR_GENERAL;
+                _queue.emplace_back();
+                _queue.back().Package = Core::Service<PackageInfo>::Create<PackageInfo>(*name, *version, *arch);
+                _queue.back().Install = Core::Service<InstallInfo>::Create<InstallInfo>();
+                _worker.Run();
             }
+        } else if ((_isSyncing == true) || (_syncRequested == true)) {
+            result = Core::ERROR_INPROGRESS;
+        } else {
+            _syncRequested = true;
+            _worker.Run();
         }
         _adminLock.Unlock();
 
         return result;
+    }
+
+    void PackagerImplementation::BlockingBatchNoLock(bool isInstall, bool isSync)
+    {
+        // OPKG bug: it marks it checked dependency for a package as cyclic dependency handling fix
+        // but since in our case it's not an process which dies when done, this info survives and makes the
+        // deps check to be skipped on subsequent calls. This is why hash_deinit() is called below
+        // and needs to be initialized here agian. Once per batch is enough, it is one transaction.
+        if (_opkgInitialized == true)  // it was initialized
+            FreeOPKG();
+        _opkgInitialized = InitOPKG();
 
+        if (_opkgInitialized == true) {
+            // One repository synchronization for the whole batch.
+            BlockingSetupLocalRepoNoLock(isSync == true ? RepoSyncMode::FORCED : RepoSyncMode::SETUP);
+            if (isInstall == true)
+                BlockingInstallUntilCompletionNoLock();
+        } else {
+            if (isSync == true)
+                NotifyRepoSynced(Core::ERROR_GENERAL);
+            for (InstallationData& data : _inProgress) {
+                data.Install->SetError(Core::ERROR_GENERAL);
+                NotifyStateChange(data);
+            }
+        }
     }
 
     void PackagerImplementation::BlockingInstallUntilCompletionNoLock() {
-        ASSERT(_inProgress.Install != nullptr && _inProgress.Package != nullptr);
+        ASSERT(_inProgress.empty() == false);
 
 #if defined (DO_NOT_USE_DEPRECATED_API)
         opkg_cmd_t* command = opkg_cmd_find("install");
         if (command) {
-            _inProgress.Install->SetState(Exchange::IPackager::INSTALLING);
-            NotifyStateChange();
+            // All packages are resolved and installed in one opkg transaction.
+            std::vector<string> names;
+            std::vector<string> before;
+            std::vector<const char*> argv;
+            names.reserve(_inProgress.size());
+            before.reserve(_inProgress.size());
+            argv.reserve(_inProgress.size());
+            for (InstallationData& data : _inProgress) {
+                names.push_back(data.Package->Name());
+                before.push_back(InstalledVersion(data.Package->Name()));
+                argv.push_back(names.back().c_str());
+                data.Install->SetState(Exchange::IPackager::INSTALLING);
+                NotifyStateChange(data);
+            }
             opkg_config->pfm = command->pfm;
-            std::unique_ptr<char[]> targetCopy(new char [_inProgress.Package->Name().length() + 1]);
-            std::copy_n(_inProgress.Package->Name().begin(), _inProgress.Package->Name().length(), targetCopy.get());
-            (targetCopy.get())[_inProgress.Package->Name().length()] = 0;
-            const char* argv[1];
-            argv[0] = targetCopy.get();
-            if (opkg_cmd_exec(command, 1, argv) == 0) {
-                _inProgress.Install->SetProgress(100);
-                _inProgress.Install->SetState(Exchange::IPackager::INSTALLED);
-            } else {
-                _inProgress.Install->SetError(Core::ERROR_GENERAL);
+            bool succeeded = (opkg_cmd_exec(command, static_cast<int>(argv.size()), argv.data()) == 0);
+            std::vector<string>::const_iterator previous(before.begin());
+            for (InstallationData& data : _inProgress) {
+                // If the transaction as a whole failed, some packages might still have made it. A package
+                // that was there before only counts if it now has the version that was asked for, or, if
+                // no version was given, if the transaction changed it.
+                const string installed(succeeded == true ? string() : InstalledVersion(data.Package->Name()));
+                const string requested(data.Package->Version());
+                if ((succeeded == true) ||
+                    ((installed.empty() == false) &&
+                     (requested.empty() == true ? (installed != *previous) : IsVersion(data.Package->Name(), requested)))) {
+                    data.Install->SetProgress(100);
+                    data.Install->SetState(Exchange::IPackager::INSTALLED);
+                } else {
+                    data.Install->SetError(Core::ERROR_GENERAL);
+                }
+                NotifyStateChange(data);
+                previous++;
             }
-            NotifyStateChange();
         } else {
-            _inProgress.Install->SetError(Core::ERROR_GENERAL);
-            NotifyStateChange();
+            for (InstallationData& data : _inProgress) {
+                data.Install->SetError(Core::ERROR_GENERAL);
+                NotifyStateChange(data);
+            }
         }
 #else
-        _isUpgrade = false;
-        opkg_package_callback_t checkUpgrade = [](pkg* pkg, void* user_data) {
-            PackagerImplementation* self = static_cast<PackagerImplementation*>(user_data);
-            if (self->_isUpgrade == false) {
-                self->_isUpgrade = self->_inProgress.Package->Name() == pkg->name;
-                if (self->_isUpgrade && self->_inProgress.Package->Version().empty() == false) {
-                    self->_isUpgrade = opkg_compare_versions(pkg->version,
-                                                             self->_inProgress.Package->Version().c_str()) < 0;
+        // The libopkg API installs one package per call, but the feeds are loaded and synchronized once.
+        for (InstallationData& data : _inProgress) {
+            _current = &data;
+            _isUpgrade = false;
+            opkg_package_callback_t checkUpgrade = [](pkg* pkg, void* user_data) {
+                PackagerImplementation* self = static_cast<PackagerImplementation*>(user_data);
+                if (self->_isUpgrade == false) {
+                    self->_isUpgrade = self->_current->Package->Name() == pkg->name;
+                    if (self->_isUpgrade && self->_current->Package->Version().empty() == false) {
+                        self->_isUpgrade = opkg_compare_versions(pkg->version,
+                                                                 self->_current->Package->Version().c_str()) < 0;
+                    }
                 }
+            };
+            opkg_list_upgradable_packages(checkUpgrade, this);
+
+            typedef int (*InstallFunction)(const char *, opkg_progress_callback_t, void *);
+            InstallFunction installFunction = opkg_install_package;
+            if (_isUpgrade) {
+                installFunction = opkg_upgrade_package;
             }
-        };
-        opkg_list_upgradable_packages(checkUpgrade, this);
+            _isUpgrade = false;
 
-        typedef int (*InstallFunction)(const char *, opkg_progress_callback_t, void *);
-        InstallFunction installFunction = opkg_install_package;
-        if (_isUpgrade) {
-            installFunction = opkg_upgrade_package;
+            if (installFunction(data.Package->Name().c_str(), PackagerImplementation::InstallationProgessNoLock,
+                                this) != 0) {
+                data.Install->SetError(Core::ERROR_GENERAL);
+                NotifyStateChange(data);
+            }
         }
-        _isUpgrade = false;
+        _current = nullptr;
+#endif
+    }
 
-        if (installFunction(_inProgress.Package->Name().c_str(), PackagerImplementation::InstallationProgessNoLock,
-                            this) != 0) {
-            _inProgress.Install->SetError(Core::ERROR_GENERAL);
-            NotifyStateChange();
+#if defined (DO_NOT_USE_DEPRECATED_API)
+    /* static */ string PackagerImplementation::InstalledVersion(const string& name)
+    {
+        string result;
+        pkg_t* package = pkg_hash_fetch_installed_by_name(name.c_str());
+        if (package != nullptr) {
+            char* version = pkg_version_str_alloc(package);
+            if (version != nullptr) {
+                result = version;
+                free(version);
+            }
         }
-#endif
+        return (result);
     }
 
-#if !defined (DO_NOT_USE_DEPRECATED_API)
+    /* static */ bool PackagerImplementation::IsVersion(const string& name, const string& version)
+    {
+        // The requested version may come with or without epoch and revision.
+        pkg_t* package = pkg_hash_fetch_installed_by_name(name.c_str());
+        return ((package != nullptr) &&
+                ((version == InstalledVersion(name)) || ((package->version != nullptr) && (version == package->version))));
+    }
+#else
     /* static */ void PackagerImplementation::InstallationProgessNoLock(const opkg_progress_data_t* progress,
                                                                         void* data)
     {
         PackagerImplementation* self = static_cast<PackagerImplementation*>(data);
-        self->_inProgress.Install->SetProgress(progress->percentage);
+        ASSERT(self->_current != nullptr);
+        InstallationData& current = *(self->_current);
+        current.Install->SetProgress(progress->percentage);
         if (progress->action == OPKG_INSTALL &&
-            self->_inProgress.Install->State() == Exchange::IPackager::DOWNLOADING) {
-            self->_inProgress.Install->SetState(Exchange::IPackager::DOWNLOADED);
-            self->NotifyStateChange();
+            current.Install->State() == Exchange::IPackager::DOWNLOADING) {
+            current.Install->SetState(Exchange::IPackager::DOWNLOADED);
+            self->NotifyStateChange(current);
         }
         bool stateChanged = false;
         switch (progress->action) {
             case OPKG_DOWNLOAD:
-                if (self->_inProgress.Install->State() != Exchange::IPackager::DOWNLOADING) {
-                    self->_inProgress.Install->SetState(Exchange::IPackager::DOWNLOADING);
+                if (current.Install->State() != Exchange::IPackager::DOWNLOADING) {
+                    current.Install->SetState(Exchange::IPackager::DOWNLOADING);
                     stateChanged = true;
                 }
                 break;
             case OPKG_INSTALL:
-                if (self->_inProgress.Install->State() != Exchange::IPackager::INSTALLING) {
-                    self->_inProgress.Install->SetState(Exchange::IPackager::INSTALLING);
+                if (current.Install->State() != Exchange::IPackager::INSTALLING) {
+                    current.Install->SetState(Exchange::IPackager::INSTALLING);
                     stateChanged = true;
                 }
                 break;
         }
 
         if (stateChanged == true)
-            self->NotifyStateChange();
+            self->NotifyStateChange(current);
         if (progress->percentage == 100) {
-            self->_inProgress.Install->SetState(Exchange::IPackager::INSTALLED);
-            self->NotifyStateChange();
+            current.Install->SetState(Exchange::IPackager::INSTALLED);
+            self->NotifyStateChange(current);
         }
     }
 #endif
 
-    void PackagerImplementation::NotifyStateChange()
+    void PackagerImplementation::NotifyStateChange(const InstallationData& data)
     {
         _adminLock.Lock();
-        TRACE_L1("State for %s changed to %d (%d %%, %d)", _inProgress.Package->Name().c_str(), _inProgress.Install->State(), _inProgress.Install->Progress(), _inProgress.Install->ErrorCode());
+        TRACE_L1("State for %s changed to %d (%d %%, %d)", data.Package->Name().c_str(), data.Install->State(), data.Install->Progress(), data.Install->ErrorCode());
         for (auto* notification : _notifications) {
-            notification->StateChange(_inProgress.Package, _inProgress.Install);
+            notification->StateChange(data.Package, data.Install);
         }
         _adminLock.Unlock();
     }
@@ -322,13 +403,21 @@ namespace Plugin {
         string dirPath = Core::ToString(opkg_config->lists_dir);
         Core::Directory dir(dirPath.c_str());
         bool containFiles = false;
-        if (mode == RepoSyncMode::SETUP && _alwaysUpdateFirst == false) {
+        RepositoryIndex::Feeds feeds;
+
+        RepositoryIndex::Load(_configFile, feeds);
+
+        if (mode == RepoSyncMode::SETUP) {
             while (dir.Next() == true) {
                 if (dir.Name() != _T(".") && dir.Name() != _T("..") && dir.Name() != dirPath) {
                     containFiles = true;
                     break;
                 }
             }
+            // Even if we are asked to always update first, a recently synchronized index is reused.
+            if ((containFiles == true) && (_alwaysUpdateFirst == true) && (_index.IsFresh(feeds) == false)) {
+                containFiles = false;
+            }
         }
         ASSERT(mode == RepoSyncMode::SETUP || _isSyncing == true);
         if (containFiles == false) {
@@ -344,6 +433,9 @@ namespace Plugin {
             {
                 TRACE_L1("Failed to set up local repo. Installing might not work");
                 result = Core::ERROR_GENERAL;
+                _index.Invalidate();
+            } else {
+                _index.Synchronized(std::move(feeds));
             }
             NotifyRepoSynced(result);
         }
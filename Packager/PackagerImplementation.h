@@ -20,9 +20,11 @@
 #pragma once
 
 #include "Module.h"
+#include "RepositoryIndex.h"
 #include <interfaces/IPackager.h>
 
 #include <list>
+#include <map>
 #include <string>
 
 // Forward declarations so we do not need to include the OPKG headers here.
@@ -48,6 +50,8 @@ namespace Plugin {
                 , NoDeps()
                 , NoSignatureCheck()
                 , AlwaysUpdateFirst()
+                , BatchWindow(100)
+                , RepositoryFreshness(0)
             {
                 Add(_T("config"), &ConfigFile);
                 Add(_T("temppath"), &TempDir);
@@ -57,6 +61,8 @@ namespace Plugin {
                 Add(_T("nodeps"), &NoDeps);
                 Add(_T("nosignaturecheck"), &NoSignatureCheck);
                 Add(_T("alwaysupdatefirst"), &AlwaysUpdateFirst);
+                Add(_T("batchwindow"), &BatchWindow);
+                Add(_T("repositoryfreshness"), &RepositoryFreshness);
             }
 
             ~Config() override
@@ -74,6 +80,8 @@ namespace Plugin {
             Core::JSON::Boolean NoDeps;
             Core::JSON::Boolean NoSignatureCheck;
             Core::JSON::Boolean AlwaysUpdateFirst;
+            Core::JSON::DecUInt16 BatchWindow;          // Time (ms) to collect installs into one transaction
+            Core::JSON::DecUInt32 RepositoryFreshness;  // Time (s) a synchronized repository index is reused
         };
 
         PackagerImplementation()
@@ -87,9 +95,15 @@ namespace Plugin {
             , _alwaysUpdateFirst(false)
             , _volatileCache(false)
             , _opkgInitialized(false)
+            , _batchWindow(100)
+            , _queue()
+            , _inProgress()
+            , _current(nullptr)
             , _worker(this)
             , _isUpgrade(false)
             , _isSyncing(false)
+            , _syncRequested(false)
+            , _index()
         {
         }
 
@@ -227,6 +241,8 @@ namespace Plugin {
             InstallInfo* Install = nullptr;
         };
 
+        using InstallationQueue = std::list<InstallationData>;
+
         class InstallThread : public Core::Thread {
         public:
             InstallThread(PackagerImplementation* parent)
@@ -238,27 +254,32 @@ namespace Plugin {
 
             uint32_t Worker() override {
                 while(IsRunning() == true) {
-                    _parent->_adminLock.Lock(); // The parent may have lock when this starts so wait for it to release.
-                    bool isInstall = _parent->_inProgress.Install != nullptr;
-                    ASSERT(isInstall != true || _parent->_inProgress.Package != nullptr);
+                    // Give the callers a moment to queue up more packages, so they end up in the same transaction.
+                    if (_parent->_batchWindow != 0) {
+                        SleepMs(_parent->_batchWindow);
+                    }
+
+                    _parent->_adminLock.Lock();
+                    _parent->_inProgress.splice(_parent->_inProgress.end(), _parent->_queue);
+                    bool isInstall = (_parent->_inProgress.empty() == false);
+                    bool isSync = _parent->_syncRequested;
+                    _parent->_syncRequested = false;
+                    _parent->_isSyncing = isSync;
                     _parent->_adminLock.Unlock();
 
-                    // After this point locking is not needed because API running on other threads only read if in
-                    // progress is filled in.
-                    _parent->BlockingSetupLocalRepoNoLock(isInstall == true ? RepoSyncMode::SETUP : RepoSyncMode::FORCED);
-                    if (isInstall)
-                        _parent->BlockingInstallUntilCompletionNoLock();
-
-                    if (isInstall) {
-                        _parent->_adminLock.Lock();
-                        _parent->_inProgress.Install->Release();
-                        _parent->_inProgress.Package->Release();
-                        _parent->_inProgress.Install = nullptr;
-                        _parent->_inProgress.Package = nullptr;
-                        _parent->_adminLock.Unlock();
+                    // After this point locking is not needed for the batch, because API running on other threads
+                    // only reads it and only appends to the queue.
+                    if ((isInstall == true) || (isSync == true)) {
+                        _parent->BlockingBatchNoLock(isInstall, isSync);
                     }
 
-                    Block();
+                    _parent->_adminLock.Lock();
+                    _parent->_inProgress.clear();
+                    if ((_parent->_queue.empty() == true) && (_parent->_syncRequested == false)) {
+                        // Blocking under the lock, so a request coming in right now will Run() us again.
+                        Block();
+                    }
+                    _parent->_adminLock.Unlock();
                 }
 
                 return Core::infinite;
@@ -275,11 +296,15 @@ namespace Plugin {
 
         uint32_t DoWork(const string* name, const string* version, const string* arch);
         void UpdateConfig() const;
-#if !defined (DO_NOT_USE_DEPRECATED_API)
+#if defined (DO_NOT_USE_DEPRECATED_API)
+        static string InstalledVersion(const string& name);
+        static bool IsVersion(const string& name, const string& version);
+#else
         static void InstallationProgessNoLock(const _opkg_progress_data_t* progress, void* data);
 #endif
-        void NotifyStateChange();
+        void NotifyStateChange(const InstallationData& data);
         void NotifyRepoSynced(uint32_t status);
+        void BlockingBatchNoLock(bool isInstall, bool isSync);
         void BlockingInstallUntilCompletionNoLock();
         void BlockingSetupLocalRepoNoLock(RepoSyncMode mode);
         bool InitOPKG();
@@ -295,11 +320,16 @@ namespace Plugin {
         bool _alwaysUpdateFirst;
         bool _volatileCache;
         bool _opkgInitialized;
+        uint16_t _batchWindow;
         std::vector<Exchange::IPackager::INotification*> _notifications;
-        InstallationData _inProgress;
+        InstallationQueue _queue;
+        InstallationQueue _inProgress;
+        InstallationData* _current;
         InstallThread _worker;
         bool _isUpgrade;
         bool _isSyncing;
+        bool _syncRequested;
+        RepositoryIndex _index;
     };
 
 }  // namespace Plugin
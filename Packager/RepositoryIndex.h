@@ -0,0 +1,128 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Keeps track of when, and against which feeds, the local repository index was last synchronized,
+    // so a synchronization can be skipped while that index is still good. opkg has no conditional (ETag)
+    // fetch, so the feeds are validated here: a file:// feed is identified by the inode, modification
+    // time and size of its package index. For anything else there is no cheap check, those are only
+    // reused within the freshness window.
+    class RepositoryIndex {
+    public:
+        typedef std::map<string, string> Feeds;
+
+        RepositoryIndex(const RepositoryIndex&) = delete;
+        RepositoryIndex& operator=(const RepositoryIndex&) = delete;
+
+        RepositoryIndex()
+            : _freshness(0)
+            , _lastSync(0)
+            , _feeds()
+        {
+        }
+        ~RepositoryIndex()
+        {
+        }
+
+    public:
+        // Time (s) a synchronized index is reused, whatever the feeds are. 0 relies on the feeds only.
+        void Freshness(const uint32_t seconds)
+        {
+            _freshness = seconds;
+        }
+
+        // Reads the feeds from an opkg configuration file. An empty validator means "unknown".
+        static void Load(const string& configFile, Feeds& feeds)
+        {
+            std::ifstream file(configFile);
+            string line;
+
+            feeds.clear();
+
+            while (std::getline(file, line)) {
+                std::istringstream tokens(line);
+                string type, name, url;
+
+                if ((tokens >> type >> name >> url) && ((type == _T("src")) || (type == _T("src/gz")))) {
+                    string validator;
+
+                    if (url.compare(0, 7, _T("file://")) == 0) {
+                        string index = url.substr(7) + (type == _T("src/gz") ? _T("/Packages.gz") : _T("/Packages"));
+                        struct stat info;
+                        if (::stat(index.c_str(), &info) == 0) {
+                            validator = Core::NumberType<uint64_t>(info.st_ino).Text() + ':' +
+                                        Core::NumberType<uint64_t>(info.st_mtim.tv_sec).Text() + '.' + Core::NumberType<uint64_t>(info.st_mtim.tv_nsec).Text() + ':' +
+                                        Core::NumberType<uint64_t>(info.st_size).Text();
+                        }
+                    }
+
+                    feeds[url] = validator;
+                }
+            }
+        }
+
+        bool IsFresh(const Feeds& feeds) const
+        {
+            bool fresh = false;
+
+            if (_lastSync != 0) {
+                if ((_freshness != 0) &&
+                    (Core::Time::Now().Ticks() < (_lastSync + (static_cast<uint64_t>(_freshness) * Core::Time::TicksPerMillisecond * 1000)))) {
+                    fresh = true;
+                } else if ((feeds.empty() == false) && (feeds == _feeds)) {
+                    // Unchanged since the last synchronization, provided every feed could be validated.
+                    fresh = std::find_if(feeds.begin(), feeds.end(),
+                        [](const std::pair<const string, string>& feed) { return (feed.second.empty()); }) == feeds.end();
+                }
+            }
+
+            return (fresh);
+        }
+
+        void Synchronized(Feeds&& feeds)
+        {
+            _lastSync = Core::Time::Now().Ticks();
+            _feeds = std::move(feeds);
+        }
+        void Invalidate()
+        {
+            _lastSync = 0;
+            _feeds.clear();
+        }
+
+    private:
+        uint32_t _freshness;
+        uint64_t _lastSync;
+        Feeds _feeds;
+    };
+
+}  // namespace Plugin
+}  // namespace WPEFramework
@@ -0,0 +1,176 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RepositoryIndex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Checks when the Packager reuses its repository index, against local file:// feeds: a plain and a
+// gzipped one, set up in a scratch directory next to an opkg configuration that points at them.
+
+using namespace WPEFramework;
+
+namespace {
+
+    class Feed {
+    public:
+        Feed(const Feed&) = delete;
+        Feed& operator=(const Feed&) = delete;
+
+        Feed(const string& root)
+            : _root(root)
+            , _configFile(root + "/opkg.conf")
+        {
+            ::mkdir(_root.c_str(), 0755);
+            ::mkdir((_root + "/plain").c_str(), 0755);
+            ::mkdir((_root + "/gzipped").c_str(), 0755);
+
+            Write(_root + "/plain/Packages", "Package: first\nVersion: 1.0\nFilename: first_1.0_all.ipk\n\n");
+            Write(_root + "/gzipped/Packages.gz", "\x1f\x8b not really compressed, only the file is looked at");
+        }
+        ~Feed()
+        {
+            ::unlink((_root + "/plain/Packages").c_str());
+            ::unlink((_root + "/gzipped/Packages.gz").c_str());
+            ::unlink(_configFile.c_str());
+            ::rmdir((_root + "/plain").c_str());
+            ::rmdir((_root + "/gzipped").c_str());
+            ::rmdir(_root.c_str());
+        }
+
+    public:
+        const string& ConfigFile() const
+        {
+            return (_configFile);
+        }
+        void Configure(const bool remote) const
+        {
+            string config("# feeds\n"
+                          "src local-plain file://" + _root + "/plain\n"
+                          "src/gz local-gzipped file://" + _root + "/gzipped\n");
+            if (remote == true) {
+                config += "src/gz remote http://127.0.0.1:1/feed\n";
+            }
+            config += "dest root /\n"
+                      "option overlay_root /overlay\n";
+
+            Write(_configFile, config);
+        }
+        void Publish(const string& packages) const
+        {
+            Write(_root + "/plain/Packages", packages);
+        }
+        void Remove() const
+        {
+            ::unlink((_root + "/gzipped/Packages.gz").c_str());
+        }
+
+    private:
+        static void Write(const string& fileName, const string& content)
+        {
+            FILE* file = fopen(fileName.c_str(), "w");
+            if (file != nullptr) {
+                fwrite(content.c_str(), 1, content.length(), file);
+                fclose(file);
+            }
+        }
+
+    private:
+        string _root;
+        string _configFile;
+    };
+
+    uint32_t _failures = 0;
+
+    void Check(const char description[], const bool condition)
+    {
+        printf("%-64s %s\n", description, (condition == true ? "ok" : "FAILED"));
+        _failures += (condition == true ? 0 : 1);
+    }
+
+    bool IsFresh(const Plugin::RepositoryIndex& index, const Feed& feed)
+    {
+        Plugin::RepositoryIndex::Feeds feeds;
+        Plugin::RepositoryIndex::Load(feed.ConfigFile(), feeds);
+        return (index.IsFresh(feeds));
+    }
+
+    void Synchronize(Plugin::RepositoryIndex& index, const Feed& feed)
+    {
+        Plugin::RepositoryIndex::Feeds feeds;
+        Plugin::RepositoryIndex::Load(feed.ConfigFile(), feeds);
+        index.Synchronized(std::move(feeds));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    char root[] = "/tmp/packager-feed-XXXXXX";
+
+    if ((argc > 1) || (::mkdtemp(root) == nullptr)) {
+        printf("%s\n\tRuns against file:// feeds in a scratch directory in /tmp\n", argv[0]);
+        return (1);
+    }
+
+    ::rmdir(root);
+
+    {
+        Feed feed(root);
+        feed.Configure(false);
+
+        Plugin::RepositoryIndex::Feeds feeds;
+        Plugin::RepositoryIndex::Load(feed.ConfigFile(), feeds);
+        Check("Both file:// feeds are found, options and comments skipped", (feeds.size() == 2));
+        Check("Both file:// feeds are validated", (feeds.size() == 2) && (feeds.begin()->second.empty() == false) && (feeds.rbegin()->second.empty() == false));
+
+        Plugin::RepositoryIndex index;
+        Check("Never synchronized, the index is not fresh", (IsFresh(index, feed) == false));
+
+        Synchronize(index, feed);
+        Check("Unchanged feeds, the index is reused", (IsFresh(index, feed) == true));
+
+        feed.Publish("Package: first\nVersion: 1.1\nFilename: first_1.1_all.ipk\n\nPackage: second\nVersion: 2.0\nFilename: second_2.0_all.ipk\n\n");
+        Check("A package index that changed, calls for a synchronization", (IsFresh(index, feed) == false));
+
+        Synchronize(index, feed);
+        Check("After synchronizing, the index is reused again", (IsFresh(index, feed) == true));
+
+        feed.Remove();
+        Check("A package index that disappeared, calls for a synchronization", (IsFresh(index, feed) == false));
+
+        index.Invalidate();
+        Check("A failed synchronization, invalidates the index", (IsFresh(index, feed) == false));
+
+        feed.Configure(true);
+        Synchronize(index, feed);
+        Check("A remote feed can not be validated, the index is not reused", (IsFresh(index, feed) == false));
+
+        index.Freshness(60);
+        Check("Within the freshness window, the index is reused anyway", (IsFresh(index, feed) == true));
+
+        index.Invalidate();
+        Check("Even within the window, an invalidated index is not reused", (IsFresh(index, feed) == false));
+    }
+
+    return (_failures == 0 ? 0 : 2);
+}
@@ -22,10 +22,14 @@
 
 #include <gst/gst.h>
 
+#include <cinttypes>
+#include <set>
+#include <sys/stat.h>
+
 namespace WPEFramework {
 namespace Plugin {
 
-class PlayerInfoImplementation : public Exchange::IPlayerProperties {
+class PlayerInfoImplementation : public Exchange::IPlayerProperties, public PluginHost::IStateControl {
 private:
 
     class GstUtils {
@@ -201,18 +205,103 @@ private:
 
     typedef std::map<const string, const Exchange::IPlayerProperties::IAudioIterator::AudioCodec> AudioCaps;
     typedef std::map<const string, const Exchange::IPlayerProperties::IVideoIterator::VideoCodec> VideoCaps;
+    typedef std::list<Exchange::IPlayerProperties::IAudioIterator::AudioCodec> AudioCodecs;
+    typedef std::list<Exchange::IPlayerProperties::IVideoIterator::VideoCodec> VideoCodecs;
+
+    class Config : public Core::JSON::Container {
+    public:
+        Config(const Config&) = delete;
+        Config& operator=(const Config&) = delete;
+
+        Config()
+            : Core::JSON::Container()
+            , CodecCache(true)
+        {
+            Add(_T("codeccache"), &CodecCache);
+        }
+        ~Config() override
+        {
+        }
+
+    public:
+        Core::JSON::Boolean CodecCache;
+    };
+
+    // The codec lists only change if the GStreamer plugin set changes, so they are persisted together
+    // with a hash of that set and reused on the next activation.
+    class CodecCache : public Core::JSON::Container {
+    public:
+        CodecCache(const CodecCache&) = delete;
+        CodecCache& operator=(const CodecCache&) = delete;
+
+        CodecCache()
+            : Core::JSON::Container()
+            , Registry()
+            , Audio()
+            , Video()
+        {
+            Add(_T("registry"), &Registry);
+            Add(_T("audio"), &Audio);
+            Add(_T("video"), &Video);
+        }
+        ~CodecCache() override
+        {
+        }
+
+    public:
+        Core::JSON::String Registry;
+        Core::JSON::ArrayType<Core::JSON::DecUInt32> Audio;
+        Core::JSON::ArrayType<Core::JSON::DecUInt32> Video;
+    };
+
+    // Verifies the cached codec lists against the real registry after activation, off the activation path.
+    class RefreshThread : public Core::Thread {
+    public:
+        RefreshThread() = delete;
+        RefreshThread(const RefreshThread&) = delete;
+        RefreshThread& operator=(const RefreshThread&) = delete;
+
+        RefreshThread(PlayerInfoImplementation& parent)
+            : Core::Thread(Core::Thread::DefaultStackSize(), _T("PlayerInfoRefresh"))
+            , _parent(parent)
+        {
+        }
+        ~RefreshThread() override
+        {
+            Stop();
+            Wait(Core::Thread::STOPPED | Core::Thread::BLOCKED, Core::infinite);
+        }
+
+        uint32_t Worker() override
+        {
+            _parent.Refresh();
+            Block();
+            return (Core::infinite);
+        }
+
+    private:
+        PlayerInfoImplementation& _parent;
+    };
 
 public:
-    PlayerInfoImplementation() {
+    PlayerInfoImplementation()
+        : _adminLock()
+        , _audioCodecs()
+        , _videoCodecs()
+        , _cacheFile()
+        , _registry()
+        , _refresh(*this)
+    {
         gst_init(0, nullptr);
-        UpdateAudioCodecInfo();
-        UpdateVideoCodecInfo();
     }
 
     PlayerInfoImplementation(const PlayerInfoImplementation&) = delete;
     PlayerInfoImplementation& operator= (const PlayerInfoImplementation&) = delete;
     virtual ~PlayerInfoImplementation()
     {
+        _refresh.Stop();
+        _refresh.Wait(Core::Thread::STOPPED | Core::Thread::BLOCKED, Core::infinite);
+
         _audioCodecs.clear();
         _videoCodecs.clear();
     }
@@ -220,21 +309,210 @@ public:
 public:
     Exchange::IPlayerProperties::IAudioIterator* AudioCodec() const override
     {
-        return (Core::Service<AudioIteratorImplementation>::Create<Exchange::IPlayerProperties::IAudioIterator>(_audioCodecs));
+        _adminLock.Lock();
+        Exchange::IPlayerProperties::IAudioIterator* iterator = Core::Service<AudioIteratorImplementation>::Create<Exchange::IPlayerProperties::IAudioIterator>(_audioCodecs);
+        _adminLock.Unlock();
+        return (iterator);
     }
     Exchange::IPlayerProperties::IVideoIterator* VideoCodec() const override
     {
-        return (Core::Service<VideoIteratorImplementation>::Create<Exchange::IPlayerProperties::IVideoIterator>(_videoCodecs));
+        _adminLock.Lock();
+        Exchange::IPlayerProperties::IVideoIterator* iterator = Core::Service<VideoIteratorImplementation>::Create<Exchange::IPlayerProperties::IVideoIterator>(_videoCodecs);
+        _adminLock.Unlock();
+        return (iterator);
+    }
+
+    // The plugin hands over its configuration here, before the codecs are asked for.
+    uint32_t Configure(PluginHost::IShell* service) override
+    {
+        const uint64_t start = Core::Time::Now().Ticks();
+        Config config;
+        config.FromString(service->ConfigLine());
+
+        _adminLock.Lock();
+        _audioCodecs.clear();
+        _videoCodecs.clear();
+        _adminLock.Unlock();
+
+        if ((config.CodecCache.Value() == true) && (Core::Directory(service->PersistentPath().c_str()).CreatePath() == true)) {
+            _cacheFile = service->PersistentPath() + _T("codecs.json");
+        } else {
+            _cacheFile.clear();
+        }
+
+        _registry = RegistryHash();
+
+        if (LoadCache() == true) {
+            SYSLOG(Logging::Startup, (_T("PlayerInfo codecs loaded from cache (warm) in %" PRIu64 " us"), (Core::Time::Now().Ticks() - start)));
+            _refresh.Run();
+        } else {
+            AudioCodecs audioCodecs;
+            VideoCodecs videoCodecs;
+
+            UpdateAudioCodecInfo(audioCodecs);
+            UpdateVideoCodecInfo(videoCodecs);
+
+            _adminLock.Lock();
+            _audioCodecs = std::move(audioCodecs);
+            _videoCodecs = std::move(videoCodecs);
+            _adminLock.Unlock();
+
+            SaveCache();
+            SYSLOG(Logging::Startup, (_T("PlayerInfo codecs scanned from the GStreamer registry (cold) in %" PRIu64 " us"), (Core::Time::Now().Ticks() - start)));
+        }
+
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Request(const PluginHost::IStateControl::command /* command */) override
+    {
+        // Nothing to suspend or resume, only the configuration is of interest.
+        return (Core::ERROR_ILLEGAL_STATE);
+    }
+    PluginHost::IStateControl::state State() const override
+    {
+        return (PluginHost::IStateControl::RESUMED);
+    }
+    void Register(PluginHost::IStateControl::INotification* /* notification */) override
+    {
+    }
+    void Unregister(PluginHost::IStateControl::INotification* /* notification */) override
+    {
     }
 
    BEGIN_INTERFACE_MAP(PlayerInfoImplementation)
         INTERFACE_ENTRY(Exchange::IPlayerProperties)
+        INTERFACE_ENTRY(PluginHost::IStateControl)
    END_INTERFACE_MAP
 
 private:
+    // Identifies the plugin set, and with that the outcome of the registry scan: GStreamer version, every
+    // plugin with its version and the size and modification time of its library, and the rank overrides.
+    static string RegistryHash()
+    {
+        std::set<string> entries;
+        guint major, minor, micro, nano;
+
+        gst_version(&major, &minor, &micro, &nano);
+        entries.insert(Core::NumberType<uint32_t>(major).Text() + '.' + Core::NumberType<uint32_t>(minor).Text() + '.' + Core::NumberType<uint32_t>(micro).Text());
+
+        GList* plugins = gst_registry_get_plugin_list(gst_registry_get());
+        for (GList* iterator = plugins; iterator; iterator = iterator->next) {
+            GstPlugin* plugin = static_cast<GstPlugin*>(iterator->data);
+            const gchar* fileName = gst_plugin_get_filename(plugin);
+            string entry = string(gst_plugin_get_name(plugin)) + ':' + gst_plugin_get_version(plugin);
+
+            struct stat info;
+            if ((fileName != nullptr) && (::stat(fileName, &info) == 0)) {
+                entry += ':' + Core::NumberType<uint64_t>(info.st_size).Text() + ':' + Core::NumberType<uint64_t>(info.st_mtime).Text();
+            }
+            entries.insert(entry);
+        }
+        gst_plugin_list_free(plugins);
+
+        const char* ranks = getenv("GST_PLUGIN_FEATURE_RANK");
+        if (ranks != nullptr) {
+            entries.insert(string("rank:") + ranks);
+        }
+
+        // FNV-1a, the set keeps the order independent of the registry.
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (const string& entry : entries) {
+            for (const char character : entry) {
+                hash = (hash ^ static_cast<uint8_t>(character)) * 0x100000001b3ULL;
+            }
+            hash = (hash ^ '\n') * 0x100000001b3ULL;
+        }
+
+        return (Core::NumberType<uint64_t, false, BASE_HEXADECIMAL>(hash).Text());
+    }
+
+    bool LoadCache()
+    {
+        bool loaded = false;
+
+        if (_cacheFile.empty() == false) {
+            Core::File file(_cacheFile, true);
+
+            if (file.Open(true) == true) {
+                CodecCache cache;
+
+                if ((cache.IElement::FromFile(file) == true) && (cache.Registry.Value() == _registry)) {
+                    AudioCodecs audioCodecs;
+                    VideoCodecs videoCodecs;
+
+                    Core::JSON::ArrayType<Core::JSON::DecUInt32>::ConstIterator audio(cache.Audio.Elements());
+                    while (audio.Next() == true) {
+                        audioCodecs.push_back(static_cast<Exchange::IPlayerProperties::IAudioIterator::AudioCodec>(audio.Current().Value()));
+                    }
+                    Core::JSON::ArrayType<Core::JSON::DecUInt32>::ConstIterator video(cache.Video.Elements());
+                    while (video.Next() == true) {
+                        videoCodecs.push_back(static_cast<Exchange::IPlayerProperties::IVideoIterator::VideoCodec>(video.Current().Value()));
+                    }
+
+                    _adminLock.Lock();
+                    _audioCodecs = std::move(audioCodecs);
+                    _videoCodecs = std::move(videoCodecs);
+                    _adminLock.Unlock();
+
+                    loaded = true;
+                }
+                file.Close();
+            }
+        }
+
+        return (loaded);
+    }
+
+    void SaveCache() const
+    {
+        if (_cacheFile.empty() == false) {
+            Core::File file(_cacheFile, true);
+
+            if (file.Create() == true) {
+                CodecCache cache;
+                cache.Registry = _registry;
+
+                _adminLock.Lock();
+                for (const Exchange::IPlayerProperties::IAudioIterator::AudioCodec codec : _audioCodecs) {
+                    cache.Audio.Add() = static_cast<uint32_t>(codec);
+                }
+                for (const Exchange::IPlayerProperties::IVideoIterator::VideoCodec codec : _videoCodecs) {
+                    cache.Video.Add() = static_cast<uint32_t>(codec);
+                }
+                _adminLock.Unlock();
+
+                cache.IElement::ToFile(file);
+                file.Close();
+            }
+        }
+    }
 
+    void Refresh()
+    {
+        const uint64_t start = Core::Time::Now().Ticks();
+        AudioCodecs audioCodecs;
+        VideoCodecs videoCodecs;
+
+        UpdateAudioCodecInfo(audioCodecs);
+        UpdateVideoCodecInfo(videoCodecs);
+
+        _adminLock.Lock();
+        bool changed = ((audioCodecs != _audioCodecs) || (videoCodecs != _videoCodecs));
+        if (changed == true) {
+            _audioCodecs = std::move(audioCodecs);
+            _videoCodecs = std::move(videoCodecs);
+        }
+        _adminLock.Unlock();
+
+        if (changed == true) {
+            TRACE_L1(_T("Cached PlayerInfo codecs were outdated, updating the cache"));
+            SaveCache();
+        }
+
+        TRACE_L1(_T("PlayerInfo codec cache verified in %" PRIu64 " us"), (Core::Time::Now().Ticks() - start));
+    }
 
-    void UpdateAudioCodecInfo()
+    void UpdateAudioCodecInfo(AudioCodecs& codecs) const
     {
         AudioCaps audioCaps = {
             {"audio/mpeg, mpegversion=(int)1", Exchange::IPlayerProperties::IAudioIterator::AudioCodec::AUDIO_MPEG1},
@@ -249,12 +527,12 @@ private:
             {"audio/x-vorbis", Exchange::IPlayerProperties::IAudioIterator::AudioCodec::AUDIO_VORBIS_OGG},
             {"audio/x-wav", Exchange::IPlayerProperties::IAudioIterator::AudioCodec::AUDIO_WAV},
         };
-        if (GstUtils::GstRegistryCheckElementsForMediaTypes(audioCaps, _audioCodecs) != true) {
+        if (GstUtils::GstRegistryCheckElementsForMediaTypes(audioCaps, codecs) != true) {
             TRACE_L1(_T("There is no Audio Codec support available"));
         }
 
     }
-    void UpdateVideoCodecInfo()
+    void UpdateVideoCodecInfo(VideoCodecs& codecs) const
     {
         VideoCaps videoCaps = {
             {"video/x-h263", Exchange::IPlayerProperties::IVideoIterator::VideoCodec::VIDEO_H263},
@@ -265,14 +543,18 @@ private:
             {"video/x-vp9", Exchange::IPlayerProperties::IVideoIterator::VideoCodec::VIDEO_VP9},
             {"video/x-vp10", Exchange::IPlayerProperties::IVideoIterator::VideoCodec::VIDEO_VP10}
         };
-        if (GstUtils::GstRegistryCheckElementsForMediaTypes(videoCaps, _videoCodecs) != true) {
+        if (GstUtils::GstRegistryCheckElementsForMediaTypes(videoCaps, codecs) != true) {
             TRACE_L1(_T("There is no Video Codec support available"));
         }
     }
 
 private:
-    std::list<Exchange::IPlayerProperties::IAudioIterator::AudioCodec> _audioCodecs;
-    std::list<Exchange::IPlayerProperties::IVideoIterator::VideoCodec> _videoCodecs;
+    mutable Core::CriticalSection _adminLock;
+    AudioCodecs _audioCodecs;
+    VideoCodecs _videoCodecs;
+    string _cacheFile;
+    string _registry;
+    RefreshThread _refresh;
 };
 
     SERVICE_REGISTRATION(PlayerInfoImplementation, 1, 0);
@@ -19,6 +19,8 @@
  
 #include "PlayerInfo.h"
 
+#include <cinttypes>
+
 namespace WPEFramework {
 namespace Plugin {
 
@@ -37,28 +39,25 @@ namespace Plugin {
         config.FromString(service->ConfigLine());
         _skipURL = static_cast<uint8_t>(service->WebPrefix().length());
 
+        const uint64_t start = Core::Time::Now().Ticks();
+
         _player = service->Root<Exchange::IPlayerProperties>(_connectionId, 2000, _T("PlayerInfoImplementation"));
 
         if (_player != nullptr) {
+            // An implementation that can be configured (e.g. its codec cache), takes it through IStateControl.
+            PluginHost::IStateControl* stateControl(_player->QueryInterface<PluginHost::IStateControl>());
 
-            _audioCodecs = _player->AudioCodec();
-            if (_audioCodecs != nullptr) {
-
-                _videoCodecs = _player->VideoCodec();
-                if (_videoCodecs == nullptr) {
-
-                    _audioCodecs->Release();
-                    _audioCodecs = nullptr;
-
+            if (stateControl != nullptr) {
+                if (stateControl->Configure(service) != Core::ERROR_NONE) {
                     _player->Release();
                     _player = nullptr;
                 }
-            } else {
-                _player->Release();
-                _player = nullptr;
+                stateControl->Release();
             }
         }
 
+        SYSLOG(Logging::Startup, (_T("PlayerInfo implementation activated in %" PRIu64 " us"), (Core::Time::Now().Ticks() - start)));
+
         if (_player == nullptr) {
             message = _T("PlayerInfo could not be instantiated.");
         }
@@ -117,16 +116,23 @@ namespace Plugin {
 
     void PlayerInfo::Info(JsonData::PlayerInfo::CodecsData& playerInfo) const
     {
-        Core::JSON::EnumType<JsonData::PlayerInfo::CodecsData::AudiocodecsType> audioCodec;
-        _audioCodecs->Reset();
-        while(_audioCodecs->Next()) {
-            playerInfo.Audio.Add(audioCodec = static_cast<JsonData::PlayerInfo::CodecsData::AudiocodecsType>(_audioCodecs->Codec()));
+        // Fresh iterators every time, the implementation updates its lists once the cached ones are verified.
+        Exchange::IPlayerProperties::IAudioIterator* audioCodecs = _player->AudioCodec();
+        if (audioCodecs != nullptr) {
+            Core::JSON::EnumType<JsonData::PlayerInfo::CodecsData::AudiocodecsType> audioCodec;
+            while(audioCodecs->Next()) {
+                playerInfo.Audio.Add(audioCodec = static_cast<JsonData::PlayerInfo::CodecsData::AudiocodecsType>(audioCodecs->Codec()));
+            }
+            audioCodecs->Release();
         }
 
-        Core::JSON::EnumType<JsonData::PlayerInfo::CodecsData::VideocodecsType> videoCodec;
-        _videoCodecs->Reset();
-        while(_videoCodecs->Next()) {
-            playerInfo.Video.Add(videoCodec = static_cast<JsonData::PlayerInfo::CodecsData::VideocodecsType>(_videoCodecs->Codec()));
+        Exchange::IPlayerProperties::IVideoIterator* videoCodecs = _player->VideoCodec();
+        if (videoCodecs != nullptr) {
+            Core::JSON::EnumType<JsonData::PlayerInfo::CodecsData::VideocodecsType> videoCodec;
+            while(videoCodecs->Next()) {
+                playerInfo.Video.Add(videoCodec = static_cast<JsonData::PlayerInfo::CodecsData::VideocodecsType>(videoCodecs->Codec()));
+            }
+            videoCodecs->Release();
         }
     }
 
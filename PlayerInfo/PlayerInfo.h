@@ -27,6 +27,21 @@ namespace WPEFramework {
 namespace Plugin {
 
     class PlayerInfo : public PluginHost::IPlugin, public PluginHost::IWeb, public PluginHost::JSONRPC {
+    private:
+        class Config : public Core::JSON::Container {
+        public:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+            Config()
+                : Core::JSON::Container()
+            {
+            }
+            ~Config() override
+            {
+            }
+        };
+
     public:
         PlayerInfo(const PlayerInfo&) = delete;
         PlayerInfo& operator=(const PlayerInfo&) = delete;
@@ -35,8 +50,6 @@ namespace Plugin {
             : _skipURL(0)
             , _connectionId(0)
             , _player(nullptr)
-            , _audioCodecs(nullptr)
-            , _videoCodecs(nullptr)
         {
             RegisterAll();
         }
@@ -76,9 +89,6 @@ namespace Plugin {
         uint8_t _skipURL;
         uint32_t _connectionId;
         Exchange::IPlayerProperties* _player;
-
-        Exchange::IPlayerProperties::IAudioIterator* _audioCodecs;
-        Exchange::IPlayerProperties::IVideoIterator* _videoCodecs;
     };
 
 } // namespace Plugin
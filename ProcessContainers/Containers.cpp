@@ -26,17 +26,56 @@ namespace Plugin {
 
     const string Containers::Initialize(PluginHost::IShell* service) 
     {
+        Config config;
+        config.FromString(service->ConfigLine());
+
+        _statistics.reset(new Statistics(config.CGroups.Value(), config.History.Value()));
+        _interval = config.Interval.Value() * 1000;
+
+        if (_interval != 0) {
+            _sampler = Core::ProxyType<Core::IDispatch>(Core::ProxyType<Sampler>::Create(*this));
+            Core::IWorkerPool::Instance().Schedule(Core::Time::Now(), _sampler);
+        }
+
         return (string());
     }
 
     void Containers::Deinitialize(PluginHost::IShell* service) 
     {
-        
+        _adminLock.Lock();
+        Core::ProxyType<Core::IDispatch> sampler(_sampler);
+        _sampler.Release();
+        _adminLock.Unlock();
+
+        // A pass in progress sees the sampler is gone and will not schedule the next one.
+        if (sampler.IsValid() == true) {
+            Core::IWorkerPool::Instance().Revoke(sampler);
+        }
+
+        _statistics.reset();
     }
 
     string Containers::Information() const 
     {
         return (string());
     }
+
+    void Containers::Sample()
+    {
+        Statistics::Changes changes;
+
+        _statistics->Sample();
+        _statistics->Changed(changes);
+
+        if (changes.empty() == false) {
+            event_statistics(changes);
+        }
+
+        _adminLock.Lock();
+        if (_sampler.IsValid() == true) {
+            Core::IWorkerPool::Instance().Schedule(Core::Time::Now().Add(_interval), _sampler);
+        }
+        _adminLock.Unlock();
+    }
+}
 }
-}
\ No newline at end of file
@@ -23,17 +23,200 @@
 // This plugin should never be started as outofprocess!
 
 #include "Module.h"
+#include "Statistics.h"
 #include "interfaces/json/JsonData_Containers.h"
 
 namespace WPEFramework {
 namespace Plugin {
 
     class Containers : public PluginHost::IPlugin, PluginHost::JSONRPC {
+    private:
+        class Config : public Core::JSON::Container {
+        public:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+            Config()
+                : Core::JSON::Container()
+                , Interval(5)
+                , History(12)
+                , CGroups(_T("/sys/fs/cgroup"))
+            {
+                Add(_T("interval"), &Interval);
+                Add(_T("history"), &History);
+                Add(_T("cgroups"), &CGroups);
+            }
+            ~Config() override
+            {
+            }
+
+        public:
+            Core::JSON::DecUInt16 Interval;
+            Core::JSON::DecUInt8 History;
+            Core::JSON::String CGroups;
+        };
+
+        class Sampler : public Core::IDispatch {
+        public:
+            Sampler() = delete;
+            Sampler(const Sampler&) = delete;
+            Sampler& operator=(const Sampler&) = delete;
+
+            Sampler(Containers& parent)
+                : _parent(parent)
+            {
+            }
+            ~Sampler() override
+            {
+            }
+
+        public:
+            void Dispatch() override
+            {
+                _parent.Sample();
+            }
+
+        private:
+            Containers& _parent;
+        };
+
+    public:
+        class SampleData : public Core::JSON::Container {
+        public:
+            SampleData(const SampleData& copy)
+                : Core::JSON::Container()
+                , Time(copy.Time)
+                , Memory(copy.Memory)
+                , MemoryAnon(copy.MemoryAnon)
+                , MemoryFile(copy.MemoryFile)
+                , Cpu(copy.Cpu)
+                , CpuUser(copy.CpuUser)
+                , CpuSystem(copy.CpuSystem)
+                , IoRead(copy.IoRead)
+                , IoWrite(copy.IoWrite)
+                , CpuPressure(copy.CpuPressure)
+                , MemoryPressure(copy.MemoryPressure)
+                , IoPressure(copy.IoPressure)
+            {
+                Init();
+            }
+            SampleData& operator=(const SampleData&) = delete;
+
+            SampleData()
+                : Core::JSON::Container()
+            {
+                Init();
+            }
+            ~SampleData() override
+            {
+            }
+
+            void Set(const Statistics::Sample& sample)
+            {
+                Time = Core::Time(sample.Time).ToISO8601(true);
+                Memory = sample.Memory;
+                MemoryAnon = sample.MemoryAnon;
+                MemoryFile = sample.MemoryFile;
+                Cpu = sample.Cpu;
+                CpuUser = sample.CpuUser;
+                CpuSystem = sample.CpuSystem;
+                IoRead = sample.IoRead;
+                IoWrite = sample.IoWrite;
+                CpuPressure = sample.CpuPressure;
+                MemoryPressure = sample.MemoryPressure;
+                IoPressure = sample.IoPressure;
+            }
+
+        private:
+            void Init()
+            {
+                Add(_T("time"), &Time);
+                Add(_T("memory"), &Memory);
+                Add(_T("memoryanon"), &MemoryAnon);
+                Add(_T("memoryfile"), &MemoryFile);
+                Add(_T("cpu"), &Cpu);
+                Add(_T("cpuuser"), &CpuUser);
+                Add(_T("cpusystem"), &CpuSystem);
+                Add(_T("ioread"), &IoRead);
+                Add(_T("iowrite"), &IoWrite);
+                Add(_T("cpupressure"), &CpuPressure);
+                Add(_T("memorypressure"), &MemoryPressure);
+                Add(_T("iopressure"), &IoPressure);
+            }
+
+        public:
+            Core::JSON::String Time;
+            Core::JSON::DecUInt64 Memory;
+            Core::JSON::DecUInt64 MemoryAnon;
+            Core::JSON::DecUInt64 MemoryFile;
+            Core::JSON::DecUInt64 Cpu;
+            Core::JSON::DecUInt64 CpuUser;
+            Core::JSON::DecUInt64 CpuSystem;
+            Core::JSON::DecUInt64 IoRead;
+            Core::JSON::DecUInt64 IoWrite;
+            Core::JSON::DecUInt64 CpuPressure;
+            Core::JSON::DecUInt64 MemoryPressure;
+            Core::JSON::DecUInt64 IoPressure;
+        };
+
+        class StatisticsData : public Core::JSON::Container {
+        public:
+            StatisticsData(const StatisticsData& copy)
+                : Core::JSON::Container()
+                , Name(copy.Name)
+                , Samples(copy.Samples)
+            {
+                Add(_T("name"), &Name);
+                Add(_T("samples"), &Samples);
+            }
+            StatisticsData& operator=(const StatisticsData&) = delete;
+
+            StatisticsData()
+                : Core::JSON::Container()
+            {
+                Add(_T("name"), &Name);
+                Add(_T("samples"), &Samples);
+            }
+            ~StatisticsData() override
+            {
+            }
+
+        public:
+            Core::JSON::String Name;
+            Core::JSON::ArrayType<SampleData> Samples;
+        };
+
+        class StatisticsParamsData : public Core::JSON::Container {
+        public:
+            StatisticsParamsData(const StatisticsParamsData&) = delete;
+            StatisticsParamsData& operator=(const StatisticsParamsData&) = delete;
+
+            StatisticsParamsData()
+                : Core::JSON::Container()
+                , Names()
+                , History(1)
+            {
+                Add(_T("names"), &Names);
+                Add(_T("history"), &History);
+            }
+            ~StatisticsParamsData() override
+            {
+            }
+
+        public:
+            Core::JSON::ArrayType<Core::JSON::String> Names;
+            Core::JSON::DecUInt8 History;
+        };
+
     public:
         Containers(const Containers&) = delete;
         Containers& operator=(const Containers&) = delete;
 
         Containers()
+            : _adminLock()
+            , _statistics()
+            , _sampler()
+            , _interval(0)
         {
             RegisterAll();
         }
@@ -66,6 +249,16 @@ namespace Plugin {
         uint32_t get_networks(const string& index, Core::JSON::ArrayType<JsonData::Containers::NetworksData>& response) const;
         uint32_t get_memory(const string& index, JsonData::Containers::MemoryData& response) const;
         uint32_t get_cpu(const string& index, JsonData::Containers::CpuData& response) const;
+        uint32_t endpoint_statistics(const StatisticsParamsData& params, Core::JSON::ArrayType<StatisticsData>& response);
+        void event_statistics(const Statistics::Changes& changes);
+
+        void Sample();
+
+    private:
+        Core::CriticalSection _adminLock;
+        std::unique_ptr<Statistics> _statistics;
+        Core::ProxyType<Core::IDispatch> _sampler;
+        uint32_t _interval;
     };
 
 } // namespace Plugin
@@ -39,12 +39,14 @@ namespace Plugin {
         Property<Core::JSON::ArrayType<NetworksData>>(_T("networks"), &Containers::get_networks, nullptr, this);
         Property<MemoryData>(_T("memory"), &Containers::get_memory, nullptr, this);
         Property<CpuData>(_T("cpu"), &Containers::get_cpu, nullptr, this);
+        Register<StatisticsParamsData,Core::JSON::ArrayType<StatisticsData>>(_T("statistics"), &Containers::endpoint_statistics, this);
     }
 
     void Containers::UnregisterAll()
     {
         Unregister(_T("start"));
         Unregister(_T("stop"));
+        Unregister(_T("statistics"));
         Unregister(_T("cpu"));
         Unregister(_T("memory"));
         Unregister(_T("networks"));
@@ -229,6 +231,62 @@ namespace Plugin {
         
         return result;
     }
+
+    // Method: statistics - cgroup statistics of several containers at once
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNAVAILABLE: None of the containers has statistics
+    uint32_t Containers::endpoint_statistics(const StatisticsParamsData& params, Core::JSON::ArrayType<StatisticsData>& response)
+    {
+        std::list<string> names;
+
+        auto index = params.Names.Elements();
+        while (index.Next() == true) {
+            names.push_back(index.Current().Value());
+        }
+
+        _adminLock.Lock();
+        const bool sampling = _sampler.IsValid();
+        _adminLock.Unlock();
+
+        // Without periodic sampling, take a pass now.
+        if (sampling == false) {
+            _statistics->Sample();
+        }
+
+        if (names.empty() == true) {
+            _statistics->Names(names);
+        }
+
+        for (const string& name : names) {
+            Statistics::History samples;
+
+            if (_statistics->Get(name, params.History.Value(), samples) == true) {
+                StatisticsData& entry(response.Add());
+                entry.Name = name;
+
+                for (const Statistics::Sample& sample : samples) {
+                    entry.Samples.Add().Set(sample);
+                }
+            }
+        }
+
+        return (response.Length() > 0 ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
+    }
+
+    // Event: statistics - Signals the containers whose statistics changed since the previous pass
+    void Containers::event_statistics(const Statistics::Changes& changes)
+    {
+        Core::JSON::ArrayType<StatisticsData> params;
+
+        for (const std::pair<string, Statistics::Sample>& change : changes) {
+            StatisticsData& entry(params.Add());
+            entry.Name = change.first;
+            entry.Samples.Add().Set(change.second);
+        }
+
+        Notify(_T("statistics"), params);
+    }
 } // namespace Plugin
 
 }
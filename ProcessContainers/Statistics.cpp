@@ -0,0 +1,304 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Statistics.h"
+#include <processcontainers/ProcessContainer.h>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    static constexpr const TCHAR* FileNames[] = {
+        _T("/memory.current"),
+        _T("/memory.stat"),
+        _T("/cpu.stat"),
+        _T("/io.stat"),
+        _T("/cpu.pressure"),
+        _T("/memory.pressure"),
+        _T("/io.pressure")
+    };
+
+    // cgroup files are regenerated on every read from the start, so an open descriptor can be read over and over.
+    static uint32_t Load(const int descriptor, char buffer[], const uint32_t size)
+    {
+        ssize_t length = (descriptor != -1 ? ::pread(descriptor, buffer, size - 1, 0) : 0);
+
+        if (length < 0) {
+            length = 0;
+        }
+        buffer[length] = '\0';
+
+        return (static_cast<uint32_t>(length));
+    }
+
+    // Value of a "<key> <value>" line.
+    static uint64_t Field(const char text[], const char key[])
+    {
+        const size_t length = strlen(key);
+        const char* line = text;
+        uint64_t result = 0;
+
+        while ((line != nullptr) && (*line != '\0')) {
+            if ((strncmp(line, key, length) == 0) && (line[length] == ' ')) {
+                result = strtoull(&line[length + 1], nullptr, 10);
+                break;
+            }
+            line = strchr(line, '\n');
+            if (line != nullptr) {
+                line++;
+            }
+        }
+
+        return (result);
+    }
+
+    // Sum of all "<key>=<value>" pairs, io.stat has a line per device.
+    static uint64_t Sum(const char text[], const char key[])
+    {
+        const size_t length = strlen(key);
+        const char* position = text;
+        uint64_t result = 0;
+
+        while ((position = strstr(position, key)) != nullptr) {
+            position += length;
+            result += strtoull(position, nullptr, 10);
+        }
+
+        return (result);
+    }
+
+    // The accumulated stall time of the "some" line of a pressure file.
+    static uint64_t Stalled(const char text[])
+    {
+        const char* total = (strncmp(text, "some ", 5) == 0 ? strstr(text, "total=") : nullptr);
+
+        return (total != nullptr ? strtoull(&total[6], nullptr, 10) : 0);
+    }
+
+    bool Statistics::Entry::Open(const string& path)
+    {
+        bool opened = false;
+
+        Close();
+
+        for (uint8_t index = 0; index < FILES; index++) {
+            // Controllers that are not enabled, or a kernel without PSI, leave files out, those report 0.
+            Descriptors[index] = ::open((path + FileNames[index]).c_str(), O_RDONLY | O_CLOEXEC);
+            opened = opened || (Descriptors[index] != -1);
+        }
+
+        return (opened);
+    }
+
+    void Statistics::Entry::Close()
+    {
+        for (uint8_t index = 0; index < FILES; index++) {
+            if (Descriptors[index] != -1) {
+                ::close(Descriptors[index]);
+                Descriptors[index] = -1;
+            }
+        }
+    }
+
+    string Statistics::Path(const uint32_t pid) const
+    {
+        string result;
+        char buffer[512];
+        int descriptor = ::open((_T("/proc/") + Core::NumberType<uint32_t>(pid).Text() + _T("/cgroup")).c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (descriptor != -1) {
+            Load(descriptor, buffer, sizeof(buffer));
+            ::close(descriptor);
+
+            // The unified hierarchy is the "0::<path>" entry.
+            const char* line = buffer;
+            while ((line != nullptr) && (*line != '\0') && (strncmp(line, "0::", 3) != 0)) {
+                line = strchr(line, '\n');
+                if (line != nullptr) {
+                    line++;
+                }
+            }
+
+            if ((line != nullptr) && (*line != '\0')) {
+                const char* end = strchr(line, '\n');
+                result = _mountPoint + string(&line[3], (end != nullptr ? (end - &line[3]) : strlen(&line[3])));
+            }
+        }
+
+        return (result);
+    }
+
+    /* static */ void Statistics::Read(const Entry& entry, Sample& sample)
+    {
+        char buffer[4096];
+
+        sample.Time = Core::Time::Now().Ticks();
+
+        Load(entry.Descriptors[MEMORY_CURRENT], buffer, sizeof(buffer));
+        sample.Memory = strtoull(buffer, nullptr, 10);
+
+        Load(entry.Descriptors[MEMORY_STAT], buffer, sizeof(buffer));
+        sample.MemoryAnon = Field(buffer, "anon");
+        sample.MemoryFile = Field(buffer, "file");
+
+        Load(entry.Descriptors[CPU_STAT], buffer, sizeof(buffer));
+        sample.Cpu = Field(buffer, "usage_usec");
+        sample.CpuUser = Field(buffer, "user_usec");
+        sample.CpuSystem = Field(buffer, "system_usec");
+
+        Load(entry.Descriptors[IO_STAT], buffer, sizeof(buffer));
+        sample.IoRead = Sum(buffer, "rbytes=");
+        sample.IoWrite = Sum(buffer, "wbytes=");
+
+        Load(entry.Descriptors[CPU_PRESSURE], buffer, sizeof(buffer));
+        sample.CpuPressure = Stalled(buffer);
+
+        Load(entry.Descriptors[MEMORY_PRESSURE], buffer, sizeof(buffer));
+        sample.MemoryPressure = Stalled(buffer);
+
+        Load(entry.Descriptors[IO_PRESSURE], buffer, sizeof(buffer));
+        sample.IoPressure = Stalled(buffer);
+    }
+
+    void Statistics::Sample()
+    {
+        auto& administrator = ProcessContainers::IContainerAdministrator::Instance();
+        auto iterator = administrator.Containers();
+        Changes changes;
+
+        _adminLock.Lock();
+
+        for (Entries::iterator index = _entries.begin(); index != _entries.end(); index++) {
+            index->second.Sampled = false;
+        }
+
+        while (iterator.Next() == true) {
+            const uint32_t pid = iterator.Current()->Pid();
+
+            if (pid != 0) {
+                const string name(iterator.Current()->Id());
+                Entries::iterator index = _entries.find(name);
+
+                if (index == _entries.end()) {
+                    index = _entries.emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple()).first;
+                }
+
+                Entry& entry(index->second);
+
+                // A restarted container lives in a new cgroup, start over.
+                if (entry.Pid != pid) {
+                    const string path(Path(pid));
+
+                    entry.Samples.clear();
+                    entry.Pid = ((path.empty() == false) && (entry.Open(path) == true) ? pid : 0);
+
+                    if (entry.Pid == 0) {
+                        TRACE_L1(_T("No cgroup statistics available for container %s"), name.c_str());
+                    }
+                }
+
+                if (entry.Pid != 0) {
+                    Sample current;
+                    Read(entry, current);
+
+                    if (entry.Samples.empty() == false) {
+                        const Sample& previous(entry.Samples.back());
+                        Sample delta;
+
+                        delta.Time = current.Time;
+                        delta.Memory = current.Memory;
+                        delta.MemoryAnon = current.MemoryAnon;
+                        delta.MemoryFile = current.MemoryFile;
+                        delta.Cpu = current.Cpu - previous.Cpu;
+                        delta.CpuUser = current.CpuUser - previous.CpuUser;
+                        delta.CpuSystem = current.CpuSystem - previous.CpuSystem;
+                        delta.IoRead = current.IoRead - previous.IoRead;
+                        delta.IoWrite = current.IoWrite - previous.IoWrite;
+                        delta.CpuPressure = current.CpuPressure - previous.CpuPressure;
+                        delta.MemoryPressure = current.MemoryPressure - previous.MemoryPressure;
+                        delta.IoPressure = current.IoPressure - previous.IoPressure;
+
+                        // An idle container with a stable footprint has nothing to report.
+                        if ((delta.Cpu != 0) || (delta.IoRead != 0) || (delta.IoWrite != 0) || (delta.CpuPressure != 0) || (delta.MemoryPressure != 0) || (delta.IoPressure != 0) || (delta.Memory != previous.Memory)) {
+                            changes.emplace_back(name, delta);
+                        }
+                    }
+
+                    if (entry.Samples.size() == _depth) {
+                        entry.Samples.pop_front();
+                    }
+                    entry.Samples.push_back(current);
+                }
+
+                entry.Sampled = true;
+            }
+        }
+
+        // Forget the containers that are gone.
+        Entries::iterator index = _entries.begin();
+        while (index != _entries.end()) {
+            if (index->second.Sampled == false) {
+                index = _entries.erase(index);
+            } else {
+                index++;
+            }
+        }
+
+        _changes = std::move(changes);
+
+        _adminLock.Unlock();
+
+        administrator.Release();
+    }
+
+    bool Statistics::Get(const string& name, const uint8_t count, History& samples) const
+    {
+        bool found = false;
+
+        _adminLock.Lock();
+
+        Entries::const_iterator index = _entries.find(name);
+
+        if ((index != _entries.end()) && (index->second.Samples.empty() == false)) {
+            const History& history(index->second.Samples);
+            const size_t skip = (history.size() > count ? history.size() - count : 0);
+
+            samples.assign(std::next(history.begin(), skip), history.end());
+            found = true;
+        }
+
+        _adminLock.Unlock();
+
+        return (found);
+    }
+
+    void Statistics::Names(std::list<string>& names) const
+    {
+        _adminLock.Lock();
+
+        for (Entries::const_iterator index = _entries.begin(); index != _entries.end(); index++) {
+            if (index->second.Samples.empty() == false) {
+                names.push_back(index->first);
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -0,0 +1,144 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <deque>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Samples the cgroup v2 statistics of all containers in one pass. The cgroup files of a container are
+    // opened once and re-read in place on every pass, the last samples are kept as history so queries
+    // never have to touch the cgroup files.
+    class Statistics {
+    public:
+        struct Sample {
+            uint64_t Time; // Core::Time ticks
+            uint64_t Memory; // memory.current, bytes
+            uint64_t MemoryAnon; // memory.stat anon, bytes
+            uint64_t MemoryFile; // memory.stat file, bytes
+            uint64_t Cpu; // cpu.stat usage_usec
+            uint64_t CpuUser; // cpu.stat user_usec
+            uint64_t CpuSystem; // cpu.stat system_usec
+            uint64_t IoRead; // io.stat rbytes, all devices
+            uint64_t IoWrite; // io.stat wbytes, all devices
+            uint64_t CpuPressure; // cpu.pressure some total, usec
+            uint64_t MemoryPressure; // memory.pressure some total, usec
+            uint64_t IoPressure; // io.pressure some total, usec
+        };
+
+        typedef std::deque<Sample> History;
+        typedef std::list< std::pair<string, Sample> > Changes;
+
+    private:
+        enum file {
+            MEMORY_CURRENT,
+            MEMORY_STAT,
+            CPU_STAT,
+            IO_STAT,
+            CPU_PRESSURE,
+            MEMORY_PRESSURE,
+            IO_PRESSURE,
+            FILES
+        };
+
+        class Entry {
+        public:
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            Entry()
+                : Pid(0)
+                , Samples()
+                , Sampled(false)
+            {
+                for (uint8_t index = 0; index < FILES; index++) {
+                    Descriptors[index] = -1;
+                }
+            }
+            ~Entry()
+            {
+                Close();
+            }
+
+        public:
+            bool Open(const string& path);
+            void Close();
+
+        public:
+            uint32_t Pid;
+            int Descriptors[FILES];
+            History Samples;
+            bool Sampled;
+        };
+
+        typedef std::map<string, Entry> Entries;
+
+    public:
+        Statistics() = delete;
+        Statistics(const Statistics&) = delete;
+        Statistics& operator=(const Statistics&) = delete;
+
+        Statistics(const string& mountPoint, const uint8_t depth)
+            : _adminLock()
+            , _mountPoint(mountPoint)
+            , _depth(depth == 0 ? 1 : depth)
+            , _entries()
+            , _changes()
+        {
+        }
+        ~Statistics()
+        {
+        }
+
+    public:
+        // Reads the statistics of all running containers, drops the ones that are gone and
+        // records the difference with the previous pass for the containers that changed.
+        void Sample();
+
+        // The last count samples of a container, oldest first.
+        bool Get(const string& name, const uint8_t count, History& samples) const;
+        void Names(std::list<string>& names) const;
+
+        // Per container the difference between the last two passes. The memory values are not
+        // counters, they are reported as is.
+        void Changed(Changes& changes) const
+        {
+            _adminLock.Lock();
+            changes = _changes;
+            _adminLock.Unlock();
+        }
+
+    private:
+        string Path(const uint32_t pid) const;
+        static void Read(const Entry& entry, Sample& sample);
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        const string _mountPoint;
+        const uint8_t _depth;
+        Entries _entries;
+        Changes _changes;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -22,6 +22,7 @@
 
 #include "Module.h"
 
+#include <deque>
 #include <string>
 #include <syslog.h>
 #include <unordered_map>
@@ -104,6 +105,7 @@ public:
         Notification(ProcessMonitor* parent)
             : _adminLock()
             , _processMap()
+            , _exits()
             , _job(*this)
             , _service(nullptr)
             , _parent(*parent)
@@ -143,6 +145,7 @@ public:
 
             _job.Revoke();
 
+            _exits.clear();
             _processMap.clear();
         }
         void StateChange(PluginHost::IShell* service) override
@@ -150,19 +153,21 @@ public:
             PluginHost::IShell::state currentState(service->State());
             if (currentState == PluginHost::IShell::DEACTIVATION) {
 
-                uint64_t exitTime = 0;
-
                 _adminLock.Lock();
 
                 std::unordered_map<string, ProcessObject>::iterator itr(
                         _processMap.find(service->Callsign()));
                 if (itr != _processMap.end()) {
-                    exitTime = Core::Time::Now().Ticks() + _exittimeout;
+                    uint64_t exitTime = Core::Time::Now().Ticks() + _exittimeout;
                     itr->second.SetExitTime(exitTime);
-                }
 
-                if (exitTime != 0) {
-                    ScheduleJob();
+                    // All exits share the same timeout, so they expire in the order they
+                    // are queued. Only the first one needs a wakeup.
+                    _exits.emplace_back(exitTime, service->Callsign());
+
+                    if (_exits.size() == 1) {
+                        _job.Schedule(exitTime);
+                    }
                 }
 
                 _adminLock.Unlock();
@@ -182,11 +187,12 @@ public:
 
             _adminLock.Lock();
 
-            auto itr = _processMap.begin();
-            while (itr != _processMap.end()) {
+            while ((_exits.empty() == false) && (_exits.front().first <= currTime)) {
+                std::unordered_map<string, ProcessObject>::iterator itr(
+                        _processMap.find(_exits.front().second));
 
-                uint64_t exitTime = itr->second.ExitTime();
-                if ((exitTime != 0) && (exitTime <= currTime)) {
+                // A later deactivation of the same plugin has moved the exit time.
+                if ((itr != _processMap.end()) && (itr->second.ExitTime() == _exits.front().first)) {
                     Core::Process proc(itr->second.ProcessId());
                     if (proc.IsActive()) {
                         proc.Kill(true);
@@ -194,34 +200,17 @@ public:
                                 (_T("ProcessMonitor killed: [%s]!"),
                                         itr->first.c_str()));
                     }
-                    itr = _processMap.erase(itr);
-                }
-                else {
-                    itr++;
+                    _processMap.erase(itr);
                 }
-            }
-
-            ScheduleJob();
 
-            _adminLock.Unlock();
-        }
-        void ScheduleJob()
-        {
-            uint64_t scheduleTime = 0;
-
-            for (auto itr : _processMap) {
-                uint64_t exitTime = itr.second.ExitTime();
-                if (exitTime != 0) {
-                    if ((scheduleTime == 0) || (scheduleTime > exitTime)) {
-                        scheduleTime = exitTime;
-                    }
-                }
+                _exits.pop_front();
             }
 
-            if (scheduleTime != 0) {
-                _job.Revoke();
-                _job.Schedule(scheduleTime);
+            if (_exits.empty() == false) {
+                _job.Schedule(_exits.front().first);
             }
+
+            _adminLock.Unlock();
         }
         void Activated(RPC::IRemoteConnection* connection) override
         {
@@ -244,6 +233,7 @@ public:
     private:
         Core::CriticalSection _adminLock;
         std::unordered_map<string, ProcessObject> _processMap;
+        std::deque< std::pair<uint64_t, string> > _exits;
         Job  _job;
         PluginHost::IShell* _service;
         ProcessMonitor& _parent;
@@ -0,0 +1,322 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+// Generates key events at a high rate through a uinput keyboard, so the /dev/input path of the
+// RemoteControl plugin can be exercised without a remote. The benchmark reads the events back from
+// the event node itself, the same way LinuxDevice does, and reports the throughput and the
+// latency from injection to read. With the plugin running it picks up the same device, its
+// "latency" property then shows the time up to the key handler.
+
+namespace {
+
+    static const uint16_t Keys[] = { KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_7, KEY_8, KEY_9, KEY_0 };
+
+    struct Options {
+        Options()
+            : Events(10000)
+            , Rate(0)
+            , Batch(1)
+            , Settle(500)
+        {
+        }
+
+        uint32_t Events;
+        uint32_t Rate;
+        uint32_t Batch;
+        uint32_t Settle;
+    };
+
+    struct Result {
+        Result()
+            : Received(0)
+            , Dropped(0)
+            , Latencies()
+        {
+        }
+
+        uint32_t Received;
+        uint32_t Dropped;
+        std::vector<uint32_t> Latencies;
+    };
+
+    uint64_t Now()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000));
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-events") == 0)) {
+                options.Events = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-rate") == 0)) {
+                options.Rate = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-batch") == 0)) {
+                options.Batch = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-settle") == 0)) {
+                options.Settle = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Events == 0) || (options.Batch == 0));
+    }
+
+    void ShowHelp()
+    {
+        printf("RemoteControlBenchmark [options]\n"
+               "\t-events <count>           Key presses, each followed by a release [10000]\n"
+               "\t-rate <count>             Key presses per second, 0 is as fast as possible [0]\n"
+               "\t-batch <count>            Key events per synchronization report [1]\n"
+               "\t-settle <ms>              Time given to udev and the plugin to pick up the device [500]\n");
+    }
+
+    bool Emit(const int fd, const uint16_t type, const uint16_t code, const int32_t value)
+    {
+        struct input_event event;
+        memset(&event, 0, sizeof(event));
+        event.type = type;
+        event.code = code;
+        event.value = value;
+
+        return (::write(fd, &event, sizeof(event)) == sizeof(event));
+    }
+
+    int Create()
+    {
+        int fd = ::open("/dev/uinput", O_WRONLY | O_CLOEXEC);
+
+        if (fd == -1) {
+            fprintf(stderr, "Could not open /dev/uinput: %s\n", strerror(errno));
+        } else {
+            struct uinput_setup setup;
+            memset(&setup, 0, sizeof(setup));
+            setup.id.bustype = BUS_VIRTUAL;
+            setup.id.vendor = 0x0001;
+            setup.id.product = 0x0001;
+            // LinuxDevice associates the device with its key handling by name.
+            strncpy(setup.name, "RemoteControl benchmark keyboard", sizeof(setup.name) - 1);
+
+            bool result = (ioctl(fd, UI_SET_EVBIT, EV_KEY) == 0) && (ioctl(fd, UI_SET_EVBIT, EV_SYN) == 0);
+
+            for (const uint16_t key : Keys) {
+                result = result && (ioctl(fd, UI_SET_KEYBIT, key) == 0);
+            }
+
+            if ((result == false) || (ioctl(fd, UI_DEV_SETUP, &setup) != 0) || (ioctl(fd, UI_DEV_CREATE) != 0)) {
+                fprintf(stderr, "Could not create the uinput device: %s\n", strerror(errno));
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        return (fd);
+    }
+
+    // The event node belonging to the created device, /sys/devices/virtual/input/<sysname>/event<N>.
+    std::string Node(const int fd)
+    {
+        std::string result;
+        char sysName[64];
+
+        if (ioctl(fd, UI_GET_SYSNAME(sizeof(sysName)), sysName) >= 0) {
+            const std::string path(std::string("/sys/devices/virtual/input/") + sysName);
+            DIR* directory = ::opendir(path.c_str());
+
+            if (directory != nullptr) {
+                struct dirent* entry;
+
+                while ((result.empty() == true) && ((entry = ::readdir(directory)) != nullptr)) {
+                    if (strncmp(entry->d_name, "event", 5) == 0) {
+                        result = std::string("/dev/input/") + entry->d_name;
+                    }
+                }
+
+                ::closedir(directory);
+            }
+        }
+
+        return (result);
+    }
+
+    // Drains the event node on every wake up and time stamps each key event as it is read.
+    void Read(const int fd, const int epoll, const uint32_t expected, std::atomic<bool>& done, Result& result)
+    {
+        struct input_event events[64];
+        struct epoll_event wakeup;
+
+        while ((result.Received < expected) && (done.load() == false)) {
+            if (epoll_wait(epoll, &wakeup, 1, 100) > 0) {
+                ssize_t length;
+
+                while ((length = ::read(fd, events, sizeof(events))) > 0) {
+                    const uint64_t now = Now();
+                    const uint32_t count = static_cast<uint32_t>(length / sizeof(input_event));
+
+                    for (uint32_t index = 0; index < count; index++) {
+                        const input_event& event(events[index]);
+
+                        if ((event.type == EV_SYN) && (event.code == SYN_DROPPED)) {
+                            result.Dropped++;
+                        } else if (event.type == EV_KEY) {
+#ifdef input_event_sec
+                            const uint64_t stamp = (static_cast<uint64_t>(event.input_event_sec) * 1000000) + event.input_event_usec;
+#else
+                            const uint64_t stamp = (static_cast<uint64_t>(event.time.tv_sec) * 1000000) + event.time.tv_usec;
+#endif
+                            result.Latencies.push_back(static_cast<uint32_t>(now >= stamp ? now - stamp : 0));
+                            result.Received++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Every press is followed by its release, batch key events share one synchronization report.
+    uint32_t Generate(const int fd, const Options& options)
+    {
+        const uint32_t total = options.Events * 2;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        uint32_t sent = 0;
+
+        while (sent < total) {
+            for (uint32_t index = 0; (index < options.Batch) && (sent < total); index++, sent++) {
+                if (Emit(fd, EV_KEY, Keys[(sent / 2) % (sizeof(Keys) / sizeof(Keys[0]))], ((sent & 1) == 0 ? 1 : 0)) == false) {
+                    fprintf(stderr, "Writing to the uinput device failed: %s\n", strerror(errno));
+                    return (sent);
+                }
+            }
+
+            Emit(fd, EV_SYN, SYN_REPORT, 0);
+
+            if (options.Rate != 0) {
+                // Pace on presses, each press comes with a release.
+                std::this_thread::sleep_until(start + std::chrono::microseconds((static_cast<uint64_t>(sent / 2) * 1000000) / options.Rate));
+            }
+        }
+
+        return (sent);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    const int device = Create();
+
+    if (device == -1) {
+        return (1);
+    }
+
+    const std::string node(Node(device));
+    int fd = (node.empty() == false ? ::open(node.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC) : -1);
+    int epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    int exitCode = 1;
+
+    if ((fd == -1) || (epoll == -1)) {
+        fprintf(stderr, "Could not open the event node of the uinput device [%s]\n", node.c_str());
+    } else {
+        int clock = CLOCK_MONOTONIC;
+        struct epoll_event watch;
+        memset(&watch, 0, sizeof(watch));
+        watch.events = EPOLLIN;
+        watch.data.fd = fd;
+
+        ioctl(fd, EVIOCSCLOCKID, &clock);
+        epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &watch);
+
+        // Give udev, and the plugin if it runs, time to open the new device.
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.Settle));
+
+        Result result;
+        std::atomic<bool> done(false);
+        result.Latencies.reserve(options.Events * 2);
+
+        std::thread reader(Read, fd, epoll, options.Events * 2, std::ref(done), std::ref(result));
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const uint32_t sent = Generate(device, options);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Whatever has not arrived a second after the last event is lost.
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        done = true;
+        reader.join();
+
+        printf("events,rate,batch,sent,sent_per_s,received,dropped,min_us,p50_us,p99_us,max_us\n");
+
+        std::vector<uint32_t>& latencies(result.Latencies);
+        std::sort(latencies.begin(), latencies.end());
+
+        if (latencies.empty() == true) {
+            latencies.push_back(0);
+        }
+
+        printf("%u,%u,%u,%u,%.0f,%u,%u,%u,%u,%u,%u\n",
+            options.Events, options.Rate, options.Batch, sent, (seconds > 0 ? sent / seconds : 0), result.Received, result.Dropped,
+            latencies.front(), latencies[latencies.size() / 2], latencies[(latencies.size() * 99) / 100], latencies.back());
+
+        exitCode = ((sent == result.Received) && (result.Dropped == 0) ? 0 : 2);
+    }
+
+    if (epoll != -1) {
+        ::close(epoll);
+    }
+    if (fd != -1) {
+        ::close(fd);
+    }
+
+    ioctl(device, UI_DEV_DESTROY);
+    ::close(device);
+
+    return (exitCode);
+}
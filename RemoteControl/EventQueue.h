@@ -0,0 +1,91 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#include <atomic>
+
+namespace WPEFramework {
+namespace Remotes {
+
+    // Single producer, single consumer ring buffer. The thread reading the input devices pushes, the
+    // dispatching thread pops, neither of them ever takes a lock or allocates.
+    template <typename ELEMENT, const uint16_t SIZE>
+    class EventQueue {
+    private:
+        static_assert((SIZE != 0) && ((SIZE & (SIZE - 1)) == 0), "The queue size must be a power of 2");
+
+    public:
+        EventQueue(const EventQueue<ELEMENT, SIZE>&) = delete;
+        EventQueue<ELEMENT, SIZE>& operator=(const EventQueue<ELEMENT, SIZE>&) = delete;
+
+        EventQueue()
+            : _head(0)
+            , _tail(0)
+        {
+        }
+        ~EventQueue()
+        {
+        }
+
+    public:
+        inline bool IsEmpty() const
+        {
+            return (_head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire));
+        }
+        // Producer side only.
+        bool Push(const ELEMENT& element)
+        {
+            bool result = false;
+            const uint32_t tail = _tail.load(std::memory_order_relaxed);
+
+            if ((tail - _head.load(std::memory_order_acquire)) < SIZE) {
+                _elements[tail & (SIZE - 1)] = element;
+                _tail.store(tail + 1, std::memory_order_release);
+                result = true;
+            }
+
+            return (result);
+        }
+        // Consumer side only.
+        bool Pop(ELEMENT& element)
+        {
+            bool result = false;
+            const uint32_t head = _head.load(std::memory_order_relaxed);
+
+            if (head != _tail.load(std::memory_order_acquire)) {
+                element = _elements[head & (SIZE - 1)];
+                _head.store(head + 1, std::memory_order_release);
+                result = true;
+            }
+
+            return (result);
+        }
+
+    private:
+        // Keep the indexes on their own cache line, they are written by different threads.
+        alignas(64) std::atomic<uint32_t> _head;
+        alignas(64) std::atomic<uint32_t> _tail;
+        ELEMENT _elements[SIZE];
+    };
+
+}
+}
@@ -17,11 +17,14 @@
  * limitations under the License.
  */
 
+#include "EventQueue.h"
 #include "RemoteAdministrator.h"
 
 #include <interfaces/IKeyHandler.h>
 #include <libudev.h>
 #include <linux/uinput.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 
 namespace WPEFramework {
 namespace Plugin {
@@ -40,6 +43,9 @@ namespace Plugin {
     private:
         static constexpr const TCHAR* InputDeviceSysFilePath = _T("/sys/class/input/");
         static constexpr const TCHAR* DeviceNamePath = _T("/device/name");
+        static constexpr uint16_t QueueSize = 256;
+        static constexpr uint8_t EventBatch = 64;
+        static constexpr uint8_t MaxWakeups = 16;
 
     private:
         LinuxDevice(const LinuxDevice&) = delete;
@@ -54,6 +60,68 @@ namespace Plugin {
             virtual void ProducerEvent(const Exchange::ProducerEvents event) { }
         };
 
+        // An input event as read from the device, stamped with the (monotonic) time the device reported it.
+        struct Event {
+            uint64_t Time;
+            uint16_t Type;
+            uint16_t Code;
+            int32_t Value;
+        };
+
+        // An opened /dev/input/event* node. The key state is tracked so the device can be brought back in
+        // sync after the kernel dropped events (SYN_DROPPED) because we did not read fast enough.
+        struct Device {
+            Device(const int descriptor, IDevInputDevice* handler)
+                : Descriptor(descriptor)
+                , Handler(handler)
+                , Dropped(false)
+            {
+                memset(Keys, 0, sizeof(Keys));
+                (void)ioctl(Descriptor, EVIOCGKEY(sizeof(Keys)), Keys);
+            }
+
+            int Descriptor;
+            IDevInputDevice* Handler;
+            bool Dropped;
+            uint8_t Keys[(KEY_MAX / 8) + 1];
+        };
+
+        // Reading the devices and handing the events to the handlers are separate threads, so a slow handler
+        // never delays the reading, and the delay between the two can be measured.
+        class Dispatcher : public Core::Thread {
+        public:
+            Dispatcher() = delete;
+            Dispatcher(const Dispatcher&) = delete;
+            Dispatcher& operator=(const Dispatcher&) = delete;
+
+            Dispatcher(LinuxDevice& parent)
+                : Core::Thread(Core::Thread::DefaultStackSize(), _T("LinuxInputDispatch"))
+                , _parent(parent)
+            {
+            }
+            ~Dispatcher() override
+            {
+            }
+
+        public:
+            void Halt()
+            {
+                Core::Thread::Block();
+                _parent.Signal();
+                Wait(Core::Thread::INITIALIZED | Core::Thread::BLOCKED | Core::Thread::STOPPED, Core::infinite);
+            }
+
+        private:
+            uint32_t Worker() override
+            {
+                _parent.Dispatch();
+                return (0);
+            }
+
+        private:
+            LinuxDevice& _parent;
+        };
+
         class KeyDevice : public Exchange::IKeyProducer, public IDevInputDevice {
         public:
             KeyDevice(const KeyDevice&) = delete;
@@ -62,9 +130,10 @@ namespace Plugin {
             KeyDevice(LinuxDevice* parent)
                 : _parent(parent)
                 , _callback(nullptr)
+                , _handle(Remotes::RemoteAdministrator::InvalidHandle)
             {
                 ASSERT(_parent != nullptr);
-                Remotes::RemoteAdministrator::Instance().Announce(*this);
+                _handle = Remotes::RemoteAdministrator::Instance().Announce(*this);
             }
             virtual ~KeyDevice()
             {
@@ -127,7 +196,11 @@ namespace Plugin {
                 if (type == EV_KEY) {
                     if ((code < BTN_MISC) || (code >= KEY_OK)) {
                         if (value != 2) {
-                            _callback->KeyEvent((value != 0), code, Name());
+                            if (_handle != Remotes::RemoteAdministrator::InvalidHandle) {
+                                Remotes::RemoteAdministrator::Instance().KeyEvent(_handle, (value != 0), code);
+                            } else if (_callback != nullptr) {
+                                _callback->KeyEvent((value != 0), code, Name());
+                            }
                         }
                         return true;
                     }
@@ -148,6 +221,7 @@ namespace Plugin {
         private:
             LinuxDevice* _parent;
             Exchange::IKeyHandler* _callback;
+            uint16_t _handle;
         };
 
         class WheelDevice : public Exchange::IWheelProducer, public IDevInputDevice {
@@ -313,24 +387,24 @@ namespace Plugin {
                     uint8_t absbits[(ABS_MAX / 8) + 1];
                     memset(absbits, 0, sizeof(absbits));
 
-                    if (ioctl(index.second.first, EVIOCGBIT(EV_ABS, sizeof(absbits)), absbits) >= 0) {
+                    if (ioctl(index.second.Descriptor, EVIOCGBIT(EV_ABS, sizeof(absbits)), absbits) >= 0) {
                         if (CheckBit(absbits, ABS_X) == true) {
                             // Note: Only multitouch protocol B supported. In case of protocol A multitouch device, will run as single-touch.
                             _have_multitouch = (CheckBit(absbits, ABS_MT_SLOT) == true) && (CheckBit(absbits, ABS_MT_POSITION_X) == true);
 
                             struct input_absinfo absinfo;
                             if (_have_multitouch == true) {
-                                if (ioctl(index.second.first, EVIOCGABS(ABS_MT_POSITION_X), &absinfo) >= 0) {
+                                if (ioctl(index.second.Descriptor, EVIOCGABS(ABS_MT_POSITION_X), &absinfo) >= 0) {
                                     _abs_x_multiplier = ((1 << 16) << ABS_MULTIPLIER_PRECISSION) / absinfo.maximum;
                                 }
-                                if (ioctl(index.second.first, EVIOCGABS(ABS_MT_POSITION_Y), &absinfo) >= 0) {
+                                if (ioctl(index.second.Descriptor, EVIOCGABS(ABS_MT_POSITION_Y), &absinfo) >= 0) {
                                     _abs_y_multiplier = ((1 << 16) << ABS_MULTIPLIER_PRECISSION) / absinfo.maximum;
                                 }
                             } else {
-                                if (ioctl(index.second.first, EVIOCGABS(ABS_X), &absinfo) >= 0) {
+                                if (ioctl(index.second.Descriptor, EVIOCGABS(ABS_X), &absinfo) >= 0) {
                                     _abs_x_multiplier = ((1 << 16) << ABS_MULTIPLIER_PRECISSION) / absinfo.maximum;
                                 }
-                                if (ioctl(index.second.first, EVIOCGABS(ABS_Y), &absinfo) >= 0) {
+                                if (ioctl(index.second.Descriptor, EVIOCGABS(ABS_Y), &absinfo) >= 0) {
                                     _abs_y_multiplier = ((1 << 16) << ABS_MULTIPLIER_PRECISSION) / absinfo.maximum;
                                 }
                             }
@@ -422,6 +496,8 @@ namespace Plugin {
                                 _abs_latch[i].Reset();
                             }
                         }
+                        // The touch report is delivered on this event.
+                        return true;
                     }
                 }
                 return false;
@@ -513,6 +589,11 @@ namespace Plugin {
             , _devices()
             , _monitor(nullptr)
             , _update(-1)
+            , _epoll(::epoll_create1(EPOLL_CLOEXEC))
+            , _buffer()
+            , _signal(::eventfd(0, EFD_CLOEXEC))
+            , _queue()
+            , _dispatcher(*this)
         {
             _pipe[0] = -1;
             _pipe[1] = -1;
@@ -538,11 +619,16 @@ namespace Plugin {
 
                 udev_unref(udev);
 
+                Watch(_pipe[0], &_pipe[0]);
+                Watch(_update, &_update);
+
                 _inputDevices.emplace_back(Core::Service<KeyDevice>::Create<KeyDevice>(this));
                 _inputDevices.emplace_back(Core::Service<WheelDevice>::Create<WheelDevice>(this));
                 _inputDevices.emplace_back(Core::Service<PointerDevice>::Create<PointerDevice>(this));
                 _inputDevices.emplace_back(Core::Service<TouchDevice>::Create<TouchDevice>(this));
 
+                _dispatcher.Run();
+
                 Pair();
             }
         }
@@ -550,8 +636,18 @@ namespace Plugin {
         {
             Block();
 
+            _dispatcher.Halt();
+
             Clear();
 
+            if (_signal != -1) {
+                ::close(_signal);
+            }
+
+            if (_epoll != -1) {
+                ::close(_epoll);
+            }
+
             if (_pipe[0] != -1) {
                 close(_pipe[0]);
                 close(_pipe[1]);
@@ -608,12 +704,20 @@ namespace Plugin {
                 Core::File entry(dir.Current(), false);
                 if ((entry.IsDirectory() == false) && (entry.FileName().substr(0, 5) == _T("event"))) {
 
-                    TRACE(Trace::Information, (_T("Opening input device: %s"), entry.Name().c_str()));
+                    // Devices already watched keep their descriptor, and with it their pending events.
+                    if ((_devices.find(entry.Name()) == _devices.end()) && (entry.Open(true) == true)) {
+
+                        TRACE(Trace::Information, (_T("Opening input device: %s"), entry.Name().c_str()));
 
-                    if (entry.Open(true) == true) {
                         int fd = entry.DuplicateHandle();
-                        std::map<string, std::pair<int, IDevInputDevice*>>::iterator device(_devices.find(entry.Name()));
-                        if (device == _devices.end()) {
+
+                        if (fd != -1) {
+                            // Have the events stamped on the clock used to measure the dispatch latency.
+                            int clock = CLOCK_MONOTONIC;
+                            ioctl(fd, EVIOCSCLOCKID, &clock);
+                            // Every wake up drains the device, the last read has to come back empty instead of blocking.
+                            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
                             string deviceName;
                             ReadDeviceName(entry.Name(), deviceName);
                             std::transform(deviceName.begin(), deviceName.end(), deviceName.begin(), std::ptr_fun<int, int>(std::toupper));
@@ -627,25 +731,63 @@ namespace Plugin {
                                 }
                             }
 
-                            _devices.insert(std::make_pair(entry.Name(), std::make_pair(fd, inputDevice)));
+                            std::map<string, Device>::iterator device = _devices.emplace(std::piecewise_construct,
+                                std::forward_as_tuple(entry.Name()),
+                                std::forward_as_tuple(fd, inputDevice)).first;
+
+                            Watch(fd, &(device->second));
                         }
                     }
                 }
             }
 
+            // The handlers are set up again while nothing is dispatched to them. What was read before is
+            // still delivered, to the handlers as they were set up when it was read.
+            _dispatcher.Halt();
+            Drain();
+
             for (auto& device : _inputDevices) {
                 device->Teardown();
                 device->Setup();
             }
+
+            _dispatcher.Run();
         }
         void Clear()
         {
-            for (std::map<string, std::pair<int, IDevInputDevice*>>::const_iterator it = _devices.begin(), end = _devices.end();
+            for (std::map<string, Device>::const_iterator it = _devices.begin(), end = _devices.end();
                  it != end; ++it) {
-                close(it->second.first);
+                epoll_ctl(_epoll, EPOLL_CTL_DEL, it->second.Descriptor, nullptr);
+                close(it->second.Descriptor);
             }
             _devices.clear();
         }
+        void Watch(const int fd, void* source)
+        {
+            struct epoll_event event;
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.ptr = source;
+
+            if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+                TRACE_L1("Could not watch descriptor %d, error: %d", fd, errno);
+            }
+        }
+        void Remove(const Device* device)
+        {
+            std::map<string, Device>::iterator index = _devices.begin();
+
+            while ((index != _devices.end()) && (&(index->second) != device)) {
+                ++index;
+            }
+
+            if (index != _devices.end()) {
+                TRACE_L1("Closing input device: %s", index->first.c_str());
+                epoll_ctl(_epoll, EPOLL_CTL_DEL, index->second.Descriptor, nullptr);
+                close(index->second.Descriptor);
+                _devices.erase(index);
+            }
+        }
         void Block()
         {
             Core::Thread::Block();
@@ -654,29 +796,19 @@ namespace Plugin {
         }
         virtual uint32_t Worker()
         {
-            while (IsRunning() == true) {
-                fd_set readset;
-                FD_ZERO(&readset);
-                FD_SET(_pipe[0], &readset);
-                FD_SET(_update, &readset);
+            struct epoll_event events[MaxWakeups];
 
-                int result = std::max(_pipe[0], _update);
-
-                // set up all the input devices
-                for (std::map<string, std::pair<int, IDevInputDevice*>>::const_iterator index = _devices.begin(), end = _devices.end(); index != end; ++index) {
-                    FD_SET(index->second.first, &readset);
-                    result = std::max(result, index->second.first);
-                }
+            while (IsRunning() == true) {
+                int result = epoll_wait(_epoll, events, MaxWakeups, -1);
 
-                result = select(result + 1, &readset, 0, 0, nullptr);
+                for (int index = 0; index < result; index++) {
+                    const void* source = events[index].data.ptr;
 
-                if (result > 0) {
-                    if (FD_ISSET(_pipe[0], &readset)) {
+                    if (source == &_pipe[0]) {
                         char buff;
                         (void)read(_pipe[0], &buff, 1);
-                    }
-                    if (FD_ISSET(_update, &readset)) {
-                        // Make the call to receive the device. select() ensured that this will not block.
+                    } else if (source == &_update) {
+                        // Make the call to receive the device. epoll_wait() ensured that this will not block.
                         udev_device* dev = udev_monitor_receive_device(_monitor);
                         if (dev) {
                             const char* nodeId = udev_device_get_devnode(dev);
@@ -687,49 +819,162 @@ namespace Plugin {
                                 Refresh();
                             }
                         }
+                    } else {
+                        Device* device = static_cast<Device*>(events[index].data.ptr);
+
+                        // Whatever was still pending is read before a hang up is acted upon.
+                        if ((HandleInput(*device) == false) || ((events[index].events & (EPOLLERR | EPOLLHUP)) != 0)) {
+                            // fd closed?
+                            Remove(device);
+                        }
                     }
+                }
+            }
+            return (Core::infinite);
+        }
+        static uint64_t Now()
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return ((static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000));
+        }
+        void Signal()
+        {
+            const uint64_t increment = 1;
+            (void)::write(_signal, &increment, sizeof(increment));
+        }
+        void Enqueue(const Event& event)
+        {
+            // Never drop input, if the dispatcher lags this far behind, wait for it.
+            while (_queue.Push(event) == false) {
+                Signal();
+                ::sched_yield();
+            }
+        }
+        void Enqueue(const uint64_t time, const uint16_t type, const uint16_t code, const int32_t value)
+        {
+            Event event;
+            event.Time = time;
+            event.Type = type;
+            event.Code = code;
+            event.Value = value;
+            Enqueue(event);
+        }
+        // The kernel dropped events, the keys that changed state in the meantime are reported as if the
+        // events had not been lost.
+        void Resync(Device& device)
+        {
+            uint8_t keys[sizeof(device.Keys)];
+            memset(keys, 0, sizeof(keys));
 
-                    // find the devices to read from
-                    std::map<string, std::pair<int, IDevInputDevice*>>::iterator index = _devices.begin();
+            if (ioctl(device.Descriptor, EVIOCGKEY(sizeof(keys)), keys) >= 0) {
+                const uint64_t now = Now();
+                bool changed = false;
 
-                    while (index != _devices.end()) {
-                        if (FD_ISSET(index->second.first, &readset)) {
+                for (uint16_t code = 0; code <= KEY_MAX; code++) {
+                    const uint8_t mask = (1 << (code & 7));
 
-                            if (HandleInput(index->second.first) == false) {
-                                // fd closed?
-                                close(index->second.first);
-                                index = _devices.erase(index);
-                            } else {
-                                ++index;
-                            }
-                        } else {
-                            ++index;
-                        }
+                    if (((device.Keys[code >> 3] ^ keys[code >> 3]) & mask) != 0) {
+                        Enqueue(now, EV_KEY, code, ((keys[code >> 3] & mask) != 0 ? 1 : 0));
+                        changed = true;
                     }
                 }
+
+                if (changed == true) {
+                    Enqueue(now, EV_SYN, SYN_REPORT, 0);
+                }
+
+                memcpy(device.Keys, keys, sizeof(keys));
             }
-            return (Core::infinite);
+
+            TRACE_L1("Input device %d dropped events, resynchronized", device.Descriptor);
         }
-        bool HandleInput(const int fd)
+        void Process(Device& device, const input_event& entry)
         {
-            input_event entry[16];
-            int index = 0;
-            int result = ::read(fd, entry, sizeof(entry));
-
-            if (result > 0) {
-                while (result >= static_cast<int>(sizeof(input_event))) {
-                    ASSERT(index < static_cast<int>((sizeof(entry) / sizeof(input_event))));
-                    for (auto& device : _inputDevices) {
-                        if (device->HandleInput(entry[index].code,  entry[index].type, entry[index].value) == true) {
-                            break;
-                        }
+            if ((entry.type == EV_SYN) && (entry.code == SYN_DROPPED)) {
+                device.Dropped = true;
+            } else if (device.Dropped == true) {
+                // Everything up to the next report belongs to an incomplete frame.
+                if ((entry.type == EV_SYN) && (entry.code == SYN_REPORT)) {
+                    device.Dropped = false;
+                    Resync(device);
+                }
+            } else {
+                if ((entry.type == EV_KEY) && (entry.code <= KEY_MAX)) {
+                    if (entry.value != 0) {
+                        device.Keys[entry.code >> 3] |= (1 << (entry.code & 7));
+                    } else {
+                        device.Keys[entry.code >> 3] &= ~(1 << (entry.code & 7));
                     }
-                    index++;
-                    result -= sizeof(input_event);
+                }
+
+#ifdef input_event_sec
+                Enqueue((static_cast<uint64_t>(entry.input_event_sec) * 1000000) + entry.input_event_usec, entry.type, entry.code, entry.value);
+#else
+                Enqueue((static_cast<uint64_t>(entry.time.tv_sec) * 1000000) + entry.time.tv_usec, entry.type, entry.code, entry.value);
+#endif
+            }
+        }
+        bool HandleInput(Device& device)
+        {
+            bool pending = false;
+            int result;
+
+            // Drain the device, evdev only hands out complete events.
+            while ((result = ::read(device.Descriptor, _buffer, sizeof(_buffer))) > 0) {
+                const uint16_t count = (result / sizeof(input_event));
+
+                for (uint16_t index = 0; index < count; index++) {
+                    Process(device, _buffer[index]);
+                }
+
+                pending = true;
+
+                if (static_cast<size_t>(result) < sizeof(_buffer)) {
+                    // A short read means the device is empty, save the read that would say so.
+                    break;
                 }
             }
 
-            return (result >= 0);
+            if (pending == true) {
+                // One wake up for the whole batch.
+                Signal();
+            }
+
+            return ((result > 0) || ((result < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))));
+        }
+        void Dispatch()
+        {
+            uint64_t pending;
+
+            if (::read(_signal, &pending, sizeof(pending)) == sizeof(pending)) {
+                Drain();
+            }
+        }
+        // Only to be called from the dispatcher, or while it is halted: the queue has a single consumer.
+        void Drain()
+        {
+            Remotes::LatencyHistogram& latency(Remotes::RemoteAdministrator::Instance().Latency());
+            Event event;
+
+            while (_queue.Pop(event) == true) {
+                bool handled = false;
+
+                for (auto& device : _inputDevices) {
+                    if (device->HandleInput(event.Code, event.Type, event.Value) == true) {
+                        handled = true;
+                        break;
+                    }
+                }
+
+                // Only events that were delivered count, a touch report is delivered on its EV_SYN.
+                if (handled == true) {
+                    const uint64_t now = Now();
+                    if (now >= event.Time) {
+                        latency.Record(now - event.Time);
+                    }
+                }
+            }
         }
         bool ReadDeviceName(const string& eventLocation, string& deviceName)
         {
@@ -757,14 +1002,19 @@ namespace Plugin {
             return status;
         }
 
-        std::map<string, std::pair<int, IDevInputDevice*>> Devices() { return _devices; }
+        const std::map<string, Device>& Devices() const { return _devices; }
 
     private:
-        std::map<string, std::pair<int, IDevInputDevice*>> _devices;
+        std::map<string, Device> _devices;
         int _pipe[2];
         udev_monitor* _monitor;
         int _update;
+        int _epoll;
+        input_event _buffer[EventBatch];
         std::vector<IDevInputDevice*> _inputDevices;
+        int _signal;
+        Remotes::EventQueue<Event, QueueSize> _queue;
+        Dispatcher _dispatcher;
         static LinuxDevice* _singleton;
     };
 
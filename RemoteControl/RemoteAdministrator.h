@@ -22,10 +22,101 @@
 #include "Module.h"
 #include <interfaces/IKeyHandler.h>
 
+#include <atomic>
+
 namespace WPEFramework {
 namespace Remotes {
 
+    // Time between the moment an input device reported an event and the moment it is dispatched, in
+    // power of 2 buckets of microseconds. Recording is lock free, it happens on the dispatching thread.
+    class LatencyHistogram {
+    public:
+        static constexpr uint8_t Buckets = 16;
+        static constexpr uint8_t FirstBucket = 4; // [0, 16us)
+
+    public:
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        LatencyHistogram()
+            : _count(0)
+            , _total(0)
+            , _maximum(0)
+        {
+            for (uint8_t index = 0; index < Buckets; index++) {
+                _buckets[index] = 0;
+            }
+        }
+        ~LatencyHistogram()
+        {
+        }
+
+    public:
+        // The upper limit of a bucket, in microseconds, the last one has none.
+        static uint32_t Limit(const uint8_t bucket)
+        {
+            return (bucket < (Buckets - 1) ? (1 << (FirstBucket + bucket)) : ~0);
+        }
+        void Record(const uint64_t microSeconds)
+        {
+            uint8_t bucket = 0;
+
+            while ((bucket < (Buckets - 1)) && (microSeconds >= Limit(bucket))) {
+                bucket++;
+            }
+
+            _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+            _total.fetch_add(microSeconds, std::memory_order_relaxed);
+
+            uint64_t maximum = _maximum.load(std::memory_order_relaxed);
+            while ((microSeconds > maximum) && (_maximum.compare_exchange_weak(maximum, microSeconds, std::memory_order_relaxed) == false)) {
+            }
+        }
+        uint32_t Count(const uint8_t bucket) const
+        {
+            return (_buckets[bucket].load(std::memory_order_relaxed));
+        }
+        uint32_t Count() const
+        {
+            return (_count.load(std::memory_order_relaxed));
+        }
+        uint64_t Average() const
+        {
+            const uint32_t count = _count.load(std::memory_order_relaxed);
+            return (count != 0 ? (_total.load(std::memory_order_relaxed) / count) : 0);
+        }
+        uint64_t Maximum() const
+        {
+            return (_maximum.load(std::memory_order_relaxed));
+        }
+
+    private:
+        std::atomic<uint32_t> _buckets[Buckets];
+        std::atomic<uint32_t> _count;
+        std::atomic<uint64_t> _total;
+        std::atomic<uint64_t> _maximum;
+    };
+
     class RemoteAdministrator {
+    private:
+        // Key producers announced get a handle, an index in this table, so their events can be
+        // dispatched without searching the producers or building a name for every key. The table is
+        // bound once, when the producer is announced. Slots are reused, so they are only read under
+        // the admin lock.
+        struct KeySlot {
+            KeySlot()
+                : Producer(nullptr)
+                , Handler(nullptr)
+                , Table()
+            {
+            }
+
+            Exchange::IKeyProducer* Producer;
+            Exchange::IKeyHandler* Handler;
+            string Table;
+        };
+
     private:
         RemoteAdministrator(const RemoteAdministrator&);
         RemoteAdministrator& operator=(const RemoteAdministrator&);
@@ -39,10 +130,15 @@ namespace Remotes {
             , _wheels()
             , _pointers()
             , _touchpanels()
+            , _keySlots()
+            , _latency()
         {
         }
 
     public:
+        static constexpr uint16_t InvalidHandle = static_cast<uint16_t>(~0);
+        static constexpr uint16_t MaxKeySlots = 16;
+
         typedef Core::IteratorType<std::list<Exchange::IKeyProducer*>, Exchange::IKeyProducer*> KeyIterator;
         typedef Core::IteratorType<std::list<Exchange::IWheelProducer*>, Exchange::IWheelProducer*> WheelIterator;
         typedef Core::IteratorType<std::list<Exchange::IPointerProducer*>, Exchange::IPointerProducer*> PointerIterator;
@@ -75,6 +171,40 @@ namespace Remotes {
         {
             return (TouchIterator(_touchpanels));
         }
+        inline LatencyHistogram& Latency()
+        {
+            return (_latency);
+        }
+        // The path for producers that hold a handle: no search and no name built per key. The slot is
+        // copied under the lock, the handler is called after it is released.
+        uint32_t KeyEvent(const uint16_t handle, const bool pressed, const uint32_t code)
+        {
+            uint32_t result = Core::ERROR_UNAVAILABLE;
+
+            if (handle < MaxKeySlots) {
+                Exchange::IKeyHandler* handler = nullptr;
+                string table;
+
+                _adminLock.Lock();
+
+                const KeySlot& slot(_keySlots[handle]);
+
+                if (slot.Handler != nullptr) {
+                    handler = slot.Handler;
+                    handler->AddRef();
+                    table = slot.Table;
+                }
+
+                _adminLock.Unlock();
+
+                if (handler != nullptr) {
+                    result = handler->KeyEvent(pressed, code, table);
+                    handler->Release();
+                }
+            }
+
+            return (result);
+        }
         uint32_t Error(const string& device)
         {
             uint32_t result = Core::ERROR_UNAVAILABLE;
@@ -226,8 +356,10 @@ namespace Remotes {
 
             return (result);
         }
-        void Announce(Exchange::IKeyProducer& remoteControl)
+        uint16_t Announce(Exchange::IKeyProducer& remoteControl)
         {
+            uint16_t handle = InvalidHandle;
+
             _adminLock.Lock();
 
             std::list<Exchange::IKeyProducer*>::iterator index(std::find(_remotes.begin(), _remotes.end(), &remoteControl));
@@ -238,12 +370,28 @@ namespace Remotes {
             if (index == _remotes.end()) {
                 _remotes.push_back(&remoteControl);
 
+                handle = 0;
+                while ((handle < MaxKeySlots) && (_keySlots[handle].Producer != nullptr)) {
+                    handle++;
+                }
+
+                // A producer without a slot still works, through the callback it is handed.
+                if (handle < MaxKeySlots) {
+                    _keySlots[handle].Producer = &remoteControl;
+                    _keySlots[handle].Table = remoteControl.Name();
+                    _keySlots[handle].Handler = _keyCallback;
+                } else {
+                    handle = InvalidHandle;
+                }
+
                 if (_keyCallback != nullptr) {
                     remoteControl.Callback(_keyCallback);
                 }
             }
 
             _adminLock.Unlock();
+
+            return (handle);
         }
         void Announce(Exchange::IWheelProducer& wheel)
         {
@@ -307,6 +455,7 @@ namespace Remotes {
 
             if (index != _remotes.end()) {
                 _remotes.erase(index);
+                Release(remoteControl);
 
                 if (_keyCallback != nullptr) {
                     remoteControl.Callback(nullptr);
@@ -379,6 +528,11 @@ namespace Remotes {
                     index++;
                 }
                 _remotes.clear();
+
+                for (KeySlot& slot : _keySlots) {
+                    slot.Handler = nullptr;
+                    slot.Producer = nullptr;
+                }
             }
 
             {
@@ -425,6 +579,12 @@ namespace Remotes {
             auto index(_remotes.begin());
             _keyCallback = callback;
 
+            for (KeySlot& slot : _keySlots) {
+                if (slot.Producer != nullptr) {
+                    slot.Handler = callback;
+                }
+            }
+
             while (index != _remotes.end()) {
                 uint32_t result = (*index)->Callback(callback);
 
@@ -517,6 +677,18 @@ namespace Remotes {
             _adminLock.Unlock();
         }
 
+    private:
+        void Release(const Exchange::IKeyProducer& remoteControl)
+        {
+            for (KeySlot& slot : _keySlots) {
+                if (slot.Producer == &remoteControl) {
+                    slot.Handler = nullptr;
+                    slot.Producer = nullptr;
+                    break;
+                }
+            }
+        }
+
     private:
         Core::CriticalSection _adminLock;
         Exchange::IKeyHandler* _keyCallback;
@@ -527,6 +699,8 @@ namespace Remotes {
         std::list<Exchange::IWheelProducer*> _wheels;
         std::list<Exchange::IPointerProducer*> _pointers;
         std::list<Exchange::ITouchProducer*> _touchpanels;
+        KeySlot _keySlots[MaxKeySlots];
+        LatencyHistogram _latency;
     };
 }
 }
@@ -143,6 +143,64 @@ namespace Plugin {
             Core::JSON::ArrayType<Link> Links;
         };
 
+        class LatencyData : public Core::JSON::Container {
+        public:
+            class BucketData : public Core::JSON::Container {
+            public:
+                BucketData& operator=(const BucketData&) = delete;
+
+                BucketData()
+                    : Core::JSON::Container()
+                    , Limit()
+                    , Count()
+                {
+                    Add(_T("limit"), &Limit);
+                    Add(_T("count"), &Count);
+                }
+                BucketData(const BucketData& copy)
+                    : Core::JSON::Container()
+                    , Limit(copy.Limit)
+                    , Count(copy.Count)
+                {
+                    Add(_T("limit"), &Limit);
+                    Add(_T("count"), &Count);
+                }
+                ~BucketData()
+                {
+                }
+
+            public:
+                Core::JSON::DecUInt32 Limit;
+                Core::JSON::DecUInt32 Count;
+            };
+
+        public:
+            LatencyData(const LatencyData&) = delete;
+            LatencyData& operator=(const LatencyData&) = delete;
+
+            LatencyData()
+                : Core::JSON::Container()
+                , Count()
+                , Average()
+                , Maximum()
+                , Buckets()
+            {
+                Add(_T("count"), &Count);
+                Add(_T("average"), &Average);
+                Add(_T("maximum"), &Maximum);
+                Add(_T("buckets"), &Buckets);
+            }
+            ~LatencyData()
+            {
+            }
+
+        public:
+            Core::JSON::DecUInt32 Count;
+            Core::JSON::DecUInt64 Average;
+            Core::JSON::DecUInt64 Maximum;
+            Core::JSON::ArrayType<BucketData> Buckets;
+        };
+
         class Data : public Core::JSON::Container {
 
         private:
@@ -349,6 +407,7 @@ namespace Plugin {
         uint32_t endpoint_unpair(const JsonData::RemoteControl::UnpairParamsData& params);
         uint32_t get_devices(Core::JSON::ArrayType<Core::JSON::String>& response) const;
         uint32_t get_device(const string& index, JsonData::RemoteControl::DeviceData& response) const;
+        uint32_t get_latency(LatencyData& response) const;
 
     private:
         uint32_t _skipURL;
@@ -46,6 +46,7 @@ namespace Plugin {
         Register<UnpairParamsData,void>(_T("unpair"), &RemoteControl::endpoint_unpair, this);
         Property<Core::JSON::ArrayType<Core::JSON::String>>(_T("devices"), &RemoteControl::get_devices, nullptr, this);
         Property<DeviceData>(_T("device"), &RemoteControl::get_device, nullptr, this);
+        Property<LatencyData>(_T("latency"), &RemoteControl::get_latency, nullptr, this);
     }
 
     void RemoteControl::UnregisterAll()
@@ -61,6 +62,7 @@ namespace Plugin {
         Unregister(_T("press"));
         Unregister(_T("send"));
         Unregister(_T("key"));
+        Unregister(_T("latency"));
         Unregister(_T("device"));
         Unregister(_T("devices"));
     }
@@ -153,6 +155,26 @@ namespace Plugin {
        return Core::ERROR_NONE;
    }
 
+   // Property: latency - Time between an input device reporting an event and its dispatch
+   // Return codes:
+   //  - ERROR_NONE: Success
+   uint32_t RemoteControl::get_latency(LatencyData& response) const
+   {
+       const Remotes::LatencyHistogram& latency(Remotes::RemoteAdministrator::Instance().Latency());
+
+       response.Count = latency.Count();
+       response.Average = latency.Average();
+       response.Maximum = latency.Maximum();
+
+       for (uint8_t bucket = 0; bucket < Remotes::LatencyHistogram::Buckets; bucket++) {
+           LatencyData::BucketData& entry(response.Buckets.Add());
+           entry.Limit = Remotes::LatencyHistogram::Limit(bucket);
+           entry.Count = latency.Count(bucket);
+       }
+
+       return Core::ERROR_NONE;
+   }
+
    uint32_t RemoteControl::get_device(const string& index, DeviceData& response) const
    {
        uint32_t result = Core::ERROR_NONE;
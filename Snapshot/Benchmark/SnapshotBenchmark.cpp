@@ -0,0 +1,248 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Encoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Measures the time it takes the Snapshot plugin to turn a frame into a file, without the need
+// for capture hardware. Frames are synthetic, in the B8_G8_R8_A8 layout the capture devices
+// hand over, and come in three flavours to cover the range of content a UI produces:
+//   ui:       flat areas and a few gradients, compresses well (a typical menu screen)
+//   gradient: smooth colour ramps over the whole frame
+//   noise:    random pixels, the worst case for every format
+
+using namespace WPEFramework::Plugin;
+
+namespace {
+
+    struct Options {
+        Options()
+            : Width(1920)
+            , Height(1080)
+            , Iterations(10)
+            , Content("ui")
+            , Output("/tmp/SnapshotBenchmark")
+            , Formats("png,qoi,ppm")
+            , Levels({ 1, 6 })
+            , Filter(Encoder::FILTER_ADAPTIVE)
+            , Strips({ 1, 2, 4 })
+        {
+        }
+
+        uint32_t Width;
+        uint32_t Height;
+        uint32_t Iterations;
+        std::string Content;
+        std::string Output;
+        std::string Formats;
+        std::vector<uint8_t> Levels;
+        Encoder::filter Filter;
+        std::vector<uint8_t> Strips;
+    };
+
+    void Generate(const std::string& content, const uint32_t width, const uint32_t height, std::vector<uint8_t>& frame)
+    {
+        frame.resize(width * height * 4);
+        uint8_t* pixel = frame.data();
+        uint32_t seed = 0x12345678;
+
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++, pixel += 4) {
+                if (content == "noise") {
+                    seed = (seed * 1103515245) + 12345;
+                    pixel[0] = static_cast<uint8_t>(seed >> 16);
+                    pixel[1] = static_cast<uint8_t>(seed >> 8);
+                    pixel[2] = static_cast<uint8_t>(seed >> 24);
+                } else if (content == "gradient") {
+                    pixel[0] = static_cast<uint8_t>((x * 255) / width);
+                    pixel[1] = static_cast<uint8_t>((y * 255) / height);
+                    pixel[2] = static_cast<uint8_t>(((x + y) * 255) / (width + height));
+                } else {
+                    // A background gradient with a grid of flat tiles on top of it.
+                    const bool tile = (((x / 64) % 4) != 0) && (((y / 48) % 3) != 0);
+                    pixel[0] = (tile ? 0x30 : static_cast<uint8_t>(0x40 + ((y * 64) / height)));
+                    pixel[1] = (tile ? 0x30 : 0x20);
+                    pixel[2] = (tile ? static_cast<uint8_t>(0x80 + ((x / 64) * 8)) : 0x20);
+                }
+                pixel[3] = 0xFF;
+            }
+        }
+    }
+
+    void ParseList(const char* text, std::vector<uint8_t>& list)
+    {
+        list.clear();
+
+        while ((text != nullptr) && (*text != '\0')) {
+            char* end;
+            unsigned long value = ::strtoul(text, &end, 10);
+
+            if (end == text) {
+                break;
+            }
+            list.push_back(static_cast<uint8_t>(std::min(value, 255UL)));
+            text = (*end == ',' ? end + 1 : end);
+        }
+    }
+
+    bool Selected(const std::string& list, const char name[])
+    {
+        size_t start = 0;
+        bool found = false;
+
+        while ((found == false) && (start <= list.length())) {
+            size_t end = list.find(',', start);
+            if (end == std::string::npos) {
+                end = list.length();
+            }
+            found = (list.compare(start, end - start, name) == 0);
+            start = end + 1;
+        }
+
+        return (found);
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-width") == 0)) {
+                options.Width = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-height") == 0)) {
+                options.Height = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-iterations") == 0)) {
+                options.Iterations = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-content") == 0)) {
+                options.Content = argv[++index];
+            } else if ((value == true) && (strcmp(argv[index], "-output") == 0)) {
+                options.Output = argv[++index];
+            } else if ((value == true) && (strcmp(argv[index], "-formats") == 0)) {
+                options.Formats = argv[++index];
+            } else if ((value == true) && (strcmp(argv[index], "-levels") == 0)) {
+                ParseList(argv[++index], options.Levels);
+            } else if ((value == true) && (strcmp(argv[index], "-filter") == 0)) {
+                showHelp = !Encoder::Filter(argv[++index], options.Filter);
+            } else if ((value == true) && (strcmp(argv[index], "-strips") == 0)) {
+                ParseList(argv[++index], options.Strips);
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Width == 0) || (options.Height == 0) || (options.Iterations == 0) || (options.Levels.empty() == true) || (options.Strips.empty() == true));
+    }
+
+    void ShowHelp()
+    {
+        printf("SnapshotBenchmark [options]\n"
+               "\t-width <pixels>           Frame width [1920]\n"
+               "\t-height <pixels>          Frame height [1080]\n"
+               "\t-iterations <count>       Captures per configuration [10]\n"
+               "\t-content <ui|gradient|noise> Synthetic frame content [ui]\n"
+               "\t-output <path>            File written, the extension is added [/tmp/SnapshotBenchmark]\n"
+               "\t-formats <list>           Any of png,qoi,ppm [all]\n"
+               "\t-levels <list>            PNG compression levels [1,6]\n"
+               "\t-filter <name>            PNG filter: none, sub, up, average, paeth or adaptive [adaptive]\n"
+               "\t-strips <list>            Strips encoded concurrently [1,2,4]\n");
+    }
+
+    bool Measure(const Options& options, const Encoder& encoder, const std::vector<uint8_t>& frame, const uint8_t level, const uint8_t strips)
+    {
+        const std::string fileName(options.Output + '.' + encoder.Extension());
+        std::vector<double> durations;
+        long size = 0;
+        bool result = true;
+
+        durations.reserve(options.Iterations);
+
+        for (uint32_t run = 0; (run < options.Iterations) && (result == true); run++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            FILE* file = fopen(fileName.c_str(), "wb");
+            result = encoder.Encode(file, frame.data(), options.Width, options.Height);
+
+            if (file != nullptr) {
+                size = ftell(file);
+                fclose(file);
+            }
+
+            durations.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        if (result == false) {
+            fprintf(stderr, "Encoding to %s failed.\n", fileName.c_str());
+        } else {
+            std::sort(durations.begin(), durations.end());
+
+            double total = 0;
+            for (const double duration : durations) {
+                total += duration;
+            }
+
+            printf("%s,%s,%u,%u,%u,%u,%u,%.2f,%.2f,%.2f,%.2f,%ld\n",
+                encoder.Extension(), options.Content.c_str(), options.Width, options.Height,
+                (encoder.Format() == Encoder::PNG ? level : 0), strips, options.Iterations,
+                durations.front(), durations[durations.size() / 2], total / durations.size(), durations.back(), size);
+        }
+
+        return (result);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    std::vector<uint8_t> frame;
+    Generate(options.Content, options.Width, options.Height, frame);
+
+    printf("format,content,width,height,level,strips,iterations,min_ms,p50_ms,avg_ms,max_ms,bytes\n");
+
+    static const Encoder::format formats[] = { Encoder::PNG, Encoder::QOI, Encoder::PPM };
+    bool result = true;
+
+    for (const Encoder::format format : formats) {
+        if (Selected(options.Formats, Encoder(format, 0, options.Filter, 1).Extension()) == true) {
+            // Only PNG has a compression level, for the others the first entry will do.
+            const size_t levels = (format == Encoder::PNG ? options.Levels.size() : 1);
+
+            for (size_t level = 0; level < levels; level++) {
+                for (const uint8_t strips : options.Strips) {
+                    Encoder encoder(format, options.Levels[level], options.Filter, strips);
+                    result = Measure(options, encoder, frame, options.Levels[level], strips) && result;
+                }
+            }
+        }
+    }
+
+    return (result == true ? 0 : 1);
+}
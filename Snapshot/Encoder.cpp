@@ -0,0 +1,608 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Encoder.h"
+
+#include <png.h>
+#include <zlib.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    namespace {
+
+        constexpr uint8_t SourcePixel = 4; // B8_G8_R8_A8
+        constexpr uint8_t TargetPixel = 3; // R8_G8_B8
+        constexpr size_t FlushSize = 64 * 1024;
+
+        // Collects encoded bytes. With a file attached the content is streamed out in FlushSize
+        // pieces, without one it is kept, so strips can be encoded concurrently and written in
+        // order afterwards.
+        class Output {
+        private:
+            Output(const Output&) = delete;
+            Output& operator=(const Output&) = delete;
+
+        public:
+            Output(FILE* file)
+                : _file(file)
+                , _data()
+                , _failed(false)
+            {
+                _data.reserve(FlushSize);
+            }
+            Output(Output&&) = default;
+            ~Output()
+            {
+            }
+
+        public:
+            inline void Put(const uint8_t value)
+            {
+                _data.push_back(value);
+
+                if ((_file != nullptr) && (_data.size() >= FlushSize)) {
+                    Flush();
+                }
+            }
+            inline void Write(const uint8_t data[], const size_t length)
+            {
+                _data.insert(_data.end(), data, data + length);
+
+                if ((_file != nullptr) && (_data.size() >= FlushSize)) {
+                    Flush();
+                }
+            }
+            bool Flush()
+            {
+                if ((_file != nullptr) && (_data.empty() == false)) {
+                    _failed = _failed || (::fwrite(_data.data(), 1, _data.size(), _file) != _data.size());
+                    _data.clear();
+                }
+                return (_failed == false);
+            }
+            const std::vector<uint8_t>& Data() const
+            {
+                return (_data);
+            }
+
+        private:
+            FILE* _file;
+            std::vector<uint8_t> _data;
+            bool _failed;
+        };
+
+        inline void ToRGB(const uint8_t source[], const uint32_t width, uint8_t target[])
+        {
+            for (uint32_t index = 0; index < width; index++, source += SourcePixel, target += TargetPixel) {
+                target[0] = source[2];
+                target[1] = source[1];
+                target[2] = source[0];
+            }
+        }
+
+        inline void BigEndian(uint8_t target[], const uint32_t value)
+        {
+            target[0] = static_cast<uint8_t>(value >> 24);
+            target[1] = static_cast<uint8_t>(value >> 16);
+            target[2] = static_cast<uint8_t>(value >> 8);
+            target[3] = static_cast<uint8_t>(value);
+        }
+
+        // Runs work(0) .. work(count - 1), all but the first one on their own thread.
+        template <typename WORK>
+        void Parallel(const uint8_t count, WORK&& work)
+        {
+            std::vector<std::thread> workers;
+            workers.reserve(count);
+
+            for (uint8_t index = 1; index < count; index++) {
+                workers.emplace_back(work, index);
+            }
+
+            work(0);
+
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        // PPM
+        // -----------------------------------------------------------------------------------------------
+        void EncodePPM(const uint8_t buffer[], const uint32_t width, const uint32_t first, const uint32_t last, Output& output)
+        {
+            std::vector<uint8_t> row(width * TargetPixel);
+
+            for (uint32_t line = first; line < last; line++) {
+                ToRGB(&buffer[line * width * SourcePixel], width, row.data());
+                output.Write(row.data(), row.size());
+            }
+        }
+
+        // QOI, see https://qoiformat.org/qoi-specification.pdf
+        // -----------------------------------------------------------------------------------------------
+        // A strip starts with an empty colour index and with the last pixel of the previous strip as
+        // the previous pixel. Index slots are only referenced once this strip has filled them, and
+        // a decoder fills them the same way, so the strips concatenate into one valid stream.
+        void EncodeQOI(const uint8_t buffer[], const uint32_t width, const uint32_t first, const uint32_t last, Output& output)
+        {
+            uint32_t index[64];
+            uint64_t valid = 0;
+            uint8_t run = 0;
+
+            const uint8_t* pixel = &buffer[first * width * SourcePixel];
+            const uint8_t* end = &buffer[last * width * SourcePixel];
+
+            uint8_t previous[3] = { 0, 0, 0 };
+            if (first != 0) {
+                previous[0] = pixel[-2];
+                previous[1] = pixel[-3];
+                previous[2] = pixel[-4];
+            }
+
+            for (; pixel != end; pixel += SourcePixel) {
+                const uint8_t r = pixel[2];
+                const uint8_t g = pixel[1];
+                const uint8_t b = pixel[0];
+
+                if ((r == previous[0]) && (g == previous[1]) && (b == previous[2])) {
+                    if (++run == 62) {
+                        output.Put(0xC0 | (run - 1));
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run != 0) {
+                    output.Put(0xC0 | (run - 1));
+                    run = 0;
+                }
+
+                // Alpha is always 255: 255 * 11 contributes 53 to the hash.
+                const uint8_t slot = static_cast<uint8_t>(((r * 3) + (g * 5) + (b * 7) + 53) & 0x3F);
+                const uint32_t colour = (r << 16) | (g << 8) | b;
+
+                if (((valid & (1ULL << slot)) != 0) && (index[slot] == colour)) {
+                    output.Put(slot);
+                } else {
+                    index[slot] = colour;
+                    valid |= (1ULL << slot);
+
+                    const int8_t dr = static_cast<int8_t>(r - previous[0]);
+                    const int8_t dg = static_cast<int8_t>(g - previous[1]);
+                    const int8_t db = static_cast<int8_t>(b - previous[2]);
+                    const int8_t drdg = static_cast<int8_t>(dr - dg);
+                    const int8_t dbdg = static_cast<int8_t>(db - dg);
+
+                    if ((dr >= -2) && (dr <= 1) && (dg >= -2) && (dg <= 1) && (db >= -2) && (db <= 1)) {
+                        output.Put(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+                    } else if ((dg >= -32) && (dg <= 31) && (drdg >= -8) && (drdg <= 7) && (dbdg >= -8) && (dbdg <= 7)) {
+                        output.Put(0x80 | (dg + 32));
+                        output.Put(((drdg + 8) << 4) | (dbdg + 8));
+                    } else {
+                        const uint8_t literal[] = { 0xFE, r, g, b };
+                        output.Write(literal, sizeof(literal));
+                    }
+                }
+
+                previous[0] = r;
+                previous[1] = g;
+                previous[2] = b;
+            }
+
+            if (run != 0) {
+                output.Put(0xC0 | (run - 1));
+            }
+        }
+
+        // PNG, strip wise (pigz style): every strip is a raw deflate stream ending on a byte boundary
+        // (Z_SYNC_FLUSH), only the last one is finished. Concatenated they form the zlib payload.
+        // -----------------------------------------------------------------------------------------------
+        inline uint8_t Paeth(const uint8_t a, const uint8_t b, const uint8_t c)
+        {
+            const int p = a + b - c;
+            const int pa = abs(p - a);
+            const int pb = abs(p - b);
+            const int pc = abs(p - c);
+            return ((pa <= pb) && (pa <= pc) ? a : (pb <= pc ? b : c));
+        }
+
+        // Returns the sum of the filtered bytes taken as signed values, the usual heuristic to pick
+        // a filter for a row.
+        uint32_t FilterRow(const Encoder::filter type, const uint8_t row[], const uint8_t prior[], const uint32_t length, uint8_t target[])
+        {
+            uint32_t cost = 0;
+
+            target[0] = static_cast<uint8_t>(type);
+            target++;
+
+            for (uint32_t index = 0; index < length; index++) {
+                const uint8_t a = (index >= TargetPixel ? row[index - TargetPixel] : 0);
+                const uint8_t b = (prior != nullptr ? prior[index] : 0);
+                const uint8_t c = ((prior != nullptr) && (index >= TargetPixel) ? prior[index - TargetPixel] : 0);
+                uint8_t value = row[index];
+
+                switch (type) {
+                case Encoder::FILTER_SUB:
+                    value -= a;
+                    break;
+                case Encoder::FILTER_UP:
+                    value -= b;
+                    break;
+                case Encoder::FILTER_AVERAGE:
+                    value -= static_cast<uint8_t>((a + b) >> 1);
+                    break;
+                case Encoder::FILTER_PAETH:
+                    value -= Paeth(a, b, c);
+                    break;
+                default:
+                    break;
+                }
+
+                target[index] = value;
+                cost += abs(static_cast<int8_t>(value));
+            }
+
+            return (cost);
+        }
+
+        bool Deflate(z_stream& stream, std::vector<uint8_t>& output, size_t& used, const int flush)
+        {
+            int result = Z_OK;
+            bool done = false;
+
+            while ((done == false) && ((result == Z_OK) || (result == Z_BUF_ERROR))) {
+                if ((output.size() - used) < (16 * 1024)) {
+                    output.resize(output.size() + FlushSize);
+                }
+
+                stream.next_out = &output[used];
+                stream.avail_out = static_cast<uInt>(output.size() - used);
+
+                result = deflate(&stream, flush);
+                used = output.size() - stream.avail_out;
+
+                if (flush == Z_FINISH) {
+                    done = (result == Z_STREAM_END);
+                } else {
+                    done = ((stream.avail_in == 0) && (stream.avail_out != 0));
+                }
+            }
+
+            return (done);
+        }
+
+        struct Strip {
+            Strip()
+                : Data()
+                , Adler(adler32(0, nullptr, 0))
+                , Length(0)
+                , Failed(false)
+            {
+            }
+
+            std::vector<uint8_t> Data;
+            uLong Adler;
+            uLong Length;
+            bool Failed;
+        };
+
+        void DeflateStrip(const uint8_t buffer[], const uint32_t width, const uint32_t first, const uint32_t last,
+            const int level, const Encoder::filter type, const bool final, Strip& strip)
+        {
+            const uint32_t length = width * TargetPixel;
+            std::vector<uint8_t> rows(2 * length);
+            std::vector<uint8_t> filtered(2 * (length + 1));
+            uint8_t* current = &rows[0];
+            uint8_t* prior = nullptr;
+            size_t used = 0;
+
+            z_stream stream;
+            ::memset(&stream, 0, sizeof(stream));
+
+            if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                strip.Failed = true;
+                return;
+            }
+
+            if (first != 0) {
+                // Up, Average and Paeth look at the row above, also for the first row of a strip.
+                prior = &rows[length];
+                ToRGB(&buffer[(first - 1) * width * SourcePixel], width, prior);
+            }
+
+            for (uint32_t line = first; (line < last) && (strip.Failed == false); line++) {
+                uint8_t* best = &filtered[0];
+
+                ToRGB(&buffer[line * width * SourcePixel], width, current);
+
+                if (type != Encoder::FILTER_ADAPTIVE) {
+                    FilterRow(type, current, prior, length, best);
+                } else {
+                    uint8_t* candidate = &filtered[length + 1];
+                    uint32_t lowest = FilterRow(Encoder::FILTER_NONE, current, prior, length, best);
+
+                    for (uint8_t index = Encoder::FILTER_SUB; index <= Encoder::FILTER_PAETH; index++) {
+                        uint32_t cost = FilterRow(static_cast<Encoder::filter>(index), current, prior, length, candidate);
+                        if (cost < lowest) {
+                            lowest = cost;
+                            std::swap(best, candidate);
+                        }
+                    }
+                }
+
+                strip.Adler = adler32(strip.Adler, best, length + 1);
+                strip.Length += length + 1;
+
+                stream.next_in = best;
+                stream.avail_in = length + 1;
+                strip.Failed = !Deflate(stream, strip.Data, used, Z_NO_FLUSH);
+
+                prior = current;
+                current = (current == &rows[0] ? &rows[length] : &rows[0]);
+            }
+
+            if (strip.Failed == false) {
+                strip.Failed = !Deflate(stream, strip.Data, used, (final ? Z_FINISH : Z_SYNC_FLUSH));
+            }
+
+            strip.Data.resize(used);
+            deflateEnd(&stream);
+        }
+
+        struct Part {
+            const uint8_t* Data;
+            size_t Length;
+        };
+
+        bool WriteChunk(FILE* file, const char type[4], const Part parts[], const uint8_t count)
+        {
+            uint8_t header[8];
+            uint8_t trailer[4];
+            size_t length = 0;
+
+            for (uint8_t index = 0; index < count; index++) {
+                length += parts[index].Length;
+            }
+
+            BigEndian(header, static_cast<uint32_t>(length));
+            ::memcpy(&header[4], type, 4);
+
+            uLong crc = crc32(crc32(0, nullptr, 0), &header[4], 4);
+            bool result = (::fwrite(header, 1, sizeof(header), file) == sizeof(header));
+
+            for (uint8_t index = 0; (index < count) && (result == true); index++) {
+                if (parts[index].Length != 0) {
+                    crc = crc32(crc, parts[index].Data, static_cast<uInt>(parts[index].Length));
+                    result = (::fwrite(parts[index].Data, 1, parts[index].Length, file) == parts[index].Length);
+                }
+            }
+
+            BigEndian(trailer, static_cast<uint32_t>(crc));
+
+            return ((result == true) && (::fwrite(trailer, 1, sizeof(trailer), file) == sizeof(trailer)));
+        }
+    }
+
+    /* static */ bool Encoder::Format(const std::string& name, format& value)
+    {
+        bool result = true;
+
+        if (name == "png") {
+            value = PNG;
+        } else if (name == "qoi") {
+            value = QOI;
+        } else if (name == "ppm") {
+            value = PPM;
+        } else {
+            result = false;
+        }
+
+        return (result);
+    }
+
+    /* static */ bool Encoder::Filter(const std::string& name, filter& value)
+    {
+        static const char* const names[] = { "none", "sub", "up", "average", "paeth", "adaptive" };
+
+        bool result = false;
+
+        for (uint8_t index = 0; (index < (sizeof(names) / sizeof(names[0]))) && (result == false); index++) {
+            if (name == names[index]) {
+                value = static_cast<filter>(index);
+                result = true;
+            }
+        }
+
+        return (result);
+    }
+
+    bool Encoder::Encode(FILE* file, const uint8_t buffer[], const uint32_t width, const uint32_t height) const
+    {
+        bool result = false;
+
+        if (file != nullptr) {
+            if ((_format == PNG) && ((_strips == 1) || (height <= 1))) {
+                result = EncodePNG(file, buffer, width, height);
+            } else {
+                result = EncodeStrips(file, buffer, width, height);
+            }
+        }
+
+        return (result);
+    }
+
+    // Single threaded PNG, through libpng. The capture rows are handed over as they are, libpng
+    // swaps the colours and strips the alpha while it filters, so no copy of the frame is made.
+    bool Encoder::EncodePNG(FILE* file, const uint8_t buffer[], const uint32_t width, const uint32_t height) const
+    {
+        static const int filters[] = { PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP, PNG_FILTER_AVG, PNG_FILTER_PAETH, PNG_ALL_FILTERS };
+
+        png_structp pngPointer = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+        if (pngPointer == nullptr) {
+            return (false);
+        }
+
+        png_infop infoPointer = png_create_info_struct(pngPointer);
+        if (infoPointer == nullptr) {
+            png_destroy_write_struct(&pngPointer, nullptr);
+            return (false);
+        }
+
+        // Set up error handling.
+        if (setjmp(png_jmpbuf(pngPointer))) {
+            png_destroy_write_struct(&pngPointer, &infoPointer);
+            return (false);
+        }
+
+        png_init_io(pngPointer, file);
+        png_set_IHDR(pngPointer,
+            infoPointer,
+            width,
+            height,
+            8,
+            PNG_COLOR_TYPE_RGB,
+            PNG_INTERLACE_NONE,
+            PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+        png_set_compression_level(pngPointer, _level);
+        png_set_filter(pngPointer, PNG_FILTER_TYPE_BASE, filters[_filter]);
+        png_write_info(pngPointer, infoPointer);
+
+        png_set_bgr(pngPointer);
+        png_set_filler(pngPointer, 0, PNG_FILLER_AFTER);
+
+        for (uint32_t line = 0; line < height; line++) {
+            png_write_row(pngPointer, const_cast<png_bytep>(&buffer[line * width * SourcePixel]));
+        }
+
+        png_write_end(pngPointer, nullptr);
+        png_destroy_write_struct(&pngPointer, &infoPointer);
+
+        return (true);
+    }
+
+    bool Encoder::EncodeStrips(FILE* file, const uint8_t buffer[], const uint32_t width, const uint32_t height) const
+    {
+        const uint32_t rows = (height == 0 ? 1 : (height + _strips - 1) / _strips);
+        const uint8_t count = static_cast<uint8_t>(height == 0 ? 1 : (height + rows - 1) / rows);
+        bool result = true;
+
+        if (_format == PNG) {
+            std::vector<Strip> strips(count);
+
+            Parallel(count, [&](const uint8_t index) {
+                const uint32_t first = index * rows;
+                const uint32_t last = (first + rows < height ? first + rows : height);
+                DeflateStrip(buffer, width, first, last, _level, _filter, (index == (count - 1)), strips[index]);
+            });
+
+            static const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+            uint8_t header[13] = { 0, 0, 0, 0, 0, 0, 0, 0, 8, PNG_COLOR_TYPE_RGB, 0, 0, 0 };
+            BigEndian(&header[0], width);
+            BigEndian(&header[4], height);
+
+            // zlib header: deflate with a 32K window, the level is informational only.
+            uint8_t zlib[2] = { 0x78, static_cast<uint8_t>((_level < 2 ? 0 : (_level < 6 ? 1 : (_level == 6 ? 2 : 3))) << 6) };
+            zlib[1] |= static_cast<uint8_t>(31 - (((zlib[0] << 8) | zlib[1]) % 31));
+
+            uLong adler = strips[0].Adler;
+            for (uint8_t index = 1; index < count; index++) {
+                adler = adler32_combine(adler, strips[index].Adler, static_cast<z_off_t>(strips[index].Length));
+            }
+            uint8_t checksum[4];
+            BigEndian(checksum, static_cast<uint32_t>(adler));
+
+            const Part ihdr[] = { { header, sizeof(header) } };
+            result = (::fwrite(signature, 1, sizeof(signature), file) == sizeof(signature)) && WriteChunk(file, "IHDR", ihdr, 1);
+
+            for (uint8_t index = 0; (index < count) && (result == true); index++) {
+                const Part idat[] = {
+                    { zlib, (index == 0 ? sizeof(zlib) : 0) },
+                    { strips[index].Data.data(), strips[index].Data.size() },
+                    { checksum, (index == (count - 1) ? sizeof(checksum) : 0) }
+                };
+
+                result = (strips[index].Failed == false) && WriteChunk(file, "IDAT", idat, 3);
+            }
+
+            result = result && WriteChunk(file, "IEND", nullptr, 0);
+        } else {
+            static const uint8_t trailer[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+            Output output(file);
+
+            if (_format == PPM) {
+                char header[32];
+                int length = ::snprintf(header, sizeof(header), "P6\n%u %u\n255\n", width, height);
+                output.Write(reinterpret_cast<const uint8_t*>(header), length);
+            } else {
+                uint8_t header[14] = { 'q', 'o', 'i', 'f', 0, 0, 0, 0, 0, 0, 0, 0, 3, 0 };
+                BigEndian(&header[4], width);
+                BigEndian(&header[8], height);
+                output.Write(header, sizeof(header));
+            }
+
+            auto encode = [&](const uint8_t index, Output& target) {
+                const uint32_t first = index * rows;
+                const uint32_t last = (first + rows < height ? first + rows : height);
+
+                if (_format == PPM) {
+                    EncodePPM(buffer, width, first, last, target);
+                } else {
+                    EncodeQOI(buffer, width, first, last, target);
+                }
+            };
+
+            if (count <= 1) {
+                // Nothing to split, stream straight into the file.
+                encode(0, output);
+            } else {
+                std::vector<Output> strips;
+                strips.reserve(count);
+
+                for (uint8_t index = 0; index < count; index++) {
+                    strips.emplace_back(nullptr);
+                }
+
+                Parallel(count, [&](const uint8_t index) {
+                    encode(index, strips[index]);
+                });
+
+                for (const Output& strip : strips) {
+                    output.Write(strip.Data().data(), strip.Data().size());
+                }
+            }
+
+            if (_format == QOI) {
+                output.Write(trailer, sizeof(trailer));
+            }
+
+            result = output.Flush();
+        }
+
+        return (result);
+    }
+
+} // Namespace Plugin.
+}
@@ -0,0 +1,107 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __SNAPSHOT_ENCODER_H
+#define __SNAPSHOT_ENCODER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Turns a captured frame (4 bytes per pixel, blue first, alpha ignored) into an image file.
+    // The encoder works straight from the capture buffer, rows are never copied up front, and
+    // it can split the frame in horizontal strips that are encoded concurrently. It deliberately
+    // has no dependencies on the framework, so it can be driven by the benchmark as well.
+    class Encoder {
+    public:
+        enum format {
+            PNG,
+            QOI,
+            PPM
+        };
+
+        // PNG row filters, values match the PNG filter type byte.
+        enum filter {
+            FILTER_NONE = 0,
+            FILTER_SUB = 1,
+            FILTER_UP = 2,
+            FILTER_AVERAGE = 3,
+            FILTER_PAETH = 4,
+            FILTER_ADAPTIVE = 5
+        };
+
+        static constexpr uint8_t MaxStrips = 16;
+
+    public:
+        Encoder(const Encoder&) = default;
+        Encoder& operator=(const Encoder&) = default;
+
+        Encoder()
+            : _format(PNG)
+            , _level(6)
+            , _filter(FILTER_ADAPTIVE)
+            , _strips(1)
+        {
+        }
+        Encoder(const format type, const uint8_t level, const filter rowFilter, const uint8_t strips)
+            : _format(type)
+            , _level(level > 9 ? 9 : level)
+            , _filter(rowFilter)
+            , _strips(strips == 0 ? 1 : (strips > MaxStrips ? MaxStrips : strips))
+        {
+        }
+        ~Encoder()
+        {
+        }
+
+    public:
+        inline format Format() const
+        {
+            return (_format);
+        }
+        inline const char* Extension() const
+        {
+            return (_format == PNG ? "png" : (_format == QOI ? "qoi" : "ppm"));
+        }
+
+        // Unknown names leave the value untouched and return false.
+        static bool Format(const std::string& name, format& value);
+        static bool Filter(const std::string& name, filter& value);
+
+        // Buffer holds height rows of width B8_G8_R8_A8 pixels, without padding.
+        bool Encode(FILE* file, const uint8_t buffer[], const uint32_t width, const uint32_t height) const;
+
+    private:
+        bool EncodePNG(FILE* file, const uint8_t buffer[], const uint32_t width, const uint32_t height) const;
+        bool EncodeStrips(FILE* file, const uint8_t buffer[], const uint32_t width, const uint32_t height) const;
+
+    private:
+        format _format;
+        uint8_t _level;
+        filter _filter;
+        uint8_t _strips;
+    };
+
+} // Namespace Plugin.
+}
+
+#endif // __SNAPSHOT_ENCODER_H
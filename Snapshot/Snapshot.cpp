@@ -19,8 +19,6 @@
  
 #include "Snapshot.h"
 
-#include <png.h>
-
 namespace WPEFramework {
 namespace Plugin {
 
@@ -33,8 +31,9 @@ namespace Plugin {
         StoreImpl& operator=(const StoreImpl&) = delete;
 
     public:
-        StoreImpl(Core::BinairySemaphore& inProgress, const string& path)
+        StoreImpl(Core::BinairySemaphore& inProgress, const string& path, const Encoder& encoder)
             : _file(FileBodyExtended::Instance(inProgress, path))
+            , _encoder(encoder)
         {
         }
 
@@ -44,80 +43,18 @@ namespace Plugin {
 
         virtual bool R8_G8_B8_A8(const unsigned char* buffer, const unsigned int width, const unsigned int height)
         {
-
-            png_structp pngPointer = nullptr;
             bool result = false;
 
-            pngPointer = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-            if (pngPointer == nullptr) {
-
-                return result;
-            }
-
-            png_infop infoPointer = nullptr;
-            infoPointer = png_create_info_struct(pngPointer);
-            if (infoPointer == nullptr) {
-
-                png_destroy_write_struct(&pngPointer, &infoPointer);
-                return result;
-            }
-
-            // Set up error handling.
-            if (setjmp(png_jmpbuf(pngPointer))) {
-
-                png_destroy_write_struct(&pngPointer, &infoPointer);
-                return result;
-            }
-
-            // Set image attributes.
-            int depth = 8;
-            png_set_IHDR(pngPointer,
-                infoPointer,
-                width,
-                height,
-                depth,
-                PNG_COLOR_TYPE_RGB,
-                PNG_INTERLACE_NONE,
-                PNG_COMPRESSION_TYPE_DEFAULT,
-                PNG_FILTER_TYPE_DEFAULT);
-
-            // Initialize rows of PNG.
-            png_byte** rowLines = static_cast<png_byte**>(png_malloc(pngPointer, height * sizeof(png_byte*)));
-            const int pixelSize = 4; // RGBA
-            for (unsigned int i = 0; i < height; ++i) {
-
-                png_byte* rowLine = static_cast<png_byte*>(png_malloc(pngPointer, sizeof(png_byte) * width * pixelSize));
-                const uint8_t* rowSource = buffer + (sizeof(png_byte) * i * width * pixelSize);
-                rowLines[i] = rowLine;
-                for (unsigned int j = 0; j < width * pixelSize; j += pixelSize) {
-                    *rowLine++ = rowSource[j + 2]; // Red
-                    *rowLine++ = rowSource[j + 1]; // Green
-                    *rowLine++ = rowSource[j + 0]; // Blue
-                    // ignore alpha
-                }
-            }
-
             // Duplicate file descriptor and create File stream based on it.
             FILE* filePointer = static_cast<FILE*>(*_file);
             if (nullptr != filePointer) {
-                // Write the image data to "file".
-                png_init_io(pngPointer, filePointer);
-                png_set_rows(pngPointer, infoPointer, rowLines);
-                png_write_png(pngPointer, infoPointer, PNG_TRANSFORM_IDENTITY, nullptr);
-                // All went well.
-                result = true;
-            }
-
-            // Close stream to flush and release allocated buffers
-            fclose(filePointer);
+                // Encode straight from the capture buffer into the "file".
+                result = _encoder.Encode(filePointer, buffer, width, height);
 
-            for (unsigned int i = 0; i < height; i++) {
-                png_free(pngPointer, rowLines[i]);
+                // Close stream to flush and release allocated buffers
+                fclose(filePointer);
             }
 
-            png_free(pngPointer, rowLines);
-            png_destroy_write_struct(&pngPointer, &infoPointer);
-
             return result;
         }
 
@@ -180,21 +117,36 @@ namespace Plugin {
 
     private:
         Core::ProxyType<FileBodyExtended> _file;
+        const Encoder& _encoder;
     };
 
     /* virtual */ const string Snapshot::Initialize(PluginHost::IShell* service)
     {
         string result;
+        Config config;
+        config.FromString(service->ConfigLine());
 
-        // Capture PNG file name
         ASSERT(service->PersistentPath() != _T(""));
         ASSERT(_device == nullptr);
 
+        Encoder::format format = Encoder::PNG;
+        Encoder::filter filter = Encoder::FILTER_ADAPTIVE;
+
+        if (Encoder::Format(config.Format.Value(), format) == false) {
+            TRACE_L1(_T("Unknown capture format: %s, using png"), config.Format.Value().c_str());
+        }
+        if (Encoder::Filter(config.Filter.Value(), filter) == false) {
+            TRACE_L1(_T("Unknown PNG filter: %s, using adaptive"), config.Filter.Value().c_str());
+        }
+
+        _encoder = Encoder(format, config.Compression.Value(), filter, config.Strips.Value());
+
+        // Capture file name
         Core::Directory directory(service->PersistentPath().c_str());
         if (directory.CreatePath()) {
-            _fileName = service->PersistentPath() + string("Capture.png");
+            _fileName = service->PersistentPath() + string("Capture.") + _encoder.Extension();
         } else {
-            _fileName = string("/tmp/Capture.png");
+            _fileName = string("/tmp/Capture.") + _encoder.Extension();
         }
 
         // Setup skip URL for right offset.
@@ -259,7 +211,7 @@ namespace Plugin {
                 response->ErrorCode = Web::STATUS_OK;
             } else if ((index.Current() == "Capture")) {
 
-                StoreImpl file(_inProgress, _fileName);
+                StoreImpl file(_inProgress, _fileName, _encoder);
 
                 // _inProgress event is signalled, capture screen
                 if (file.IsValid() == true) {
@@ -267,7 +219,8 @@ namespace Plugin {
                     if (_device->Capture(file)) {
 
                         // Attach to response.
-                        response->ContentType = Web::MIMETypes::MIME_IMAGE_PNG;
+                        // QOI and PPM have no registered MIME type, serve them as plain binary.
+                        response->ContentType = (_encoder.Format() == Encoder::PNG ? Web::MIMETypes::MIME_IMAGE_PNG : Web::MIMETypes::MIME_BINARY);
                         response->Body(static_cast<Core::ProxyType<Web::IBody>>(file));
                         response->Message = string(_device->Name());
                         response->ErrorCode = Web::STATUS_ACCEPTED;
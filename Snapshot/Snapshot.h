@@ -21,6 +21,7 @@
 #define __SNAPSHOT_H
 
 #include "Module.h"
+#include "Encoder.h"
 #include <interfaces/ICapture.h>
 
 namespace WPEFramework {
@@ -31,11 +32,41 @@ namespace Plugin {
         Snapshot(const Snapshot&) = delete;
         Snapshot& operator=(const Snapshot&) = delete;
 
+        class Config : public Core::JSON::Container {
+        private:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+        public:
+            Config()
+                : Core::JSON::Container()
+                , Format(_T("png"))
+                , Compression(6)
+                , Filter(_T("adaptive"))
+                , Strips(1)
+            {
+                Add(_T("format"), &Format);
+                Add(_T("compression"), &Compression);
+                Add(_T("filter"), &Filter);
+                Add(_T("strips"), &Strips);
+            }
+            ~Config()
+            {
+            }
+
+        public:
+            Core::JSON::String Format;
+            Core::JSON::DecUInt8 Compression;
+            Core::JSON::String Filter;
+            Core::JSON::DecUInt8 Strips;
+        };
+
     public:
         Snapshot()
             : _skipURL(0)
             , _device(nullptr)
             , _fileName()
+            , _encoder()
             , _inProgress(false)
         {
         }
@@ -66,6 +97,7 @@ namespace Plugin {
         uint8_t _skipURL;
         Exchange::ICapture* _device;
         string _fileName;
+        Encoder _encoder;
         Core::BinairySemaphore _inProgress;
     };
 
@@ -22,6 +22,7 @@
 #include "Module.h"
 #include <interfaces/IStream.h>
 #include "PlayerPlatform.h"
+#include "LockStatistics.h"
 
 namespace WPEFramework {
 
@@ -65,7 +66,7 @@ namespace Player {
             void Deallocate(uint8_t index);
 
         private:
-            Core::CriticalSection _adminLock;
+            AdministratorLock _adminLock;
             std::map<string, IPlayerPlatformFactory*> _streamers;
             Core::BitArrayFlexType<16> _slots;
         };
@@ -0,0 +1,403 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Administrator.h"
+#include "../LockStatistics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Drives the stream lifecycle of the Streamer without any hardware underneath: every stream runs
+// create, load, play, a number of seeks and destroy cycles against the stream administrator, the
+// same calls the plugin makes for its JSON-RPC and COM-RPC clients, on the Stub player platform.
+// While playing the Stub raises position reports and player events from a thread of its own, those
+// come in through the same frontend lock the control calls take. Reported are the latency
+// percentiles per lifecycle step, the event delivery latency and the time spent waiting for the
+// frontend and administrator locks.
+
+using namespace WPEFramework;
+
+namespace {
+
+    typedef Player::Implementation::Administrator Administrator;
+    typedef Player::Implementation::LockStatistics LockStatistics;
+
+    enum step {
+        CREATE,
+        LOAD,
+        PLAY,
+        SEEK,
+        DESTROY,
+        STEPS
+    };
+
+    static const char* StepNames[] = { "create", "load", "play", "seek", "destroy" };
+
+    struct Options {
+        Options()
+            : Streams(4)
+            , Cycles(1000)
+            , Seeks(4)
+            , PlayTime(0)
+            , Frontends(0)
+            , Decoders(0)
+            , Pool(0)
+            , SetupTime(0)
+            , TuneTime(0)
+            , EventInterval(1)
+        {
+        }
+
+        uint32_t Streams;
+        uint32_t Cycles;
+        uint32_t Seeks;
+        uint32_t PlayTime;
+        uint32_t Frontends;
+        uint32_t Decoders;
+        uint32_t Pool;
+        uint32_t SetupTime;
+        uint32_t TuneTime;
+        uint32_t EventInterval;
+    };
+
+    // Latencies in ns, collected per stream and merged afterwards.
+    struct Result {
+        Result()
+            : Failures(0)
+            , Events(0)
+            , Updates(0)
+        {
+        }
+
+        std::vector<uint64_t> Steps[STEPS];
+        std::vector<uint64_t> Deliveries;
+        uint32_t Failures;
+        uint32_t Events;
+        uint32_t Updates;
+    };
+
+    class StreamSink : public Exchange::IStream::ICallback {
+    public:
+        StreamSink(const StreamSink&) = delete;
+        StreamSink& operator=(const StreamSink&) = delete;
+
+        StreamSink()
+            : _changes(0)
+        {
+        }
+        ~StreamSink() override
+        {
+        }
+
+    public:
+        void StateChange(const Exchange::IStream::state) override
+        {
+            _changes++;
+        }
+        void Event(const uint32_t) override
+        {
+        }
+        void DRM(const uint32_t) override
+        {
+        }
+        uint32_t Changes() const
+        {
+            return (_changes);
+        }
+
+        BEGIN_INTERFACE_MAP(StreamSink)
+        INTERFACE_ENTRY(Exchange::IStream::ICallback)
+        END_INTERFACE_MAP
+
+    private:
+        uint32_t _changes;
+    };
+
+    // Called from the event thread of the player, next to the control calls of the stream.
+    class ControlSink : public Exchange::IStream::IControl::ICallback {
+    public:
+        ControlSink(const ControlSink&) = delete;
+        ControlSink& operator=(const ControlSink&) = delete;
+
+        ControlSink(Result& result)
+            : _lock()
+            , _result(result)
+        {
+        }
+        ~ControlSink() override
+        {
+        }
+
+    public:
+        void TimeUpdate(const uint64_t) override
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _result.Updates++;
+        }
+        void Event(const uint32_t eventId) override
+        {
+            // The Stub raises its events with the low part of the time they were raised at, in us.
+            const uint32_t now = static_cast<uint32_t>(Core::Time::Now().Ticks());
+
+            std::lock_guard<std::mutex> guard(_lock);
+            _result.Deliveries.push_back(static_cast<uint64_t>(now - eventId) * 1000);
+            _result.Events++;
+        }
+
+        BEGIN_INTERFACE_MAP(ControlSink)
+        INTERFACE_ENTRY(Exchange::IStream::IControl::ICallback)
+        END_INTERFACE_MAP
+
+    private:
+        std::mutex _lock;
+        Result& _result;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-streams") == 0)) {
+                options.Streams = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-cycles") == 0)) {
+                options.Cycles = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-seeks") == 0)) {
+                options.Seeks = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-playtime") == 0)) {
+                options.PlayTime = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-frontends") == 0)) {
+                options.Frontends = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-decoders") == 0)) {
+                options.Decoders = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-pool") == 0)) {
+                options.Pool = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-setuptime") == 0)) {
+                options.SetupTime = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-tunetime") == 0)) {
+                options.TuneTime = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-eventinterval") == 0)) {
+                options.EventInterval = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        if (options.Frontends == 0) {
+            options.Frontends = options.Streams;
+        }
+        if (options.Decoders == 0) {
+            options.Decoders = options.Streams;
+        }
+
+        // Both the frontend and the decoder slots are kept in 16 bit sets.
+        return ((showHelp == true) || (options.Streams == 0) || (options.Cycles == 0) || (options.Frontends > 16) || (options.Decoders > 16));
+    }
+
+    void ShowHelp()
+    {
+        printf("StreamerBenchmark [options]\n"
+               "\t-streams <count>          Streams cycled concurrently, each from a thread of its own [4]\n"
+               "\t-cycles <count>           Create, load, play, seek and destroy cycles per stream [1000]\n"
+               "\t-seeks <count>            Seeks per cycle [4]\n"
+               "\t-playtime <ms>            Time a stream keeps playing after its seeks [0]\n"
+               "\t-frontends <count>        Stub frontends, at most 16, fewer than streams makes them compete [streams]\n"
+               "\t-decoders <count>         Decoder slots, at most 16 [streams]\n"
+               "\t-pool <count>             Stub players kept ready [0]\n"
+               "\t-setuptime <ms>           Simulated player setup time [0]\n"
+               "\t-tunetime <ms>            Simulated tune time [0]\n"
+               "\t-eventinterval <ms>       Interval of the position reports and player events, 0 is none [1]\n");
+    }
+
+    string Configuration(const Options& options)
+    {
+        char buffer[256];
+
+        snprintf(buffer, sizeof(buffer),
+            "{\"decoders\":%u,\"Stub\":{\"frontends\":%u,\"pool\":%u,\"setuptime\":%u,\"tunetime\":%u,\"eventinterval\":%u}}",
+            options.Decoders, options.Frontends, options.Pool, options.SetupTime, options.TuneTime, options.EventInterval);
+
+        return (string(buffer));
+    }
+
+    inline uint64_t Elapsed(const std::chrono::steady_clock::time_point& start)
+    {
+        return (std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    void Cycle(const Options& options, const uint32_t id, Result& result)
+    {
+        Administrator& administrator(Administrator::Instance());
+        Core::Sink<StreamSink> streamSink;
+        Core::Sink<ControlSink> controlSink(result);
+        char uri[64];
+
+        for (uint32_t step = 0; step < STEPS; step++) {
+            result.Steps[step].reserve(step == SEEK ? options.Cycles * options.Seeks : options.Cycles);
+        }
+
+        for (uint32_t cycle = 0; cycle < options.Cycles; cycle++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            Exchange::IStream* stream = administrator.Acquire(Exchange::IStream::streamtype::Cable);
+
+            if (stream == nullptr) {
+                // More streams than frontends, all of them are taken, the cycle is lost.
+                result.Failures++;
+                std::this_thread::yield();
+                continue;
+            }
+
+            stream->Callback(&streamSink);
+            result.Steps[CREATE].push_back(Elapsed(start));
+
+            snprintf(uri, sizeof(uri), "tune://benchmark/%u/%u", id, cycle);
+
+            start = std::chrono::steady_clock::now();
+            stream->Load(uri);
+            result.Steps[LOAD].push_back(Elapsed(start));
+
+            start = std::chrono::steady_clock::now();
+            Exchange::IStream::IControl* control = stream->Control();
+            result.Steps[PLAY].push_back(Elapsed(start));
+
+            if (control == nullptr) {
+                result.Failures++;
+            } else {
+                control->Callback(&controlSink);
+
+                for (uint32_t seek = 0; seek < options.Seeks; seek++) {
+                    start = std::chrono::steady_clock::now();
+                    control->Position((seek + 1) * 10000);
+                    control->Position();
+                    result.Steps[SEEK].push_back(Elapsed(start));
+                }
+
+                if (options.PlayTime != 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(options.PlayTime));
+                }
+
+                control->Callback(nullptr);
+            }
+
+            start = std::chrono::steady_clock::now();
+            if (control != nullptr) {
+                control->Release();
+            }
+            stream->Callback(nullptr);
+            stream->Release();
+            result.Steps[DESTROY].push_back(Elapsed(start));
+        }
+
+        if (streamSink.Changes() == 0) {
+            result.Failures++;
+        }
+    }
+
+    void Percentiles(const char name[], std::vector<uint64_t>& values)
+    {
+        std::sort(values.begin(), values.end());
+
+        if (values.empty() == true) {
+            printf("%s,0,0,0,0,0\n", name);
+        } else {
+            printf("%s,%u,%.1f,%.1f,%.1f,%.1f\n", name, static_cast<uint32_t>(values.size()),
+                values[values.size() / 2] / 1000.0, values[(values.size() * 99) / 100] / 1000.0,
+                values[(values.size() * 999) / 1000] / 1000.0, values.back() / 1000.0);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    Administrator& administrator(Administrator::Instance());
+    administrator.Initialize(Configuration(options));
+
+    // The pool is filled during initialization, that is not part of the cycles.
+    LockStatistics::Instance().Clear();
+
+    std::vector<Result> results(options.Streams);
+    std::vector<std::thread> streams;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (uint32_t index = 0; index < options.Streams; index++) {
+        streams.emplace_back(Cycle, std::cref(options), index, std::ref(results[index]));
+    }
+    for (std::thread& stream : streams) {
+        stream.join();
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    administrator.Deinitialize();
+
+    Result total;
+
+    for (Result& result : results) {
+        for (uint32_t step = 0; step < STEPS; step++) {
+            total.Steps[step].insert(total.Steps[step].end(), result.Steps[step].begin(), result.Steps[step].end());
+        }
+        total.Deliveries.insert(total.Deliveries.end(), result.Deliveries.begin(), result.Deliveries.end());
+        total.Failures += result.Failures;
+        total.Events += result.Events;
+        total.Updates += result.Updates;
+    }
+
+    printf("streams,cycles,seeks,seconds,cycles_per_s,failures,events,updates\n");
+    printf("%u,%u,%u,%.2f,%.0f,%u,%u,%u\n\n", options.Streams, options.Cycles, options.Seeks, seconds,
+        (seconds > 0 ? static_cast<uint32_t>(total.Steps[CREATE].size()) / seconds : 0), total.Failures, total.Events, total.Updates);
+
+    printf("step,count,p50_us,p99_us,p999_us,max_us\n");
+    for (uint32_t step = 0; step < STEPS; step++) {
+        Percentiles(StepNames[step], total.Steps[step]);
+    }
+    Percentiles("event", total.Deliveries);
+
+    printf("\nlock,acquisitions,contended,contended_pct,waited_us,longest_us\n");
+
+    static const char* LockNames[] = { "frontend", "administrator" };
+
+    for (uint8_t site = 0; site < LockStatistics::SITES; site++) {
+        LockStatistics::Counters counters;
+        LockStatistics::Instance().Get(static_cast<LockStatistics::site>(site), counters);
+
+        printf("%s,%llu,%llu,%.2f,%.1f,%.1f\n", LockNames[site],
+            static_cast<unsigned long long>(counters.Acquisitions), static_cast<unsigned long long>(counters.Contended),
+            (counters.Acquisitions != 0 ? (counters.Contended * 100.0) / counters.Acquisitions : 0),
+            counters.Waited / 1000.0, counters.Longest / 1000.0);
+    }
+
+    return (total.Failures == 0 ? 0 : 2);
+}
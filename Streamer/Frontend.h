@@ -24,6 +24,7 @@
 #include "Element.h"
 #include "PlayerPlatform.h"
 #include "Administrator.h"
+#include "LockStatistics.h"
 
 namespace WPEFramework {
 
@@ -442,16 +443,22 @@ namespace Player {
             {
                 _adminLock.Lock();
                 ASSERT(_decoder != nullptr);
-                if (_decoder != nullptr) {
+                const bool detached = (_decoder != nullptr);
+                if (detached == true) {
                     ASSERT(_player != nullptr);
                     ASSERT(_administrator != nullptr);
                     ReleaseElements();
                     _player->DetachDecoder(_decoder->Index());
                     _administrator->Deallocate(_decoder->Index());
                     _decoder = nullptr;
-                    Release();
                 }
                 _adminLock.Unlock();
+
+                // Released without the lock, the last release clears the player callback and that waits for
+                // an event on its way in, which needs this lock.
+                if (detached == true) {
+                    Release();
+                }
             }
             IPlayerPlatform* Implementation()
             {
@@ -487,7 +494,7 @@ namespace Player {
 
         private:
             mutable uint32_t _refCount;
-            mutable Core::CriticalSection _adminLock;
+            mutable FrontendLock _adminLock;
             Administrator* _administrator;
             DecoderImplementation* _decoder;
             IStream::ICallback* _callback;
@@ -0,0 +1,402 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#include "Administrator.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A player without any media underneath. It walks through the stream states like a real platform
+// does and can be configured to take the time a real platform needs to set up and to tune, so the
+// zap path of the Streamer, including the player pool, can be measured on any Linux box. While
+// playing it can report its position and raise player events at a fixed interval from a thread of
+// its own, like a real platform does, to put load on the event path as well.
+
+namespace WPEFramework {
+namespace Player {
+namespace Implementation {
+
+    namespace {
+
+        static class Config : public Core::JSON::Container {
+        public:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+            Config()
+                : Core::JSON::Container()
+                , SetupTime(0)
+                , TuneTime(0)
+                , EventInterval(0)
+            {
+                Add(_T("setuptime"), &SetupTime);
+                Add(_T("tunetime"), &TuneTime);
+                Add(_T("eventinterval"), &EventInterval);
+            }
+
+            Core::JSON::DecUInt16 SetupTime;
+            Core::JSON::DecUInt16 TuneTime;
+            Core::JSON::DecUInt16 EventInterval;
+        } config;
+
+        class Stub : public IPlayerPlatform {
+        public:
+            Stub() = delete;
+            Stub(const Stub&) = delete;
+            Stub& operator=(const Stub&) = delete;
+
+            Stub(const Exchange::IStream::streamtype streamType, const uint8_t index)
+                : _adminLock()
+                , _state(Exchange::IStream::state::Error)
+                , _streamType(streamType)
+                , _error(Core::ERROR_UNAVAILABLE)
+                , _speed(0)
+                , _speeds()
+                , _position(0)
+                , _since(0)
+                , _rectangle()
+                , _z(0)
+                , _elements()
+                , _callback(nullptr)
+                , _index(index)
+                , _emitter()
+                , _emitterLock()
+                , _emitterSignal()
+                , _running(false)
+                , _delivering(false)
+            {
+                _speeds.push_back(0);
+                _speeds.push_back(100);
+                _speeds.push_back(200);
+                _speeds.push_back(-200);
+            }
+            ~Stub() override
+            {
+                Stop();
+            }
+
+        public:
+            static Exchange::IStream::streamtype Supported()
+            {
+                return (static_cast<Exchange::IStream::streamtype>(
+                    static_cast<int>(Exchange::IStream::streamtype::Cable) |
+                    static_cast<int>(Exchange::IStream::streamtype::Terrestrial) |
+                    static_cast<int>(Exchange::IStream::streamtype::Satellite) |
+                    static_cast<int>(Exchange::IStream::streamtype::Unicast)));
+            }
+            uint32_t Setup() override
+            {
+                ASSERT(_state == Exchange::IStream::state::Error);
+
+                // The cost of bringing up a platform player, the pool pays it ahead of time.
+                std::this_thread::sleep_for(std::chrono::milliseconds(config.SetupTime.Value()));
+
+                _adminLock.Lock();
+                _state = Exchange::IStream::state::Idle;
+                _error = Core::ERROR_NONE;
+                _adminLock.Unlock();
+
+                if (config.EventInterval.Value() != 0) {
+                    _running = true;
+                    _emitter = std::thread(&Stub::Emit, this);
+                }
+
+                return (Core::ERROR_NONE);
+            }
+            uint32_t Teardown() override
+            {
+                Stop();
+
+                _adminLock.Lock();
+                _state = Exchange::IStream::state::Error;
+                _error = Core::ERROR_UNAVAILABLE;
+                _adminLock.Unlock();
+
+                return (Core::ERROR_NONE);
+            }
+            uint32_t Reset() override
+            {
+                _adminLock.Lock();
+                _state = Exchange::IStream::state::Idle;
+                _error = Core::ERROR_NONE;
+                _speed = 0;
+                _position = 0;
+                _since = 0;
+                _elements.clear();
+                _adminLock.Unlock();
+
+                return (Core::ERROR_NONE);
+            }
+            void Callback(ICallback* callback) override
+            {
+                // Waits for an event on its way out, the frontend goes away once its callback is cleared. No
+                // player lock is held while waiting, the event may be waiting for the frontend lock.
+                std::unique_lock<std::mutex> guard(_emitterLock);
+                _emitterSignal.wait(guard, [this]() { return (_delivering == false); });
+
+                _adminLock.Lock();
+                _callback = callback;
+                _adminLock.Unlock();
+            }
+            string Metadata() const override
+            {
+                return (string());
+            }
+            Exchange::IStream::streamtype Type() const override
+            {
+                return (_streamType);
+            }
+            Exchange::IStream::drmtype DRM() const override
+            {
+                return (Exchange::IStream::drmtype::None);
+            }
+            Exchange::IStream::state State() const override
+            {
+                return (_state);
+            }
+            uint32_t Error() const override
+            {
+                return (_error);
+            }
+            uint8_t Index() const override
+            {
+                return (_index);
+            }
+            uint32_t Load(const string& uri) override
+            {
+                uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+                if (_state != Exchange::IStream::state::Error) {
+                    TRACE(Trace::Information, (_T("Stub player [%i] loading %s"), _index, uri.c_str()));
+
+                    ChangeState(Exchange::IStream::state::Loading);
+
+                    std::this_thread::sleep_for(std::chrono::milliseconds(config.TuneTime.Value()));
+
+                    _adminLock.Lock();
+                    _elements.clear();
+                    _elements.emplace_back(Exchange::IStream::IElement::type::Video);
+                    _elements.emplace_back(Exchange::IStream::IElement::type::Audio);
+                    _adminLock.Unlock();
+
+                    ChangeState(Exchange::IStream::state::Prepared);
+                    result = Core::ERROR_NONE;
+                }
+
+                return (result);
+            }
+            uint32_t AttachDecoder(const uint8_t index VARIABLE_IS_NOT_USED) override
+            {
+                uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+                if (_state == Exchange::IStream::state::Prepared) {
+                    _adminLock.Lock();
+                    _speed = 100;
+                    _since = Core::Time::Now().Ticks();
+                    _adminLock.Unlock();
+
+                    ChangeState(Exchange::IStream::state::Controlled);
+                    result = Core::ERROR_NONE;
+                }
+
+                return (result);
+            }
+            uint32_t DetachDecoder(const uint8_t index VARIABLE_IS_NOT_USED) override
+            {
+                uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+                if (_state == Exchange::IStream::state::Controlled) {
+                    _adminLock.Lock();
+                    _position = Current();
+                    _speed = 0;
+                    _adminLock.Unlock();
+
+                    ChangeState(Exchange::IStream::state::Prepared);
+                    result = Core::ERROR_NONE;
+                }
+
+                return (result);
+            }
+            uint32_t Speed(const int32_t speed) override
+            {
+                uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+                if (_state == Exchange::IStream::state::Controlled) {
+                    _adminLock.Lock();
+                    _position = Current();
+                    _since = Core::Time::Now().Ticks();
+                    _speed = speed;
+                    _adminLock.Unlock();
+
+                    result = Core::ERROR_NONE;
+                }
+
+                return (result);
+            }
+            int32_t Speed() const override
+            {
+                return (_speed);
+            }
+            const std::vector<int32_t>& Speeds() const override
+            {
+                return (_speeds);
+            }
+            void Position(const uint64_t absoluteTime) override
+            {
+                _adminLock.Lock();
+                _position = absoluteTime;
+                _since = Core::Time::Now().Ticks();
+                _adminLock.Unlock();
+            }
+            uint64_t Position() const override
+            {
+                _adminLock.Lock();
+                uint64_t result = Current();
+                _adminLock.Unlock();
+
+                return (result);
+            }
+            void TimeRange(uint64_t& begin, uint64_t& end) const override
+            {
+                begin = 0;
+                end = ~0;
+            }
+            const Rectangle& Window() const override
+            {
+                return (_rectangle);
+            }
+            void Window(const Rectangle& rectangle) override
+            {
+                _rectangle = rectangle;
+            }
+            uint32_t Order() const override
+            {
+                return (_z);
+            }
+            void Order(const uint32_t order) override
+            {
+                _z = order;
+            }
+            const std::list<ElementaryStream>& Elements() const override
+            {
+                return (_elements);
+            }
+
+        private:
+            void Emit()
+            {
+                const std::chrono::milliseconds interval(config.EventInterval.Value());
+                std::unique_lock<std::mutex> guard(_emitterLock);
+
+                while (_emitterSignal.wait_for(guard, interval, [this]() { return (_running == false); }) == false) {
+                    _adminLock.Lock();
+                    ICallback* callback = (_state == Exchange::IStream::state::Controlled ? _callback : nullptr);
+                    const uint64_t position = Current();
+                    _adminLock.Unlock();
+
+                    if (callback != nullptr) {
+                        // Deliver without any player lock taken, the frontend calls into the player with its own
+                        // lock taken. Clearing the callback waits until the delivery is done.
+                        _delivering = true;
+                        guard.unlock();
+
+                        callback->TimeUpdate(position);
+
+                        // The event carries the time it was raised at, so the receiver can tell how long the delivery took.
+                        callback->PlayerEvent(static_cast<uint32_t>(Core::Time::Now().Ticks()));
+
+                        guard.lock();
+                        _delivering = false;
+                        _emitterSignal.notify_all();
+                    }
+                }
+            }
+            void Stop()
+            {
+                std::unique_lock<std::mutex> guard(_emitterLock);
+                _running = false;
+                guard.unlock();
+
+                _emitterSignal.notify_all();
+
+                if (_emitter.joinable() == true) {
+                    _emitter.join();
+                }
+            }
+            // Position in milliseconds, playing at the current speed since the last change.
+            uint64_t Current() const
+            {
+                uint64_t result = _position;
+
+                if ((_state == Exchange::IStream::state::Controlled) && (_speed != 0)) {
+                    const int64_t elapsed = static_cast<int64_t>((Core::Time::Now().Ticks() - _since) / Core::Time::TicksPerMillisecond);
+                    const int64_t moved = (elapsed * _speed) / 100;
+
+                    result = ((moved < 0) && (static_cast<uint64_t>(-moved) > _position) ? 0 : _position + moved);
+                }
+
+                return (result);
+            }
+            void ChangeState(const Exchange::IStream::state state)
+            {
+                _adminLock.Lock();
+
+                _state = state;
+
+                if (_callback != nullptr) {
+                    _callback->StateChange(_state);
+                }
+
+                _adminLock.Unlock();
+            }
+
+        private:
+            mutable Core::CriticalSection _adminLock;
+            Exchange::IStream::state _state;
+            Exchange::IStream::streamtype _streamType;
+            uint32_t _error;
+            int32_t _speed;
+            std::vector<int32_t> _speeds;
+            uint64_t _position;
+            uint64_t _since;
+            Rectangle _rectangle;
+            uint32_t _z;
+            std::list<ElementaryStream> _elements;
+            ICallback* _callback;
+            uint8_t _index;
+            std::thread _emitter;
+            std::mutex _emitterLock;
+            std::condition_variable _emitterSignal;
+            bool _running;
+            bool _delivering; // An event is on its way to the callback, guarded by the emitter lock.
+        };
+
+        static PlayerPlatformRegistrationType<Stub, Exchange::IStream::streamtype::Undefined> Register(
+            /*  Initialize */ [](const string& configuration) -> uint32_t {
+                config.FromString(configuration);
+                return (Core::ERROR_NONE);
+            });
+
+    } // namespace
+
+} // namespace Implementation
+} // namespace Player
+}
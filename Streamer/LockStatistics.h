@@ -0,0 +1,163 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+#ifdef STREAMER_LOCK_STATISTICS
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace WPEFramework {
+
+namespace Player {
+
+    namespace Implementation {
+
+#ifdef STREAMER_LOCK_STATISTICS
+
+        // Load test builds time every acquisition of the locks on the stream lifecycle path. The time
+        // includes the cost of an uncontended acquisition, only waits over the threshold count as contended.
+        class LockStatistics {
+        public:
+            enum site : uint8_t {
+                FRONTEND,
+                ADMINISTRATOR,
+                SITES
+            };
+
+            static constexpr uint64_t Threshold = 1000; // ns
+
+            struct Counters {
+                uint64_t Acquisitions;
+                uint64_t Contended;
+                uint64_t Waited; // ns
+                uint64_t Longest; // ns
+            };
+
+        private:
+            struct Site {
+                Site()
+                    : Acquisitions(0)
+                    , Contended(0)
+                    , Waited(0)
+                    , Longest(0)
+                {
+                }
+
+                // Every site on its own cache line, they are updated from all threads.
+                alignas(64) std::atomic<uint64_t> Acquisitions;
+                std::atomic<uint64_t> Contended;
+                std::atomic<uint64_t> Waited;
+                std::atomic<uint64_t> Longest;
+            };
+
+            LockStatistics() = default;
+
+        public:
+            LockStatistics(const LockStatistics&) = delete;
+            LockStatistics& operator=(const LockStatistics&) = delete;
+
+            static LockStatistics& Instance()
+            {
+                static LockStatistics instance;
+                return (instance);
+            }
+
+        public:
+            void Record(const site which, const uint64_t waited)
+            {
+                Site& entry(_sites[which]);
+
+                entry.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+                entry.Waited.fetch_add(waited, std::memory_order_relaxed);
+
+                if (waited >= Threshold) {
+                    entry.Contended.fetch_add(1, std::memory_order_relaxed);
+
+                    uint64_t longest = entry.Longest.load(std::memory_order_relaxed);
+                    while ((waited > longest) && (entry.Longest.compare_exchange_weak(longest, waited, std::memory_order_relaxed) == false)) {
+                    }
+                }
+            }
+            void Get(const site which, Counters& counters) const
+            {
+                const Site& entry(_sites[which]);
+
+                counters.Acquisitions = entry.Acquisitions.load(std::memory_order_relaxed);
+                counters.Contended = entry.Contended.load(std::memory_order_relaxed);
+                counters.Waited = entry.Waited.load(std::memory_order_relaxed);
+                counters.Longest = entry.Longest.load(std::memory_order_relaxed);
+            }
+            void Clear()
+            {
+                for (uint8_t index = 0; index < SITES; index++) {
+                    _sites[index].Acquisitions.store(0, std::memory_order_relaxed);
+                    _sites[index].Contended.store(0, std::memory_order_relaxed);
+                    _sites[index].Waited.store(0, std::memory_order_relaxed);
+                    _sites[index].Longest.store(0, std::memory_order_relaxed);
+                }
+            }
+
+        private:
+            Site _sites[SITES];
+        };
+
+        template <const LockStatistics::site SITE>
+        class TimedCriticalSection : public Core::CriticalSection {
+        public:
+            TimedCriticalSection(const TimedCriticalSection<SITE>&) = delete;
+            TimedCriticalSection<SITE>& operator=(const TimedCriticalSection<SITE>&) = delete;
+
+            TimedCriticalSection()
+                : Core::CriticalSection()
+            {
+            }
+            ~TimedCriticalSection()
+            {
+            }
+
+        public:
+            void Lock()
+            {
+                const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+                Core::CriticalSection::Lock();
+
+                LockStatistics::Instance().Record(SITE, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            }
+        };
+
+        typedef TimedCriticalSection<LockStatistics::FRONTEND> FrontendLock;
+        typedef TimedCriticalSection<LockStatistics::ADMINISTRATOR> AdministratorLock;
+
+#else
+
+        typedef Core::CriticalSection FrontendLock;
+        typedef Core::CriticalSection AdministratorLock;
+
+#endif
+
+    } // namespace Implementation
+
+} // namespace Player
+
+}
@@ -24,6 +24,8 @@
 #include "Geometry.h"
 #include "Element.h"
 
+#include <algorithm>
+#include <list>
 #include <vector>
 #include <set>
 
@@ -52,6 +54,21 @@ namespace Player {
             virtual uint32_t Setup() = 0;
             virtual uint32_t Teardown() = 0;
 
+            // Brings a released player back to the state right after Setup, so it can be handed out
+            // again by the pool of its factory. It runs on the worker pool, after the release. Players
+            // that can stop playback cheaper than a full teardown should override this. On failure the
+            // player must be left torn down.
+            virtual uint32_t Reset()
+            {
+                uint32_t result = Teardown();
+
+                if (result == Core::ERROR_NONE) {
+                    result = Setup();
+                }
+
+                return (result);
+            }
+
             virtual void Callback(ICallback* callback) = 0;
 
             virtual string Metadata() const = 0;
@@ -112,7 +129,11 @@ namespace Player {
                 , _Deinitialize(deinitializer)
                 , _configuration()
                 , _players()
+                , _idle()
+                , _resetting()
+                , _pool(0)
                 , _adminLock()
+                , _job(*this)
             {
                 ASSERT(Name().empty() == false);
             }
@@ -120,6 +141,8 @@ namespace Player {
             ~PlayerPlatformFactoryType()
             {
                 ASSERT(_slots.Empty() == true);
+                ASSERT(_idle.empty() == true);
+                ASSERT(_resetting.empty() == true);
             }
 
             uint32_t Initialize(const string& configuration) override
@@ -145,21 +168,38 @@ namespace Player {
                 result = (_Initialize != nullptr? _Initialize(_configuration) : Core::ERROR_NONE);
 
                 if (result == Core::ERROR_NONE) {
-                    // Pick up the number of frontends
+                    // Pick up the number of frontends and the number of them to keep ready
                     struct DefaultConfig : public Core::JSON::Container {
                     public:
                         DefaultConfig()
                             : Core::JSON::Container()
                             , Frontends(0)
+                            , Pool(0)
                         {
                             Add(_T("frontends"), &Frontends);
+                            Add(_T("pool"), &Pool);
                         }
 
                         Core::JSON::DecUInt8 Frontends;
+                        Core::JSON::DecUInt8 Pool;
                     } config;
 
                     config.FromString(_configuration);
                     _slots.Reset(config.Frontends.Value());
+                    _pool = std::min(config.Pool.Value(), config.Frontends.Value());
+
+                    // Pay the construction and setup of the pooled players now, not on the first zap.
+                    while (_idle.size() < _pool) {
+                        IPlayerPlatform* player = Construct();
+
+                        if (player == nullptr) {
+                            break;
+                        }
+
+                        _idle.push_back(player);
+                    }
+
+                    TRACE(Trace::Information, (_T("Player '%s' keeps %i of %i frontend(s) ready"), Name().c_str(), static_cast<uint32_t>(_idle.size()), _slots.Size()));
                 }
 
                 _adminLock.Unlock();
@@ -169,8 +209,21 @@ namespace Player {
 
             void Deinitialize() override
             {
+                // A reset that is running finishes first, it takes the lock when done.
+                _job.Revoke();
+
                 _adminLock.Lock();
 
+                while (_resetting.empty() == false) {
+                    Dispose(_resetting.front());
+                    _resetting.pop_front();
+                }
+
+                while (_idle.empty() == false) {
+                    Dispose(_idle.front());
+                    _idle.pop_front();
+                }
+
                 if (_Deinitialize) {
                     _Deinitialize();
                 }
@@ -183,26 +236,30 @@ namespace Player {
             IPlayerPlatform* Create() override
             {
                 IPlayerPlatform* player = nullptr;
+                IPlayerPlatform* waiting = nullptr;
 
                 _adminLock.Lock();
 
-                uint8_t index = _slots.Find();
-                if (index < _slots.Size()) {
-                    player =  new PLAYER(Type(), index);
+                if (_idle.empty() == false) {
+                    player = _idle.front();
+                    _idle.pop_front();
+                } else if (((player = Construct()) == nullptr) && (_resetting.empty() == false)) {
+                    // All frontends are taken, but one is still waiting for its reset, do not wait for the job.
+                    waiting = _resetting.front();
+                    _resetting.pop_front();
+                }
 
-                    if ((player != nullptr) && (player->Setup() != Core::ERROR_NONE)) {
-                        TRACE(Trace::Error, (_T("Player '%s' setup failed!"),  Name().c_str()));
-                        delete player;
-                        player = nullptr;
-                    }
+                _adminLock.Unlock();
 
-                    if (player != nullptr) {
-                        _players.emplace(player);
-                        _slots.Set(index);
-                    }
+                if ((waiting != nullptr) && (Reset(waiting) == true)) {
+                    player = waiting;
                 }
 
-                _adminLock.Unlock();
+                if (player != nullptr) {
+                    _adminLock.Lock();
+                    _players.emplace(player);
+                    _adminLock.Unlock();
+                }
 
                 return (player);
             }
@@ -220,15 +277,17 @@ namespace Player {
                     ASSERT(_slots.IsSet(index) == true);
 
                     if (_slots.IsSet(index) == true) {
-                        _slots.Clr(index);
-
-                        if (player->Teardown() != Core::ERROR_NONE) {
-                            TRACE(Trace::Error, (_T("Player %s[%i] teardown failed!"), Name().c_str(), player->Index()));
-                        }
-
                         _players.erase(it);
-                        delete player;
                         result = true;
+
+                        // A player for the pool keeps its frontend. It is reset on the worker pool, so
+                        // the zap that released it does not wait for that.
+                        if ((_idle.size() + _resetting.size()) < _pool) {
+                            _resetting.push_back(player);
+                            _job.Submit();
+                        } else {
+                            Dispose(player);
+                        }
                     }
                 }
 
@@ -258,6 +317,82 @@ namespace Player {
             }
 
         private:
+            friend Core::ThreadPool::JobType<PlayerPlatformFactoryType&>;
+
+            // Resets the released players for the pool, one by one, without holding the lock.
+            void Dispatch()
+            {
+                _adminLock.Lock();
+
+                while (_resetting.empty() == false) {
+                    IPlayerPlatform* player = _resetting.front();
+                    _resetting.pop_front();
+
+                    _adminLock.Unlock();
+
+                    const bool reset = Reset(player);
+
+                    _adminLock.Lock();
+
+                    if (reset == true) {
+                        _idle.push_back(player);
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
+            // Resets a player taken out of the pool administration, the lock must not be held. A player
+            // that fails is gone, its frontend is freed.
+            bool Reset(IPlayerPlatform* player)
+            {
+                const bool result = (player->Reset() == Core::ERROR_NONE);
+
+                if (result == false) {
+                    const uint8_t index = player->Index();
+
+                    TRACE(Trace::Error, (_T("Player %s[%i] reset failed!"), Name().c_str(), index));
+                    delete player;
+
+                    _adminLock.Lock();
+                    _slots.Clr(index);
+                    _adminLock.Unlock();
+                }
+
+                return (result);
+            }
+            // Takes a free frontend, the lock must be held.
+            IPlayerPlatform* Construct()
+            {
+                IPlayerPlatform* player = nullptr;
+
+                uint8_t index = _slots.Find();
+                if (index < _slots.Size()) {
+                    player =  new PLAYER(Type(), index);
+
+                    if ((player != nullptr) && (player->Setup() != Core::ERROR_NONE)) {
+                        TRACE(Trace::Error, (_T("Player '%s' setup failed!"),  Name().c_str()));
+                        delete player;
+                        player = nullptr;
+                    }
+
+                    if (player != nullptr) {
+                        _slots.Set(index);
+                    }
+                }
+
+                return (player);
+            }
+            // Returns the frontend of the player, the lock must be held.
+            void Dispose(IPlayerPlatform* player)
+            {
+                _slots.Clr(player->Index());
+
+                if (player->Teardown() != Core::ERROR_NONE) {
+                    TRACE(Trace::Error, (_T("Player %s[%i] teardown failed!"), Name().c_str(), player->Index()));
+                }
+
+                delete player;
+            }
             Exchange::IStream::streamtype Type(const TemplateIntToType<true>& /* For compile time diffrentiation */) const 
             {
                 // Lets load the StreamType from the Player..
@@ -275,7 +410,11 @@ namespace Player {
             DeinitializerType _Deinitialize;
             string _configuration;
             std::set<IPlayerPlatform*> _players;
+            std::list<IPlayerPlatform*> _idle;
+            std::list<IPlayerPlatform*> _resetting;
+            uint8_t _pool;
             mutable Core::CriticalSection _adminLock;
+            Core::WorkerPool::JobType<PlayerPlatformFactoryType&> _job;
         };
 
     } // namespace Implementation
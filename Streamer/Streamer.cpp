@@ -40,6 +40,7 @@ namespace Plugin {
         _skipURL = _service->WebPrefix().length();
 
         config.FromString(_service->ConfigLine());
+        _events.Window(config.TimeUpdateWindow.Value());
 
         // Register the Process::Notification stuff. The Remote process might die before we get a
         // change to "register" the sink for these events !!! So do it ahead of instantiation.
@@ -76,6 +77,7 @@ namespace Plugin {
         ASSERT(_player != nullptr);
 
         service->Unregister(&_notification);
+        _events.Clear();
 
         if (_player->Release() != Core::ERROR_DESTRUCTION_SUCCEEDED) {
 
@@ -391,6 +393,7 @@ namespace Plugin {
                     if (stream != _streams.end()) {
                         stream->second->Release();
                         _streams.erase(position);
+                        _events.Forget(position);
                         result->ErrorCode = Web::STATUS_OK;
                         result->Message = _T("Stream is released");
                     }
@@ -21,6 +21,7 @@
 
 #include "Module.h"
 #include "Geometry.h"
+#include <JSONNotification.h>
 #include <interfaces/json/JsonData_Streamer.h>
 
 namespace WPEFramework {
@@ -224,6 +225,189 @@ namespace Plugin {
             Core::Sink<ControlSink> _controlSink;
         };
 
+        // Position updates come in at the pace of the player, for every stream. Within the window only the
+        // last position of a stream is reported, the first one goes out right away. Every other event of a
+        // stream first flushes the position that is still pending, so clients see all events in order.
+        // Taking a report out and delivering it happen under the delivery lock, so a report that is taken
+        // out can not be overtaken by one taken out later.
+        class EventBus {
+        private:
+            struct Entry {
+                Entry()
+                    : Last(0)
+                    , Position(0)
+                    , Pending(false)
+                {
+                }
+
+                uint64_t Last;
+                uint64_t Position;
+                bool Pending;
+            };
+
+            typedef std::map<uint8_t, Entry> Entries;
+
+        public:
+            EventBus() = delete;
+            EventBus(const EventBus&) = delete;
+            EventBus& operator=(const EventBus&) = delete;
+
+            EventBus(Streamer& parent)
+                : _adminLock()
+                , _deliveryLock()
+                , _parent(parent)
+                , _window(0)
+                , _armed(false)
+                , _entries()
+                , _job(*this)
+            {
+            }
+            ~EventBus()
+            {
+                _job.Revoke();
+            }
+
+        public:
+            void Window(const uint16_t window)
+            {
+                _window = static_cast<uint64_t>(window) * Core::Time::TicksPerMillisecond;
+            }
+            void TimeUpdate(const uint8_t index, const uint64_t position)
+            {
+                const uint64_t now = Core::Time::Now().Ticks();
+                bool report = false;
+
+                _deliveryLock.Lock();
+                _adminLock.Lock();
+
+                Entry& entry(_entries[index]);
+
+                if ((entry.Pending == false) && (now >= (entry.Last + _window))) {
+                    entry.Last = now;
+                    report = true;
+                } else {
+                    entry.Position = position;
+
+                    if (entry.Pending == false) {
+                        entry.Pending = true;
+
+                        // An already armed job may come a little later than this deadline, but always
+                        // within the window.
+                        if (_armed == false) {
+                            _armed = true;
+                            _job.Schedule(entry.Last + _window);
+                        }
+                    }
+                }
+
+                _adminLock.Unlock();
+
+                // Reported without the admin lock, the parent calls out to the observers.
+                if (report == true) {
+                    _parent.Position(index, position);
+                }
+
+                _deliveryLock.Unlock();
+            }
+            // Any other event of the stream, reported after the position that is still pending. The payload
+            // is a copy, reporting the position builds its own payload in the same thread local buffer.
+            void Report(const string& event, const uint8_t index, const string payload)
+            {
+                uint64_t position = 0;
+                bool report = false;
+
+                _deliveryLock.Lock();
+                _adminLock.Lock();
+
+                Entries::iterator entry(_entries.find(index));
+
+                if ((entry != _entries.end()) && (entry->second.Pending == true)) {
+                    position = Take(entry->second, Core::Time::Now().Ticks());
+                    report = true;
+                }
+
+                _adminLock.Unlock();
+
+                if (report == true) {
+                    _parent.Position(index, position);
+                }
+
+                _parent.Report(event, index, payload);
+
+                _deliveryLock.Unlock();
+            }
+            void Forget(const uint8_t index)
+            {
+                _adminLock.Lock();
+                _entries.erase(index);
+                _adminLock.Unlock();
+            }
+            void Clear()
+            {
+                _job.Revoke();
+
+                _adminLock.Lock();
+                _entries.clear();
+                _armed = false;
+                _adminLock.Unlock();
+            }
+
+        private:
+            friend Core::ThreadPool::JobType<EventBus&>;
+
+            // Takes the pending position out, to be reported once the lock is released.
+            uint64_t Take(Entry& entry, const uint64_t now)
+            {
+                entry.Pending = false;
+                entry.Last = now;
+                return (entry.Position);
+            }
+            void Dispatch()
+            {
+                const uint64_t now = Core::Time::Now().Ticks();
+                uint64_t next = static_cast<uint64_t>(~0);
+                std::vector< std::pair<uint8_t, uint64_t> > reports;
+
+                _deliveryLock.Lock();
+                _adminLock.Lock();
+
+                for (Entries::iterator entry = _entries.begin(); entry != _entries.end(); entry++) {
+                    if (entry->second.Pending == true) {
+                        const uint64_t due = entry->second.Last + _window;
+
+                        if (due <= now) {
+                            reports.emplace_back(entry->first, Take(entry->second, now));
+                        } else if (due < next) {
+                            next = due;
+                        }
+                    }
+                }
+
+                _armed = (next != static_cast<uint64_t>(~0));
+
+                if (_armed == true) {
+                    _job.Schedule(next);
+                }
+
+                _adminLock.Unlock();
+
+                for (const std::pair<uint8_t, uint64_t>& report : reports) {
+                    _parent.Position(report.first, report.second);
+                }
+
+                _deliveryLock.Unlock();
+            }
+
+        private:
+            Core::CriticalSection _adminLock;
+            Core::CriticalSection _deliveryLock;
+            Streamer& _parent;
+            uint64_t _window;
+            bool _armed;
+            Entries _entries;
+            Core::WorkerPool::JobType<EventBus&> _job;
+        };
+
         typedef std::map<uint8_t, StreamProxy> Streams;
         typedef std::map<uint8_t, ControlProxy> Controls;
 
@@ -236,8 +420,10 @@ namespace Plugin {
             Config()
                 : Core::JSON::Container()
                 , OutOfProcess(true)
+                , TimeUpdateWindow(250)
             {
                 Add(_T("outofprocess"), &OutOfProcess);
+                Add(_T("timeupdatewindow"), &TimeUpdateWindow);
             }
             ~Config()
             {
@@ -245,6 +431,7 @@ namespace Plugin {
 
         public:
             Core::JSON::Boolean OutOfProcess;
+            Core::JSON::DecUInt16 TimeUpdateWindow;
         };
 
     public:
@@ -330,6 +517,7 @@ namespace Plugin {
             , _service(nullptr)
             , _player(nullptr)
             , _notification(this)
+            , _events(*this)
             , _streams()
             , _controls()
         {
@@ -384,52 +572,42 @@ namespace Plugin {
         Core::ProxyType<Web::Response> DeleteMethod(Core::TextSegmentIterator& index);
         void Deactivated(RPC::IRemoteConnection* connection);
 
+        // Each event is built once, one payload for both the plugin notification and the JSON-RPC event.
+        // It carries the fields of both, so neither one loses what its clients look for.
         void StateChange(const uint8_t index, Exchange::IStream::state state)
         {
             TRACE(Trace::Information, (_T("Stream [%d] moved state: [%s]"), index, Core::EnumerateType<Exchange::IStream::state>(state).Data()));
 
-            _service->Notify(_T("{ \"id\": ") +
-                             Core::NumberType<uint8_t>(index).Text() +
-                             _T(", \"stream\": \"") +
-                             Core::EnumerateType<Exchange::IStream::state>(state).Data() +
-                             _T("\" }"));
-            event_statechange(std::to_string(index), static_cast<JsonData::Streamer::StateType>(state));
+            _events.Report(_T("statechange"), index, JSONNotification().Number("id", index).String("stream", Core::EnumerateType<Exchange::IStream::state>(state).Data()).String("state", Core::EnumerateType<JsonData::Streamer::StateType>(static_cast<JsonData::Streamer::StateType>(state)).Data()).Data());
         }
         void TimeUpdate(const uint8_t index, const uint64_t position)
         {
-            _service->Notify(_T("{ \"id\": ") +
-                             Core::NumberType<uint8_t>(index).Text() +
-                            _T(", \"time\": ") +
-                            Core::NumberType<uint64_t>(position).Text() +
-                            _T(" }"));
-            event_timeupdate(std::to_string(index), position);
+            _events.TimeUpdate(index, position);
+        }
+        void Position(const uint8_t index, const uint64_t position)
+        {
+            Report(_T("timeupdate"), index, JSONNotification().Number("id", index).Number("time", position).Data());
         }
         void StreamEvent(const uint8_t index, const uint32_t eventId)
         {
             TRACE(Trace::Information, (_T("Stream [%d] custom notification: [%08x]"), index, eventId));
 
-            _service->Notify(_T("{ \"id\": ") +
-                             Core::NumberType<uint8_t>(index).Text() +
-                            _T(", \"stream_event\": \"") +
-                            Core::NumberType<uint32_t>(eventId).Text() +
-                            _T("\" }"));
-            event_stream(std::to_string(index), eventId);
+            _events.Report(_T("stream"), index, JSONNotification().Number("id", index).String("stream_event", eventId).Number("code", eventId).Data());
         }
         void PlayerEvent(const uint8_t index, const uint32_t eventId)
         {
             TRACE(Trace::Information, (_T("Stream [%d] custom player notification: [%08x]"), index, eventId));
 
-            _service->Notify(_T("{ \"id\": ") +
-                             Core::NumberType<uint8_t>(index).Text() +
-                             _T(", \"player_event\": \"") +
-                             Core::NumberType<uint32_t>(eventId).Text() +
-                             _T("\" }"));
-            event_player(std::to_string(index), eventId);
+            _events.Report(_T("player"), index, JSONNotification().Number("id", index).String("player_event", eventId).Number("code", eventId).Data());
         }
         void DrmEvent(const uint8_t index, uint32_t state)
         {
-            _service->Notify(_T("{ \"id\": ") + Core::NumberType<uint8_t>(index).Text() + _T(", \"drm\": \"") + Core::NumberType<uint8_t>(state).Text() + _T("\" }"));
-            event_drm(std::to_string(index), state);
+            _events.Report(_T("drm"), index, JSONNotification().Number("id", index).String("drm", static_cast<uint8_t>(state)).Number("code", state).Data());
+        }
+        void Report(const string& event, const uint8_t index, const string& payload)
+        {
+            _service->Notify(payload);
+            event_notify(event, index, payload);
         }
 
         // JsonRpc
@@ -454,11 +632,7 @@ namespace Plugin {
         uint32_t get_metadata(const string& index, Core::JSON::String& response) const;
         uint32_t get_error(const string& index, Core::JSON::DecUInt32& response) const;
         uint32_t get_elements(const string& index, Core::JSON::ArrayType<JsonData::Streamer::StreamelementData>& response) const;
-        void event_statechange(const string& id, const JsonData::Streamer::StateType& state);
-        void event_timeupdate(const string& id, const uint64_t& time);
-        void event_stream(const string& id, const uint32_t& code);
-        void event_player(const string& id, const uint32_t& code);
-        void event_drm(const string& id, const uint32_t& code);
+        void event_notify(const string& event, const uint8_t index, const string& payload);
 
     private:
         uint32_t _skipURL;
@@ -467,6 +641,7 @@ namespace Plugin {
 
         Exchange::IPlayer* _player;
         Core::Sink<Notification> _notification;
+        EventBus _events;
 
         // Stream and StreamControl holding areas for the RESTFull API.
         Streams _streams;
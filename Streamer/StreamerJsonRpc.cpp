@@ -140,6 +140,7 @@ namespace Plugin {
                 stream->second->Callback(nullptr);
                 stream->second->Release();
                 _streams.erase(stream);
+                _events.Forget(id);
             }
         }
         else {
@@ -605,63 +606,18 @@ namespace Plugin {
         return result;
     }
 
-    // Event: statechange - Notifies of stream state change
-    void Streamer::event_statechange(const string& id, const StateType& state)
+    // Events: statechange, timeupdate, stream, player and drm - Notify of changes and incidents of a stream,
+    // only to the observers of that stream. The payload is the one of the plugin notification, built once.
+    void Streamer::event_notify(const string& event, const uint8_t index, const string& payload)
     {
-        StatechangeParamsData params;
-        params.State = state;
+        const string id(Core::NumberType<uint8_t>(index).Text());
+        Core::JSON::String params;
 
-        Notify(_T("statechange"), params, [&](const string& designator) -> bool {
-            const string designator_id = designator.substr(0, designator.find('.'));
-            return (id == designator_id);
-        });
-    }
-
-    // Event: timeupdate - Notifies of stream position change
-    void Streamer::event_timeupdate(const string& id, const uint64_t& time)
-    {
-        TimeupdateParamsData params;
-        params.Time = time;
-
-        Notify(_T("timeupdate"), params, [&](const string& designator) -> bool {
-            const string designator_id = designator.substr(0, designator.find('.'));
-            return (id == designator_id);
-        });
-    }
-
-    // Event: stream - Notifies of a custom stream incident
-    void Streamer::event_stream(const string& id, const uint32_t& code)
-    {
-        StreamParamsInfo params;
-        params.Code = code;
-
-        Notify(_T("stream"), params, [&](const string& designator) -> bool {
-            const string designator_id = designator.substr(0, designator.find('.'));
-            return (id == designator_id);
-        });
-    }
-
-    // Event: player - Notifies of a custom player incident
-    void Streamer::event_player(const string& id, const uint32_t& code)
-    {
-        StreamParamsInfo params;
-        params.Code = code;
-
-        Notify(_T("player"), params, [&](const string& designator) -> bool {
-            const string designator_id = designator.substr(0, designator.find('.'));
-            return (id == designator_id);
-        });
-    }
-
-    // Event: drm - Notifies of a custom DRM-related incident
-    void Streamer::event_drm(const string& id, const uint32_t& code)
-    {
-        StreamParamsInfo params;
-        params.Code = code;
+        params.SetQuoted(false);
+        params = payload;
 
-        Notify(_T("drm"), params, [&](const string& designator) -> bool {
-            const string designator_id = designator.substr(0, designator.find('.'));
-            return (id == designator_id);
+        Notify(event, params, [&](const string& designator) -> bool {
+            return (designator.compare(0, designator.find('.'), id) == 0);
         });
     }
 
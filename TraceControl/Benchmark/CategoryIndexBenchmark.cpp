@@ -0,0 +1,253 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <CategoryIndex.h>
+
+// Synthesizes the trace categories of a number of processes and compares the CategoryIndex of the
+// TraceControl plugin with the map it replaced, that was built from scratch by walking all trace
+// controls of all processes for every status query and after every change. The walk itself is
+// replayed from memory, so the numbers leave out the RPC round trip per category the plugin pays
+// on top for a remote process.
+
+using namespace WPEFramework::Plugin;
+
+namespace {
+
+    enum state {
+        ENABLED,
+        DISABLED,
+        TRISTATED
+    };
+
+    struct Options {
+        Options()
+            : Processes(8)
+            , Modules(64)
+            , Categories(16)
+            , Iterations(100)
+        {
+        }
+
+        uint32_t Processes;
+        uint32_t Modules;
+        uint32_t Categories;
+        uint32_t Iterations;
+    };
+
+    struct Category {
+        std::string Module;
+        std::string Name;
+        bool Enabled;
+    };
+
+    typedef std::vector<Category> Process;
+
+    // The per query rebuild the index replaced.
+    class Walk {
+    public:
+        struct CategoryInfo {
+            std::string Category;
+            state State;
+
+            bool operator==(const std::string& rhs) const
+            {
+                return (Category == rhs);
+            }
+        };
+
+        typedef std::list<CategoryInfo> CategoryList;
+        typedef std::map<std::string, CategoryList> ModuleMap;
+
+        Walk(const std::vector<Process>& processes)
+        {
+            for (const Process& process : processes) {
+                for (const Category& entry : process) {
+                    ModuleMap::iterator index(_modules.find(entry.Module));
+
+                    if (index == _modules.end()) {
+                        _modules[entry.Module].push_back({ entry.Name, (entry.Enabled ? ENABLED : DISABLED) });
+                    } else {
+                        CategoryList::iterator selected(std::find(index->second.begin(), index->second.end(), entry.Name));
+
+                        if (selected == index->second.end()) {
+                            _modules[entry.Module].push_back({ entry.Name, (entry.Enabled ? ENABLED : DISABLED) });
+                        } else if (((entry.Enabled == true) && (selected->State != ENABLED)) || ((entry.Enabled == false) && (selected->State != DISABLED))) {
+                            selected->State = TRISTATED;
+                        }
+                    }
+                }
+            }
+        }
+
+        ModuleMap _modules;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-processes") == 0)) {
+                options.Processes = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-modules") == 0)) {
+                options.Modules = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-categories") == 0)) {
+                options.Categories = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-iterations") == 0)) {
+                options.Iterations = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Processes == 0) || (options.Modules == 0) || (options.Categories == 0) || (options.Iterations == 0));
+    }
+
+    void ShowHelp()
+    {
+        printf("TraceControlBenchmark [options]\n"
+               "\t-processes <count>        Processes with trace categories [8]\n"
+               "\t-modules <count>          Modules per process [64]\n"
+               "\t-categories <count>       Categories per module [16]\n"
+               "\t-iterations <count>       Repetitions of every measurement [100]\n");
+    }
+
+    // Every process has the framework modules, the plugin modules are spread over the processes.
+    std::vector<Process> Generate(const Options& options)
+    {
+        std::vector<Process> processes(options.Processes);
+        const uint32_t shared = std::max(1u, options.Modules / 4);
+        char name[64];
+
+        for (uint32_t process = 0; process < options.Processes; process++) {
+            for (uint32_t module = 0; module < options.Modules; module++) {
+                if (module < shared) {
+                    snprintf(name, sizeof(name), "Framework_%u", module);
+                } else {
+                    snprintf(name, sizeof(name), "Plugin_%u", (process * options.Modules) + module);
+                }
+
+                for (uint32_t category = 0; category < options.Categories; category++) {
+                    char categoryName[32];
+                    snprintf(categoryName, sizeof(categoryName), "Category_%u", category);
+                    processes[process].push_back({ name, categoryName, ((category % 3) == 0) });
+                }
+            }
+        }
+
+        return (processes);
+    }
+
+    template <typename ACTION>
+    double Measure(const uint32_t iterations, ACTION action)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t index = 0; index < iterations; index++) {
+            action();
+        }
+
+        return (std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    std::vector<Process> processes(Generate(options));
+    CategoryIndex index;
+    uint32_t checksum = 0;
+    uint32_t entries = 0;
+
+    for (uint32_t process = 0; process < processes.size(); process++) {
+        for (const Category& entry : processes[process]) {
+            index.Add(process, entry.Module, entry.Name, entry.Enabled);
+        }
+        entries += static_cast<uint32_t>(processes[process].size());
+    }
+
+    // A full status query.
+    const double walkQuery = Measure(options.Iterations, [&]() {
+        Walk walk(processes);
+        checksum += static_cast<uint32_t>(walk._modules.size());
+    });
+    const double indexQuery = Measure(options.Iterations, [&]() {
+        index.Visit("", "", [&](const std::string&, const std::string&, CategoryIndex::Entry& entry) { checksum += entry.Enabled; });
+    });
+
+    // Switching a module on everywhere and reporting the new state of that module.
+    const double walkModule = Measure(options.Iterations, [&]() {
+        for (Process& process : processes) {
+            for (Category& entry : process) {
+                if (entry.Module == "Framework_0") {
+                    entry.Enabled = true;
+                }
+            }
+        }
+        Walk walk(processes);
+        checksum += static_cast<uint32_t>(walk._modules["Framework_0"].size());
+    });
+    const double indexModule = Measure(options.Iterations, [&]() {
+        index.Set(true, "Framework_0", "");
+        index.Visit("Framework_0", "", [&](const std::string&, const std::string&, CategoryIndex::Entry& entry) { checksum += entry.Enabled; });
+    });
+
+    // A wildcard toggle over all plugin modules, and a bulk toggle of everything.
+    const double indexPattern = Measure(options.Iterations, [&]() {
+        checksum += index.Set(false, "Plugin_*", "Category_1?");
+    });
+    const double indexAll = Measure(options.Iterations, [&]() {
+        checksum += index.Set(false, "", "");
+    });
+
+    // A process connecting and going away again.
+    const double indexChurn = Measure(options.Iterations, [&]() {
+        const uint32_t id = static_cast<uint32_t>(processes.size());
+        for (const Category& entry : processes[0]) {
+            index.Add(id, entry.Module, entry.Name, entry.Enabled);
+        }
+        index.Remove(id);
+    });
+
+    printf("processes,modules,categories,entries,walk_query_us,index_query_us,walk_module_us,index_module_us,index_pattern_us,index_all_us,index_process_us\n");
+    printf("%u,%u,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+        options.Processes, options.Modules, options.Categories, entries,
+        walkQuery, indexQuery, walkModule, indexModule, indexPattern, indexAll, indexChurn);
+
+    // Keep the measured work from being optimized away.
+    return (checksum == 0xFFFFFFFF ? 2 : 0);
+}
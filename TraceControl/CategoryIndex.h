@@ -0,0 +1,260 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // The trace categories of all processes, kept as processes come and go and as categories are
+    // switched, so a query does not have to walk the trace controls of every process. Every process
+    // adds its own slice, a category known in several processes counts how many of them have it
+    // enabled. Module and category selections take an exact name, an empty string or "*" for all,
+    // or a pattern with '*' and '?'. Only depends on the standard library, so it can be used stand
+    // alone.
+    class CategoryIndex {
+    public:
+        struct Entry {
+            uint32_t Enabled;
+            uint32_t Total;
+            uint32_t Touched;
+        };
+
+        typedef std::map<std::string, Entry> Categories;
+        typedef std::map<std::string, Categories> Modules;
+
+    private:
+        struct Reference {
+            Modules::iterator Module;
+            Categories::iterator Category;
+            bool Enabled;
+        };
+
+        typedef std::vector<Reference> Slice;
+        typedef std::map<uint32_t, Slice> Slices;
+
+    public:
+        CategoryIndex(const CategoryIndex&) = delete;
+        CategoryIndex& operator=(const CategoryIndex&) = delete;
+
+        CategoryIndex()
+            : _modules()
+            , _slices()
+            , _sequence(0)
+        {
+        }
+        ~CategoryIndex()
+        {
+        }
+
+    public:
+        static bool IsPattern(const std::string& selection)
+        {
+            return (selection.find_first_of("*?") != std::string::npos);
+        }
+        static bool IsAll(const std::string& selection)
+        {
+            return ((selection.empty() == true) || (selection == "*"));
+        }
+        static bool Match(const std::string& selection, const std::string& name)
+        {
+            return ((IsAll(selection) == true) || (IsPattern(selection) == false ? (selection == name) : Glob(selection.c_str(), name.c_str())));
+        }
+
+        inline bool Contains(const uint32_t source) const
+        {
+            return (_slices.find(source) != _slices.end());
+        }
+        inline bool IsEmpty() const
+        {
+            return (_modules.empty());
+        }
+        // Tells if at least one process has the category enabled.
+        bool IsEnabled(const std::string& module, const std::string& category) const
+        {
+            bool result = false;
+            Modules::const_iterator selected(_modules.find(module));
+
+            if (selected != _modules.end()) {
+                Categories::const_iterator entry(selected->second.find(category));
+
+                result = ((entry != selected->second.end()) && (entry->second.Enabled != 0));
+            }
+
+            return (result);
+        }
+        void Add(const uint32_t source, const std::string& module, const std::string& category, const bool enabled)
+        {
+            Modules::iterator selected(_modules.find(module));
+
+            if (selected == _modules.end()) {
+                selected = _modules.insert(std::pair<const std::string, Categories>(module, Categories())).first;
+            }
+
+            Categories::iterator entry(selected->second.find(category));
+
+            if (entry == selected->second.end()) {
+                const Entry empty = { 0, 0, 0 };
+                entry = selected->second.insert(std::pair<const std::string, Entry>(category, empty)).first;
+            }
+
+            entry->second.Total++;
+            if (enabled == true) {
+                entry->second.Enabled++;
+            }
+
+            const Reference reference = { selected, entry, enabled };
+            _slices[source].push_back(reference);
+        }
+        void Remove(const uint32_t source)
+        {
+            Slices::iterator slice(_slices.find(source));
+
+            if (slice != _slices.end()) {
+                for (const Reference& reference : slice->second) {
+                    Entry& entry(reference.Category->second);
+
+                    entry.Total--;
+                    if (reference.Enabled == true) {
+                        entry.Enabled--;
+                    }
+
+                    // The last process knowing the category is gone, and perhaps the module with it.
+                    if (entry.Total == 0) {
+                        reference.Module->second.erase(reference.Category);
+
+                        if (reference.Module->second.empty() == true) {
+                            _modules.erase(reference.Module);
+                        }
+                    }
+                }
+
+                _slices.erase(slice);
+            }
+        }
+        void Clear()
+        {
+            _slices.clear();
+            _modules.clear();
+        }
+        // Marks the selected categories in one pass over the index and then brings the slices of
+        // the processes in line in one pass, returns the number of categories selected.
+        uint32_t Set(const bool enabled, const std::string& module, const std::string& category)
+        {
+            uint32_t count = 0;
+
+            _sequence++;
+
+            Visit(module, category, [&](const std::string&, const std::string&, Entry& entry) {
+                entry.Enabled = (enabled == true ? entry.Total : 0);
+                entry.Touched = _sequence;
+                count++;
+            });
+
+            if (count != 0) {
+                for (Slices::iterator slice(_slices.begin()); slice != _slices.end(); slice++) {
+                    for (Reference& reference : slice->second) {
+                        if (reference.Category->second.Touched == _sequence) {
+                            reference.Enabled = enabled;
+                        }
+                    }
+                }
+            }
+
+            return (count);
+        }
+        // Calls action(module, category, entry) for every selected category, sorted by module and category.
+        template <typename ACTION>
+        void Visit(const std::string& module, const std::string& category, ACTION&& action)
+        {
+            if ((IsAll(module) == true) || (IsPattern(module) == true)) {
+                for (Modules::iterator index(_modules.begin()); index != _modules.end(); index++) {
+                    if (Match(module, index->first) == true) {
+                        Select(index, category, action);
+                    }
+                }
+            } else {
+                Modules::iterator index(_modules.find(module));
+
+                if (index != _modules.end()) {
+                    Select(index, category, action);
+                }
+            }
+        }
+
+    private:
+        template <typename ACTION>
+        static void Select(Modules::iterator& module, const std::string& category, ACTION& action)
+        {
+            if ((IsAll(category) == true) || (IsPattern(category) == true)) {
+                for (Categories::iterator index(module->second.begin()); index != module->second.end(); index++) {
+                    if (Match(category, index->first) == true) {
+                        action(module->first, index->first, index->second);
+                    }
+                }
+            } else {
+                Categories::iterator index(module->second.find(category));
+
+                if (index != module->second.end()) {
+                    action(module->first, index->first, index->second);
+                }
+            }
+        }
+        static bool Glob(const char pattern[], const char name[])
+        {
+            const char* star = nullptr;
+            const char* resume = nullptr;
+            bool result = true;
+
+            while ((*name != '\0') && (result == true)) {
+                if ((*pattern == '?') || (*pattern == *name)) {
+                    pattern++;
+                    name++;
+                } else if (*pattern == '*') {
+                    // Let the star take nothing first, give it one more character on every mismatch.
+                    star = pattern++;
+                    resume = name;
+                } else if (star != nullptr) {
+                    pattern = star + 1;
+                    name = ++resume;
+                } else {
+                    result = false;
+                }
+            }
+
+            while (*pattern == '*') {
+                pattern++;
+            }
+
+            return ((result == true) && (*pattern == '\0'));
+        }
+
+    private:
+        Modules _modules;
+        Slices _slices;
+        uint32_t _sequence;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework
@@ -139,19 +139,9 @@ namespace Plugin {
             response->Console = _config.Console;
             response->Remote = _config.Remote;
 
-            Observer::ModuleIterator index(_observer.Modules());
-
-            while (index.Next() == true) {
-                string moduleName(Core::ToString(index.Module()));
-
-                Observer::ModuleIterator::CategoryIterator categories(index.Categories());
-
-                while (categories.Next()) {
-                    string categoryName(Core::ToString(categories.Category()));
-
-                    response->Settings.Add(Data::Trace(moduleName, categoryName, categories.State()));
-                }
-            }
+            _observer.Modules(EMPTY_STRING, EMPTY_STRING, [&](const string& moduleName, const string& categoryName, const state value) {
+                response->Settings.Add(Data::Trace(moduleName, categoryName, value));
+            });
 
             result->Body(Core::proxy_cast<Web::IBody>(response));
             result->ContentType = Web::MIME_JSON;
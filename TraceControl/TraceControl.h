@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Module.h"
+#include "CategoryIndex.h"
 #include <interfaces/json/JsonData_TraceControl.h>
 
 namespace WPEFramework {
@@ -45,6 +46,8 @@ namespace Plugin {
             Observer(const Observer&) = delete;
             Observer& operator=(const Observer&) = delete;
 
+            static constexpr uint32_t SliceLifetime = 10; // s
+
         public:
             class Source : public Core::CyclicBuffer {
             private:
@@ -328,229 +331,12 @@ namespace Plugin {
                 static LocalIterator _localIterator;
             };
 
-            class ModuleIterator {
-            public:
-                class CategoryInfo {
-                public:
-                    CategoryInfo()
-                        : _category()
-                        , _state(TRISTATED)
-                    {
-                    }
-                    CategoryInfo(const std::string category, const bool enabled)
-                        : _category(category)
-                        , _state(enabled ? ENABLED : DISABLED)
-                    {
-                    }
-                    CategoryInfo(const CategoryInfo& copy)
-                        : _category(copy._category)
-                        , _state(copy._state)
-                    {
-                    }
-                    ~CategoryInfo()
-                    {
-                    }
-
-                    inline CategoryInfo& operator=(const CategoryInfo& rhs)
-                    {
-                        _category = rhs._category;
-                        _state = rhs._state;
-
-                        return (*this);
-                    }
-                    inline bool operator==(const string& rhs) const
-                    {
-                        return (_category == rhs);
-                    }
-                    inline bool operator!=(const string& rhs) const
-                    {
-                        return !(operator==(rhs));
-                    }
-
-                public:
-                    inline state State() const
-                    {
-                        return (_state);
-                    }
-                    inline void State(const state value)
-                    {
-                        _state = value;
-                    }
-                    inline const string& Category() const
-                    {
-                        return (_category);
-                    }
-
-                private:
-                    string _category;
-                    state _state;
-                };
-
-                typedef std::list<CategoryInfo> CategoryList;
-                typedef std::map<std::string, CategoryList> ModuleMap;
-                typedef Core::IteratorType<const CategoryList, const CategoryInfo&, CategoryList::const_iterator> CategoryListIterator;
-                typedef Core::IteratorMapType<const ModuleMap, const CategoryList&, const std::string&, ModuleMap::const_iterator> ModuleMapIterator;
-
-            public:
-                class CategoryIterator {
-                public:
-                    CategoryIterator()
-                        : _categories(nullptr)
-                        , _iterator()
-                    {
-                    }
-                    CategoryIterator(const CategoryIterator& copy)
-                        : _categories(copy._categories)
-                        , _iterator()
-                    {
-                        if (_categories != nullptr) {
-                            _iterator = CategoryListIterator(*_categories);
-                        }
-                    }
-                    CategoryIterator(const CategoryList& categories)
-                        : _categories(&categories)
-                        , _iterator(*_categories)
-                    {
-                    }
-                    ~CategoryIterator()
-                    {
-                    }
-
-                    CategoryIterator& operator=(const CategoryIterator& rhs)
-                    {
-                        _categories = rhs._categories;
-
-                        if (_categories != nullptr) {
-                            _iterator = CategoryListIterator(*_categories);
-                        } else {
-                            _iterator = CategoryListIterator();
-                        }
-
-                        return (*this);
-                    }
-
-                public:
-                    inline bool IsValid() const
-                    {
-                        return (_iterator.IsValid());
-                    }
-                    inline void Reset()
-                    {
-                        _iterator.Reset(0);
-                    }
-                    inline bool Next()
-                    {
-                        return (_iterator.Next());
-                    }
-                    inline const std::string& Category() const
-                    {
-                        ASSERT(_iterator.IsValid());
-
-                        return (_iterator.operator->().Category());
-                    }
-                    inline state State() const
-                    {
-                        ASSERT(_iterator.IsValid());
-
-                        return (_iterator.operator->().State());
-                    }
-
-                private:
-                    const CategoryList* _categories;
-                    CategoryListIterator _iterator;
-                };
-
-            public:
-                ModuleIterator()
-                    : _modules()
-                    , _iterator()
-                {
-                }
-                ModuleIterator(const ModuleIterator& copy)
-                    : _modules(copy._modules)
-                    , _iterator(_modules)
-                {
-                }
-                ModuleIterator(const std::map<const uint32_t, Source*>& buffers)
-                    : _modules()
-                {
-                    std::map<const uint32_t, Source*>::const_iterator index(buffers.begin());
-
-                    while (index != buffers.end()) {
-                        bool enabled;
-                        string category;
-                        string module;
-
-                        Source* modules(index->second);
-                        modules->Reset();
-
-                        while (modules->Info(enabled, module, category)) {
-                            ModuleMap::iterator index(_modules.find(module));
-
-                            if (index == _modules.end()) {
-                                // First attempt, no need to validate if the category exists...
-                                _modules[module].push_back(CategoryInfo(category, enabled));
-                            } else {
-                                CategoryList::iterator selected(std::find(index->second.begin(), index->second.end(), category));
-
-                                if (selected == index->second.end()) {
-                                    _modules[module].push_back(CategoryInfo(category, enabled));
-                                } else if (((enabled == true) && (selected->State() != ENABLED)) || ((enabled == false) && (selected->State() != DISABLED))) {
-                                    selected->State(TRISTATED);
-                                }
-                            }
-                        }
-
-                        index++;
-                    }
-
-                    _iterator = ModuleMapIterator(_modules);
-                }
-                ~ModuleIterator()
-                {
-                }
-
-                ModuleIterator& operator=(const ModuleIterator& rhs)
-                {
-                    _modules = rhs._modules;
-                    _iterator = ModuleMapIterator(_modules);
-
-                    return (*this);
-                }
-
-            public:
-                inline bool IsValid() const
-                {
-                    return (_iterator.IsValid());
-                }
-                inline void Reset()
-                {
-                    _iterator.Reset(0);
-                }
-                inline bool Next()
-                {
-                    return (_iterator.Next());
-                }
-                inline std::string Module() const
-                {
-                    ASSERT(_iterator.IsValid());
-
-                    return (_iterator.Key());
-                }
-                inline CategoryIterator Categories() const
-                {
-                    return (CategoryIterator(_iterator.operator*()));
-                }
-
-            private:
-                ModuleMap _modules;
-                ModuleMapIterator _iterator;
-            };
-
         public:
             Observer(TraceControl& parent)
                 : Thread(Core::Thread::DefaultStackSize(), _T("TraceWorker"))
                 , _buffers()
+                , _index()
+                , _loaded()
                 , _traceControl(Trace::TraceUnit::Instance())
                 , _parent(parent)
                 , _refcount(0)
@@ -590,6 +376,9 @@ namespace Plugin {
                     _buffers.erase(_buffers.begin());
                 }
 
+                _index.Clear();
+                _loaded.clear();
+
                 _adminLock.Unlock();
             }
             virtual void Activated(RPC::IRemoteConnection* connection)
@@ -599,6 +388,7 @@ namespace Plugin {
                 ASSERT(_buffers.find(connection->Id()) == _buffers.end());
 
                 // By definition, get the buffer file from WPEFramework (local source)
+                // The categories are added to the index on the first query, not from within this notification.
                 _buffers.insert(std::pair<const uint32_t, Source*>(connection->Id(), new Source(_parent.TracePath(), connection)));
 
                 _adminLock.Unlock();
@@ -614,6 +404,9 @@ namespace Plugin {
                     _buffers.erase(index);
                 }
 
+                _index.Remove(connection->Id());
+                _loaded.erase(connection->Id());
+
                 _adminLock.Unlock();
             }
 
@@ -621,13 +414,41 @@ namespace Plugin {
             {
                 _adminLock.Lock();
 
-                std::map<const uint32_t, Source*>::iterator index(_buffers.begin());
+                if ((CategoryIndex::IsPattern(module) == false) && (CategoryIndex::IsPattern(category) == false)) {
+                    std::map<const uint32_t, Source*>::iterator index(_buffers.begin());
 
-                while (index != _buffers.end()) {
-                    index->second->Set(enabled, module, category);
-                    index++;
+                    while (index != _buffers.end()) {
+                        index->second->Set(enabled, module, category);
+                        index++;
+                    }
+                } else {
+                    // The trace controllers take an exact name or everything, resolve the patterns on the
+                    // index, a module selected as a whole goes out in a single call.
+                    std::list<std::pair<string, string>> selection;
+                    const bool modules = CategoryIndex::IsAll(category);
+
+                    Refresh();
+
+                    _index.Visit(module, category, [&](const string& moduleName, const string& categoryName, CategoryIndex::Entry&) {
+                        if (modules == false) {
+                            selection.emplace_back(moduleName, categoryName);
+                        } else if ((selection.empty() == true) || (selection.back().first != moduleName)) {
+                            selection.emplace_back(moduleName, EMPTY_STRING);
+                        }
+                    });
+
+                    std::map<const uint32_t, Source*>::iterator index(_buffers.begin());
+
+                    while (index != _buffers.end()) {
+                        for (const std::pair<string, string>& entry : selection) {
+                            index->second->Set(enabled, entry.first, entry.second);
+                        }
+                        index++;
+                    }
                 }
 
+                _index.Set(enabled, module, category);
+
                 _adminLock.Unlock();
             }
 
@@ -645,9 +466,68 @@ namespace Plugin {
                 _adminLock.Unlock();
             }
 
-            inline ModuleIterator Modules() const
+            // Calls action(module, category, state) for the selected categories, see CategoryIndex. The
+            // selection is copied out, the action is called without the lock taken.
+            template <typename ACTION>
+            void Modules(const std::string& module, const std::string& category, ACTION&& action)
+            {
+                std::list<std::pair<std::pair<string, string>, state>> selection;
+
+                _adminLock.Lock();
+
+                Refresh();
+
+                _index.Visit(module, category, [&](const string& moduleName, const string& categoryName, CategoryIndex::Entry& entry) {
+                    selection.emplace_back(std::make_pair(moduleName, categoryName), (entry.Enabled == entry.Total ? ENABLED : (entry.Enabled == 0 ? DISABLED : TRISTATED)));
+                });
+
+                _adminLock.Unlock();
+
+                for (const std::pair<std::pair<string, string>, state>& entry : selection) {
+                    action(entry.first.first, entry.first.second, entry.second);
+                }
+            }
+
+        private:
+            // The own process is walked on every query, that takes no RPC and picks up categories added by
+            // loading a plugin as well as categories switched without this plugin. A remote process can not
+            // tell about such changes, its slice is walked again once it is older than SliceLifetime, or
+            // as soon as it traces in a category the index does not know as enabled.
+            void Refresh()
             {
-                return (ModuleIterator(_buffers));
+                const uint64_t now = Core::Time::Now().Ticks();
+                std::map<const uint32_t, Source*>::iterator index(_buffers.begin());
+
+                while (index != _buffers.end()) {
+                    const uint32_t id = index->first;
+
+                    if (id == 0) {
+                        _index.Remove(id);
+                        Load(id, *(index->second));
+                    } else {
+                        std::map<const uint32_t, uint64_t>::iterator loaded(_loaded.find(id));
+
+                        if ((loaded == _loaded.end()) || (now >= (loaded->second + (static_cast<uint64_t>(SliceLifetime) * Core::Time::TicksPerMillisecond * 1000)))) {
+                            _index.Remove(id);
+                            Load(id, *(index->second));
+                            _loaded[id] = now;
+                        }
+                    }
+
+                    index++;
+                }
+            }
+            void Load(const uint32_t id, Source& source)
+            {
+                bool enabled;
+                string category;
+                string module;
+
+                source.Reset();
+
+                while (source.Info(enabled, module, category) == true) {
+                    _index.Add(id, module, category, enabled);
+                }
             }
 
         private:
@@ -707,6 +587,11 @@ namespace Plugin {
 
                         if (selected != nullptr) {
 
+                            // A trace in a category not known as enabled, means the slice of its process is stale.
+                            if ((selected->Id() != 0) && (_index.IsEnabled(selected->Module(), selected->Category()) == false)) {
+                                _loaded.erase(selected->Id());
+                            }
+
                             // Oke, output this entry
                             _parent.Dispatch(*selected);
 
@@ -729,6 +614,8 @@ namespace Plugin {
         private:
             Core::CriticalSection _adminLock;
             std::map<const uint32_t, Source*> _buffers;
+            CategoryIndex _index;
+            std::map<const uint32_t, uint64_t> _loaded; // Time a remote slice was walked, in Core::Time ticks.
             Trace::TraceUnit& _traceControl;
             TraceControl& _parent;
             mutable uint32_t _refcount;
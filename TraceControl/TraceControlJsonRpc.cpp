@@ -76,27 +76,14 @@ namespace Plugin {
         response.Remote.Port = _config.Remote.Port;
         response.Remote.Binding = _config.Remote.Binding;
 
-        Observer::ModuleIterator index(_observer.Modules());
-
-        while (index.Next() == true) {
-            string moduleName(Core::ToString(index.Module()));
-            Observer::ModuleIterator::CategoryIterator categories(index.Categories());
-
-            if ((params.Module.IsSet() == false) || ((params.Module.IsSet() == true) && (moduleName == params.Module.Value()))) {
-                while (categories.Next()) {
-                    string categoryName(Core::ToString(categories.Category()));
-
-                    if ((params.Category.IsSet() == false) || ((params.Category.IsSet() == true) && (categoryName == params.Category.Value()))) {
-                        Data::Trace trace = Data::Trace(moduleName, categoryName, categories.State());
-                        JsonData::TraceControl::TraceInfo traceResponse;
-                        traceResponse.Module = trace.Module;
-                        traceResponse.Category = trace.Category;
-                        traceResponse.State = TranslateState(trace.State);
-                        response.Settings.Add(traceResponse);
-                    }
-                }
-            }
-        }
+        _observer.Modules((params.Module.IsSet() == true ? params.Module.Value() : string(EMPTY_STRING)), (params.Category.IsSet() == true ? params.Category.Value() : string(EMPTY_STRING)),
+            [&](const string& moduleName, const string& categoryName, const state value) {
+                JsonData::TraceControl::TraceInfo traceResponse;
+                traceResponse.Module = moduleName;
+                traceResponse.Category = categoryName;
+                traceResponse.State = TranslateState(value);
+                response.Settings.Add(traceResponse);
+            });
 
         return result;
     }
@@ -135,6 +135,11 @@ void Adapter::NotifierConfigFile(const std::string& nofityConfigFile)
     _notifier->ConfigurationFile(nofityConfigFile);
 }
 
+void Adapter::NotificationWindow(const uint16_t window)
+{
+    _adapterCallback->Window(window);
+}
+
 void Adapter::SetNotifyCallback(Implementation::ICallback* callback)
 {
     TRACE(Trace::Information, (string(__FUNCTION__)));
@@ -510,49 +515,157 @@ WebPAStatus Adapter::Helper::ParameterNamesOfSetters(const req_struct*& reqObj,
 uint32_t Adapter::NotificationCallback::Worker()
 {
     if ((_signaled.Lock(Core::infinite) == Core::ERROR_NONE) && (IsRunning() == true)) {
+        // Everything queued from here on, will be picked up in this run.
+        _signaled.ResetEvent();
+
+        // The window is set from the configuration thread, stick to one value for this run.
+        const uint16_t window = _window.load();
+
+        if (window != 0) {
+            // Let the burst settle, so it can go upstream in a single message.
+            SleepMs(window);
+        }
+
         _adminLock.Lock();
         NotificationHandler* handler = NotificationHandler::GetInstance();
 
         if (handler) {
             TRACE(Trace::Information, (_T("Got notification Instance")));
 
-            do {
-                NotifyData* notifyData = handler->NotificationData();
-                if ((nullptr != notifyData) && (IsRunning() == true)) {
-                    std::string notifySource = _parent->_notifier->Source();
-                    std::string notifyDest = _parent->_notifier->Destination();
+            if (window == 0) {
+                Dispatch(*handler);
+            } else {
+                Batch(*handler);
+            }
+
+            Report(handler->Dropped());
+        }
+        _adminLock.Unlock();
+    }
+
+    return Core::infinite;
+}
+
+void Adapter::NotificationCallback::Send(const std::string& payload)
+{
+    std::string notifySource = _parent->_notifier->Source();
+    std::string notifyDest = _parent->_notifier->Destination();
+
+    TRACE(Trace::Information, (_T("Notification Source = %s"), notifySource.c_str()));
+    TRACE(Trace::Information, (_T("Notification Dest = %s"), notifyDest.c_str()));
+
+    if (payload.empty() != true) {
+        TRACE(Trace::Information, (_T("Notification notifyPayload = %s"), payload.c_str()));
+    } else {
+        TRACE(Trace::Information, (_T("Notification Payload is nullptr")));
+    }
+    if ((payload.empty() != true) && (notifySource.empty() != true) && (notifyDest.empty() != true)) {
+        if (_parent->_callback) {
+            _parent->_callback->NotifyEvent(payload, notifySource, notifyDest);
+            _sentNotifications++;
+        }
+    } else {
+        TRACE(Trace::Error, (_T("Error in generating notification payload")));
+    }
+}
+
+void Adapter::NotificationCallback::Dispatch(NotificationHandler& handler)
+{
+    do {
+        NotifyData* notifyData = handler.NotificationData();
+        if ((nullptr != notifyData) && (IsRunning() == true)) {
+            _rawEvents++;
+
+            TRACE(Trace::Information, (_T("Calling Process request")));
+            Send(_parent->_notifier->Process(*notifyData));
+
+            _parent->FreeNotificationData(notifyData);
+        } else {
+            if (nullptr != notifyData) {
+                _parent->FreeNotificationData(notifyData);
+            }
+            TRACE(Trace::Information, (_T("Notification Queue is Empty")));
+            break;
+        }
+    } while(true);
+}
+
+void Adapter::NotificationCallback::Batch(NotificationHandler& handler)
+{
+    bool empty = false;
 
-                    TRACE(Trace::Information, (_T("Calling Process request")));
+    while ((empty == false) && (IsRunning() == true)) {
+        std::vector<NotifyData*> batch;
+        std::unordered_map<std::string, uint16_t> positions;
 
-                    std::string notifyPayload = _parent->_notifier->Process(*notifyData);
+        batch.reserve(MaxBatchSize);
 
-                    TRACE(Trace::Information, (_T("Notification Source = %s"), notifySource));
-                    TRACE(Trace::Information, (_T("Notification Dest = %s"), notifyDest));
+        while (batch.size() < MaxBatchSize) {
+            NotifyData* notifyData = handler.NotificationData();
+
+            if (nullptr == notifyData) {
+                empty = true;
+                break;
+            }
 
-                    if (notifyPayload.empty() != true) {
-                        TRACE(Trace::Information, (_T("Notification notifyPayload = %s"), notifyPayload));
-                    } else {
-                        TRACE(Trace::Information, (_T("Notification Payload is nullptr")));
-                    }
-                    if ((notifyPayload.empty() != true) && (notifySource.empty() != true) && (notifyDest.empty() != true)) {
-                        if (_parent->_callback)
-                            _parent->_callback->NotifyEvent(notifyPayload, notifySource, notifyDest);
-                    } else {
-                        TRACE(Trace::Error, (_T("Error in generating notification payload")));
-                    }
+            _rawEvents++;
 
+            if (notifyData->data.notify == nullptr) {
                 _parent->FreeNotificationData(notifyData);
+            } else {
+                std::unordered_map<std::string, uint16_t>::const_iterator index(positions.find(notifyData->data.notify->Name()));
+
+                if (index != positions.end()) {
+                    // Same parameter changed again, only the latest value is of interest.
+                    _parent->FreeNotificationData(batch[index->second]);
+                    batch[index->second] = notifyData;
+                    _coalescedEvents++;
                 } else {
-                    TRACE(Trace::Error, (_T("Notification Queue is Empty")));
-                    break;
+                    positions.emplace(notifyData->data.notify->Name(), static_cast<uint16_t>(batch.size()));
+                    batch.push_back(notifyData);
                 }
-            } while(true);
+            }
+        }
+
+        if (batch.size() == 1) {
+            Send(_parent->_notifier->Process(*batch.front()));
+        } else if (batch.size() > 1) {
+            Send(_parent->_notifier->Process(batch));
+            _batchedEvents += static_cast<uint32_t>(batch.size());
+        }
+
+        for (NotifyData* notifyData : batch) {
+            _parent->FreeNotificationData(notifyData);
         }
-        _adminLock.Unlock();
     }
-    _signaled.ResetEvent();
+}
 
-    return Core::infinite;
+void Adapter::NotificationCallback::Report(const uint32_t dropped)
+{
+    Core::JSON::Container statistics;
+    Core::JSON::DecUInt32 raw(_rawEvents, true);
+    Core::JSON::DecUInt32 coalesced(_coalescedEvents, true);
+    Core::JSON::DecUInt32 batched(_batchedEvents, true);
+    Core::JSON::DecUInt32 sent(_sentNotifications, true);
+    Core::JSON::DecUInt32 lost(dropped, true);
+    std::string report;
+
+    statistics.Add(_T("raw"), &raw);
+    statistics.Add(_T("coalesced"), &coalesced);
+    statistics.Add(_T("batched"), &batched);
+    statistics.Add(_T("sent"), &sent);
+    statistics.Add(_T("dropped"), &lost);
+    statistics.ToString(report);
+
+    // Only what changed is worth a notification, a run that found nothing to send changes nothing.
+    if (report != _reported) {
+        TRACE(Trace::Information, (_T("Notifications: %s"), report.c_str()));
+
+        if (_parent->_callback != nullptr) {
+            _parent->_callback->Statistics(report);
+        }
+        _reported = report;
+    }
 }
 
 void Adapter::Helper::UpdateRebootReason(const req_struct*& reqObj)
@@ -24,6 +24,8 @@
 #include "Parameter.h"
 #include "DataModel.h"
 
+#include <atomic>
+
 namespace WPEFramework {
 namespace WebPA {
 
@@ -37,6 +39,9 @@ private:
 
 private:
     class NotificationCallback : public ICallback, public Core::Thread {
+    private:
+        static constexpr const uint16_t MaxBatchSize = 64;
+
     public:
         NotificationCallback() = delete;
         NotificationCallback(const NotificationCallback&) = delete;
@@ -47,6 +52,12 @@ private:
             : _parent(parent)
             , _signaled(false, true)
             , _adminLock()
+            , _window(0)
+            , _rawEvents(0)
+            , _coalescedEvents(0)
+            , _batchedEvents(0)
+            , _sentNotifications(0)
+            , _reported()
         {
             Run();
             printf("%s constructed. Line: %d\n", __PRETTY_FUNCTION__,  __LINE__);
@@ -61,14 +72,34 @@ private:
         }
         virtual void NotifyEvent() override;
 
+        // Time, in milliseconds, changes are collected before they are sent upstream as one
+        // notification. Repeated changes of the same parameter within the window only report
+        // the latest value. Zero sends every change on its own. A batch is sent as an array of the
+        // same payloads a single change is sent as.
+        void Window(const uint16_t window)
+        {
+            _window.store(window);
+        }
+
     private:
     virtual uint32_t Worker();
+        void Send(const std::string& payload);
+        void Dispatch(NotificationHandler& handler);
+        void Batch(NotificationHandler& handler);
+        void Report(const uint32_t dropped);
 
     private:
         Adapter* _parent;
 
         Core::Event _signaled;
         Core::CriticalSection _adminLock;
+
+        std::atomic<uint16_t> _window;
+        uint32_t _rawEvents;
+        uint32_t _coalescedEvents;
+        uint32_t _batchedEvents;
+        uint32_t _sentNotifications;
+        std::string _reported;
     };
 
 public:
@@ -85,6 +116,7 @@ public:
     void SetNotifyCallback(Implementation::ICallback* cb);
     void InitializeNotifyParameters(void);
     void NotifierConfigFile(const std::string& nofityConfigFile);
+    void NotificationWindow(const uint16_t window);
 
     void ProcessRequest(char* reqPayload, char* transactionId, char** resPayload);
     void CurrentTime(struct timespec* timer);
@@ -22,410 +22,254 @@
 namespace WPEFramework {
 
 DataModel::DataModel(Handler* handler)
-    : _dmHandle(0)
+    : _objects()
+    , _parameters()
     , _handler(handler)
 {
 }
 
 DataModel::~DataModel()
 {
-    if (_dmHandle) {
-        TiXmlDocument* doc = reinterpret_cast<TiXmlDocument*>(_dmHandle);
-        delete (doc);
-    }
 }
 
 DMStatus DataModel::LoadDM(const std::string& filename)
 {
-    TiXmlDocument* doc = new TiXmlDocument(filename.c_str());
+    TiXmlDocument doc(filename.c_str());
     DMStatus status = DM_FAILURE;
 
-    if (nullptr != doc) {
-        bool loadOK = doc->LoadFile();
-        if (loadOK) {
-            _dmHandle = reinterpret_cast<int>(doc);
+    _objects.clear();
+    _parameters.clear();
+
+    if (doc.LoadFile() == true) {
+        Compile(&doc);
+
+        if (_objects.empty() == false) {
+            TRACE(Trace::Information, (_T("Data model compiled: %u objects, %u parameters"), static_cast<uint32_t>(_objects.size()), static_cast<uint32_t>(_parameters.size())));
             status = DM_SUCCESS;
-        } else {
-            _dmHandle = 0;
         }
-    } else {
-        _dmHandle = 0;
     }
     return status;
 }
 
-int16_t DataModel::ParameterInstanceCount(const std::string& paramName) const
+void DataModel::Compile(const TiXmlNode* document)
 {
-    int16_t instanceCount = 0;
-
-    if (paramName.empty() != true) {
-        std::size_t found = paramName.find(InstanceNumberIndicator);
-        if (found != std::string::npos) {
-
-            // Get the number of instances from Adapter
-            std::string paramType;
-
-            if (IsValidParameter (paramName, paramType)) {
-                TRACE(Trace::Information, (_T( "Valid Parameter..! ")));
-                string name(paramName, 0, found - 1 );
-                Data param(name + "NumberOfEntries", static_cast<const int>(0));
-
-                FaultCode status = (static_cast<const Handler&>(*_handler)).Parameter(param);
-                if (status != FaultCode::NoFault) {
-                    TRACE(Trace::Error, (_T("[%s:%s:%d] Error in Get Message Handler : faultCode = %d"), __FILE__, __FUNCTION__, __LINE__, status));
-                } else {
-                    TRACE(Trace::Information, (_T("[%s:%s:%d] The value for param: %s is %d"), __FILE__, __FUNCTION__, __LINE__, param.Name().c_str(), param.Value().Integer()));
-                    instanceCount = param.Value().Integer();
-                }
+    const TiXmlNode* child = document->FirstChild();
 
-            }
+    // Goto actual Object node ie "Device."
+    while (child != nullptr) {
+        if (child->Type() != TiXmlNode::TINYXML_ELEMENT) {
+            child = child->NextSibling();
+        } else if (strcmp(child->Value(), "object") == 0) {
+            break;
+        } else {
+            child = child->FirstChild();
         }
     }
-    return instanceCount;
-}
 
+    // All objects are siblings, the parameters are the children of the object.
+    for (; child != nullptr; child = child->NextSibling()) {
+        const TiXmlElement* element = child->ToElement();
 
-void DataModel::ReplaceWithInstanceNumber(string& paramName, uint16_t instanceNumber) const
-{
-    if (paramName.empty() != true) {
-        std::size_t position = paramName.find(InstanceNumberIndicator);
-        if (position != std::string::npos) {
-            std::string number = std::to_string(instanceNumber);
-            paramName.replace(position, strlen(InstanceNumberIndicator) - 1, number);
-        }
-    }
-}
+        if ((element != nullptr) && (strcmp(element->Value(), "object") == 0) && (element->FirstAttribute() != nullptr)) {
+            const std::string objectName(element->FirstAttribute()->Value());
+            Object& object(_objects[objectName]);
 
-bool DataModel::CheckMatchingParameter(const char* attrValue, const char* paramName, uint32_t& ret) const
-{
-    bool status = false;
+            for (const TiXmlElement* parameter = element->FirstChildElement("parameter"); parameter != nullptr; parameter = parameter->NextSiblingElement("parameter")) {
+                const TiXmlAttribute* name = parameter->FirstAttribute();
 
-    int i = 10;
-    int inst = 0;
+                if (name != nullptr) {
+                    std::string dataType;
+                    const TiXmlElement* syntax = parameter->FirstChildElement("syntax");
 
-    while (true) {
-        if (!(*attrValue && *paramName && (*attrValue == *paramName))) {
+                    if ((syntax != nullptr) && (syntax->FirstChildElement() != nullptr)) {
+                        dataType = syntax->FirstChildElement()->Value();
+                    }
 
-            ret = 0;
-            if (*attrValue == '{' && *paramName >= 48 && *paramName <= 56) {
-                attrValue += 3;
-                while(*paramName &&* paramName != '.') {
-                    ret = ret*i + (*paramName - 48);
-                    paramName++;
-                    inst = ret;
-                }
-            } else {
+                    _parameters[objectName + name->Value()] = dataType;
 
-                ret = 0;
-                if (!*paramName) {
-                    if (!*attrValue && (*(attrValue - 2) == '}')) {
-                        ret = inst;
+                    const char* getIdx = parameter->Attribute("getIdx");
+                    if ((getIdx != nullptr) && (strtol(getIdx, nullptr, 10) >= 1)) {
+                        object.Parameters.emplace_back(name->Value(), dataType);
                     }
-                    status = true;
                 }
-                break;
             }
         }
-        attrValue++;
-        paramName++;
     }
-    return status;
 }
 
-TiXmlNode* DataModel::Parameters(TiXmlNode* parent, const std::string& paramName, std::string& currentParam, std::map<uint32_t, std::pair<std::string, std::string>>& paramList) const
+void DataModel::Normalise(const std::string& paramName, std::string& normalised, std::vector<std::pair<std::size_t, uint32_t>>& instances) const
 {
-    // If parent is Null Return
-    if (!parent) {
-        return nullptr;
-    }
-
-    int isReccursiveCall = 0;
-    // Identify whether the call is recursive or initial call
-    if (currentParam.empty() != true) {
-        isReccursiveCall = 1;
-    }
+    std::size_t start = 0;
 
-    TiXmlNode* child;
-    // Goto actual Object node ie "Device."
-    if (parent->Type() != TiXmlNode::TINYXML_ELEMENT) {
-        for (child = parent->FirstChild(); child != 0;) {
-            if (child->Type() != TiXmlNode::TINYXML_ELEMENT) {
-                child = child->NextSibling();
-            } else {
-                if (!strcmp (child->Value(), "object"))
-                    break;
-                child = child->FirstChild();
-            }
-        }
-    } else {
-        child = parent;
-    }
+    normalised.clear();
+    normalised.reserve(paramName.length() + (2 * MaxInstanceLevels));
 
-    std::string zeroInstance;
-    while (child) {
-        TiXmlElement* pElement =  child->ToElement();
-        TiXmlAttribute* pAttrib = pElement->FirstAttribute();
-        uint32_t inst = 0;
-        int status = 0;
-
-        // Check if node is an Object
-        if (!strcmp(child->Value(),"object")) {
-            if (strstr(pAttrib->Value(), paramName.c_str()) || (status = CheckMatchingParameter(pAttrib->Value(), paramName.c_str(), inst))) {
-                // If the number of instances are 0 then skip this object and go to next sibling
-                if ((zeroInstance.empty() != true) && strstr(pAttrib->Value(), zeroInstance.c_str())) {
-                    child = child->NextSibling();
-                    continue;
-                } else if (zeroInstance.empty() != true) {
-                    zeroInstance = "";
-                }
-                // If matching found update the current parameter with wild card input std::string
-                if (status && !isReccursiveCall) {
-                    currentParam = paramName;
-                }
-                currentParam = pAttrib->Value();
-                TiXmlNode* bChild, *sChild;
-                bChild = child;
-                // Goto the parameters
-                child = child->FirstChild();
-
-                // Object not having any parameter thus go to next Sibling
-                if (nullptr == child) {
-                    child = bChild->NextSibling();
-                }
+    while (start < paramName.length()) {
+        std::size_t end = paramName.find('.', start);
 
-                char* endPtr = nullptr;
-                const std::string maxEntries = pElement->Attribute("maxEntries");
-                // Seems like a {i} instance
-                if (maxEntries.empty() != true && ((!strcmp(maxEntries.c_str(),"unbounded")) || (strtol(maxEntries.c_str(), &endPtr, 10) > 1))) {
-                    // Make Sure that its ends with {i}
-                    if (IsParamEndsWithInstance(pAttrib->Value()) == true ) {
-                        uint16_t instanceNumber = 0;
-                        uint16_t i = 1;
-                        // Get the Number of instances for that attribute
-                        uint16_t actualInstance = ParameterInstanceCount(pAttrib->Value());
-                        if (inst) {
-                            // Check if valid instance count is given in input wild card if not make it as zero, this will skip current branch
-                            if (actualInstance >= inst)
-                                i = instanceNumber = inst;
-                            else
-                                instanceNumber = 0;
-                        } else {
-                            instanceNumber = actualInstance;
+        if (end == std::string::npos) {
+            // The last segment is the parameter itself, take it as is.
+            normalised.append(paramName, start, std::string::npos);
+            break;
+        }
 
-                        }
-                        sChild = child;
-                        // Number of instances are > 0 go through each and populate data for each instance
-                        std::string tempParamName;
-                        while (i <= instanceNumber) {
-                            tempParamName = child->Parent()->ToElement()->FirstAttribute()->Value();
-                            currentParam = tempParamName;
-
-                            // Replace {i} with current instance number and call recursively
-                            ReplaceWithInstanceNumber(currentParam, i);
-
-                            sChild = Parameters(child, tempParamName, currentParam, paramList);
-                            i++;
-                        }
-                        child = sChild;
-                        // Seems like instance count is empty
-                        if (!instanceNumber) {
-                            zeroInstance = pAttrib->Value();
-                            child = child->Parent();
-                        }
-                    }
-                }
-            }
-            else if (isReccursiveCall) { // Tree found once and processed and going to another branch so break
-                return child;
-            }
-            else { // Tree not found yet goto next sibling and get it
-                child = child->NextSibling();
-            }
+        std::size_t index = start;
+        uint32_t number = 0;
+        while ((index < end) && (isdigit(paramName[index]))) {
+            number = (number * 10) + (paramName[index] - '0');
+            index++;
         }
-        // Found the Parameter
-        else if (!strcmp(child->Value(),"parameter")) {
-            TiXmlNode* bChild;
-            // Find all parameters
-            for (bChild = child ; child ; child=child->NextSibling()) {
-                if (paramList.size() <= MaxNumParameters) {
-                    if (currentParam.length() > 0) {
-                        if (child->ToElement()->Attribute("getIdx") && strtol(child->ToElement()->Attribute("getIdx"),nullptr,10) >= 1) {
-                            paramList.insert(std::make_pair(paramList.size(), std::make_pair(currentParam + child->ToElement()->FirstAttribute()->Value(), child->FirstChild()->FirstChild()->Value())));
-                        }
-                    }
-                }
-            }
-            // Go to next object
-            child = bChild->Parent();
-            child = child->NextSibling();
+
+        if ((index == end) && (end > start)) {
+            normalised.append(InstanceNumberIndicator);
+            instances.emplace_back(start, number);
+        } else {
+            normalised.append(paramName, start, (end + 1) - start);
         }
+        start = end + 1;
     }
-    return child;
 }
 
-DMStatus DataModel::Parameters(const std::string& paramName, std::map<uint32_t, std::pair<std::string, std::string>>& paramList) const
+bool DataModel::Lookup(const std::string& paramName, std::string& dataType) const
 {
-    std::string currentParam;
-    std::string parameterName = paramName;
+    bool valid = false;
 
-    ASSERT(_dmHandle != 0);
-    DMStatus status = DM_SUCCESS;
-    if (Utils::IsWildCardParam(parameterName)) {
-        Parameters(reinterpret_cast<TiXmlDocument*>(_dmHandle), parameterName, currentParam, paramList);
-        if (paramList.size() == 0) {
-            status = DM_ERR_INVALID_PARAMETER;
-        }
+    std::unordered_map<std::string, std::string>::const_iterator parameter(_parameters.find(paramName));
+    if (parameter != _parameters.end()) {
+        dataType = parameter->second;
+        valid = true;
     } else {
-        status = DM_ERR_WILDCARD_NOT_SUPPORTED;
+        valid = (_objects.find(paramName) != _objects.end());
     }
-    return status;
+    return valid;
 }
 
-void DataModel::CheckforParameterMatch(TiXmlNode* parent, const std::string& paramName, bool& match, std::string& dataType) const
+uint16_t DataModel::ParameterInstanceCount(const std::string& objectName, InstanceCounts& counts) const
 {
-    if (!parent)
-        return;
+    uint16_t instanceCount = 0;
 
-    static bool isObject = false;
-    static bool isMatched = false;
+    InstanceCounts::const_iterator index(counts.find(objectName));
 
-    if (parent->Type() == TiXmlNode::TINYXML_ELEMENT) {
-        TiXmlElement* pElement = parent->ToElement();
-        TiXmlAttribute* pAttrib = pElement->FirstAttribute();
-        if (!strcmp(parent->Value(), "object")) {
-            isObject = true;
-        }
+    if (index != counts.end()) {
+        instanceCount = index->second;
+    } else {
+        // Get the number of instances from Adapter
+        string name(objectName, 0, objectName.length() - 1);
+        Data param(name + "NumberOfEntries", static_cast<const int>(0));
 
-        if (pAttrib) {
-            // Construct Object without parameter from input ParamName
-            std::size_t found = paramName.find_last_of(".");
+        FaultCode status = (static_cast<const Handler&>(*_handler)).Parameter(param);
+        if (status != FaultCode::NoFault) {
+            TRACE(Trace::Error, (_T("[%s:%s:%d] Error in Get Message Handler : faultCode = %d"), __FILE__, __FUNCTION__, __LINE__, status));
+        } else {
+            TRACE(Trace::Information, (_T("[%s:%s:%d] The value for param: %s is %d"), __FILE__, __FUNCTION__, __LINE__, param.Name().c_str(), param.Value().Integer()));
+            instanceCount = param.Value().Integer();
+        }
+        counts.emplace(objectName, instanceCount);
+    }
+    return instanceCount;
+}
 
-            std::string tempObject;
-            if (found != std::string::npos) {
-                tempObject.assign(paramName, 0, found + 1);
-            } else {
-                tempObject = paramName;
-            }
+void DataModel::Expand(const std::string& pattern, const std::size_t offset, const std::string& current, const std::vector<std::pair<std::size_t, uint32_t>>& instances, const uint8_t level, const Object& object, InstanceCounts& counts, ParameterList& paramList) const
+{
+    std::size_t position = pattern.find(InstanceNumberIndicator, offset);
 
-            static std::string objectName;
-            if (!strcmp(pAttrib->Value(), tempObject.c_str())) {
-                objectName = pAttrib->Value();
-                isMatched = true;
-            }
+    if (position == std::string::npos) {
+        const std::string objectName(current + pattern.substr(offset));
 
-            if (isMatched || !isObject) {
-                if (objectName == paramName) {
-                    match = true;
-                    return;
-                } else {
-                    isObject = 0;
-                    if (!strcmp(parent->Value(), "parameter")) {
-                        std::string nameFromParamater = objectName + pAttrib->Value();
-
-                        if ((objectName + pAttrib->Value()) == paramName) {
-                            dataType = parent->FirstChild()->FirstChild()->Value();
-                            match = true;
-                            return;
-                        }
-                    }
-                }
+        for (const auto& parameter : object.Parameters) {
+            if (paramList.size() >= MaxNumParameters) {
+                break;
             }
+            paramList.emplace(static_cast<uint32_t>(paramList.size()), std::make_pair(objectName + parameter.first, parameter.second));
+        }
+    } else {
+        const std::string prefix(current + pattern.substr(offset, position - offset));
+        const uint16_t actualInstance = ParameterInstanceCount(prefix, counts);
+        uint32_t first = 1;
+        uint32_t last = actualInstance;
+
+        // If the instance was given in the request, only that one is of interest, if it exists.
+        if (level < instances.size()) {
+            first = instances[level].second;
+            last = (first <= actualInstance ? first : 0);
         }
-    }
 
-    for (TiXmlNode* child = parent->FirstChild(); child != 0; child = child->NextSibling()) {
-        CheckforParameterMatch(child, paramName, match, dataType);
-        if (match == true) {
-            break;
+        for (uint32_t i = first; (i <= last) && (paramList.size() < MaxNumParameters); ++i) {
+            Expand(pattern, position + strlen(InstanceNumberIndicator), prefix + std::to_string(i) + '.', instances, level + 1, object, counts, paramList);
         }
     }
-    isMatched = 0;
 }
 
-uint8_t DataModel::FindInstanceOccurance(const std::string& paramName, std::map<uint8_t, std::pair<std::size_t, std::size_t>>& positions) const
+DMStatus DataModel::Parameters(const std::string& paramName, ParameterList& paramList) const
 {
-    uint8_t count = 0;
-    std::string name = paramName;
-    std::size_t separator = 0;
-    while (true) {
-        std::size_t position =  name.find_first_of("0123456789", separator);
-        if (position != std::string::npos) {
-            separator = name.find(".", position);
-            if (separator != std::string::npos) {
-                positions.insert(std::make_pair(count, std::make_pair(position, separator)));
-                count++;
-            } else {
-                break;
-            }
-        } else {
-            break;
-        }
-    }
+    ASSERT(_objects.empty() == false);
+    DMStatus status = DM_SUCCESS;
 
-    return count;
-}
+    if (Utils::IsWildCardParam(paramName)) {
+        std::string pattern;
+        std::vector<std::pair<std::size_t, uint32_t>> instances;
+        InstanceCounts counts;
 
-bool DataModel::ValidateParameterInstance(const std::string& paramName, std::string& dataType) const
-{
-    bool valid = false;
+        Normalise(paramName, pattern, instances);
 
-    std::map<uint8_t, std::pair<std::size_t, std::size_t>> positions;
-    uint8_t occurrences = FindInstanceOccurance(paramName, positions);
-
-    for (uint8_t i = occurrences; (i > 0) && (valid != true); --i) {
-        uint8_t index = occurrences - i;
-
-        std::string tempName = paramName;
-        std::map<uint8_t, std::pair<std::size_t, std::size_t>>::iterator position = positions.find(index);
-        if (positions.end() != position) {
-            tempName.replace(position->second.first, ((position->second.second + 1) - position->second.first), InstanceNumberIndicator);
-            uint16_t maxCombinations = pow(2, i - 1);
-            for (uint16_t j = 0; j < maxCombinations; ++j) {
-                std::string name = tempName;
-                int8_t newPosition = 0;
-                for (uint8_t k = 0; k < i; ++k) {
-                    if ((j & (1 << k))) {
-
-                        index = (occurrences - 1) - k;
-                        std::map<uint8_t, std::pair<std::size_t, std::size_t>>::iterator position = positions.find(index);
-                        if (positions.end() != position) {
-
-                            newPosition = strlen(InstanceNumberIndicator) - ((position->second.second + 1) - position->second.first);
-                            name.replace(position->second.first + newPosition, ((position->second.second + 1) - position->second.first), InstanceNumberIndicator);
-                        }
-                    }
-                }
-                CheckforParameterMatch(reinterpret_cast<TiXmlDocument*>(_dmHandle), name, valid, dataType);
-                if (valid == true) {
-                    break;
-                }
+        // All objects in the requested sub tree are adjacent in the ordered index.
+        std::map<std::string, Object>::const_iterator index(_objects.lower_bound(pattern));
+
+        while ((index != _objects.end()) && (index->first.compare(0, pattern.length(), pattern) == 0) && (paramList.size() < MaxNumParameters)) {
+            if (index->second.Parameters.empty() == false) {
+                Expand(index->first, 0, std::string(), instances, 0, index->second, counts, paramList);
             }
+            index++;
+        }
+
+        if (paramList.size() == 0) {
+            status = DM_ERR_INVALID_PARAMETER;
         }
+    } else {
+        status = DM_ERR_WILDCARD_NOT_SUPPORTED;
     }
-    return valid;
+    return status;
 }
 
 bool DataModel::IsValidParameter(const std::string& paramName, std::string& dataType) const
 {
-    bool valid = false;
-    ASSERT(_dmHandle != 0);
-    CheckforParameterMatch(reinterpret_cast<TiXmlDocument*>(_dmHandle), paramName, valid, dataType);
+    ASSERT(_objects.empty() == false);
+
+    bool valid = Lookup(paramName, dataType);
+
     if (valid != true) {
-        valid = ValidateParameterInstance(paramName, dataType);
-    }
-    return valid;
-}
+        std::string normalised;
+        std::vector<std::pair<std::size_t, uint32_t>> instances;
 
-bool DataModel::IsParamEndsWithInstance(const std::string& paramName) const
-{
-    bool isInstance = false;
+        Normalise(paramName, normalised, instances);
+
+        if (instances.empty() == false) {
+            valid = Lookup(normalised, dataType);
+
+            // Numbers in the path might also be part of the name rather than an instance
+            // number, so try the remaining combinations as well.
+            if ((valid != true) && (instances.size() > 1) && (instances.size() <= MaxInstanceLevels)) {
+                const uint16_t all = static_cast<uint16_t>((1 << instances.size()) - 1);
 
-    if (paramName.empty() != true) {
-        std::size_t position = paramName.find(string(InstanceNumberIndicator));
-        if ((position != std::string::npos) && ((position + strlen(InstanceNumberIndicator)) != std::string::npos)) {
-            isInstance = true;
+                for (uint16_t mask = all - 1; (mask > 0) && (valid != true); --mask) {
+                    std::string name;
+                    std::size_t last = 0;
+
+                    for (uint8_t i = 0; i < instances.size(); ++i) {
+                        if ((mask & (1 << i)) != 0) {
+                            const std::size_t end = paramName.find('.', instances[i].first);
+                            name.append(paramName, last, instances[i].first - last);
+                            name.append(InstanceNumberIndicator);
+                            last = end + 1;
+                        }
+                    }
+                    name.append(paramName, last, std::string::npos);
+
+                    valid = Lookup(name, dataType);
+                }
+            }
         }
     }
-    return isInstance;
+    return valid;
 }
 }
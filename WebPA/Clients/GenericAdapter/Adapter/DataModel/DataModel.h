@@ -40,8 +40,25 @@ DMStatus;
 class DataModel {
 private:
     static constexpr const uint32_t  MaxNumParameters = 2048;
+    static constexpr const uint8_t  MaxInstanceLevels = 8;
     static constexpr const TCHAR* InstanceNumberIndicator = "{i}.";
 
+    // The XML is only read once, at load time. All the lookups afterwards are done on
+    // this index, keyed by the normalised path: every instance number is replaced by
+    // the InstanceNumberIndicator, just like it is written in the data model itself.
+    struct Object {
+        Object()
+            : Parameters()
+        {
+        }
+
+        // Parameters that are reported on a wildcard request (getIdx >= 1), in document order.
+        std::vector<std::pair<std::string, std::string>> Parameters;
+    };
+
+    typedef std::map<uint32_t, std::pair<std::string, std::string>> ParameterList;
+    typedef std::map<std::string, uint16_t> InstanceCounts;
+
 public:
     DataModel() = delete;
     DataModel(const DataModel&) = delete;
@@ -51,22 +68,20 @@ public:
     ~DataModel();
 
     DMStatus LoadDM(const std::string& filename);
-    DMStatus Parameters(const std::string& paramName, std::map<uint32_t, std::pair<std::string, std::string>>& paramList) const;
+    DMStatus Parameters(const std::string& paramName, ParameterList& paramList) const;
     bool IsValidParameter(const std::string& paramName, std::string& dataType) const;
-    int DMHandle() { return _dmHandle; }
+    int DMHandle() { return (_objects.empty() == false ? 1 : 0); }
 
 private:
-    TiXmlNode* Parameters(TiXmlNode* pParent, const std::string& paramName, std::string& currentParam, std::map<uint32_t, std::pair<std::string, std::string>>& paramList) const;
-    void CheckforParameterMatch(TiXmlNode *pParent, const std::string& paramName, bool& pMatch, std::string& dataType) const;
-    bool IsParamEndsWithInstance(const std::string& paramName) const;
-    void ReplaceWithInstanceNumber(string& paramName, uint16_t instanceNumber) const;
-    bool CheckMatchingParameter(const char* attrValue, const char* paramName, uint32_t& ret) const;
-    bool ValidateParameterInstance(const std::string& paramName, std::string& dataType) const;
-    uint8_t FindInstanceOccurance(const std::string& paramName, std::map<uint8_t, std::pair<std::size_t, std::size_t>>& positions) const;
-    int16_t ParameterInstanceCount(const std::string& paramName) const;
+    void Compile(const TiXmlNode* document);
+    bool Lookup(const std::string& paramName, std::string& dataType) const;
+    void Normalise(const std::string& paramName, std::string& normalised, std::vector<std::pair<std::size_t, uint32_t>>& instances) const;
+    void Expand(const std::string& pattern, const std::size_t offset, const std::string& current, const std::vector<std::pair<std::size_t, uint32_t>>& instances, const uint8_t level, const Object& object, InstanceCounts& counts, ParameterList& paramList) const;
+    uint16_t ParameterInstanceCount(const std::string& objectName, InstanceCounts& counts) const;
 
 private:
-    int _dmHandle;
+    std::map<std::string, Object> _objects;
+    std::unordered_map<std::string, std::string> _parameters;
     Handler* _handler;
 };
 }
@@ -19,6 +19,8 @@
  
 #include "Notifier.h"
 
+#include <cinttypes>
+
 namespace WPEFramework {
 namespace WebPA {
 
@@ -61,56 +63,8 @@ string Notifier::Process(const NotifyData& notifyData)
         ParamNotify* param = notifyData.data.notify;
         if (param) {
             TRACE(Trace::Information, (_T("Notification Processed")));
-            TRACE(Trace::Information, (_T("DeviceID: %s"), Source().c_str()));
             NotifierPayload notfierPayload;
-            notfierPayload.DeviceID = Source();
-            TRACE(Trace::Information, (_T("ParameterName: %s"), param->Name().c_str()));
-            notfierPayload.Name = param->Name();
-            TRACE(Trace::Information, (_T("ParameterType: %d"), param->Value().Type()));
-            notfierPayload.Type = param->Value().Type();
-            TRACE(Trace::Information, (_T("NotificationType: %s"), NotifyTypeStr));
-
-            switch(param->Value().Type())
-            {
-            case Variant::ParamType::TypeString:
-            {
-                TRACE(Trace::Information, (_T("paramValue: %s"), param->Value().String().c_str()));
-                Core::JSON::Variant value(static_cast<string>(param->Value().String()));
-                notfierPayload.Value = value;
-                break;
-            }
-            case Variant::ParamType::TypeInteger:
-            {
-                TRACE(Trace::Information, (_T("paramValue: %d"), param->Value().Integer()));
-                Core::JSON::Variant value(static_cast<int32_t>(param->Value().Integer()));
-                notfierPayload.Value = value;
-                break;
-            }
-            case Variant::ParamType::TypeUnsignedInteger:
-            {
-                TRACE(Trace::Information, (_T("paramValue: %d"), param->Value().UnsignedInteger()));
-                Core::JSON::Variant value(static_cast<uint32_t>(param->Value().Integer()));
-                notfierPayload.Value = value;
-                break;
-            }
-            case Variant::ParamType::TypeBoolean:
-            {
-                TRACE(Trace::Information, (_T("paramValue: %d"), param->Value().Boolean()));
-                Core::JSON::Variant value(static_cast<bool>(param->Value().Integer()));
-                notfierPayload.Value = value;
-            }
-            case Variant::ParamType::TypeUnsignedLong:
-            {
-                TRACE(Trace::Information, (_T("paramValue: %d"), param->Value().UnsignedLong()));
-                Core::JSON::Variant value(static_cast<uint64_t>(param->Value().UnsignedLong()));
-                notfierPayload.Value = value;
-                break;
-            }
-            default:
-            {
-                break;
-            }
-            }
+            Fill(notfierPayload, Source(), *param);
             notfierPayload.ToString(payload);
             TRACE(Trace::Information, (_T("Notification Processed ,Payload = %s"), payload));
 
@@ -124,6 +78,84 @@ string Notifier::Process(const NotifyData& notifyData)
     return payload;
 }
 
+std::string Notifier::Process(const std::vector<NotifyData*>& notifyData)
+{
+    TRACE(Trace::Information, (_T("%s:Start"), __FUNCTION__));
+    std::string payload;
+    Core::JSON::ArrayType<NotifierPayload> batchPayload;
+    const std::string source(Source());
+
+    for (const NotifyData* entry : notifyData) {
+        if ((entry != nullptr) && (entry->type == PARAM_VALUE_CHANGE_NOTIFY) && (entry->data.notify != nullptr)) {
+            Fill(batchPayload.Add(), source, *(entry->data.notify));
+        }
+    }
+
+    if (batchPayload.Length() > 0) {
+        batchPayload.ToString(payload);
+        TRACE(Trace::Information, (_T("Notifications Processed, Count = %u Payload = %s"), static_cast<uint32_t>(batchPayload.Length()), payload.c_str()));
+    }
+    TRACE(Trace::Information, (_T("%s:End"), __FUNCTION__));
+    return payload;
+}
+
+void Notifier::Fill(NotifierPayload& payload, const std::string& source, const ParamNotify& param) const
+{
+    TRACE(Trace::Information, (_T("DeviceID: %s"), source.c_str()));
+    payload.DeviceID = source;
+    TRACE(Trace::Information, (_T("ParameterName: %s"), param.Name().c_str()));
+    payload.Name = param.Name();
+    TRACE(Trace::Information, (_T("ParameterType: %d"), param.Value().Type()));
+    payload.Type = param.Value().Type();
+    TRACE(Trace::Information, (_T("NotificationType: %s"), NotifyTypeStr));
+    payload.NotifyType = NotifyTypeStr;
+    payload.Value = Value(param);
+}
+
+Core::JSON::Variant Notifier::Value(const ParamNotify& param) const
+{
+    Core::JSON::Variant result;
+
+    switch(param.Value().Type())
+    {
+    case Variant::ParamType::TypeString:
+    {
+        TRACE(Trace::Information, (_T("paramValue: %s"), param.Value().String().c_str()));
+        result = Core::JSON::Variant(static_cast<string>(param.Value().String()));
+        break;
+    }
+    case Variant::ParamType::TypeInteger:
+    {
+        TRACE(Trace::Information, (_T("paramValue: %d"), param.Value().Integer()));
+        result = Core::JSON::Variant(static_cast<int32_t>(param.Value().Integer()));
+        break;
+    }
+    case Variant::ParamType::TypeUnsignedInteger:
+    {
+        TRACE(Trace::Information, (_T("paramValue: %u"), param.Value().UnsignedInteger()));
+        result = Core::JSON::Variant(static_cast<uint32_t>(param.Value().Integer()));
+        break;
+    }
+    case Variant::ParamType::TypeBoolean:
+    {
+        TRACE(Trace::Information, (_T("paramValue: %d"), param.Value().Boolean()));
+        result = Core::JSON::Variant(static_cast<bool>(param.Value().Integer()));
+        break;
+    }
+    case Variant::ParamType::TypeUnsignedLong:
+    {
+        TRACE(Trace::Information, (_T("paramValue: %" PRIu64), static_cast<uint64_t>(param.Value().UnsignedLong())));
+        result = Core::JSON::Variant(static_cast<uint64_t>(param.Value().UnsignedLong()));
+        break;
+    }
+    default:
+    {
+        break;
+    }
+    }
+    return (result);
+}
+
 std::string Notifier::Source()
 {
     TRACE(Trace::Information, (_T("%s:Start"), __FUNCTION__));
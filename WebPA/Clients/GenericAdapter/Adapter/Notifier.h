@@ -31,9 +31,10 @@ private:
    static constexpr const TCHAR* UnknownParamValue = "Unknown";
 
 private:
+   // A batch goes upstream as a JSON array of these, so every change has the same layout,
+   // whether it is sent on its own or together with others.
    class NotifierPayload : public Core::JSON::Container {
    public:
-        NotifierPayload(const NotifierPayload&) = delete;
         NotifierPayload& operator=(const NotifierPayload&) = delete;
 
     public:
@@ -51,6 +52,20 @@ private:
             Add(_T("paramValue"), &Value);
             Add(_T("notificationType"), &NotifyType);
         }
+        NotifierPayload(const NotifierPayload& copy)
+            : Core::JSON::Container()
+            , DeviceID(copy.DeviceID)
+            , Type(copy.Type)
+            , Name(copy.Name)
+            , Value(copy.Value)
+            , NotifyType(copy.NotifyType)
+        {
+            Add(_T("device_id"), &DeviceID);
+            Add(_T("datatype"), &Type);
+            Add(_T("paramName"), &Name);
+            Add(_T("paramValue"), &Value);
+            Add(_T("notificationType"), &NotifyType);
+        }
         virtual ~NotifierPayload()
         {
         }
@@ -93,10 +108,13 @@ public:
     void ConfigurationFile(const std::string& nofityConfigFile);
     uint32_t Parameters(std::vector<std::string>& notifyParameters);
     std::string Process(const NotifyData& notifyData);
+    std::string Process(const std::vector<NotifyData*>& notifyData);
     std::string Destination();
     std::string Source();
 
 private:
+    void Fill(NotifierPayload& payload, const std::string& source, const ParamNotify& param) const;
+    Core::JSON::Variant Value(const ParamNotify& param) const;
     char CharToLower(char c);
     void StringToLower(string& str);
 
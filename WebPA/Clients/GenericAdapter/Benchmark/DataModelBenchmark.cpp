@@ -0,0 +1,231 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataModel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Issues exact and wildcard GETs against the compiled data model, the way the cloud does on a
+// parameter request. The exact names are every parameter of the model, with the instance numbers
+// filled in; the wildcards are every object of the model, with and without their instance numbers.
+// The profiles are left out: the data model only asks the handler for the NumberOfEntries of the
+// multi instance objects, the stand-in handler of this benchmark answers those with -instances.
+
+using namespace WPEFramework;
+
+namespace {
+
+    static uint16_t Instances = 2;
+
+    struct Options {
+        Options()
+            : Model("data-model.xml")
+            , Iterations(100)
+            , Instances(2)
+        {
+        }
+
+        std::string Model;
+        uint32_t Iterations;
+        uint16_t Instances;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-model") == 0)) {
+                options.Model = argv[++index];
+            } else if ((value == true) && (strcmp(argv[index], "-iterations") == 0)) {
+                options.Iterations = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else if ((value == true) && (strcmp(argv[index], "-instances") == 0)) {
+                options.Instances = static_cast<uint16_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Iterations == 0));
+    }
+
+    void ShowHelp()
+    {
+        printf("DataModelBenchmark [options]\n"
+               "\t-model <file>             TR-181 data model to load [data-model.xml]\n"
+               "\t-iterations <count>       Passes over all names [100]\n"
+               "\t-instances <count>        Instances reported for every multi instance object [2]\n");
+    }
+
+    // Replaces every instance placeholder by an instance number, cycling through the instances.
+    std::string Instantiate(const std::string& name, const uint32_t seed)
+    {
+        static const std::string placeholder("{i}");
+
+        std::string result(name);
+        std::size_t position = 0;
+        uint32_t level = 0;
+
+        while ((position = result.find(placeholder, position)) != std::string::npos) {
+            const std::string number(std::to_string(((seed >> level) % Instances) + 1));
+            result.replace(position, placeholder.length(), number);
+            position += number.length();
+            level++;
+        }
+
+        return (result);
+    }
+
+    bool Names(const std::string& model, std::vector<std::string>& exact, std::vector<std::string>& wildcards)
+    {
+        TiXmlDocument document(model.c_str());
+        bool result = document.LoadFile();
+
+        if (result == true) {
+            const TiXmlElement* root = document.RootElement();
+            const TiXmlElement* container = (root != nullptr ? root->FirstChildElement("model") : nullptr);
+
+            for (const TiXmlElement* object = (container != nullptr ? container->FirstChildElement("object") : nullptr); object != nullptr; object = object->NextSiblingElement("object")) {
+                const char* base = object->Attribute("base");
+
+                if (base != nullptr) {
+                    const std::string name(base);
+
+                    wildcards.push_back(name);
+                    if (name.find("{i}") != std::string::npos) {
+                        wildcards.push_back(Instantiate(name, static_cast<uint32_t>(wildcards.size())));
+                    }
+
+                    for (const TiXmlElement* parameter = object->FirstChildElement("parameter"); parameter != nullptr; parameter = parameter->NextSiblingElement("parameter")) {
+                        const char* parameterName = parameter->Attribute("base");
+
+                        if (parameterName != nullptr) {
+                            exact.push_back(Instantiate(name + parameterName, static_cast<uint32_t>(exact.size())));
+                        }
+                    }
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    template <typename ACTION>
+    double Measure(const uint32_t iterations, const std::vector<std::string>& names, ACTION&& action)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+            for (const std::string& name : names) {
+                action(name);
+            }
+        }
+
+        const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        return (elapsed / (static_cast<double>(iterations) * names.size()));
+    }
+}
+
+namespace WPEFramework {
+
+// Stand-in for the profile handler, only the instance counts of the multi instance objects are asked for.
+Handler::Handler()
+    : _systemLibraries()
+    , _notificationCallback(nullptr)
+    , _signaled(false, true)
+    , _adminLock()
+{
+}
+
+Handler::~Handler()
+{
+}
+
+uint32_t Handler::Worker()
+{
+    return (Core::infinite);
+}
+
+const FaultCode Handler::Parameter(Data& parameter) const
+{
+    parameter.Value(Variant(static_cast<int>(Instances)));
+    return (FaultCode::NoFault);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    Instances = std::max(options.Instances, static_cast<uint16_t>(1));
+
+    std::vector<std::string> exact;
+    std::vector<std::string> wildcards;
+
+    if (Names(options.Model, exact, wildcards) == false) {
+        fprintf(stderr, "Could not read the data model [%s]\n", options.Model.c_str());
+        return (1);
+    }
+
+    Handler handler;
+    DataModel model(&handler);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const DMStatus loaded = model.LoadDM(options.Model);
+    const double load = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    if (loaded != DM_SUCCESS) {
+        fprintf(stderr, "Could not compile the data model [%s]\n", options.Model.c_str());
+        return (1);
+    }
+
+    uint32_t valid = 0;
+    uint64_t expanded = 0;
+    std::string dataType;
+
+    const double exactTime = Measure(options.Iterations, exact, [&](const std::string& name) {
+        valid += (model.IsValidParameter(name, dataType) == true ? 1 : 0);
+    });
+
+    const double wildcardTime = Measure(options.Iterations, wildcards, [&](const std::string& name) {
+        std::map<uint32_t, std::pair<std::string, std::string>> parameters;
+        model.Parameters(name, parameters);
+        expanded += parameters.size();
+    });
+
+    printf("load_us,exact,exact_valid,exact_ns,wildcards,wildcard_parameters,wildcard_ns\n");
+    printf("%.0f,%u,%u,%.0f,%u,%llu,%.0f\n", load,
+        static_cast<uint32_t>(exact.size()), valid / options.Iterations, exactTime,
+        static_cast<uint32_t>(wildcards.size()), static_cast<unsigned long long>(expanded / options.Iterations), wildcardTime);
+
+    return (valid == (exact.size() * options.Iterations) ? 0 : 2);
+}
@@ -189,9 +189,8 @@ FaultCode Handler::Attribute(const Data& parameter)
 void Handler::FreeData(Data* parameter)
 {
     TRACE(Trace::Information, (string(__FUNCTION__)));
-    if (parameter) {
-        g_free(parameter);
-    }
+    // Data is a C++ object, it is handed out with new.
+    delete parameter;
 }
 
 std::vector<std::string> Handler::SplitParam(std::string parameter, char delimeter) const
@@ -253,18 +252,21 @@ NotificationHandler* NotificationHandler::_instance = nullptr;
 
 NotificationHandler::NotificationHandler()
     : _notificationCb(nullptr)
-    , _notificationQueue(nullptr)
+    , _notificationQueue()
+    , _dropped(0)
     , _adminLock()
 {
     TRACE(Trace::Information, (string(__FUNCTION__)));
-    // Initialize notificationQueue
-    _notificationQueue = g_async_queue_new();
 }
 
 NotificationHandler::~NotificationHandler()
 {
     TRACE(Trace::Information, (string(__FUNCTION__)));
-    g_async_queue_unref(_notificationQueue);
+    NotifyData* notifyData = nullptr;
+    while (_notificationQueue.Pop(notifyData) == true) {
+        delete notifyData->data.notify;
+        delete notifyData;
+    }
 }
 
 NotificationHandler* NotificationHandler::GetInstance()
@@ -279,12 +281,10 @@ NotificationHandler* NotificationHandler::GetInstance()
 
 NotifyData* NotificationHandler::NotificationData()
 {
-    _adminLock.Lock();
     NotifyData* notifyData = nullptr;
-    if (nullptr != _notificationQueue) {
-       notifyData = (NotifyData*) g_async_queue_timeout_pop (_notificationQueue, 1000);
+    if (_notificationQueue.Pop(notifyData) == false) {
+        notifyData = nullptr;
     }
-    _adminLock.Unlock();
     return notifyData;
 }
 
@@ -318,23 +318,25 @@ void NotificationHandler::AddNotificationToQueue(const EventId& eventId, const E
             notifyData->data.notify = paramNotify;
 
             // Add the notification to queue and call Webpa Callback
-            _adminLock.Lock();
-            if (nullptr != _notificationQueue) {
-                g_async_queue_push(_notificationQueue, notifyData);
+            if (_notificationQueue.Push(notifyData) == true) {
+                _adminLock.Lock();
                 _notificationCb->NotifyEvent();
+                _adminLock.Unlock();
             } else {
-
-                TRACE(Trace::Information, (_T("Queue is not initialized ")));
+                TRACE(Trace::Error, (_T("Notification queue is full, dropping change of %s"), eventData.Name().c_str()));
+                _dropped.fetch_add(1, std::memory_order_relaxed);
                 if (paramNotify) {
                     delete paramNotify;
                 }
+                delete notifyData;
             }
-            _adminLock.Unlock();
         } else {
             if (paramNotify) {
                 delete paramNotify;
             }
         }
+    } else if (paramNotify) {
+        delete paramNotify;
     }
 }
 
@@ -22,13 +22,105 @@
 #include "Module.h"
 #include "IAdapter.h"
 
-#include <glib.h>
+#include <atomic>
 #include <interfaces/IWebPA.h>
 
 
 namespace WPEFramework {
 
+// Bounded multi-producer/multi-consumer queue, every cell carries a sequence number that tells
+// producers and consumers whether it is theirs to fill or to empty. No locks are taken, so the
+// profile callbacks never block on the notification worker.
+template <typename ELEMENT, const uint16_t CAPACITY>
+class BoundedQueue {
+private:
+    static_assert((CAPACITY >= 2) && ((CAPACITY & (CAPACITY - 1)) == 0), "Capacity must be a power of 2");
+
+    struct Cell {
+        std::atomic<uint32_t> Sequence;
+        ELEMENT Element;
+    };
+
+public:
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator= (const BoundedQueue&) = delete;
+
+    BoundedQueue()
+        : _head(0)
+        , _tail(0)
+    {
+        for (uint32_t index = 0; index < CAPACITY; ++index) {
+            _cells[index].Sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+    ~BoundedQueue()
+    {
+    }
+
+public:
+    bool Push(const ELEMENT& element)
+    {
+        Cell* cell = nullptr;
+        uint32_t position = _tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            cell = &(_cells[position & (CAPACITY - 1)]);
+            const int32_t difference = static_cast<int32_t>(cell->Sequence.load(std::memory_order_acquire) - position);
+
+            if (difference == 0) {
+                if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // Full, the consumer is lagging behind.
+                return (false);
+            } else {
+                position = _tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->Element = element;
+        cell->Sequence.store(position + 1, std::memory_order_release);
+
+        return (true);
+    }
+    bool Pop(ELEMENT& element)
+    {
+        Cell* cell = nullptr;
+        uint32_t position = _head.load(std::memory_order_relaxed);
+
+        while (true) {
+            cell = &(_cells[position & (CAPACITY - 1)]);
+            const int32_t difference = static_cast<int32_t>(cell->Sequence.load(std::memory_order_acquire) - (position + 1));
+
+            if (difference == 0) {
+                if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // Empty, nothing produced yet.
+                return (false);
+            } else {
+                position = _head.load(std::memory_order_relaxed);
+            }
+        }
+
+        element = cell->Element;
+        cell->Sequence.store(position + CAPACITY, std::memory_order_release);
+
+        return (true);
+    }
+
+private:
+    Cell _cells[CAPACITY];
+    std::atomic<uint32_t> _head;
+    std::atomic<uint32_t> _tail;
+};
+
 class NotificationHandler {
+private:
+    static constexpr uint16_t QueueCapacity = 256;
+
 public:
     NotificationHandler();
     ~NotificationHandler();
@@ -37,6 +129,10 @@ public:
     NotifyData* NotificationData();
     void AddNotificationToQueue(const EventId& eventId, const EventData& eventData);
     void SetNotifyCallback(WebPA::ICallback* cb);
+    uint32_t Dropped() const
+    {
+        return (_dropped.load(std::memory_order_relaxed));
+    }
 
 private:
     bool IsValidParameter(string paramName);
@@ -44,7 +140,8 @@ private:
 private:
     static NotificationHandler* _instance;
     WebPA::ICallback* _notificationCb;
-    GAsyncQueue* _notificationQueue;
+    BoundedQueue<NotifyData*, QueueCapacity> _notificationQueue;
+    std::atomic<uint32_t> _dropped;
 
     Core::CriticalSection _adminLock;
 };
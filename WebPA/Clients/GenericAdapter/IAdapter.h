@@ -26,6 +26,8 @@ namespace Implementation {
     struct ICallback {
         virtual ~ICallback() {}
         virtual void NotifyEvent(const std::string& payload, const std::string& source, const std::string& destination) = 0;
+        // The notification counters, as a JSON object, each time they changed.
+        virtual void Statistics(const std::string& report) = 0;
     };
 } // Implementation
 
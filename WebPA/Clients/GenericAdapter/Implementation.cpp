@@ -53,11 +53,13 @@ private:
             , ClientURL(_T("tcp://127.0.0.1:6667"))
             , ParodusURL(_T("tcp://127.0.0.1:6666"))
             , NotifyConfigFile(_T(""))
+            , NotificationWindow(0)
         {
             Add(_T("datamodelfile"), &DataModelFile);
             Add(_T("genericclienturl"), &ClientURL);
             Add(_T("paroduslocalurl"), &ParodusURL);
             Add(_T("notifyconfigfile"), &NotifyConfigFile);
+            Add(_T("notificationwindow"), &NotificationWindow);
         }
         ~Config()
         {
@@ -68,6 +70,7 @@ private:
         Core::JSON::String ClientURL;
         Core::JSON::String ParodusURL;
         Core::JSON::String NotifyConfigFile;
+        Core::JSON::DecUInt16 NotificationWindow;
     };
 
     class NotificationCallback : public ICallback {
@@ -86,6 +89,7 @@ private:
             TRACE_L1("%s destructed. Line: %d", __PRETTY_FUNCTION__, __LINE__);
         }
         virtual void NotifyEvent(const std::string& payload, const std::string& source, const std::string& destination) override;
+        virtual void Statistics(const std::string& report) override;
 
     private:
         GenericAdapter* _parent;
@@ -100,6 +104,7 @@ public:
         : Core::Thread(0, _T("WebPAClient"))
         , _adminLock()
         , _notificationCallback(nullptr)
+        , _service(nullptr)
     {
         TRACE(Trace::Information, (_T("GenericAdapter::Construct()")));
         _adapter = new WebPA::Adapter(&_msgHandler);
@@ -124,6 +129,10 @@ public:
             delete _adapter;
             _adapter = nullptr;
         }
+        if (nullptr != _service) {
+            _service->Release();
+            _service = nullptr;
+        }
     }
 
     BEGIN_INTERFACE_MAP(GenericAdapter)
@@ -147,6 +156,16 @@ public:
             _adapter->NotifierConfigFile(config.NotifyConfigFile.Value());
         }
 
+        _adapter->NotificationWindow(config.NotificationWindow.Value());
+
+        // The notification counters go out as events of the plugin.
+        _adminLock.Lock();
+        if (_service == nullptr) {
+            _service = service;
+            _service->AddRef();
+        }
+        _adminLock.Unlock();
+
         _msgHandler.Configure(service);
 
         return Core::ERROR_NONE;
@@ -201,6 +220,7 @@ private:
 
     Handler _msgHandler;
     WebPA::Adapter* _adapter;
+    PluginHost::IShell* _service;
 
     libpd_instance_t _libparodusInstance;
     std::string _parodusURL;
@@ -358,6 +378,15 @@ void GenericAdapter::NotificationCallback::NotifyEvent(const std::string& data,
     TRACE(Trace::Information, (_T("Freed notifyWrpMsg struct.\n")));
 }
 
+void GenericAdapter::NotificationCallback::Statistics(const std::string& report)
+{
+    _parent->_adminLock.Lock();
+    if (_parent->_service != nullptr) {
+        _parent->_service->Notify(_T("{\"notifications\":") + report + _T("}"));
+    }
+    _parent->_adminLock.Unlock();
+}
+
 long GenericAdapter::TimeValDiff(struct timespec *starttime, struct timespec *finishtime)
 {
     long msec;
@@ -391,20 +391,17 @@ namespace Plugin
             break;
         }
         case WPASupplicant::Controller::CTRL_EVENT_CONNECTED: {
-            string message("{ \"event\": \"Connected\", \"ssid\": \"" + _controller->Current() + "\" }");
-            _service->Notify(message);
+            _service->Notify(JSONNotification().String("event", "Connected").String("ssid", _controller->Current()).Data());
             event_connectionchange(_controller->Current());
             break;
         }
         case WPASupplicant::Controller::CTRL_EVENT_DISCONNECTED: {
-            string message("{ \"event\": \"Disconnected\" }");
-            _service->Notify(message);
+            _service->Notify(JSONNotification().String("event", "Disconnected").Data());
             event_connectionchange(string());
             break;
         }
         case WPASupplicant::Controller::CTRL_EVENT_NETWORK_CHANGED: {
-            string message("{ \"event\": \"NetworkUpdate\" }");
-            _service->Notify(message);
+            _service->Notify(JSONNotification().String("event", "NetworkUpdate").Data());
             event_networkchange();
             break;
         }
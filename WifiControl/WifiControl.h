@@ -27,6 +27,7 @@
 #else
 #include "Controller.h"
 #endif
+#include <JSONNotification.h>
 #include <interfaces/json/JsonData_WifiControl.h>
 
 namespace WPEFramework {
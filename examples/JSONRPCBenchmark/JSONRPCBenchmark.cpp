@@ -0,0 +1,699 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MODULE_NAME JSONRPC_Benchmark
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+#include <interfaces/IPerformance.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#include "../JSONRPCPlugin/Data.h"
+
+// Headless, non-interactive counterpart of the JSONRPCClient performance menu. It drives the
+// IPerformance interface of the JSONRPCPlugin over all the transports the plugin offers and
+// reports the results in a machine readable form, so runs can be compared between releases.
+
+// Allocation accounting. Every allocation in the process is counted, the allocations done by
+// the thread issuing the calls are counted separately, so the framework threads (IPC engine,
+// resource monitor) can be distinguished from the cost paid on the calling side.
+static std::atomic<uint64_t> g_allocations(0);
+static thread_local uint64_t t_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    t_allocations++;
+
+    void* result = ::malloc(size == 0 ? 1 : size);
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+    return (result);
+}
+void* operator new[](std::size_t size)
+{
+    return (::operator new(size));
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    t_allocations++;
+    return (::malloc(size == 0 ? 1 : size));
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return (::operator new(size, tag));
+}
+void operator delete(void* ptr) noexcept
+{
+    ::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    ::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    ::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    ::free(ptr);
+}
+
+using namespace WPEFramework;
+
+namespace WPEFramework {
+
+ENUM_CONVERSION_BEGIN(Data::Response::state)
+
+    { Data::Response::ACTIVE, _TXT("Activate") },
+    { Data::Response::INACTIVE, _TXT("Inactivate") },
+    { Data::Response::IDLE, _TXT("Idle") },
+    { Data::Response::FAILURE, _TXT("Failure") },
+
+ENUM_CONVERSION_END(Data::Response::state)
+
+}
+
+namespace Benchmark {
+
+    constexpr uint16_t MaxPayload = 1024 * 32;
+    constexpr uint32_t CallTimeout = 10000;
+
+    enum operation {
+        SEND,
+        RECEIVE,
+        EXCHANGE
+    };
+
+    static const TCHAR* OperationName(const operation value)
+    {
+        return (value == SEND ? _T("send") : (value == RECEIVE ? _T("receive") : _T("exchange")));
+    }
+
+    // A call returns true if the round trip succeeded. The buffer is owned by the calling
+    // worker and is at least MaxPayload bytes.
+    typedef std::function<bool(const operation, uint16_t, uint8_t[])> CallFunction;
+
+    struct Options {
+        Options()
+            : ComChannel(_T("127.0.0.1:8899"))
+            , ThunderAccess(_T("127.0.0.1:80"))
+            , CustomChannel()
+            , Channels(_T("comrpc,jsonrpc,custom"))
+            , Operations(_T("send,receive,exchange"))
+            , Sizes({ 0, 16, 128, 256, 512, 1024, 2048, MaxPayload })
+            , Threads({ 1, 2, 4 })
+            , Iterations(1000)
+            , Warmup(50)
+            , CSV(false)
+            , Output()
+        {
+        }
+
+        string ComChannel;
+        string ThunderAccess;
+        string CustomChannel;
+        string Channels;
+        string Operations;
+        std::vector<uint16_t> Sizes;
+        std::vector<uint16_t> Threads;
+        uint32_t Iterations;
+        uint32_t Warmup;
+        bool CSV;
+        string Output;
+    };
+
+    class Measurement : public Core::JSON::Container {
+    public:
+        Measurement& operator=(const Measurement&) = delete;
+
+        Measurement()
+            : Core::JSON::Container()
+        {
+            Init();
+        }
+        Measurement(const Measurement& copy)
+            : Core::JSON::Container()
+            , Channel(copy.Channel)
+            , Operation(copy.Operation)
+            , Size(copy.Size)
+            , Threads(copy.Threads)
+            , Calls(copy.Calls)
+            , Failures(copy.Failures)
+            , Duration(copy.Duration)
+            , Throughput(copy.Throughput)
+            , Bandwidth(copy.Bandwidth)
+            , Min(copy.Min)
+            , P50(copy.P50)
+            , P99(copy.P99)
+            , P999(copy.P999)
+            , Max(copy.Max)
+            , Allocations(copy.Allocations)
+            , ProcessAllocations(copy.ProcessAllocations)
+        {
+            Init();
+        }
+        ~Measurement()
+        {
+        }
+
+    private:
+        void Init()
+        {
+            Add(_T("channel"), &Channel);
+            Add(_T("operation"), &Operation);
+            Add(_T("size"), &Size);
+            Add(_T("threads"), &Threads);
+            Add(_T("calls"), &Calls);
+            Add(_T("failures"), &Failures);
+            Add(_T("duration"), &Duration);
+            Add(_T("throughput"), &Throughput);
+            Add(_T("bandwidth"), &Bandwidth);
+            Add(_T("min"), &Min);
+            Add(_T("p50"), &P50);
+            Add(_T("p99"), &P99);
+            Add(_T("p999"), &P999);
+            Add(_T("max"), &Max);
+            Add(_T("allocations"), &Allocations);
+            Add(_T("processallocations"), &ProcessAllocations);
+        }
+
+    public:
+        Core::JSON::String Channel;
+        Core::JSON::String Operation;
+        Core::JSON::DecUInt16 Size;
+        Core::JSON::DecUInt16 Threads;
+        Core::JSON::DecUInt32 Calls;
+        Core::JSON::DecUInt32 Failures;
+        Core::JSON::DecUInt64 Duration; // Wall clock time of the run, in microseconds
+        Core::JSON::DecUInt64 Throughput; // Calls per second
+        Core::JSON::DecUInt64 Bandwidth; // Payload bytes per second
+        Core::JSON::DecUInt64 Min; // Latencies, in nanoseconds
+        Core::JSON::DecUInt64 P50;
+        Core::JSON::DecUInt64 P99;
+        Core::JSON::DecUInt64 P999;
+        Core::JSON::DecUInt64 Max;
+        Core::JSON::DecUInt32 Allocations; // Per call, on the calling thread, in thousandths
+        Core::JSON::DecUInt32 ProcessAllocations; // Per call, whole process, in thousandths
+    };
+
+    class Report : public Core::JSON::Container {
+    private:
+        Report(const Report&) = delete;
+        Report& operator=(const Report&) = delete;
+
+    public:
+        Report()
+            : Core::JSON::Container()
+            , Timestamp()
+            , Iterations(0)
+            , Warmup(0)
+            , Measurements()
+        {
+            Add(_T("timestamp"), &Timestamp);
+            Add(_T("iterations"), &Iterations);
+            Add(_T("warmup"), &Warmup);
+            Add(_T("measurements"), &Measurements);
+        }
+        ~Report()
+        {
+        }
+
+    public:
+        Core::JSON::String Timestamp;
+        Core::JSON::DecUInt32 Iterations;
+        Core::JSON::DecUInt32 Warmup;
+        Core::JSON::ArrayType<Measurement> Measurements;
+    };
+
+    static void Fill(uint8_t buffer[], const uint16_t length)
+    {
+        static const uint8_t swapPattern[] = { 0x00, 0x55, 0xAA, 0xFF };
+
+        for (uint16_t index = 0; index < length; index++) {
+            buffer[index] = swapPattern[index % sizeof(swapPattern)];
+        }
+    }
+
+    static uint64_t Percentile(const std::vector<uint64_t>& sorted, const uint16_t perMille)
+    {
+        uint64_t result = 0;
+
+        if (sorted.empty() == false) {
+            size_t rank = static_cast<size_t>(((static_cast<uint64_t>(sorted.size()) * perMille) + 999) / 1000);
+            result = sorted[(rank == 0 ? 0 : rank - 1)];
+        }
+
+        return (result);
+    }
+
+    class Runner {
+    private:
+        Runner() = delete;
+        Runner(const Runner&) = delete;
+        Runner& operator=(const Runner&) = delete;
+
+        struct Worker {
+            Worker()
+                : Latencies()
+                , Failures(0)
+                , Allocations(0)
+            {
+            }
+
+            std::vector<uint64_t> Latencies;
+            uint32_t Failures;
+            uint64_t Allocations;
+        };
+
+    public:
+        Runner(const Options& options, Report& report)
+            : _options(options)
+            , _report(report)
+        {
+        }
+        ~Runner()
+        {
+        }
+
+    public:
+        void Run(const TCHAR channel[], const operation op, const uint16_t size, const uint16_t threads, const CallFunction& call)
+        {
+            std::vector<Worker> workers(threads);
+            std::vector<std::thread> pool;
+            std::atomic<uint16_t> ready(0);
+            std::atomic<bool> go(false);
+
+            pool.reserve(threads);
+
+            for (uint16_t index = 0; index < threads; index++) {
+                pool.emplace_back([&, index]() {
+                    Worker& worker(workers[index]);
+                    uint8_t* buffer = static_cast<uint8_t*>(::malloc(MaxPayload));
+
+                    Fill(buffer, MaxPayload);
+                    worker.Latencies.reserve(_options.Iterations);
+
+                    for (uint32_t run = 0; run < _options.Warmup; run++) {
+                        call(op, size, buffer);
+                    }
+
+                    ready++;
+                    while (go.load() == false) {
+                        std::this_thread::yield();
+                    }
+
+                    uint64_t allocations = t_allocations;
+
+                    for (uint32_t run = 0; run < _options.Iterations; run++) {
+                        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                        bool succeeded = call(op, size, buffer);
+                        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+                        if (succeeded == true) {
+                            worker.Latencies.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+                        } else {
+                            worker.Failures++;
+                        }
+                    }
+
+                    // The latency vector was reserved up front, so the bookkeeping does not show up here.
+                    worker.Allocations = t_allocations - allocations;
+
+                    ::free(buffer);
+                });
+            }
+
+            while (ready.load() < threads) {
+                std::this_thread::yield();
+            }
+
+            uint64_t processAllocations = g_allocations.load();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            go = true;
+
+            for (std::thread& entry : pool) {
+                entry.join();
+            }
+
+            uint64_t duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+            processAllocations = g_allocations.load() - processAllocations;
+
+            std::vector<uint64_t> latencies;
+            uint32_t failures = 0;
+            uint64_t allocations = 0;
+
+            for (const Worker& worker : workers) {
+                latencies.insert(latencies.end(), worker.Latencies.begin(), worker.Latencies.end());
+                failures += worker.Failures;
+                allocations += worker.Allocations;
+            }
+
+            std::sort(latencies.begin(), latencies.end());
+
+            const uint64_t calls = static_cast<uint64_t>(_options.Iterations) * threads;
+            const uint64_t succeeded = latencies.size();
+
+            Measurement& entry(_report.Measurements.Add());
+            entry.Channel = channel;
+            entry.Operation = OperationName(op);
+            entry.Size = size;
+            entry.Threads = threads;
+            entry.Calls = static_cast<uint32_t>(calls);
+            entry.Failures = failures;
+            entry.Duration = duration;
+            entry.Throughput = (duration == 0 ? 0 : (succeeded * 1000000) / duration);
+            entry.Bandwidth = (duration == 0 ? 0 : (succeeded * size * 1000000) / duration);
+            entry.Min = (latencies.empty() ? 0 : latencies.front());
+            entry.P50 = Percentile(latencies, 500);
+            entry.P99 = Percentile(latencies, 990);
+            entry.P999 = Percentile(latencies, 999);
+            entry.Max = (latencies.empty() ? 0 : latencies.back());
+            entry.Allocations = static_cast<uint32_t>(calls == 0 ? 0 : (allocations * 1000) / calls);
+            entry.ProcessAllocations = static_cast<uint32_t>(calls == 0 ? 0 : (processAllocations * 1000) / calls);
+
+            fprintf(stderr, "%-8s %-8s size: %5d threads: %2d p50: %8llu ns p99: %8llu ns calls/s: %7llu failures: %u\n",
+                channel, OperationName(op), size, threads,
+                static_cast<unsigned long long>(entry.P50.Value()), static_cast<unsigned long long>(entry.P99.Value()),
+                static_cast<unsigned long long>(entry.Throughput.Value()), failures);
+        }
+
+        void Sweep(const TCHAR channel[], const CallFunction& call)
+        {
+            static const operation operations[] = { SEND, RECEIVE, EXCHANGE };
+
+            for (const operation op : operations) {
+                if (Selected(_options.Operations, OperationName(op)) == true) {
+                    for (const uint16_t size : _options.Sizes) {
+                        for (const uint16_t threads : _options.Threads) {
+                            Run(channel, op, size, threads, call);
+                        }
+                    }
+                }
+            }
+        }
+
+        static bool Selected(const string& list, const TCHAR name[])
+        {
+            Core::TextSegmentIterator index(Core::TextFragment(list), false, ',');
+            bool found = false;
+
+            while ((found == false) && (index.Next() == true)) {
+                found = (index.Current().Text() == name);
+            }
+
+            return (found);
+        }
+
+    private:
+        const Options& _options;
+        Report& _report;
+    };
+
+    template <typename INTERFACE>
+    static bool Invoke(JSONRPC::LinkType<INTERFACE>& link, const operation op, uint16_t length, uint8_t buffer[])
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        switch (op) {
+        case SEND: {
+            string stringBuffer;
+            Data::JSONDataBuffer message;
+            Core::JSON::DecUInt32 response;
+            Core::ToString(buffer, length, false, stringBuffer);
+            message.Data = stringBuffer;
+            message.Length = length;
+            result = link.template Invoke<Data::JSONDataBuffer, Core::JSON::DecUInt32>(CallTimeout, _T("send"), message, response);
+            break;
+        }
+        case RECEIVE: {
+            Data::JSONDataBuffer message;
+            Core::JSON::DecUInt16 maxSize = length;
+            result = link.template Invoke<Core::JSON::DecUInt16, Data::JSONDataBuffer>(CallTimeout, _T("receive"), maxSize, message);
+            if (result == Core::ERROR_NONE) {
+                length = MaxPayload;
+                Core::FromString(message.Data.Value(), buffer, length);
+            }
+            break;
+        }
+        case EXCHANGE: {
+            string stringBuffer;
+            Data::JSONDataBuffer message;
+            Data::JSONDataBuffer response;
+            Core::ToString(buffer, length, false, stringBuffer);
+            message.Data = stringBuffer;
+            message.Length = length;
+            result = link.template Invoke<Data::JSONDataBuffer, Data::JSONDataBuffer>(CallTimeout, _T("exchange"), message, response);
+            if (result == Core::ERROR_NONE) {
+                length = MaxPayload;
+                Core::FromString(response.Data.Value(), buffer, length);
+            }
+            break;
+        }
+        }
+
+        return (result == Core::ERROR_NONE);
+    }
+
+    static bool Invoke(Exchange::IPerformance* perf, const operation op, uint16_t length, uint8_t buffer[])
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        switch (op) {
+        case SEND:
+            result = perf->Send(length, buffer);
+            break;
+        case RECEIVE:
+            result = perf->Receive(length, buffer);
+            break;
+        case EXCHANGE:
+            result = perf->Exchange(length, buffer, MaxPayload);
+            break;
+        }
+
+        return (result == Core::ERROR_NONE);
+    }
+
+    static void WriteCSV(FILE* output, const Report& report)
+    {
+        fprintf(output, "timestamp,channel,operation,size,threads,calls,failures,duration_us,calls_per_s,bytes_per_s,min_ns,p50_ns,p99_ns,p999_ns,max_ns,allocations_per_call,process_allocations_per_call\n");
+
+        Core::JSON::ArrayType<Measurement>::ConstIterator index(report.Measurements.Elements());
+
+        while (index.Next() == true) {
+            const Measurement& entry(index.Current());
+
+            fprintf(output, "%s,%s,%s,%u,%u,%u,%u,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%u.%03u,%u.%03u\n",
+                report.Timestamp.Value().c_str(),
+                entry.Channel.Value().c_str(),
+                entry.Operation.Value().c_str(),
+                entry.Size.Value(),
+                entry.Threads.Value(),
+                entry.Calls.Value(),
+                entry.Failures.Value(),
+                static_cast<unsigned long long>(entry.Duration.Value()),
+                static_cast<unsigned long long>(entry.Throughput.Value()),
+                static_cast<unsigned long long>(entry.Bandwidth.Value()),
+                static_cast<unsigned long long>(entry.Min.Value()),
+                static_cast<unsigned long long>(entry.P50.Value()),
+                static_cast<unsigned long long>(entry.P99.Value()),
+                static_cast<unsigned long long>(entry.P999.Value()),
+                static_cast<unsigned long long>(entry.Max.Value()),
+                entry.Allocations.Value() / 1000, entry.Allocations.Value() % 1000,
+                entry.ProcessAllocations.Value() / 1000, entry.ProcessAllocations.Value() % 1000);
+        }
+    }
+
+} // namespace Benchmark
+
+static void ParseList(const char* text, std::vector<uint16_t>& list)
+{
+    list.clear();
+
+    while ((text != nullptr) && (*text != '\0')) {
+        char* end;
+        unsigned long value = ::strtoul(text, &end, 10);
+
+        if (end == text) {
+            break;
+        }
+        list.push_back(static_cast<uint16_t>(std::min(value, static_cast<unsigned long>(Benchmark::MaxPayload))));
+        text = (*end == ',' ? end + 1 : end);
+    }
+}
+
+bool ParseOptions(int argc, char** argv, Benchmark::Options& options)
+{
+    int index = 1;
+    bool showHelp = false;
+
+    while ((index < argc) && (!showHelp)) {
+        if ((index + 1) >= argc) {
+            showHelp = true;
+        } else if (strcmp(argv[index], "-remote") == 0) {
+            options.ComChannel = argv[++index];
+        } else if (strcmp(argv[index], "-thunder") == 0) {
+            options.ThunderAccess = argv[++index];
+        } else if (strcmp(argv[index], "-custom") == 0) {
+            options.CustomChannel = argv[++index];
+        } else if (strcmp(argv[index], "-channels") == 0) {
+            options.Channels = argv[++index];
+        } else if (strcmp(argv[index], "-operations") == 0) {
+            options.Operations = argv[++index];
+        } else if (strcmp(argv[index], "-sizes") == 0) {
+            ParseList(argv[++index], options.Sizes);
+        } else if (strcmp(argv[index], "-threads") == 0) {
+            ParseList(argv[++index], options.Threads);
+        } else if (strcmp(argv[index], "-iterations") == 0) {
+            options.Iterations = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+        } else if (strcmp(argv[index], "-warmup") == 0) {
+            options.Warmup = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+        } else if (strcmp(argv[index], "-format") == 0) {
+            options.CSV = (strcmp(argv[++index], "csv") == 0);
+        } else if (strcmp(argv[index], "-output") == 0) {
+            options.Output = argv[++index];
+        } else {
+            showHelp = true;
+        }
+        index++;
+    }
+
+    // Zero threads would make no sense, drop them from the sweep.
+    options.Threads.erase(std::remove(options.Threads.begin(), options.Threads.end(), 0), options.Threads.end());
+
+    if (options.CustomChannel.empty() == true) {
+        // By default the plugin opens its own JSONRPC server right after the COMRPC connector.
+        Core::NodeId comChannel(options.ComChannel.c_str());
+        options.CustomChannel = comChannel.HostAddress() + ':' + Core::NumberType<uint16_t>(comChannel.PortNumber() + 1).Text();
+    }
+
+    return ((showHelp) || (options.Threads.empty() == true) || (options.Iterations == 0));
+}
+
+void ShowHelp()
+{
+    printf("JSONRPCBenchmark [options]\n"
+           "\t-remote <address:port>     COMRPC connector of the JSONRPCPlugin [127.0.0.1:8899]\n"
+           "\t-thunder <address:port>    Thunder JSONRPC (WebSocket) access point [127.0.0.1:80]\n"
+           "\t-custom <address:port>     JSONRPCServer of the JSONRPCPlugin [COMRPC port + 1]\n"
+           "\t-channels <list>           Any of comrpc,jsonrpc,custom [all]\n"
+           "\t-operations <list>         Any of send,receive,exchange [all]\n"
+           "\t-sizes <list>              Payload sizes in bytes [0,16,128,256,512,1024,2048,32768]\n"
+           "\t-threads <list>            Number of concurrent callers [1,2,4]\n"
+           "\t-iterations <count>        Measured calls per caller [1000]\n"
+           "\t-warmup <count>            Unmeasured calls per caller [50]\n"
+           "\t-format <json|csv>         Output format [json]\n"
+           "\t-output <file>             Output file [stdout]\n");
+}
+
+int main(int argc, char** argv)
+{
+    Benchmark::Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    {
+        Benchmark::Report report;
+        Benchmark::Runner runner(options, report);
+
+        report.Timestamp = Core::Time::Now().ToISO8601(true);
+        report.Iterations = options.Iterations;
+        report.Warmup = options.Warmup;
+
+        if (Benchmark::Runner::Selected(options.Channels, _T("comrpc")) == true) {
+            Core::ProxyType<RPC::InvokeServerType<1, 0, 4>> engine(Core::ProxyType<RPC::InvokeServerType<1, 0, 4>>::Create());
+            Core::ProxyType<RPC::CommunicatorClient> client(
+                Core::ProxyType<RPC::CommunicatorClient>::Create(
+                    Core::NodeId(options.ComChannel.c_str()),
+                    Core::ProxyType<Core::IIPCServer>(engine)));
+            engine->Announcements(client->Announcement());
+
+            if (client->Open(2000) != Core::ERROR_NONE) {
+                fprintf(stderr, "Failed to open up a COMRPC link with %s, skipping COMRPC.\n", options.ComChannel.c_str());
+            } else {
+                Exchange::IPerformance* perf = client->Aquire<Exchange::IPerformance>(2000, _T("JSONRPCPlugin"), ~0);
+
+                if (perf == nullptr) {
+                    fprintf(stderr, "The JSONRPCPlugin did not return an IPerformance interface, skipping COMRPC.\n");
+                } else {
+                    runner.Sweep(_T("comrpc"), [perf](const Benchmark::operation op, uint16_t length, uint8_t buffer[]) -> bool {
+                        return (Benchmark::Invoke(perf, op, length, buffer));
+                    });
+                    perf->Release();
+                }
+                client->Close(Core::infinite);
+            }
+            client.Release();
+        }
+
+        // The JSONRPC link picks up its server from the THUNDER_ACCESS environment variable at
+        // construction time, so pointing it to the plugin's own JSONRPCServer is a matter of
+        // changing the variable before the link is created.
+        if (Benchmark::Runner::Selected(options.Channels, _T("jsonrpc")) == true) {
+            Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), options.ThunderAccess);
+
+            JSONRPC::LinkType<Core::JSON::IElement> link(_T("JSONRPCPlugin.2"), _T("benchmark.jsonrpc"));
+            runner.Sweep(_T("jsonrpc"), [&link](const Benchmark::operation op, uint16_t length, uint8_t buffer[]) -> bool {
+                return (Benchmark::Invoke(link, op, length, buffer));
+            });
+        }
+
+        if (Benchmark::Runner::Selected(options.Channels, _T("custom")) == true) {
+            Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), options.CustomChannel);
+
+            JSONRPC::LinkType<Core::JSON::IElement> link(_T("JSONRPCPlugin.2"), _T("benchmark.custom"));
+            runner.Sweep(_T("custom"), [&link](const Benchmark::operation op, uint16_t length, uint8_t buffer[]) -> bool {
+                return (Benchmark::Invoke(link, op, length, buffer));
+            });
+        }
+
+        FILE* output = (options.Output.empty() ? stdout : fopen(options.Output.c_str(), "w"));
+
+        if (output == nullptr) {
+            fprintf(stderr, "Could not open %s for writing.\n", options.Output.c_str());
+        } else {
+            if (options.CSV == true) {
+                Benchmark::WriteCSV(output, report);
+            } else {
+                string text;
+                report.ToString(text);
+                fprintf(output, "%s\n", text.c_str());
+            }
+
+            if (output != stdout) {
+                fclose(output);
+            }
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -21,9 +21,87 @@
 
 #include "../Module.h"
 
+#include <sys/mman.h>
+
 namespace WPEFramework {
 
 class MemoryAllocation {
+private:
+    // Gradual workloads grow in steps of this many ms.
+    static constexpr uint32_t Tick = 100;
+
+    struct Block {
+        void* Address;
+        uint64_t Size; // bytes
+        bool Mapped;
+    };
+
+    // Deterministic for a given seed, so a workload can be replayed exactly.
+    class Random {
+    public:
+        explicit Random(const uint32_t seed)
+            : _state(seed == 0 ? 0x9E3779B9 : seed)
+        {
+        }
+
+    public:
+        uint32_t Next()
+        {
+            _state ^= (_state << 13);
+            _state ^= (_state >> 17);
+            _state ^= (_state << 5);
+            return (_state);
+        }
+        // As many blocks per doubling of the size, so small blocks outnumber the large ones by far, as on a real heap.
+        uint32_t Size(const uint32_t minimum, const uint32_t maximum)
+        {
+            const uint8_t low = Log2(minimum);
+            const uint8_t bucket = low + static_cast<uint8_t>(Next() % (Log2(maximum) - low + 1));
+            const uint32_t from = std::max(minimum, static_cast<uint32_t>(1) << bucket);
+            const uint32_t to = (bucket >= 31 ? maximum : std::min(maximum, (static_cast<uint32_t>(2) << bucket) - 1));
+
+            return (from + (Next() % (to - from + 1)));
+        }
+
+    private:
+        static uint8_t Log2(uint32_t value)
+        {
+            uint8_t result = 0;
+            while ((value >>= 1) != 0) {
+                result++;
+            }
+            return (result);
+        }
+
+    private:
+        uint32_t _state;
+    };
+
+    struct Growth {
+        Growth()
+            : Remaining(0)
+            , Step(0)
+            , Region(nullptr)
+            , Offset(0)
+            , MinBlock(0)
+            , MaxBlock(0)
+            , Generator(0)
+            , Start(0)
+            , Operations(0)
+        {
+        }
+
+        uint64_t Remaining; // bytes
+        uint64_t Step; // bytes per tick
+        uint8_t* Region; // touch only, mapped up front
+        uint64_t Offset;
+        uint32_t MinBlock;
+        uint32_t MaxBlock;
+        Random Generator;
+        uint64_t Start;
+        uint32_t Operations;
+    };
+
 public:
     MemoryAllocation(const MemoryAllocation&) = delete;
     MemoryAllocation& operator=(const MemoryAllocation&) = delete;
@@ -35,6 +113,8 @@ public:
         , _startResident(0)
         , _currentMemoryAllocation(0)
         , _memory()
+        , _growth()
+        , _job(*this)
     {
         DisableOOMKill();
         _startSize = static_cast<uint32_t>(_process.Allocated() >> 10);
@@ -48,7 +128,10 @@ public:
         return (_singleton);
     }
 
-    ~MemoryAllocation() = default;
+    ~MemoryAllocation()
+    {
+        _job.Revoke();
+    }
 
 public:
     // Memory Allocation methods
@@ -60,17 +143,10 @@ public:
 
         _lock.Lock();
         for (noOfBlocks = 0; noOfBlocks < runs; ++noOfBlocks) {
-            _memory.push_back(malloc(static_cast<size_t>(blockSize << 10)));
-            if (!_memory.back()) {
-                SYSLOG(Trace::Fatal, (_T("*** Failed allocation !!! ***")));
+            if (Allocate(blockSize << 10) == false) {
                 break;
             }
-
-            for (uint32_t index = 0; index < (blockSize << 10); index++) {
-                static_cast<unsigned char*>(_memory.back())[index] = static_cast<unsigned char>(rand() & 0xFF);
-            }
         }
-        _currentMemoryAllocation += (noOfBlocks * blockSize);
         _lock.Unlock();
     }
 
@@ -78,25 +154,132 @@ public:
     {
         bool status = false;
 
+        // Outside the lock, a running step takes it.
+        _job.Revoke();
+
+        _lock.Lock();
+
         if (!_memory.empty()) {
             for (auto const& memoryBlock : _memory) {
-                free(memoryBlock);
+                Release(memoryBlock);
             }
             _memory.clear();
             status = true;
         }
 
-        _lock.Lock();
+        _growth = Growth();
         _currentMemoryAllocation = 0;
         _lock.Unlock();
 
         return status;
     }
 
+    // Allocates size kB in blocks drawn from the size distribution, all at once.
+    uint32_t Mixed(const uint32_t size, const uint32_t minBlock, const uint32_t maxBlock, const uint32_t seed)
+    {
+        Random random(seed);
+
+        _lock.Lock();
+        const uint32_t operations = Fill(static_cast<uint64_t>(size) << 10, minBlock, maxBlock, random);
+        _lock.Unlock();
+
+        return (operations);
+    }
+
+    // Allocates size kB the same way, then replaces half of it, at random, with blocks of other sizes
+    // for a number of iterations, and finally frees every other block. What remains is spread over
+    // the whole heap, the allocator can not give the holes back.
+    uint32_t Churn(const uint32_t size, const uint32_t minBlock, const uint32_t maxBlock, const uint32_t iterations, const uint32_t seed)
+    {
+        Random random(seed);
+
+        _lock.Lock();
+
+        const size_t first = _memory.size();
+        uint32_t operations = Fill(static_cast<uint64_t>(size) << 10, minBlock, maxBlock, random);
+
+        for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+            for (size_t index = first; index < _memory.size(); index++) {
+                if ((random.Next() & 1) != 0) {
+                    const uint32_t length = random.Size(minBlock, maxBlock);
+                    void* address = malloc(length);
+
+                    if (address != nullptr) {
+                        Scramble(static_cast<uint8_t*>(address), length);
+                        Release(_memory[index]);
+                        _currentMemoryAllocation += length;
+                        _memory[index].Address = address;
+                        _memory[index].Size = length;
+                        operations += 2;
+                    }
+                }
+            }
+        }
+
+        size_t keep = first;
+        for (size_t index = first; index < _memory.size(); index++) {
+            if (((index - first) & 1) != 0) {
+                _memory[keep++] = _memory[index];
+            } else {
+                Release(_memory[index]);
+                operations++;
+            }
+        }
+        _memory.resize(keep);
+
+        _lock.Unlock();
+
+        return (operations);
+    }
+
+    // Allocates size kB, drawn from the size distribution, at a steady rate over duration seconds.
+    void Leak(const uint32_t size, const uint32_t minBlock, const uint32_t maxBlock, const uint32_t duration, const uint32_t seed)
+    {
+        _job.Revoke();
+
+        _lock.Lock();
+        _growth = Growth();
+        _growth.MinBlock = minBlock;
+        _growth.MaxBlock = maxBlock;
+        _growth.Generator = Random(seed);
+        Start(static_cast<uint64_t>(size) << 10, duration);
+        _lock.Unlock();
+    }
+
+    // Maps size kB and writes it page by page, the resident size grows without any heap activity.
+    // At once, or at a steady rate over duration seconds.
+    uint32_t Touch(const uint32_t size, const uint32_t duration)
+    {
+        const uint64_t length = static_cast<uint64_t>(size) << 10;
+        void* region = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        uint32_t operations = 0;
+
+        _job.Revoke();
+
+        if (region == MAP_FAILED) {
+            SYSLOG(Trace::Fatal, (_T("*** Failed mapping !!! ***")));
+        } else {
+            _lock.Lock();
+            _memory.push_back({ region, length, true });
+            _growth = Growth();
+            _growth.Region = static_cast<uint8_t*>(region);
+
+            if (duration == 0) {
+                _growth.Remaining = length;
+                operations = Step(length);
+            } else {
+                Start(length, duration);
+            }
+            _lock.Unlock();
+        }
+
+        return (operations);
+    }
+
     void Statm(uint32_t& allocated, uint32_t& size, uint32_t& resident)
     {
         _lock.Lock();
-        allocated = _currentMemoryAllocation;
+        allocated = static_cast<uint32_t>(_currentMemoryAllocation >> 10);
         _lock.Unlock();
 
         size = static_cast<uint32_t>(_process.Allocated() >> 10);
@@ -123,6 +306,8 @@ public:
     }
 
 private:
+    friend Core::ThreadPool::JobType<MemoryAllocation&>;
+
     void DisableOOMKill(void)
     {
         int8_t oomNo = -17;
@@ -131,19 +316,133 @@ private:
 
     void LogMemoryUsage(void)
     {
-        SYSLOG(Trace::Information, (_T("*** Current allocated: %lu Kb ***"), _currentMemoryAllocation));
+        SYSLOG(Trace::Information, (_T("*** Current allocated: %lu Kb ***"), static_cast<uint32_t>(_currentMemoryAllocation >> 10)));
         SYSLOG(Trace::Information, (_T("*** Initial Size:     %lu Kb ***"), _startSize));
         SYSLOG(Trace::Information, (_T("*** Initial Resident: %lu Kb ***"), _startResident));
         SYSLOG(Trace::Information, (_T("*** Size:     %lu Kb ***"), static_cast<uint32_t>(_process.Allocated() >> 10)));
         SYSLOG(Trace::Information, (_T("*** Resident: %lu Kb ***"), static_cast<uint32_t>(_process.Resident() >> 10)));
     }
 
+    // Every page of a block is written, so it counts as resident right away.
+    bool Allocate(const uint32_t length)
+    {
+        void* address = malloc(length);
+
+        if (address == nullptr) {
+            SYSLOG(Trace::Fatal, (_T("*** Failed allocation !!! ***")));
+        } else {
+            Scramble(static_cast<uint8_t*>(address), length);
+            _memory.push_back({ address, length, false });
+            _currentMemoryAllocation += length;
+        }
+
+        return (address != nullptr);
+    }
+    // A constant fill gets merged by KSM or compressed to next to nothing by zram, so the pages
+    // would hardly cost any memory. Pseudo random content, seeded by where it goes, does not.
+    static void Scramble(uint8_t* address, const uint64_t length)
+    {
+        Random generator(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(address) >> 4));
+        uint64_t offset = 0;
+        uint32_t word;
+
+        for (; (offset + sizeof(word)) <= length; offset += sizeof(word)) {
+            word = generator.Next();
+            ::memcpy(&address[offset], &word, sizeof(word));
+        }
+        if (offset < length) {
+            word = generator.Next();
+            ::memcpy(&address[offset], &word, static_cast<size_t>(length - offset));
+        }
+    }
+    void Release(const Block& block)
+    {
+        if (block.Mapped == true) {
+            ::munmap(block.Address, block.Size);
+        } else {
+            free(block.Address);
+        }
+        _currentMemoryAllocation -= std::min(_currentMemoryAllocation, block.Size);
+    }
+    uint32_t Fill(const uint64_t length, const uint32_t minBlock, const uint32_t maxBlock, Random& random)
+    {
+        uint64_t filled = 0;
+        uint32_t operations = 0;
+
+        while (filled < length) {
+            const uint32_t size = static_cast<uint32_t>(std::min(static_cast<uint64_t>(random.Size(minBlock, maxBlock)), length - filled));
+
+            if (Allocate(size) == false) {
+                break;
+            }
+            filled += size;
+            operations++;
+        }
+
+        return (operations);
+    }
+    // A new gradual workload replaces the one that might still be going on.
+    void Start(const uint64_t length, const uint32_t duration)
+    {
+        const uint64_t steps = std::max(static_cast<uint64_t>(1), (static_cast<uint64_t>(duration) * 1000) / Tick);
+
+        _growth.Remaining = length;
+        _growth.Step = std::max(static_cast<uint64_t>(getpagesize()), length / steps);
+        _growth.Start = Core::Time::Now().Ticks();
+
+        _job.Submit();
+    }
+    uint32_t Step(const uint64_t length)
+    {
+        uint32_t operations = 0;
+
+        if (_growth.Region != nullptr) {
+            const uint64_t pageSize = getpagesize();
+            const uint64_t end = _growth.Offset + length;
+
+            for (uint64_t offset = _growth.Offset; offset < end; offset += pageSize) {
+                Scramble(&_growth.Region[offset], std::min(pageSize, end - offset));
+                operations++;
+            }
+
+            _currentMemoryAllocation += length;
+            _growth.Offset = end;
+        } else {
+            operations = Fill(length, _growth.MinBlock, _growth.MaxBlock, _growth.Generator);
+        }
+
+        _growth.Remaining -= length;
+        _growth.Operations += operations;
+
+        return (operations);
+    }
+    void Dispatch()
+    {
+        _lock.Lock();
+
+        if (_growth.Remaining > 0) {
+            Step(std::min(_growth.Step, _growth.Remaining));
+
+            if (_growth.Remaining > 0) {
+                _job.Schedule(Core::Time::Now().Add(static_cast<uint32_t>(Tick)));
+            } else {
+                SYSLOG(Trace::Information, (_T("*** Workload completed: %u operations in %u ms, resident %u Kb ***"),
+                    _growth.Operations, static_cast<uint32_t>((Core::Time::Now().Ticks() - _growth.Start) / Core::Time::TicksPerMillisecond),
+                    static_cast<uint32_t>(_process.Resident() >> 10)));
+            }
+        }
+
+        _lock.Unlock();
+    }
+
 private:
     Core::CriticalSection _lock;
     Core::ProcessInfo _process;
     uint32_t _startSize;
     uint32_t _startResident;
-    uint32_t _currentMemoryAllocation; // size in Kb
-    std::list<void*> _memory;
+    uint64_t _currentMemoryAllocation; // size in bytes
+    std::vector<Block> _memory;
+    Growth _growth;
+    Core::WorkerPool::JobType<MemoryAllocation&> _job;
 };
 } // namespace WPEFramework
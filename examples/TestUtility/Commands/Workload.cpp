@@ -0,0 +1,124 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include "../CommandCore/TestCommandBase.h"
+#include "../CommandCore/TestCommandController.h"
+#include "MemoryAllocation.h"
+#include "WorkloadData.h"
+
+namespace WPEFramework {
+
+class Workload : public TestCommandBase {
+public:
+    Workload(const Workload&) = delete;
+    Workload& operator=(const Workload&) = delete;
+
+public:
+    using Parameter = JsonData::TestUtility::InputInfo;
+
+    Workload()
+        : TestCommandBase(TestCommandBase::DescriptionBuilder("Runs a memory workload: mixed, leak, touch or churn"),
+              TestCommandBase::SignatureBuilder("memory", JsonData::TestUtility::TypeType::NUMBER, "memory statistics in KB and the time the workload took in us")
+                  .InputParameter("mode", JsonData::TestUtility::TypeType::STRING, "mixed (allocate at once), leak (allocate over duration), touch (grow resident without heap activity) or churn (fragment the heap)")
+                  .InputParameter("size", JsonData::TestUtility::TypeType::NUMBER, "memory in kB for the workload")
+                  .InputParameter("minblock", JsonData::TestUtility::TypeType::NUMBER, "smallest block in bytes [16]")
+                  .InputParameter("maxblock", JsonData::TestUtility::TypeType::NUMBER, "largest block in bytes [262144]")
+                  .InputParameter("duration", JsonData::TestUtility::TypeType::NUMBER, "seconds to spread leak and touch over, 0 is at once [0]")
+                  .InputParameter("iterations", JsonData::TestUtility::TypeType::NUMBER, "churn passes over the blocks [4]")
+                  .InputParameter("seed", JsonData::TestUtility::TypeType::NUMBER, "seed of the block sizes, equal seeds give equal workloads [1]"))
+        , _memoryAdmin(MemoryAllocation::Instance())
+    {
+        TestCore::TestCommandController::Instance().Announce(this);
+    }
+
+    virtual ~Workload()
+    {
+        TestCore::TestCommandController::Instance().Revoke(this);
+    }
+
+public:
+    // ICommand methods
+    string Execute(const string& params) final
+    {
+        string response = EMPTY_STRING;
+        WorkloadParamsData input;
+
+        if ((input.FromString(params) == true) && (input.Mode.IsSet() == true) && (input.MinBlock.Value() != 0) && (input.MinBlock.Value() <= input.MaxBlock.Value())) {
+            const string& mode = input.Mode.Value();
+            const uint32_t size = input.Size.Value();
+            uint32_t allocated, total, before, after;
+            uint32_t operations = 0;
+            bool known = true;
+
+            _memoryAdmin.Statm(allocated, total, before);
+
+            const uint64_t start = Core::Time::Now().Ticks();
+
+            if (mode == _T("mixed")) {
+                operations = _memoryAdmin.Mixed(size, input.MinBlock.Value(), input.MaxBlock.Value(), input.Seed.Value());
+            } else if (mode == _T("leak")) {
+                _memoryAdmin.Leak(size, input.MinBlock.Value(), input.MaxBlock.Value(), input.Duration.Value(), input.Seed.Value());
+            } else if (mode == _T("touch")) {
+                operations = _memoryAdmin.Touch(size, input.Duration.Value());
+            } else if (mode == _T("churn")) {
+                operations = _memoryAdmin.Churn(size, input.MinBlock.Value(), input.MaxBlock.Value(), input.Iterations.Value(), input.Seed.Value());
+            } else {
+                known = false;
+            }
+
+            const uint32_t elapsed = static_cast<uint32_t>(Core::Time::Now().Ticks() - start);
+
+            if (known == true) {
+                WorkloadResultData result;
+
+                _memoryAdmin.Statm(allocated, total, after);
+
+                SYSLOG(Trace::Information, (_T("*** Workload %s: %u operations in %u us, resident %u -> %u Kb ***"), mode.c_str(), operations, elapsed, before, after));
+
+                result.Operations = operations;
+                result.Elapsed = elapsed;
+                result.Growth = static_cast<int32_t>(after - before);
+                result.Allocated = allocated;
+                result.Size = total;
+                result.Resident = after;
+                result.ToString(response);
+            }
+        }
+
+        return (response);
+    }
+
+    string Name() const final
+    {
+        return _name;
+    }
+
+private:
+    BEGIN_INTERFACE_MAP(Workload)
+    INTERFACE_ENTRY(Exchange::ITestUtility::ICommand)
+    END_INTERFACE_MAP
+
+private:
+    MemoryAllocation& _memoryAdmin;
+    const string _name = _T("Workload");
+};
+
+static Workload* _singleton(Core::Service<Workload>::Create<Workload>());
+
+} // namespace WPEFramework
@@ -0,0 +1,86 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#pragma once
+
+#include "../Module.h"
+
+namespace WPEFramework {
+
+// Parameters and result of the Workload command, shared with the runworkload JSON-RPC method.
+class WorkloadParamsData : public Core::JSON::Container {
+public:
+    WorkloadParamsData(const WorkloadParamsData&) = delete;
+    WorkloadParamsData& operator=(const WorkloadParamsData&) = delete;
+
+    WorkloadParamsData()
+        : Core::JSON::Container()
+        , Mode()
+        , Size(0)
+        , MinBlock(16)
+        , MaxBlock(256 * 1024)
+        , Duration(0)
+        , Iterations(4)
+        , Seed(1)
+    {
+        Add(_T("mode"), &Mode);
+        Add(_T("size"), &Size);
+        Add(_T("minblock"), &MinBlock);
+        Add(_T("maxblock"), &MaxBlock);
+        Add(_T("duration"), &Duration);
+        Add(_T("iterations"), &Iterations);
+        Add(_T("seed"), &Seed);
+    }
+
+public:
+    Core::JSON::String Mode; // mixed, leak, touch or churn
+    Core::JSON::DecUInt32 Size; // kB
+    Core::JSON::DecUInt32 MinBlock; // bytes
+    Core::JSON::DecUInt32 MaxBlock; // bytes
+    Core::JSON::DecUInt32 Duration; // s, 0 is at once
+    Core::JSON::DecUInt32 Iterations;
+    Core::JSON::DecUInt32 Seed;
+};
+
+class WorkloadResultData : public Core::JSON::Container {
+public:
+    WorkloadResultData(const WorkloadResultData&) = delete;
+    WorkloadResultData& operator=(const WorkloadResultData&) = delete;
+
+    WorkloadResultData()
+        : Core::JSON::Container()
+    {
+        Add(_T("operations"), &Operations);
+        Add(_T("elapsed"), &Elapsed);
+        Add(_T("growth"), &Growth);
+        Add(_T("allocated"), &Allocated);
+        Add(_T("size"), &Size);
+        Add(_T("resident"), &Resident);
+    }
+
+public:
+    Core::JSON::DecUInt32 Operations;
+    Core::JSON::DecUInt32 Elapsed; // us
+    Core::JSON::DecSInt32 Growth; // resident kB gained, negative if it shrunk
+    Core::JSON::DecUInt32 Allocated; // kB
+    Core::JSON::DecUInt32 Size; // kB
+    Core::JSON::DecUInt32 Resident; // kB
+};
+
+} // namespace WPEFramework
@@ -22,6 +22,7 @@
 #include "Module.h"
 
 #include "CommandCore/TestCommandController.h"
+#include "Commands/WorkloadData.h"
 #include <interfaces/IMemory.h>
 #include <interfaces/ITestUtility.h>
 #include <interfaces/json/JsonData_TestUtility.h>
@@ -130,6 +131,7 @@ namespace Plugin {
         void UnregisterAll();
         uint32_t endpoint_runmemory(const JsonData::TestUtility::RunmemoryParamsData& params, JsonData::TestUtility::RunmemoryResultData& response);
         uint32_t endpoint_runcrash(const JsonData::TestUtility::RuncrashParamsData& params);
+        uint32_t endpoint_runworkload(const WorkloadParamsData& params, WorkloadResultData& response);
         uint32_t get_commands(Core::JSON::ArrayType<Core::JSON::String>& response) const;
         uint32_t get_description(const string& index, JsonData::TestUtility::DescriptionData& response) const;
         uint32_t get_parameters(const string& index, JsonData::TestUtility::ParametersData& response) const;
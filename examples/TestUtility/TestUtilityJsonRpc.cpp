@@ -34,6 +34,7 @@ namespace Plugin {
     {
         Register<RunmemoryParamsData,RunmemoryResultData>(_T("runmemory"), &TestUtility::endpoint_runmemory, this);
         Register<RuncrashParamsData,void>(_T("runcrash"), &TestUtility::endpoint_runcrash, this);
+        Register<WorkloadParamsData,WorkloadResultData>(_T("runworkload"), &TestUtility::endpoint_runworkload, this);
         Property<Core::JSON::ArrayType<Core::JSON::String>>(_T("commands"), &TestUtility::get_commands, nullptr, this);
         Property<DescriptionData>(_T("description"), &TestUtility::get_description, nullptr, this);
         Property<ParametersData>(_T("parameters"), &TestUtility::get_parameters, nullptr, this);
@@ -42,6 +43,7 @@ namespace Plugin {
 
     void TestUtility::UnregisterAll()
     {
+        Unregister(_T("runworkload"));
         Unregister(_T("runcrash"));
         Unregister(_T("runmemory"));
         Unregister(_T("parameters"));
@@ -114,6 +116,36 @@ namespace Plugin {
         return result;
     }
 
+    // Method: runworkload - Runs a memory workload
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNAVAILABLE: Workload command not available
+    //  - ERROR_BAD_REQUEST: Bad JSON param data format
+    uint32_t TestUtility::endpoint_runworkload(const WorkloadParamsData& params, WorkloadResultData& response)
+    {
+        uint32_t result = Core::ERROR_BAD_REQUEST;
+
+        TRACE_L1("*** Call endpoint_runworkload ***");
+
+        if (params.Mode.IsSet() == true)
+        {
+            Exchange::ITestUtility::ICommand* command = _testUtilityImp->Command(_T("Workload"));
+
+            if (command) {
+                string tmpParams, tmpResponse;
+
+                params.ToString(tmpParams);
+                tmpResponse = command->Execute(tmpParams);
+                if (response.FromString(tmpResponse) == true) {
+                    result = Core::ERROR_NONE;
+                }
+            } else {
+                result = Core::ERROR_UNAVAILABLE;
+            }
+        }
+        return result;
+    }
+
     // Property: commands - Retrieves the list of test commands
     // Return codes:
     //  - ERROR_NONE: Success
@@ -0,0 +1,208 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include <JSONNotification.h>
+
+// Builds the notifications of the Streamer, Monitor, NetworkControl and WifiControl plugins, once by
+// string concatenation as the plugins used to, once with the JSONNotification builder they use now,
+// and reports the time and the number of heap allocations per notification. Allocations are counted
+// by replacing the global operator new of this executable.
+
+namespace {
+
+    std::atomic<uint64_t> Allocations(0);
+
+}
+
+void* operator new(size_t size)
+{
+    Allocations++;
+
+    void* result = ::malloc(size != 0 ? size : 1);
+
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return (result);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    ::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    ::free(pointer);
+}
+
+using namespace WPEFramework::Plugin;
+
+namespace {
+
+    struct Options {
+        Options()
+            : Notifications(1000000)
+        {
+        }
+
+        uint32_t Notifications;
+    };
+
+    struct Result {
+        double Nanoseconds;
+        double Allocations;
+        size_t Length;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        bool showHelp = false;
+
+        for (int index = 1; (index < argc) && (showHelp == false); index++) {
+            const bool value = ((index + 1) < argc);
+
+            if ((value == true) && (strcmp(argv[index], "-notifications") == 0)) {
+                options.Notifications = static_cast<uint32_t>(::strtoul(argv[++index], nullptr, 10));
+            } else {
+                showHelp = true;
+            }
+        }
+
+        return ((showHelp == true) || (options.Notifications == 0));
+    }
+
+    void ShowHelp()
+    {
+        printf("JSONNotificationBenchmark [options]\n"
+               "\t-notifications <count>    Notifications built per event and method [1000000]\n");
+    }
+
+    // The text is handed over to a consumer that only looks at its length, just like Notify() the
+    // plugins hand it over without copying.
+    template <typename BUILD>
+    Result Measure(const uint32_t count, BUILD build)
+    {
+        Result result;
+        size_t length = 0;
+
+        // Warm up, the builder buffer grows to its size on the first notification.
+        length += build(0).length();
+
+        const uint64_t allocations = Allocations.load();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint32_t index = 0; index < count; index++) {
+            length += build(index).length();
+        }
+
+        result.Nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+        result.Allocations = static_cast<double>(Allocations.load() - allocations) / count;
+        result.Length = length / (count + 1);
+
+        return (result);
+    }
+
+    void Report(const char event[], const Result& concatenated, const Result& built)
+    {
+        printf("%s,%.1f,%.2f,%zu,%.1f,%.2f,%zu\n", event,
+            concatenated.Nanoseconds, concatenated.Allocations, concatenated.Length,
+            built.Nanoseconds, built.Allocations, built.Length);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (ParseOptions(argc, argv, options) == true) {
+        ShowHelp();
+        return (1);
+    }
+
+    const uint32_t count = options.Notifications;
+    const std::string callsign("WebKitBrowser");
+    const std::string interface("eth0");
+    const std::string address("192.168.1.34");
+    const std::string ssid("Living \"room\" 5GHz");
+    std::string message;
+
+    printf("event,concatenated_ns,concatenated_allocations,concatenated_bytes,builder_ns,builder_allocations,builder_bytes\n");
+
+    // Streamer, a position update of a stream.
+    Report("streamer_timeupdate",
+        Measure(count, [&](const uint32_t index) -> const std::string& {
+            message = std::string("{ \"id\": ") + std::to_string(index & 0xFF) + std::string(", \"time\": ") + std::to_string(static_cast<uint64_t>(index) * 40000) + std::string(" }");
+            return (message);
+        }),
+        Measure(count, [&](const uint32_t index) -> const std::string& {
+            return (JSONNotification().Number("id", static_cast<uint8_t>(index)).Number("time", static_cast<uint64_t>(index) * 40000).Data());
+        }));
+
+    // Streamer, a state change of a stream.
+    Report("streamer_statechange",
+        Measure(count, [&](const uint32_t index) -> const std::string& {
+            message = std::string("{ \"id\": ") + std::to_string(index & 0xFF) + std::string(", \"stream\": \"") + "Playing" + std::string("\" }");
+            return (message);
+        }),
+        Measure(count, [&](const uint32_t index) -> const std::string& {
+            return (JSONNotification().Number("id", static_cast<uint8_t>(index)).String("stream", "Playing").Data());
+        }));
+
+    // Monitor, a plugin restarted after it misbehaved.
+    Report("monitor_action",
+        Measure(count, [&](const uint32_t) -> const std::string& {
+            message = std::string("{\"callsign\": \"" + callsign + "\", \"action\": \"Activate\", \"reason\": \"Automatic\" }");
+            return (message);
+        }),
+        Measure(count, [&](const uint32_t) -> const std::string& {
+            return (JSONNotification().String("callsign", callsign).String("action", "Activate").String("reason", "Automatic").Data());
+        }));
+
+    // NetworkControl, an address obtained through DHCP.
+    Report("networkcontrol_dhcp",
+        Measure(count, [&](const uint32_t) -> const std::string& {
+            message = std::string(std::string("{ \"interface\": \"") + interface + std::string("\", \"status\":0, \"ip\":\"" + address + "\" }"));
+            return (message);
+        }),
+        Measure(count, [&](const uint32_t) -> const std::string& {
+            return (JSONNotification().String("interface", interface).Number("status", 0).String("ip", address).Data());
+        }));
+
+    // WifiControl, connected to a network. The concatenated version does not escape the SSID.
+    Report("wificontrol_connected",
+        Measure(count, [&](const uint32_t) -> const std::string& {
+            message = std::string("{ \"event\": \"Connected\", \"ssid\": \"" + ssid + "\" }");
+            return (message);
+        }),
+        Measure(count, [&](const uint32_t) -> const std::string& {
+            return (JSONNotification().String("event", "Connected").String("ssid", ssid).Data());
+        }));
+
+    return (0);
+}
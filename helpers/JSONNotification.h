@@ -0,0 +1,246 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <type_traits>
+
+namespace WPEFramework {
+namespace Plugin {
+
+    // Writes the flat JSON object of a plugin notification straight into a buffer that is reused
+    // from one notification to the next, so once the buffer has grown to the size of the largest
+    // notification, building one does not allocate. Strings are escaped on the way in, numbers are
+    // formatted on the stack. By default the buffer is owned by the calling thread, the text returned
+    // by Data() is valid until the next notification is built on that thread, so hand it over to
+    // Notify() right away. Only depends on the standard library, so it can be used stand alone.
+    //
+    //     _service->Notify(JSONNotification().Number("id", index).String("stream", name).Data());
+    //
+    class JSONNotification {
+    public:
+        JSONNotification(const JSONNotification&) = delete;
+        JSONNotification& operator=(const JSONNotification&) = delete;
+
+        JSONNotification()
+            : JSONNotification(Buffer())
+        {
+        }
+        explicit JSONNotification(std::string& buffer)
+            : _buffer(buffer)
+            , _length(0)
+            , _closed(false)
+        {
+            // Write in place up to what the buffer already holds, only grow it if that does not fit.
+            _buffer.resize(_buffer.capacity());
+            Reserve(1);
+            _buffer[_length++] = '{';
+        }
+        ~JSONNotification()
+        {
+        }
+
+    public:
+        JSONNotification& String(const char key[], const std::string& value)
+        {
+            Key(key);
+            Quoted(value.c_str(), value.length());
+            return (*this);
+        }
+        JSONNotification& String(const char key[], const char value[])
+        {
+            Key(key);
+            Quoted(value, ::strlen(value));
+            return (*this);
+        }
+        // A number sent as text, some notifications carry them like this.
+        template <typename NUMBER, typename std::enable_if<std::is_integral<NUMBER>::value, int>::type = 0>
+        JSONNotification& String(const char key[], const NUMBER value)
+        {
+            Key(key);
+            Reserve(MaxDigits + 2);
+            _buffer[_length++] = '\"';
+            Integer(value);
+            _buffer[_length++] = '\"';
+            return (*this);
+        }
+        template <typename NUMBER, typename std::enable_if<std::is_integral<NUMBER>::value, int>::type = 0>
+        JSONNotification& Number(const char key[], const NUMBER value)
+        {
+            Key(key);
+            Reserve(MaxDigits);
+            Integer(value);
+            return (*this);
+        }
+        JSONNotification& Boolean(const char key[], const bool value)
+        {
+            Key(key);
+            Raw((value == true ? "true" : "false"), (value == true ? 4 : 5));
+            return (*this);
+        }
+        const std::string& Data()
+        {
+            if (_closed == false) {
+                Reserve(1);
+                _buffer[_length++] = '}';
+                _closed = true;
+            }
+            // Shrinking keeps the capacity for the next notification.
+            _buffer.resize(_length);
+            return (_buffer);
+        }
+
+    private:
+        static constexpr size_t MaxDigits = 20;
+
+        static std::string& Buffer()
+        {
+            static thread_local std::string buffer;
+            return (buffer);
+        }
+        void Reserve(const size_t extra)
+        {
+            if ((_length + extra) > _buffer.length()) {
+                _buffer.resize(std::max(_buffer.length() * 2, _length + extra));
+            }
+        }
+        void Raw(const char text[], const size_t length)
+        {
+            Reserve(length);
+            ::memcpy(&_buffer[_length], text, length);
+            _length += length;
+        }
+        void Key(const char key[])
+        {
+            // Keys are literals in the plugin code, they are not escaped.
+            const size_t length = ::strlen(key);
+
+            Reserve(length + 4);
+
+            if (_length > 1) {
+                _buffer[_length++] = ',';
+            }
+            _buffer[_length++] = '\"';
+            ::memcpy(&_buffer[_length], key, length);
+            _length += length;
+            _buffer[_length++] = '\"';
+            _buffer[_length++] = ':';
+        }
+        void Quoted(const char value[], const size_t length)
+        {
+            static const char Hex[] = "0123456789abcdef";
+
+            // Worst case every character becomes a \u00XX sequence.
+            Reserve((length * 6) + 2);
+
+            char* output = &_buffer[_length];
+            *output++ = '\"';
+
+            for (const char* current = value; current != (value + length); current++) {
+                const unsigned char character = static_cast<unsigned char>(*current);
+
+                if ((character > '\\') || ((character >= 0x20) && (character != '\"') && (character != '\\'))) {
+                    *output++ = static_cast<char>(character);
+                } else {
+                    *output++ = '\\';
+
+                    switch (character) {
+                    case '\"':
+                        *output++ = '\"';
+                        break;
+                    case '\\':
+                        *output++ = '\\';
+                        break;
+                    case '\n':
+                        *output++ = 'n';
+                        break;
+                    case '\r':
+                        *output++ = 'r';
+                        break;
+                    case '\t':
+                        *output++ = 't';
+                        break;
+                    case '\b':
+                        *output++ = 'b';
+                        break;
+                    case '\f':
+                        *output++ = 'f';
+                        break;
+                    default:
+                        *output++ = 'u';
+                        *output++ = '0';
+                        *output++ = '0';
+                        *output++ = Hex[character >> 4];
+                        *output++ = Hex[character & 0xF];
+                        break;
+                    }
+                }
+            }
+
+            *output++ = '\"';
+            _length = output - _buffer.data();
+        }
+        template <typename NUMBER>
+        static bool IsNegative(const NUMBER value, std::true_type)
+        {
+            return (value < 0);
+        }
+        template <typename NUMBER>
+        static bool IsNegative(const NUMBER, std::false_type)
+        {
+            return (false);
+        }
+        // The caller reserves MaxDigits.
+        template <typename NUMBER>
+        void Integer(const NUMBER value)
+        {
+            typedef typename std::make_unsigned<NUMBER>::type UNSIGNED;
+
+            char text[MaxDigits];
+            char* position = &text[sizeof(text)];
+            const bool negative = IsNegative(value, std::is_signed<NUMBER>());
+            // Negate in the unsigned domain, the most negative value has no positive counterpart.
+            UNSIGNED remaining = (negative == true ? static_cast<UNSIGNED>(0 - static_cast<UNSIGNED>(value)) : static_cast<UNSIGNED>(value));
+
+            do {
+                *(--position) = static_cast<char>('0' + (remaining % 10));
+                remaining /= 10;
+            } while (remaining != 0);
+
+            if (negative == true) {
+                *(--position) = '-';
+            }
+
+            const size_t length = &text[sizeof(text)] - position;
+            ::memcpy(&_buffer[_length], position, length);
+            _length += length;
+        }
+
+    private:
+        std::string& _buffer;
+        size_t _length;
+        bool _closed;
+    };
+
+} // namespace Plugin
+} // namespace WPEFramework